@@ -20,6 +20,7 @@
 #include <aws/core/http/HttpClientFactory.h>
 #include <aws/core/utils/HashingUtils.h>
 #include <aws/core/utils/Outcome.h>
+#include <aws/core/AmazonSerializableWebServiceRequest.h>
 #include <aws/core/Globals.h>
 #include <aws/testing/mocks/http/MockHttpClient.h>
 #include <aws/core/utils/EnumParseOverflowContainer.h>
@@ -28,8 +29,19 @@
 #include <aws/core/platform/FileSystem.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/core/platform/Environment.h>
+#include <aws/core/client/HedgingPolicy.h>
+#include <aws/core/client/AWSErrorMarshaller.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <aws/core/utils/xml/XmlSerializer.h>
+#include <aws/core/utils/threading/Executor.h>
+#ifndef _WIN32
+#include "../../http/LoopbackHttpServer.h"
+#endif
 #include <fstream>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 using Aws::Utils::DateTime;
 using Aws::Utils::DateFormat;
@@ -223,6 +235,490 @@ TEST_F(AWSClientTestSuite, TestClockChangesAfterSkewHasBeenSet)
     ASSERT_EQ(1, client->GetRequestAttemptedRetries());
 }
 
+TEST_F(AWSClientTestSuite, TestAsyncRequestRetriesUntilSuccess)
+{
+    // null responses are reported as retryable network errors, the second retry is delayed on the retry timer.
+    mockHttpClient->AddResponseToReturn(nullptr);
+    mockHttpClient->AddResponseToReturn(nullptr);
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+
+    std::mutex mutex;
+    std::condition_variable completed;
+    bool done = false;
+    HttpResponseOutcome outcome;
+    auto request = Aws::MakeShared<AmazonWebServiceRequestMock>(ALLOCATION_TAG);
+    client->MakeRequestAsync(request, [&](const HttpResponseOutcome& result)
+    {
+        std::lock_guard<std::mutex> locker(mutex);
+        outcome = result;
+        done = true;
+        completed.notify_one();
+    });
+
+    std::unique_lock<std::mutex> locker(mutex);
+    ASSERT_TRUE(completed.wait_for(locker, std::chrono::seconds(10), [&] { return done; }));
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(HttpResponseCode::OK, outcome.GetResult()->GetResponseCode());
+    ASSERT_EQ(2, client->GetRequestAttemptedRetries());
+    ASSERT_EQ(3u, mockHttpClient->GetAllRequestsMade().size());
+}
+
+// Records the thread each request is made on.
+class ThreadRecordingHttpClient : public MockHttpClient
+{
+public:
+    std::shared_ptr<HttpResponse> MakeRequest(const std::shared_ptr<HttpRequest>& request,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_requestThreads.push_back(std::this_thread::get_id());
+        return MockHttpClient::MakeRequest(request, readLimiter, writeLimiter);
+    }
+
+    Aws::Vector<std::thread::id> GetRequestThreads() const
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        return m_requestThreads;
+    }
+
+private:
+    mutable std::mutex m_lock;
+    mutable Aws::Vector<std::thread::id> m_requestThreads;
+};
+
+TEST_F(AWSClientTestSuite, TestAsyncRetriesAreBuiltOnExecutor)
+{
+    auto recordingHttpClient = Aws::MakeShared<ThreadRecordingHttpClient>(ALLOCATION_TAG);
+    mockHttpClient = recordingHttpClient;
+    mockHttpClientFactory->SetClient(mockHttpClient);
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    config.retryStrategy = Aws::MakeShared<CountedRetryStrategy>(ALLOCATION_TAG);
+    client = Aws::MakeUnique<MockAWSClient>(ALLOCATION_TAG, config);
+
+    auto executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, 1);
+    std::thread::id executorThread;
+    std::mutex mutex;
+    std::condition_variable completed;
+    bool done = false;
+    executor->Submit([&]()
+    {
+        std::lock_guard<std::mutex> locker(mutex);
+        executorThread = std::this_thread::get_id();
+    });
+
+    // the first retry goes out without a delay, straight from the completion of the failed attempt; the second after one, off the timer.
+    mockHttpClient->AddResponseToReturn(nullptr);
+    mockHttpClient->AddResponseToReturn(nullptr);
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    HttpResponseOutcome outcome;
+    client->MakeRequestAsync(Aws::MakeShared<AmazonWebServiceRequestMock>(ALLOCATION_TAG), [&](const HttpResponseOutcome& result)
+    {
+        std::lock_guard<std::mutex> locker(mutex);
+        outcome = result;
+        done = true;
+        completed.notify_one();
+    }, executor);
+
+    std::unique_lock<std::mutex> locker(mutex);
+    ASSERT_TRUE(completed.wait_for(locker, std::chrono::seconds(10), [&] { return done; }));
+    ASSERT_TRUE(outcome.IsSuccess());
+    auto requestThreads = recordingHttpClient->GetRequestThreads();
+    ASSERT_EQ(3u, requestThreads.size());
+    ASSERT_EQ(std::this_thread::get_id(), requestThreads[0]);
+    ASSERT_EQ(executorThread, requestThreads[1]);
+    ASSERT_EQ(executorThread, requestThreads[2]);
+}
+
+TEST_F(AWSClientTestSuite, TestAsyncRequestDoesNotRetryNonRetryableError)
+{
+    QueueMockResponse(HttpResponseCode::BAD_REQUEST, HeaderValueCollection());
+
+    int calls = 0;
+    HttpResponseOutcome outcome;
+    auto request = Aws::MakeShared<AmazonWebServiceRequestMock>(ALLOCATION_TAG);
+    // the mock http client completes synchronously, so without a retry the handler runs before MakeRequestAsync returns.
+    client->MakeRequestAsync(request, [&](const HttpResponseOutcome& result)
+    {
+        outcome = result;
+        calls++;
+    });
+
+    ASSERT_EQ(1, calls);
+    ASSERT_FALSE(outcome.IsSuccess());
+    ASSERT_EQ(HttpResponseCode::BAD_REQUEST, outcome.GetError().GetResponseCode());
+    ASSERT_EQ(0, client->GetRequestAttemptedRetries());
+}
+
+class CountingSerializableRequest : public AmazonSerializableWebServiceRequest
+{
+public:
+    CountingSerializableRequest() : m_serializeCount(0) { }
+    Aws::String SerializePayload() const override { m_serializeCount++; return "{\"key\":\"value\"}"; }
+    HeaderValueCollection GetHeaders() const override { return HeaderValueCollection(); }
+    bool ShouldComputeContentMd5() const override { return true; }
+    const char* GetServiceRequestName() const override { return "CountingSerializableRequest"; }
+    int GetSerializeCount() const { return m_serializeCount; }
+
+private:
+    mutable int m_serializeCount;
+};
+
+TEST_F(AWSClientTestSuite, TestRetriesReuseSerializedPayload)
+{
+    mockHttpClient->AddResponseToReturn(nullptr);
+    mockHttpClient->AddResponseToReturn(nullptr);
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+
+    CountingSerializableRequest request;
+    auto outcome = client->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(2, client->GetRequestAttemptedRetries());
+    ASSERT_EQ(1, request.GetSerializeCount());
+
+    const auto& requestsMade = mockHttpClient->GetAllRequestsMade();
+    ASSERT_EQ(3u, requestsMade.size());
+    const Aws::String expectedMd5 = Aws::Utils::HashingUtils::Base64Encode(Aws::Utils::HashingUtils::CalculateMD5("{\"key\":\"value\"}"));
+    for (const auto& requestMade : requestsMade)
+    {
+        ASSERT_EQ("15", requestMade.GetContentLength());
+        ASSERT_EQ(expectedMd5, requestMade.GetHeaderValue(Http::CONTENT_MD5_HEADER));
+        ASSERT_EQ(Aws::Utils::HashingUtils::HexEncode(Aws::Utils::HashingUtils::CalculateSHA256("{\"key\":\"value\"}")), requestMade.GetContentBodySha256());
+    }
+}
+
+class PacingRetryStrategy : public CountedRetryStrategy
+{
+public:
+    PacingRetryStrategy(long sendDelayMs) : m_sendDelayMs(sendDelayMs), m_sendTokens(0), m_succeeded(0), m_failed(0) {}
+
+    // holds every attempt back once
+    long AcquireSendToken() override { return m_sendTokens++ % 2 == 0 ? m_sendDelayMs : 0; }
+    void OnAttemptSucceeded(long) override { m_succeeded++; }
+    void OnAttemptFailed(const AWSError<CoreErrors>&, long) override { m_failed++; }
+
+    const long m_sendDelayMs;
+    std::atomic<int> m_sendTokens;
+    std::atomic<int> m_succeeded;
+    std::atomic<int> m_failed;
+};
+
+TEST_F(AWSClientTestSuite, TestRetryStrategyPacesEveryAttempt)
+{
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    auto pacingRetryStrategy = Aws::MakeShared<PacingRetryStrategy>(ALLOCATION_TAG, 20);
+    config.retryStrategy = pacingRetryStrategy;
+    client = Aws::MakeUnique<MockAWSClient>(ALLOCATION_TAG, config);
+
+    mockHttpClient->AddResponseToReturn(nullptr);
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    auto start = std::chrono::steady_clock::now();
+    AmazonWebServiceRequestMock request;
+    auto outcome = client->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_LE(std::chrono::milliseconds(40), std::chrono::steady_clock::now() - start);
+    ASSERT_EQ(4, pacingRetryStrategy->m_sendTokens);
+    ASSERT_EQ(1, pacingRetryStrategy->m_failed);
+    ASSERT_EQ(1, pacingRetryStrategy->m_succeeded);
+
+    // asynchronous attempts that have to wait are sent from the retry timer
+    mockHttpClient->AddResponseToReturn(nullptr);
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    std::mutex mutex;
+    std::condition_variable completed;
+    bool done = false;
+    client->MakeRequestAsync(Aws::MakeShared<AmazonWebServiceRequestMock>(ALLOCATION_TAG), [&](const HttpResponseOutcome& result)
+    {
+        std::lock_guard<std::mutex> locker(mutex);
+        outcome = result;
+        done = true;
+        completed.notify_one();
+    });
+
+    std::unique_lock<std::mutex> locker(mutex);
+    ASSERT_TRUE(completed.wait_for(locker, std::chrono::seconds(10), [&] { return done; }));
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(8, pacingRetryStrategy->m_sendTokens);
+    ASSERT_EQ(2, pacingRetryStrategy->m_failed);
+    ASSERT_EQ(2, pacingRetryStrategy->m_succeeded);
+}
+
+class AsyncJsonClient : public AWSJsonClient
+{
+public:
+    AsyncJsonClient(const ClientConfiguration& config) : AWSJsonClient(config,
+        Aws::MakeShared<AWSAuthV4Signer>(ALLOCATION_TAG, Aws::MakeShared<Aws::Auth::SimpleAWSCredentialsProvider>(ALLOCATION_TAG,
+            MockAWSClient::GetMockAccessKey(), MockAWSClient::GetMockSecretAccessKey()), "service", Aws::Region::US_EAST_1),
+        Aws::MakeShared<JsonErrorMarshaller>(ALLOCATION_TAG))
+    {
+    }
+
+    using AWSJsonClient::MakeRequest;
+    using AWSJsonClient::MakeRequestAsync;
+
+    const char* GetServiceClientName() const override { return "AsyncJsonClient"; }
+};
+
+class AsyncXmlClient : public AWSXMLClient
+{
+public:
+    AsyncXmlClient(const ClientConfiguration& config) : AWSXMLClient(config,
+        Aws::MakeShared<AWSAuthV4Signer>(ALLOCATION_TAG, Aws::MakeShared<Aws::Auth::SimpleAWSCredentialsProvider>(ALLOCATION_TAG,
+            MockAWSClient::GetMockAccessKey(), MockAWSClient::GetMockSecretAccessKey()), "service", Aws::Region::US_EAST_1),
+        Aws::MakeShared<XmlErrorMarshaller>(ALLOCATION_TAG))
+    {
+    }
+
+    using AWSXMLClient::MakeRequest;
+    using AWSXMLClient::MakeRequestAsync;
+
+    const char* GetServiceClientName() const override { return "AsyncXmlClient"; }
+};
+
+TEST_F(AWSClientTestSuite, TestJsonRequestAsyncParsesOnExecutor)
+{
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    AsyncJsonClient jsonClient(config);
+    auto executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, 1);
+
+    auto httpRequest = CreateHttpRequest(URI("http://www.uri.com/path/to/res"), HttpMethod::HTTP_POST,
+            Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    auto httpResponse = Aws::MakeShared<StandardHttpResponse>(ALLOCATION_TAG, httpRequest);
+    httpResponse->SetResponseCode(HttpResponseCode::OK);
+    httpResponse->GetResponseBody() << "{\"answer\":42}";
+    mockHttpClient->AddResponseToReturn(httpResponse);
+
+    std::mutex mutex;
+    std::condition_variable completed;
+    bool done = false;
+    int answer = 0;
+    std::thread::id handlerThread;
+    // the mock http client completes the request on this thread, the response is parsed and handled on the executor's
+    jsonClient.MakeRequestAsync(URI("domain.com/something"), Aws::MakeShared<AmazonWebServiceRequestMock>(ALLOCATION_TAG),
+        HttpMethod::HTTP_POST, Aws::Auth::SIGV4_SIGNER, executor, [&](const JsonOutcome& outcome)
+    {
+        std::lock_guard<std::mutex> locker(mutex);
+        answer = outcome.IsSuccess() ? outcome.GetResult().GetPayload().View().GetInteger("answer") : -1;
+        handlerThread = std::this_thread::get_id();
+        done = true;
+        completed.notify_one();
+    });
+
+    std::unique_lock<std::mutex> locker(mutex);
+    completed.wait(locker, [&] { return done; });
+    ASSERT_EQ(42, answer);
+    ASSERT_NE(std::this_thread::get_id(), handlerThread);
+}
+
+TEST_F(AWSClientTestSuite, TestMalformedResponseFailsAlikeSyncAndAsync)
+{
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    AsyncJsonClient jsonClient(config);
+    AsyncXmlClient xmlClient(config);
+    auto queueMalformedResponse = [&](const char* body)
+    {
+        auto httpRequest = CreateHttpRequest(URI("http://www.uri.com/path/to/res"), HttpMethod::HTTP_POST,
+                Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        auto httpResponse = Aws::MakeShared<StandardHttpResponse>(ALLOCATION_TAG, httpRequest);
+        httpResponse->SetResponseCode(HttpResponseCode::OK);
+        httpResponse->GetResponseBody() << body;
+        mockHttpClient->AddResponseToReturn(httpResponse);
+    };
+
+    // every overload reports a body it can't parse as an error, as the asynchronous calls do.
+    AmazonWebServiceRequestMock request;
+    queueMalformedResponse("{\"answer\":");
+    auto jsonOutcome = jsonClient.MakeRequest(URI("domain.com/something"), request, HttpMethod::HTTP_POST, Aws::Auth::SIGV4_SIGNER);
+    ASSERT_FALSE(jsonOutcome.IsSuccess());
+    ASSERT_EQ("Json Parser Error", jsonOutcome.GetError().GetExceptionName());
+    queueMalformedResponse("{\"answer\":");
+    auto requestlessJsonOutcome = jsonClient.MakeRequest(URI("domain.com/something"), HttpMethod::HTTP_POST, Aws::Auth::SIGV4_SIGNER, "Malformed");
+    ASSERT_FALSE(requestlessJsonOutcome.IsSuccess());
+    ASSERT_EQ("Json Parser Error", requestlessJsonOutcome.GetError().GetExceptionName());
+
+    queueMalformedResponse("<Answer>42</Question>");
+    auto xmlOutcome = xmlClient.MakeRequest(URI("domain.com/something"), request, HttpMethod::HTTP_POST, Aws::Auth::SIGV4_SIGNER);
+    ASSERT_FALSE(xmlOutcome.IsSuccess());
+    ASSERT_EQ("Xml Parse Error", xmlOutcome.GetError().GetExceptionName());
+    queueMalformedResponse("<Answer>42</Question>");
+    auto requestlessXmlOutcome = xmlClient.MakeRequest(URI("domain.com/something"), HttpMethod::HTTP_POST, Aws::Auth::SIGV4_SIGNER, "Malformed");
+    ASSERT_FALSE(requestlessXmlOutcome.IsSuccess());
+    ASSERT_EQ("Xml Parse Error", requestlessXmlOutcome.GetError().GetExceptionName());
+
+    queueMalformedResponse("{\"answer\":");
+    Aws::String asyncError;
+    jsonClient.MakeRequestAsync(URI("domain.com/something"), Aws::MakeShared<AmazonWebServiceRequestMock>(ALLOCATION_TAG),
+        HttpMethod::HTTP_POST, Aws::Auth::SIGV4_SIGNER, nullptr, [&](const JsonOutcome& outcome)
+    {
+        asyncError = outcome.IsSuccess() ? "success" : outcome.GetError().GetExceptionName();
+    });
+    ASSERT_EQ("Json Parser Error", asyncError);
+}
+
+// Holds the first request it is given until that request is cancelled, or if it ignores cancellation, until it is released, and answers
+// the others from the queued responses.
+class StallFirstRequestHttpClient : public MockHttpClient
+{
+public:
+    StallFirstRequestHttpClient(bool ignoreCancellation = false) :
+        m_requests(0), m_stalledRequestCancelled(false), m_ignoreCancellation(ignoreCancellation), m_released(false) {}
+
+    std::shared_ptr<HttpResponse> MakeRequest(const std::shared_ptr<HttpRequest>& request,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override
+    {
+        if (m_requests++ == 0)
+        {
+            m_stalledRequestThread = std::this_thread::get_id();
+            for (int i = 0; i < 1000 && (m_ignoreCancellation ? !m_released.load() : ContinueRequest(*request)); ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            m_stalledRequestCancelled = !ContinueRequest(*request);
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> locker(m_lock);
+        return MockHttpClient::MakeRequest(request, readLimiter, writeLimiter);
+    }
+
+    mutable std::atomic<int> m_requests;
+    mutable std::atomic<bool> m_stalledRequestCancelled;
+    mutable std::thread::id m_stalledRequestThread;
+    const bool m_ignoreCancellation;
+    std::atomic<bool> m_released;
+
+private:
+    mutable std::mutex m_lock;
+};
+
+TEST_F(AWSClientTestSuite, TestHedgedRequestUsesFirstToComplete)
+{
+    auto stallingHttpClient = Aws::MakeShared<StallFirstRequestHttpClient>(ALLOCATION_TAG);
+    mockHttpClient = stallingHttpClient;
+    mockHttpClientFactory->SetClient(mockHttpClient);
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    // counts send tokens without holding any attempt back
+    auto retryStrategy = Aws::MakeShared<PacingRetryStrategy>(ALLOCATION_TAG, 0);
+    config.retryStrategy = retryStrategy;
+    client = Aws::MakeUnique<MockAWSClient>(ALLOCATION_TAG, config);
+
+    auto hedgingPolicy = Aws::MakeShared<HedgingPolicy>(ALLOCATION_TAG, 95.0, std::chrono::milliseconds(20));
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    AmazonWebServiceRequestMock request;
+    request.SetHedgingPolicy(hedgingPolicy);
+
+    auto start = std::chrono::steady_clock::now();
+    auto outcome = client->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_GT(std::chrono::seconds(2), std::chrono::steady_clock::now() - start);
+    ASSERT_EQ(0, client->GetRequestAttemptedRetries());
+    ASSERT_EQ(2, stallingHttpClient->m_requests);
+    ASSERT_EQ(1u, hedgingPolicy->GetHedgesSent());
+    ASSERT_EQ(1u, hedgingPolicy->GetHedgesWon());
+    // the original attempt doesn't tie up the calling thread, and the duplicate takes a send token of its own
+    ASSERT_NE(std::this_thread::get_id(), stallingHttpClient->m_stalledRequestThread);
+    ASSERT_EQ(2, retryStrategy->m_sendTokens);
+
+    // the losing attempt is cancelled rather than left to run its course
+    for (int i = 0; i < 200 && !stallingHttpClient->m_stalledRequestCancelled; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(stallingHttpClient->m_stalledRequestCancelled);
+
+    // a request that completes within the hedge delay isn't duplicated
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    hedgingPolicy = Aws::MakeShared<HedgingPolicy>(ALLOCATION_TAG, 95.0, std::chrono::milliseconds(2000));
+    request.SetHedgingPolicy(hedgingPolicy);
+    outcome = client->MakeRequest(request);
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(3, stallingHttpClient->m_requests);
+    ASSERT_EQ(0u, hedgingPolicy->GetHedgesSent());
+    ASSERT_EQ(3, retryStrategy->m_sendTokens);
+}
+
+TEST_F(AWSClientTestSuite, TestHedgedRequestDoesNotWaitForOriginalIgnoringCancellation)
+{
+    // a blocking http client that only notices cancellation between chunks of the body, if at all, keeps the losing attempt going.
+    auto stallingHttpClient = Aws::MakeShared<StallFirstRequestHttpClient>(ALLOCATION_TAG, true);
+    mockHttpClient = stallingHttpClient;
+    mockHttpClientFactory->SetClient(mockHttpClient);
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    config.retryStrategy = Aws::MakeShared<CountedRetryStrategy>(ALLOCATION_TAG);
+    client = Aws::MakeUnique<MockAWSClient>(ALLOCATION_TAG, config);
+
+    auto hedgingPolicy = Aws::MakeShared<HedgingPolicy>(ALLOCATION_TAG, 95.0, std::chrono::milliseconds(20));
+    QueueMockResponse(HttpResponseCode::OK, HeaderValueCollection());
+    AmazonWebServiceRequestMock request;
+    request.SetHedgingPolicy(hedgingPolicy);
+
+    auto start = std::chrono::steady_clock::now();
+    auto outcome = client->MakeRequest(request);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    stallingHttpClient->m_released = true;
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(1u, hedgingPolicy->GetHedgesWon());
+    ASSERT_GT(std::chrono::seconds(1), elapsed);
+}
+
+#if ENABLE_CURL_CLIENT && !defined(_WIN32)
+// Sends its requests to any uri, through the default http client.
+class LoopbackAWSClient : public AWSClient
+{
+public:
+    LoopbackAWSClient(const ClientConfiguration& config) : AWSClient(config,
+        Aws::MakeShared<AWSAuthV4Signer>(ALLOCATION_TAG, Aws::MakeShared<Aws::Auth::SimpleAWSCredentialsProvider>(ALLOCATION_TAG,
+            MockAWSClient::GetMockAccessKey(), MockAWSClient::GetMockSecretAccessKey()), "service", Aws::Region::US_EAST_1), nullptr)
+    {
+    }
+
+    HttpResponseOutcome MakeRequest(const URI& uri, const AmazonWebServiceRequest& request) const
+    {
+        return AttemptExhaustively(uri, request, HttpMethod::HTTP_GET, Aws::Auth::SIGV4_SIGNER);
+    }
+
+    const char* GetServiceClientName() const override { return "LoopbackAWSClient"; }
+
+protected:
+    AWSError<CoreErrors> BuildAWSError(const std::shared_ptr<HttpResponse>&) const override
+    {
+        return AWSError<CoreErrors>(CoreErrors::NETWORK_CONNECTION, false);
+    }
+};
+
+TEST(AWSClientTest, TestHedgeOnBlockingHttpClientReturnsWithoutWaitingForStalledOriginal)
+{
+    LoopbackHttpServer server;
+    server.StallRequests(1);
+    ClientConfiguration config;
+    config.scheme = Scheme::HTTP;
+    config.requestTimeoutMs = 30000;
+    LoopbackAWSClient client(config);
+
+    auto hedgingPolicy = Aws::MakeShared<HedgingPolicy>(ALLOCATION_TAG, 95.0, std::chrono::milliseconds(100));
+    AmazonWebServiceRequestMock request;
+    request.SetHedgingPolicy(hedgingPolicy);
+
+    auto start = std::chrono::steady_clock::now();
+    auto outcome = client.MakeRequest(URI(server.GetUri("/hedged")), request);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_TRUE(outcome.IsSuccess());
+    ASSERT_EQ(1u, hedgingPolicy->GetHedgesSent());
+    ASSERT_EQ(1u, hedgingPolicy->GetHedgesWon());
+    ASSERT_EQ(2u, server.GetRequests().size());
+    // the hedge delay plus the duplicate's round trip, not however long curl takes to notice the stalled original lost; it only polls
+    // a stalled transfer about once a second.
+    ASSERT_LE(std::chrono::milliseconds(100), elapsed);
+    ASSERT_GT(std::chrono::milliseconds(700), elapsed);
+}
+#endif // ENABLE_CURL_CLIENT && !_WIN32
+
 TEST(AWSClientTest, TestBuildHttpRequestWithHeadersOnly)
 {
     HeaderValueCollection headerValues;
@@ -0,0 +1,134 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/client/AdaptiveRetryStrategy.h>
+#include <aws/core/client/AWSError.h>
+#include <aws/core/client/CoreErrors.h>
+
+using namespace Aws::Client;
+
+static AWSError<CoreErrors> MakeError(CoreErrors type, const char* exceptionName, bool retryable)
+{
+    return AWSError<CoreErrors>(type, exceptionName, "", retryable);
+}
+
+TEST(AdaptiveRetryStrategyTest, TestRetryTokenBucketRunsDryAndRefills)
+{
+    RetryTokenBucket bucket(12);
+    ASSERT_TRUE(bucket.TryAcquire(5));
+    ASSERT_TRUE(bucket.TryAcquire(5));
+    ASSERT_FALSE(bucket.TryAcquire(5));
+    ASSERT_EQ(2, bucket.GetAvailableTokens());
+
+    bucket.Release(5);
+    ASSERT_EQ(7, bucket.GetAvailableTokens());
+    bucket.Release(100);
+    ASSERT_EQ(12, bucket.GetAvailableTokens());
+}
+
+TEST(AdaptiveRetryStrategyTest, TestRetriesAreBoundedByTokensAndMaxRetries)
+{
+    AdaptiveRetryStrategy strategy(3/*maxRetries*/, 25, 20000, 10/*retryTokens*/);
+    auto throttled = MakeError(CoreErrors::THROTTLING, "ThrottlingException", true);
+
+    ASSERT_FALSE(strategy.ShouldRetry(MakeError(CoreErrors::ACCESS_DENIED, "AccessDeniedException", false), 0));
+    ASSERT_FALSE(strategy.ShouldRetry(throttled, 3));
+    ASSERT_EQ(10, strategy.GetRetryTokenBucket().GetAvailableTokens());
+
+    ASSERT_TRUE(strategy.ShouldRetry(throttled, 0));
+    ASSERT_TRUE(strategy.ShouldRetry(throttled, 0));
+    ASSERT_FALSE(strategy.ShouldRetry(throttled, 0));
+
+    // a retry that succeeds gives its tokens back
+    strategy.OnAttemptSucceeded(1);
+    ASSERT_TRUE(strategy.ShouldRetry(throttled, 0));
+}
+
+TEST(AdaptiveRetryStrategyTest, TestDelayIsJitteredUnderCappedBackoff)
+{
+    AdaptiveRetryStrategy strategy(10, 25, 1000);
+    auto error = MakeError(CoreErrors::NETWORK_CONNECTION, "", true);
+
+    long maxSeen = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        long delay = strategy.CalculateDelayBeforeNextRetry(error, 2);
+        ASSERT_GE(delay, 0);
+        ASSERT_LE(delay, 100);
+        maxSeen = (std::max)(maxSeen, delay);
+        ASSERT_LE(strategy.CalculateDelayBeforeNextRetry(error, 62), 1000);
+    }
+    ASSERT_LT(50, maxSeen);
+}
+
+TEST(AdaptiveRetryStrategyTest, TestThrottlingErrors)
+{
+    ASSERT_TRUE(AdaptiveRetryStrategy::IsThrottlingError(MakeError(CoreErrors::THROTTLING, "", true)));
+    ASSERT_TRUE(AdaptiveRetryStrategy::IsThrottlingError(MakeError(CoreErrors::SLOW_DOWN, "", true)));
+    ASSERT_TRUE(AdaptiveRetryStrategy::IsThrottlingError(
+        MakeError(CoreErrors::UNKNOWN, "com.amazonaws.dynamodb.v20120810#ProvisionedThroughputExceededException", true)));
+    ASSERT_TRUE(AdaptiveRetryStrategy::IsThrottlingError(MakeError(CoreErrors::UNKNOWN, "RequestLimitExceeded:", true)));
+
+    auto tooManyRequests = MakeError(CoreErrors::UNKNOWN, "", true);
+    tooManyRequests.SetResponseCode(Aws::Http::HttpResponseCode::TOO_MANY_REQUESTS);
+    ASSERT_TRUE(AdaptiveRetryStrategy::IsThrottlingError(tooManyRequests));
+
+    ASSERT_FALSE(AdaptiveRetryStrategy::IsThrottlingError(MakeError(CoreErrors::INTERNAL_FAILURE, "InternalFailure", true)));
+    ASSERT_FALSE(AdaptiveRetryStrategy::IsThrottlingError(MakeError(CoreErrors::UNKNOWN, "ThrottlingExceptional", true)));
+}
+
+TEST(AdaptiveRetryStrategyTest, TestSendRateBacksOffOnThrottlingAndRecovers)
+{
+    auto now = std::chrono::steady_clock::now();
+    SendRateLimiter limiter([&now]() { return now; });
+
+    // unpaced until the service throttles
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(0, limiter.AcquireToken());
+        now += std::chrono::milliseconds(10);
+        limiter.UpdateSendRate(false);
+    }
+    ASSERT_FALSE(limiter.IsEnabled());
+    double measuredRate = limiter.GetMeasuredSendRate();
+    ASSERT_NEAR(100.0, measuredRate, 10.0);
+
+    limiter.UpdateSendRate(true);
+    ASSERT_TRUE(limiter.IsEnabled());
+    double throttledRate = limiter.GetFillRate();
+    ASSERT_NEAR(0.7 * measuredRate, throttledRate, 1.0);
+
+    // the bucket starts empty, so the next attempt waits for a token and the one after it for another
+    long delay = limiter.AcquireToken();
+    ASSERT_NEAR(1000.0 / throttledRate, static_cast<double>(delay), 1.0);
+    now += std::chrono::milliseconds(delay);
+    ASSERT_EQ(0, limiter.AcquireToken());
+    ASSERT_NEAR(1000.0 / throttledRate, static_cast<double>(limiter.AcquireToken()), 1.0);
+
+    // a second throttle cuts the rate further
+    now += std::chrono::milliseconds(100);
+    limiter.UpdateSendRate(true);
+    double rethrottledRate = limiter.GetFillRate();
+    ASSERT_LT(rethrottledRate, throttledRate);
+
+    // successes grow it back, past where it was throttled once the cubic curve flattens out
+    for (int i = 0; i < 1000; ++i)
+    {
+        now += std::chrono::milliseconds(10);
+        limiter.UpdateSendRate(false);
+    }
+    ASSERT_GT(limiter.GetFillRate(), throttledRate);
+}
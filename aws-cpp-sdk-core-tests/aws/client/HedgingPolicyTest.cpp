@@ -0,0 +1,58 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/client/HedgingPolicy.h>
+
+using namespace Aws::Client;
+
+TEST(HedgingPolicyTest, TestInitialDelayUntilEnoughSamples)
+{
+    HedgingPolicy policy(90.0, std::chrono::milliseconds(100), 100/*sampleWindow*/, 20/*minSamples*/);
+    for (int i = 0; i < 19; ++i)
+    {
+        policy.RecordLatency(std::chrono::milliseconds(1));
+        ASSERT_EQ(std::chrono::microseconds(100000), policy.GetHedgeDelay());
+    }
+    policy.RecordLatency(std::chrono::milliseconds(1));
+    ASSERT_EQ(std::chrono::microseconds(1000), policy.GetHedgeDelay());
+}
+
+TEST(HedgingPolicyTest, TestDelayIsPercentileOfRecentLatencies)
+{
+    HedgingPolicy policy(90.0, std::chrono::milliseconds(100), 100, 20);
+    for (int i = 1; i <= 100; ++i)
+    {
+        policy.RecordLatency(std::chrono::milliseconds(i));
+    }
+    ASSERT_EQ(std::chrono::microseconds(90000), policy.GetHedgeDelay());
+
+    // older latencies fall out of the window
+    for (int i = 0; i < 100; ++i)
+    {
+        policy.RecordLatency(std::chrono::microseconds(500));
+    }
+    ASSERT_EQ(std::chrono::microseconds(500), policy.GetHedgeDelay());
+}
+
+TEST(HedgingPolicyTest, TestHedgeCounts)
+{
+    HedgingPolicy policy;
+    policy.RecordHedge(true);
+    policy.RecordHedge(false);
+    policy.RecordHedge(true);
+    ASSERT_EQ(3u, policy.GetHedgesSent());
+    ASSERT_EQ(2u, policy.GetHedgesWon());
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ * 
+ *  http://aws.amazon.com/apache2.0
+ * 
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/external/gtest.h>
+
+#if ENABLE_CURL_CLIENT
+#include <aws/core/http/curl/CurlHandleContainer.h>
+#include <thread>
+
+using namespace Aws::Http;
+
+TEST(CurlHandleContainerTest, ReusesHandlesOfTheSameHost)
+{
+    CurlHandleContainer container(4);
+    CURL* first = container.AcquireCurlHandle("a.example.com");
+    ASSERT_NE(nullptr, first);
+    container.ReleaseCurlHandle(first, "a.example.com");
+
+    CURL* other = container.AcquireCurlHandle("b.example.com");
+    ASSERT_NE(first, other);
+    ASSERT_EQ(first, container.AcquireCurlHandle("a.example.com"));
+
+    container.ReleaseCurlHandle(other, "b.example.com");
+    container.ReleaseCurlHandle(first, "a.example.com");
+}
+
+TEST(CurlHandleContainerTest, LimitsHandlesPerHost)
+{
+    CurlHandleContainer container(4, 0, 1000, true, 30000, 3000, 1, true, 1);
+    CURL* first = container.TryAcquireCurlHandle("a.example.com");
+    ASSERT_NE(nullptr, first);
+    ASSERT_EQ(nullptr, container.TryAcquireCurlHandle("a.example.com"));
+
+    CURL* other = container.TryAcquireCurlHandle("b.example.com");
+    ASSERT_NE(nullptr, other);
+
+    container.ReleaseCurlHandle(other, "b.example.com");
+    container.ReleaseCurlHandle(first, "a.example.com");
+}
+
+TEST(CurlHandleContainerTest, ClosesIdleHandlesOfOtherHostsAtMaxSize)
+{
+    CurlHandleContainer container(1);
+    CURL* first = container.TryAcquireCurlHandle("a.example.com");
+    ASSERT_NE(nullptr, first);
+    ASSERT_EQ(nullptr, container.TryAcquireCurlHandle("b.example.com"));
+    container.ReleaseCurlHandle(first, "a.example.com");
+
+    CURL* other = container.TryAcquireCurlHandle("b.example.com");
+    ASSERT_NE(nullptr, other);
+    ASSERT_EQ(nullptr, container.TryAcquireCurlHandle("a.example.com"));
+    container.ReleaseCurlHandle(other, "b.example.com");
+}
+
+TEST(CurlHandleContainerTest, AcquireWaitsForAnotherHostsHandle)
+{
+    CurlHandleContainer container(1);
+    CURL* first = container.AcquireCurlHandle("a.example.com");
+    ASSERT_NE(nullptr, first);
+
+    CURL* other = nullptr;
+    std::thread waiter([&] { other = container.AcquireCurlHandle("b.example.com"); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    container.ReleaseCurlHandle(first, "a.example.com");
+    waiter.join();
+
+    ASSERT_NE(nullptr, other);
+    container.ReleaseCurlHandle(other, "b.example.com");
+}
+#endif // ENABLE_CURL_CLIENT
@@ -19,6 +19,20 @@
 #include <aws/core/http/HttpClientFactory.h>
 #include <aws/core/http/HttpClient.h>
 #include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/monitoring/HttpClientMetrics.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#if ENABLE_CURL_CLIENT
+#include <aws/core/http/curl/CurlHttpClient.h>
+#endif
+#ifndef _WIN32
+#include "LoopbackHttpServer.h"
+#endif
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <thread>
 
 using namespace Aws::Http;
 #ifndef NO_HTTP_CLIENT
@@ -30,4 +44,325 @@ TEST(HttpClientTest, TestNullResponse)
 	auto response = httpClient->MakeRequest(request);
 	ASSERT_EQ(nullptr, response);
 }
+
+#if ENABLE_CURL_CLIENT
+TEST(HttpClientTest, TestCurlHandleReusedWithoutReset)
+{
+    Aws::Client::ClientConfiguration config;
+    config.maxConnections = 1;
+    config.disableCurlHandleReset = true;
+    auto httpClient = CreateHttpClient(config);
+
+    // the second request gets the only handle with the first request's options still set.
+    auto headRequest = CreateHttpRequest(Aws::String("http://some.unknown1234xxx.test.aws"),
+            HttpMethod::HTTP_HEAD, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    ASSERT_EQ(nullptr, httpClient->MakeRequest(headRequest));
+    auto getRequest = CreateHttpRequest(Aws::String("http://some.unknown1234xxx.test.aws"),
+            HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    ASSERT_EQ(nullptr, httpClient->MakeRequest(getRequest));
+}
+
+TEST(HttpClientTest, TestCurlWarmUpConnectionsToUnknownHost)
+{
+    Aws::Client::ClientConfiguration config;
+    config.maxConnections = 4;
+    auto httpClient = CreateHttpClient(config);
+    ASSERT_EQ(0u, httpClient->WarmUpConnections(URI("http://some.unknown1234xxx.test.aws"), 2));
+
+    // the handles used for warming up went back to the pool.
+    auto request = CreateHttpRequest(Aws::String("http://some.unknown1234xxx.test.aws"),
+            HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    ASSERT_EQ(nullptr, httpClient->MakeRequest(request));
+}
+
+TEST(HttpClientTest, TestCurlMultiNullResponse)
+{
+    auto request = CreateHttpRequest(Aws::String("http://some.unknown1234xxx.test.aws"),
+            HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    Aws::Client::ClientConfiguration config;
+    config.httpLibOverride = TransferLibType::CURL_MULTI_CLIENT;
+    auto httpClient = CreateHttpClient(config);
+    ASSERT_TRUE(httpClient->SupportsNonBlockingRequests());
+    auto response = httpClient->MakeRequest(request);
+    ASSERT_EQ(nullptr, response);
+}
+
+TEST(HttpClientTest, TestCurlMultiAsyncRequestsAllComplete)
+{
+    Aws::Client::ClientConfiguration config;
+    config.httpLibOverride = TransferLibType::CURL_MULTI_CLIENT;
+    config.httpIoThreadCount = 2;
+    // fewer handles than requests, so some requests have to wait on the event loop for a handle
+    config.maxConnections = 2;
+    auto httpClient = CreateHttpClient(config);
+
+    const int requestCount = 8;
+    std::mutex completionLock;
+    std::condition_variable completionSignal;
+    int completed = 0;
+    std::atomic<int> nonNullResponses(0);
+    for (int i = 0; i < requestCount; ++i)
+    {
+        auto request = CreateHttpRequest(Aws::String("http://some.unknown1234xxx.test.aws"),
+                HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        httpClient->MakeRequestAsync(request, [&](const std::shared_ptr<HttpRequest>&, const std::shared_ptr<HttpResponse>& response)
+        {
+            if (response)
+            {
+                ++nonNullResponses;
+            }
+            std::lock_guard<std::mutex> locker(completionLock);
+            ++completed;
+            completionSignal.notify_one();
+        });
+    }
+
+    std::unique_lock<std::mutex> locker(completionLock);
+    completionSignal.wait(locker, [&](){ return completed == requestCount; });
+    ASSERT_EQ(0, nonNullResponses.load());
+}
+
+#ifndef _WIN32
+TEST(HttpClientTest, TestCurlMultiHostAtConnectionLimitDoesNotBlockOtherHosts)
+{
+    LoopbackHttpServer slowServer;
+    slowServer.SetResponseDelay(std::chrono::milliseconds(1000));
+    LoopbackHttpServer fastServer("127.0.0.2");
+
+    Aws::Client::ClientConfiguration config;
+    config.httpLibOverride = TransferLibType::CURL_MULTI_CLIENT;
+    config.httpIoThreadCount = 1;
+    config.maxConnections = 4;
+    config.maxConnectionsPerHost = 1;
+    auto httpClient = CreateHttpClient(config);
+
+    std::mutex completionLock;
+    std::condition_variable completionSignal;
+    Aws::Vector<Aws::String> completionOrder;
+    auto makeRequest = [&](const Aws::String& uri, const char* name)
+    {
+        auto request = CreateHttpRequest(uri, HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        httpClient->MakeRequestAsync(request, [&, name](const std::shared_ptr<HttpRequest>&, const std::shared_ptr<HttpResponse>& response)
+        {
+            std::lock_guard<std::mutex> locker(completionLock);
+            completionOrder.push_back(response && response->GetResponseCode() == HttpResponseCode::OK ? name : "failed");
+            completionSignal.notify_one();
+        });
+    };
+
+    // the second slow request has to wait for the slow host's only connection; the fast request queued behind it mustn't
+    makeRequest(slowServer.GetUri(), "slow");
+    makeRequest(slowServer.GetUri(), "slow");
+    makeRequest(fastServer.GetUri(), "fast");
+
+    std::unique_lock<std::mutex> locker(completionLock);
+    completionSignal.wait(locker, [&](){ return completionOrder.size() == 3; });
+    ASSERT_EQ("fast", completionOrder[0]);
+    ASSERT_EQ("slow", completionOrder[1]);
+    ASSERT_EQ("slow", completionOrder[2]);
+}
+
+TEST(HttpClientTest, TestCurlHandleReusedWithoutResetSendsOnlyTheCurrentRequest)
+{
+    LoopbackHttpServer server;
+    Aws::Client::ClientConfiguration config;
+    config.maxConnections = 1;
+    config.disableCurlHandleReset = true;
+    auto httpClient = CreateHttpClient(config);
+
+    // every request gets the only handle, with the options of the one before it still set.
+    auto putRequest = CreateHttpRequest(server.GetUri("/put"), HttpMethod::HTTP_PUT, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    putRequest->SetHeaderValue("x-reuse-test", "put");
+    putRequest->SetHeaderValue(CONTENT_LENGTH_HEADER, "4");
+    putRequest->AddContentBody(Aws::MakeShared<Aws::StringStream>("HttpClientTest", "body"));
+    ASSERT_NE(nullptr, httpClient->MakeRequest(putRequest));
+
+    auto deleteRequest = CreateHttpRequest(server.GetUri("/delete"), HttpMethod::HTTP_DELETE, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    ASSERT_NE(nullptr, httpClient->MakeRequest(deleteRequest));
+
+    auto headRequest = CreateHttpRequest(server.GetUri("/head"), HttpMethod::HTTP_HEAD, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    ASSERT_NE(nullptr, httpClient->MakeRequest(headRequest));
+
+    auto getRequest = CreateHttpRequest(server.GetUri("/get"), HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    auto getResponse = httpClient->MakeRequest(getRequest);
+    ASSERT_NE(nullptr, getResponse);
+    // the head request's no-body option is gone too.
+    ASSERT_EQ("ok", Aws::String(std::istreambuf_iterator<char>(getResponse->GetResponseBody()), std::istreambuf_iterator<char>()));
+
+    auto requests = server.GetRequests();
+    ASSERT_EQ(4u, requests.size());
+    ASSERT_EQ(1u, server.GetConnectionsAccepted());
+    ASSERT_EQ(0u, requests[0].find("PUT /put "));
+    ASSERT_NE(Aws::String::npos, Aws::Utils::StringUtils::ToLower(requests[0].c_str()).find("\r\nx-reuse-test: put\r\n"));
+    ASSERT_EQ("body", requests[0].substr(requests[0].size() - 4));
+    ASSERT_EQ(0u, requests[1].find("DELETE /delete "));
+    ASSERT_EQ(0u, requests[2].find("HEAD /head "));
+
+    // no method, header or body of the earlier requests leaks into the last one.
+    ASSERT_EQ(0u, requests[3].find("GET /get "));
+    for (size_t i = 1; i < requests.size(); ++i)
+    {
+        Aws::String lowerRequest = Aws::Utils::StringUtils::ToLower(requests[i].c_str());
+        ASSERT_EQ(Aws::String::npos, lowerRequest.find("x-reuse-test"));
+        ASSERT_EQ(Aws::String::npos, lowerRequest.find("content-length: 4"));
+        ASSERT_EQ(Aws::String::npos, lowerRequest.find("transfer-encoding"));
+        ASSERT_EQ(lowerRequest.size() - 4, lowerRequest.find("\r\n\r\n"));
+    }
+}
+
+/**
+ * Lets a test resolve a host name on one of the client's own pooled handles.
+ */
+class ResolvingCurlHttpClient : public CurlHttpClient
+{
+public:
+    ResolvingCurlHttpClient(const Aws::Client::ClientConfiguration& config) : CurlHttpClient(config) {}
+
+    /**
+     * Makes a HEAD request to uri on a pooled handle with host resolved to address, e.g. "host:port:127.0.0.1", which puts the
+     * entry into the handle's DNS cache. Returns whether the request succeeded.
+     */
+    bool HeadWithResolvedHost(const Aws::String& uri, const Aws::String& hostPortAddress) const
+    {
+        CURL* handle = m_curlHandleContainer.AcquireCurlHandle();
+        struct curl_slist* resolve = curl_slist_append(nullptr, hostPortAddress.c_str());
+        curl_easy_setopt(handle, CURLOPT_RESOLVE, resolve);
+        curl_easy_setopt(handle, CURLOPT_URL, uri.c_str());
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+        CURLcode code = curl_easy_perform(handle);
+        curl_easy_setopt(handle, CURLOPT_RESOLVE, nullptr);
+        m_curlHandleContainer.ReleaseCurlHandle(handle);
+        curl_slist_free_all(resolve);
+        return code == CURLE_OK;
+    }
+};
+
+TEST(HttpClientTest, TestCurlClientsWithSharedCaches)
+{
+    LoopbackHttpServer server;
+    // a name nothing resolves, except the entry put into a DNS cache below.
+    Aws::String hostPort = "shared-cache.unknown1234xxx.test.aws:" + server.GetUri().substr(strlen("http://127.0.0.1:"));
+    hostPort.pop_back();
+    Aws::String uri = "http://" + hostPort + "/";
+
+    Aws::Client::ClientConfiguration config;
+    config.maxConnections = 1;
+    auto unsharedClient = CreateHttpClient(config);
+
+    CurlHttpClient::InitSharedCaches();
+    {
+        ResolvingCurlHttpClient firstClient(config);
+        auto secondClient = CreateHttpClient(config);
+        ASSERT_TRUE(firstClient.HeadWithResolvedHost(uri, hostPort + ":127.0.0.1"));
+
+        // the entry the first client's handle resolved is in the cache the second client's handles share.
+        auto request = CreateHttpRequest(uri, HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        auto response = secondClient->MakeRequest(request);
+        ASSERT_NE(nullptr, response);
+        ASSERT_EQ(HttpResponseCode::OK, response->GetResponseCode());
+
+        // a client created before the caches were shared still has its own.
+        auto unsharedRequest = CreateHttpRequest(uri, HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        ASSERT_EQ(nullptr, unsharedClient->MakeRequest(unsharedRequest));
+    }
+    CurlHttpClient::CleanupSharedCaches();
+    ASSERT_EQ(2u, server.GetRequests().size());
+}
+
+static const int64_t NO_METRIC = -1;
+
+static int64_t GetConnectionReusedMetric(const HttpRequest& request)
+{
+    const auto& metrics = request.GetRequestMetrics();
+    auto reused = metrics.find(Aws::Monitoring::GetHttpClientMetricNameByType(Aws::Monitoring::HttpClientMetricsType::ConnectionReused));
+    return reused != metrics.end() ? reused->second : NO_METRIC;
+}
+
+TEST(HttpClientTest, TestCurlReportsConnectionReuseOnlyForConnectedTransfers)
+{
+    LoopbackHttpServer server;
+    Aws::Client::ClientConfiguration config;
+    config.maxConnections = 1;
+    auto httpClient = CreateHttpClient(config);
+
+    auto firstRequest = CreateHttpRequest(server.GetUri(), HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    ASSERT_NE(nullptr, httpClient->MakeRequest(firstRequest));
+    ASSERT_EQ(0, GetConnectionReusedMetric(*firstRequest));
+
+    auto secondRequest = CreateHttpRequest(server.GetUri(), HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    ASSERT_NE(nullptr, httpClient->MakeRequest(secondRequest));
+    ASSERT_EQ(1, GetConnectionReusedMetric(*secondRequest));
+    ASSERT_EQ(1u, server.GetConnectionsAccepted());
+
+    // a request that never got a connection opened none, but didn't reuse one either.
+    auto failedRequest = CreateHttpRequest(Aws::String("http://some.unknown1234xxx.test.aws"),
+            HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    ASSERT_EQ(nullptr, httpClient->MakeRequest(failedRequest));
+    ASSERT_EQ(NO_METRIC, GetConnectionReusedMetric(*failedRequest));
+}
+
+TEST(HttpClientTest, TestCurlWarmUpConnectionsCountsOnlyNewConnections)
+{
+    LoopbackHttpServer server;
+    Aws::Client::ClientConfiguration config;
+    config.maxConnections = 4;
+    auto httpClient = CreateHttpClient(config);
+
+    ASSERT_EQ(2u, httpClient->WarmUpConnections(URI(server.GetUri()), 2));
+    ASSERT_EQ(2u, server.GetConnectionsAccepted());
+
+    // both handles come back out of the pool already connected.
+    ASSERT_EQ(0u, httpClient->WarmUpConnections(URI(server.GetUri()), 2));
+    ASSERT_EQ(2u, server.GetConnectionsAccepted());
+
+    auto request = CreateHttpRequest(server.GetUri(), HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    ASSERT_NE(nullptr, httpClient->MakeRequest(request));
+    ASSERT_EQ(1, GetConnectionReusedMetric(*request));
+}
+
+TEST(HttpClientTest, TestCurlMultiWarmUpConnectionsCountsOnlyNewConnections)
+{
+    LoopbackHttpServer server;
+    Aws::Client::ClientConfiguration config;
+    config.httpLibOverride = TransferLibType::CURL_MULTI_CLIENT;
+    config.httpIoThreadCount = 1;
+    config.maxConnections = 4;
+    auto httpClient = CreateHttpClient(config);
+
+    ASSERT_EQ(2u, httpClient->WarmUpConnections(URI(server.GetUri()), 2));
+    ASSERT_EQ(2u, server.GetConnectionsAccepted());
+
+    ASSERT_EQ(0u, httpClient->WarmUpConnections(URI(server.GetUri()), 2));
+    ASSERT_EQ(2u, server.GetConnectionsAccepted());
+}
+
+TEST(HttpClientTest, TestCurlClosesConnectionsIdleLongerThanTimeout)
+{
+    LoopbackHttpServer server;
+    LoopbackHttpServer otherServer("127.0.0.2");
+    Aws::Client::ClientConfiguration config;
+    config.maxConnections = 4;
+    config.idleConnectionTimeoutMs = 200;
+    auto httpClient = CreateHttpClient(config);
+
+    auto makeRequest = [&](const Aws::String& uri)
+    {
+        auto request = CreateHttpRequest(uri, HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        EXPECT_NE(nullptr, httpClient->MakeRequest(request));
+        return GetConnectionReusedMetric(*request);
+    };
+
+    ASSERT_EQ(0, makeRequest(server.GetUri()));
+    ASSERT_EQ(1, makeRequest(server.GetUri()));
+    ASSERT_EQ(1u, server.GetConnectionsAccepted());
+
+    // idle handles are closed when another handle is released, here the other host's.
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    ASSERT_EQ(0, makeRequest(otherServer.GetUri()));
+
+    ASSERT_EQ(0, makeRequest(server.GetUri()));
+    ASSERT_EQ(2u, server.GetConnectionsAccepted());
+}
+#endif // _WIN32
+#endif // ENABLE_CURL_CLIENT
 #endif
@@ -0,0 +1,225 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#pragma once
+
+#ifndef _WIN32
+
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/StringUtils.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+/**
+ * Minimal keep-alive HTTP/1.1 server on a loopback address for tests that need to see what the http clients actually send. It answers
+ * every request with a 200 and a two byte body, after an optional delay, unless it was told to stall it, and records each request as
+ * it was received. Give servers different addresses, e.g. 127.0.0.2, for the clients to treat them as different hosts.
+ */
+class LoopbackHttpServer
+{
+public:
+    LoopbackHttpServer(const char* address = "127.0.0.1") : m_address(address), m_listenSocket(-1), m_port(0), m_responseDelayMs(0), m_connectionsAccepted(0), m_stopping(false), m_requestsToStall(0)
+    {
+        m_listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in socketAddress;
+        memset(&socketAddress, 0, sizeof(socketAddress));
+        socketAddress.sin_family = AF_INET;
+        inet_pton(AF_INET, address, &socketAddress.sin_addr);
+        socketAddress.sin_port = 0;
+        bind(m_listenSocket, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress));
+        listen(m_listenSocket, 64);
+
+        socklen_t length = sizeof(socketAddress);
+        getsockname(m_listenSocket, reinterpret_cast<sockaddr*>(&socketAddress), &length);
+        m_port = ntohs(socketAddress.sin_port);
+
+        m_acceptThread = std::thread(&LoopbackHttpServer::Accept, this);
+    }
+
+    ~LoopbackHttpServer()
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            m_stopping = true;
+        }
+        m_stopped.notify_all();
+        shutdown(m_listenSocket, SHUT_RDWR);
+        close(m_listenSocket);
+        m_acceptThread.join();
+
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            for (int connection : m_connections)
+            {
+                shutdown(connection, SHUT_RDWR);
+            }
+        }
+        for (auto& thread : m_connectionThreads)
+        {
+            thread.join();
+        }
+        for (int connection : m_connections)
+        {
+            close(connection);
+        }
+    }
+
+    Aws::String GetUri(const char* path = "/") const
+    {
+        return "http://" + m_address + ":" + Aws::Utils::StringUtils::to_string(m_port) + path;
+    }
+
+    void SetResponseDelay(std::chrono::milliseconds delay) { m_responseDelayMs = delay.count(); }
+
+    /**
+     * Never answers the next count requests; their connections are held open until the server is destroyed.
+     */
+    void StallRequests(size_t count)
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_requestsToStall = count;
+    }
+
+    size_t GetConnectionsAccepted() const { return m_connectionsAccepted.load(); }
+
+    /**
+     * The requests received so far, head and body, in the order they were received.
+     */
+    Aws::Vector<Aws::String> GetRequests() const
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        return m_requests;
+    }
+
+private:
+    void Accept()
+    {
+        for (;;)
+        {
+            int connection = accept(m_listenSocket, nullptr, nullptr);
+            if (connection < 0)
+            {
+                if (m_stopping)
+                {
+                    return;
+                }
+                continue;
+            }
+
+            m_connectionsAccepted++;
+            std::lock_guard<std::mutex> locker(m_lock);
+            m_connections.push_back(connection);
+            m_connectionThreads.emplace_back(&LoopbackHttpServer::Serve, this, connection);
+        }
+    }
+
+    void Serve(int connection)
+    {
+        Aws::String pending;
+        char buffer[4096];
+        for (;;)
+        {
+            size_t headEnd = pending.find("\r\n\r\n");
+            if (headEnd == Aws::String::npos)
+            {
+                ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+                if (received <= 0)
+                {
+                    break;
+                }
+                pending.append(buffer, static_cast<size_t>(received));
+                continue;
+            }
+
+            Aws::String head = pending.substr(0, headEnd + 4);
+            size_t contentLength = 0;
+            Aws::String lowerHead = Aws::Utils::StringUtils::ToLower(head.c_str());
+            size_t lengthHeader = lowerHead.find("\r\ncontent-length:");
+            if (lengthHeader != Aws::String::npos)
+            {
+                contentLength = static_cast<size_t>(strtoul(head.c_str() + lengthHeader + 17, nullptr, 10));
+            }
+            if (pending.size() < head.size() + contentLength)
+            {
+                ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+                if (received <= 0)
+                {
+                    break;
+                }
+                pending.append(buffer, static_cast<size_t>(received));
+                continue;
+            }
+
+            {
+                std::unique_lock<std::mutex> locker(m_lock);
+                m_requests.push_back(pending.substr(0, head.size() + contentLength));
+                if (m_requestsToStall > 0)
+                {
+                    --m_requestsToStall;
+                    m_stopped.wait(locker, [this] { return m_stopping.load(); });
+                    break;
+                }
+            }
+            pending.erase(0, head.size() + contentLength);
+
+            if (m_responseDelayMs > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_responseDelayMs.load()));
+            }
+            // a response to HEAD announces the body without sending it
+            const char* response = head.compare(0, 5, "HEAD ") == 0 ? "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n"
+                                                                      : "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+            if (send(connection, response, strlen(response), MSG_NOSIGNAL) < 0)
+            {
+                break;
+            }
+        }
+    }
+
+    Aws::String m_address;
+    int m_listenSocket;
+    unsigned short m_port;
+    std::atomic<long long> m_responseDelayMs;
+    std::atomic<size_t> m_connectionsAccepted;
+    std::atomic<bool> m_stopping;
+    mutable std::mutex m_lock;
+    std::condition_variable m_stopped;
+    size_t m_requestsToStall;
+    Aws::Vector<int> m_connections;
+    Aws::Vector<std::thread> m_connectionThreads;
+    Aws::Vector<Aws::String> m_requests;
+    std::thread m_acceptThread;
+};
+
+#endif // _WIN32
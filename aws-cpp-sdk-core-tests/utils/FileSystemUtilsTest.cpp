@@ -18,6 +18,7 @@
 #include <aws/core/utils/memory/stl/AWSSet.h>
 #include <aws/external/gtest.h>
 #include <fstream>
+#include <iterator>
 #if defined(HAS_PATHCONF)
 #include <unistd.h>
 #include <climits>
@@ -68,6 +69,65 @@ TEST(FileTest, TempFile)
     ASSERT_FALSE(testIn.good());
 }
 
+TEST(FileTest, PositionalWrite)
+{
+    Aws::String filePath = Aws::FileSystem::CreateTempFilePath();
+
+    {
+        auto writer = Aws::FileSystem::OpenFileForPositionalWrite(filePath.c_str(), 10);
+        ASSERT_TRUE(*writer);
+        ASSERT_TRUE(writer->WriteAt(5, reinterpret_cast<const unsigned char*>("world"), 5));
+        ASSERT_TRUE(writer->WriteAt(0, reinterpret_cast<const unsigned char*>("hello"), 5));
+    }
+
+    {
+        // reopening keeps what was written and only changes the length.
+        auto writer = Aws::FileSystem::OpenFileForPositionalWrite(filePath.c_str(), 12);
+        ASSERT_TRUE(*writer);
+        ASSERT_TRUE(writer->WriteAt(10, reinterpret_cast<const unsigned char*>("!!"), 2));
+    }
+
+    {
+        std::ifstream testIn(filePath.c_str(), std::ios_base::in | std::ios_base::binary);
+        std::string contents((std::istreambuf_iterator<char>(testIn)), std::istreambuf_iterator<char>());
+        ASSERT_EQ("helloworld!!", contents);
+    }
+
+    {
+        auto writer = Aws::FileSystem::OpenFileForPositionalWrite(filePath.c_str(), 5);
+        ASSERT_TRUE(*writer);
+    }
+
+    {
+        std::ifstream testIn(filePath.c_str(), std::ios_base::in | std::ios_base::binary);
+        std::string contents((std::istreambuf_iterator<char>(testIn)), std::istreambuf_iterator<char>());
+        ASSERT_EQ("hello", contents);
+    }
+
+    ASSERT_TRUE(Aws::FileSystem::RemoveFileIfExists(filePath.c_str()));
+}
+
+TEST(FileTest, GetFileInfo)
+{
+    Aws::String filePath = Aws::FileSystem::CreateTempFilePath();
+    ASSERT_FALSE(Aws::FileSystem::GetFileInfo(filePath.c_str()));
+
+    auto before = Aws::Utils::DateTime::CurrentTimeMillis() / 1000 * 1000;
+    {
+        std::ofstream testFile(filePath.c_str(), std::ios_base::out | std::ios_base::binary);
+        testFile << "contents";
+    }
+
+    auto entry = Aws::FileSystem::GetFileInfo(filePath.c_str());
+    ASSERT_TRUE(entry);
+    ASSERT_EQ(Aws::FileSystem::FileType::File, entry.fileType);
+    ASSERT_EQ(8, entry.fileSize);
+    ASSERT_GE(entry.lastModified.Millis(), before);
+    ASSERT_LE(entry.lastModified.Millis(), Aws::Utils::DateTime::CurrentTimeMillis());
+
+    ASSERT_TRUE(Aws::FileSystem::RemoveFileIfExists(filePath.c_str()));
+}
+
 class DirectoryTreeTest : public ::testing::Test
 {
 public:
@@ -16,8 +16,12 @@
 #include <aws/external/gtest.h>
 
 #include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/crypto/MD5.h>
+#include <aws/core/utils/crypto/Sha256.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
 
+#include <algorithm>
+
 
 using namespace Aws::Utils;
 
@@ -321,3 +325,56 @@ TEST(HashingUtilsTest, TestMD5FromStream)
     TestMD5FromStream( "12345678901234567890123456789012345678901234567890123456789012345678901234567890", "V+30oivjyVWsSdouIQe2eg==" );
 }
 
+TEST(HashingUtilsTest, TestIncrementalHashMatchesCalculate)
+{
+    Aws::String data;
+    for (int i = 0; i < 10000; ++i)
+    {
+        data.push_back(static_cast<char>('a' + i % 26));
+    }
+
+    Crypto::MD5 md5;
+    Crypto::Sha256 sha256;
+    // uneven pieces, so updates straddle the digests' internal block boundaries.
+    for (size_t offset = 0, piece = 1; offset < data.size(); offset += piece, piece = piece * 3 % 1000 + 1)
+    {
+        const size_t length = (std::min)(piece, data.size() - offset);
+        md5.Update(reinterpret_cast<const unsigned char*>(data.c_str()) + offset, length);
+        sha256.Update(reinterpret_cast<const unsigned char*>(data.c_str()) + offset, length);
+    }
+
+    auto md5Result = md5.GetHash();
+    auto sha256Result = sha256.GetHash();
+    ASSERT_TRUE(md5Result.IsSuccess());
+    ASSERT_TRUE(sha256Result.IsSuccess());
+    ASSERT_EQ(HashingUtils::HexEncode(HashingUtils::CalculateMD5(data)), HashingUtils::HexEncode(md5Result.GetResult()));
+    ASSERT_EQ(HashingUtils::HexEncode(HashingUtils::CalculateSHA256(data)), HashingUtils::HexEncode(sha256Result.GetResult()));
+
+    // GetHash starts over, so with nothing added the next digest is the one of the empty string.
+    ASSERT_STREQ("d41d8cd98f00b204e9800998ecf8427e", HashingUtils::HexEncode(md5.GetHash().GetResult()).c_str());
+    sha256.Update(reinterpret_cast<const unsigned char*>("abc"), 3);
+    ASSERT_STREQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", HashingUtils::HexEncode(sha256.GetHash().GetResult()).c_str());
+}
+
+TEST(HashingUtilsTest, TestMD5AndSHA256FromStream)
+{
+    // bigger than one read, and read from the middle to check the position is put back.
+    Aws::String data(200 * 1024 + 17, 'x');
+    data[12345] = 'y';
+    Aws::StringStream stream(data);
+    stream.seekg(100);
+
+    ByteBuffer md5;
+    ByteBuffer sha256;
+    ASSERT_TRUE(HashingUtils::CalculateMD5AndSHA256(stream, md5, sha256));
+    ASSERT_EQ(100, stream.tellg());
+    ASSERT_TRUE(stream.good());
+
+    ASSERT_EQ(HashingUtils::HexEncode(HashingUtils::CalculateMD5(data)), HashingUtils::HexEncode(md5));
+    ASSERT_EQ(HashingUtils::HexEncode(HashingUtils::CalculateSHA256(data)), HashingUtils::HexEncode(sha256));
+
+    Aws::StringStream empty("");
+    ASSERT_TRUE(HashingUtils::CalculateMD5AndSHA256(empty, md5, sha256));
+    ASSERT_STREQ("d41d8cd98f00b204e9800998ecf8427e", HashingUtils::HexEncode(md5).c_str());
+    ASSERT_STREQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", HashingUtils::HexEncode(sha256).c_str());
+}
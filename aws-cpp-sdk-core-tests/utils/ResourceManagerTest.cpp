@@ -0,0 +1,137 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/ResourceManager.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Aws::Utils;
+
+TEST(LockFreeOwnershipResourceManagerTest, ReturnsMostRecentlyReleasedResourceFirst)
+{
+    LockFreeOwnershipResourceManager<int> manager(3);
+    manager.Release(1);
+    manager.Release(2);
+    manager.Release(3);
+
+    ASSERT_EQ(3, manager.Acquire());
+    ASSERT_EQ(2, manager.Acquire());
+    manager.Release(2);
+    ASSERT_EQ(2, manager.Acquire());
+    ASSERT_EQ(1, manager.Acquire());
+
+    int resource = 0;
+    ASSERT_FALSE(manager.HasResourcesAvailable());
+    ASSERT_FALSE(manager.TryAcquire(resource));
+
+    manager.Release(1);
+    manager.Release(2);
+    manager.Release(3);
+    ASSERT_EQ(3u, manager.ShutdownAndWait(3).size());
+}
+
+TEST(LockFreeOwnershipResourceManagerTest, AcquireWaitsForRelease)
+{
+    LockFreeOwnershipResourceManager<int> manager(1);
+    manager.Release(7);
+    ASSERT_EQ(7, manager.Acquire());
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        manager.Release(7);
+    });
+    ASSERT_EQ(7, manager.Acquire());
+    releaser.join();
+
+    manager.Release(7);
+    ASSERT_EQ(1u, manager.ShutdownAndWait(1).size());
+}
+
+TEST(LockFreeOwnershipResourceManagerTest, EachResourceHasOneOwnerAtATime)
+{
+    const int resourceCount = 4;
+    const int threadCount = 8;
+    LockFreeOwnershipResourceManager<int> manager(resourceCount);
+    std::atomic<int> owners[resourceCount];
+    for (int i = 0; i < resourceCount; ++i)
+    {
+        owners[i] = 0;
+        manager.Release(i);
+    }
+
+    std::atomic<bool> sharedOwnership(false);
+    std::thread threads[threadCount];
+    for (auto& thread : threads)
+    {
+        thread = std::thread([&] {
+            for (int i = 0; i < 20000; ++i)
+            {
+                int resource = manager.Acquire();
+                if (++owners[resource] != 1)
+                {
+                    sharedOwnership = true;
+                }
+                --owners[resource];
+                manager.Release(resource);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_FALSE(sharedOwnership.load());
+    auto resources = manager.ShutdownAndWait(resourceCount);
+    ASSERT_EQ(static_cast<size_t>(resourceCount), resources.size());
+}
+
+TEST(LockFreeOwnershipResourceManagerTest, GrowsToCapacityWhileReleasedConcurrently)
+{
+    // more than fit in one block of slots, released from several threads at once so blocks are added concurrently.
+    const int resourceCount = 70;
+    const int threadCount = 7;
+    LockFreeOwnershipResourceManager<int> manager(resourceCount);
+    std::thread threads[threadCount];
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads[t] = std::thread([&manager, t] {
+            for (int i = t; i < resourceCount; i += threadCount)
+            {
+                manager.Release(i);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    bool acquired[resourceCount] = {};
+    int resource = 0;
+    while (manager.TryAcquire(resource))
+    {
+        ASSERT_FALSE(acquired[resource]);
+        acquired[resource] = true;
+    }
+    for (int i = 0; i < resourceCount; ++i)
+    {
+        ASSERT_TRUE(acquired[i]);
+        manager.Release(i);
+    }
+    ASSERT_EQ(static_cast<size_t>(resourceCount), manager.ShutdownAndWait(resourceCount).size());
+}
@@ -17,6 +17,8 @@
 
 #include <aws/core/utils/json/JsonSerializer.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/StringUtils.h>
+#include <climits>
 
 using namespace Aws::Utils::Json;
 using namespace Aws::Utils;
@@ -384,3 +386,98 @@ TEST(JsonSerializer, TestEquality)
     built.WithString("AWS", "Amazon Web Services");
     ASSERT_NE(parsed, built);
 }
+
+TEST(JsonSerializer, TestParseEscapes)
+{
+    JsonValue doc(Aws::String(R"({"esc\"aped" : "a\"b\\c\/d\b\f\n\r\te", "unicode" : "A\u00e9\u20AC\ud83d\ude00", "plain" : "x"})"));
+    ASSERT_TRUE(doc.WasParseSuccessful());
+    auto view = doc.View();
+    ASSERT_STREQ("a\"b\\c/d\b\f\n\r\te", view.GetString("esc\"aped").c_str());
+    ASSERT_STREQ("A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80", view.GetString("unicode").c_str());
+    ASSERT_STREQ("x", view.GetString("plain").c_str());
+}
+
+TEST(JsonSerializer, TestParseInvalidEscapesFail)
+{
+    ASSERT_FALSE(JsonValue(Aws::String(R"({"a" : "\q"})")).WasParseSuccessful());
+    ASSERT_FALSE(JsonValue(Aws::String(R"({"a" : "\u12"})")).WasParseSuccessful());
+    ASSERT_FALSE(JsonValue(Aws::String(R"({"a" : "\ud83d"})")).WasParseSuccessful());
+    ASSERT_FALSE(JsonValue(Aws::String(R"({"a" : "\ude00"})")).WasParseSuccessful());
+    ASSERT_FALSE(JsonValue(Aws::String(R"({"a" : "unterminated)")).WasParseSuccessful());
+}
+
+TEST(JsonSerializer, TestParseNumbers)
+{
+    JsonValue doc(Aws::String(R"([0, -17, 3.25, 1e3, -2.5E-2, 12345678901234, 1e300, -1e300])"));
+    ASSERT_TRUE(doc.WasParseSuccessful());
+    auto numbers = doc.View().AsArray();
+    ASSERT_EQ(8u, numbers.GetLength());
+    ASSERT_EQ(0, numbers[0].AsInteger());
+    ASSERT_EQ(-17, numbers[1].AsInteger());
+    ASSERT_DOUBLE_EQ(3.25, numbers[2].AsDouble());
+    ASSERT_EQ(1000, numbers[3].AsInteger());
+    ASSERT_DOUBLE_EQ(-0.025, numbers[4].AsDouble());
+    ASSERT_EQ(12345678901234ll, numbers[5].AsInt64());
+    ASSERT_EQ(INT_MAX, numbers[6].AsInteger());
+    ASSERT_EQ(INT_MIN, numbers[7].AsInteger());
+}
+
+TEST(JsonSerializer, TestParseRejectsMalformedDocuments)
+{
+    ASSERT_FALSE(JsonValue(Aws::String("")).WasParseSuccessful());
+    ASSERT_FALSE(JsonValue(Aws::String("   ")).WasParseSuccessful());
+    ASSERT_FALSE(JsonValue(Aws::String("{} {}")).WasParseSuccessful());
+    ASSERT_FALSE(JsonValue(Aws::String("[1, 2,]")).WasParseSuccessful());
+    ASSERT_FALSE(JsonValue(Aws::String("{\"a\" 1}")).WasParseSuccessful());
+    ASSERT_FALSE(JsonValue(Aws::String("tru")).WasParseSuccessful());
+    ASSERT_FALSE(JsonValue(Aws::String(1001, '[') + Aws::String(1001, ']')).WasParseSuccessful());
+    ASSERT_TRUE(JsonValue(Aws::String(1000, '[') + Aws::String(1000, ']')).WasParseSuccessful());
+
+    JsonValue value(Aws::String("{\"a\" : [1, 2 3]}"));
+    ASSERT_STREQ("Failed to parse JSON at: 3]}", value.GetErrorMessage().c_str());
+}
+
+TEST(JsonSerializer, TestParseLargeDocument)
+{
+    // enough nodes to spill over several blocks of the parse arena.
+    Aws::StringStream ss;
+    ss << "\xEF\xBB\xBF{\"Items\":[";
+    for (int i = 0; i < 5000; ++i)
+    {
+        ss << (i ? "," : "") << "{\"id\":{\"N\":\"" << i << "\"},\"name\":{\"S\":\"item\\n" << i << "\"}}";
+    }
+    ss << "]}";
+
+    JsonValue doc(ss);
+    ASSERT_TRUE(doc.WasParseSuccessful());
+    auto items = doc.View().GetArray("Items");
+    ASSERT_EQ(5000u, items.GetLength());
+    for (size_t i = 0; i < items.GetLength(); ++i)
+    {
+        ASSERT_EQ(Aws::Utils::StringUtils::to_string(i), items[i].GetObject("id").GetString("N"));
+        ASSERT_EQ("item\n" + Aws::Utils::StringUtils::to_string(i), items[i].GetObject("name").GetString("S"));
+    }
+}
+
+TEST(JsonSerializer, TestModifyParsedDocument)
+{
+    JsonValue doc(Aws::String(R"({"Key1" : "value1", "Nested" : {"Key2" : [1, 2]}})"));
+    ASSERT_TRUE(doc.WasParseSuccessful());
+    JsonValue copy(doc);
+
+    doc.WithString("Key3", "value3");
+    ASSERT_STREQ(R"({"Key1":"value1","Nested":{"Key2":[1,2]},"Key3":"value3"})", doc.View().WriteCompact().c_str());
+    ASSERT_STREQ(R"({"Key1":"value1","Nested":{"Key2":[1,2]}})", copy.View().WriteCompact().c_str());
+
+    JsonValue nested(Aws::String(R"({"Key4" : true})"));
+    JsonValue element(Aws::String("\"element\""));
+    Array<JsonValue> elements(1);
+    elements[0] = std::move(element);
+    copy.WithObject("Nested", std::move(nested)).WithArray("Elements", std::move(elements));
+    ASSERT_STREQ(R"({"Key1":"value1","Nested":{"Key4":true},"Elements":["element"]})", copy.View().WriteCompact().c_str());
+
+    JsonValue moved(std::move(copy));
+    JsonValue assigned;
+    assigned = std::move(moved);
+    ASSERT_TRUE(assigned.View().GetObject("Nested").GetBool("Key4"));
+}
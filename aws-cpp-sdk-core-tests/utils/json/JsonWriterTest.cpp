@@ -0,0 +1,110 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  * 
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  * 
+  *  http://aws.amazon.com/apache2.0
+  * 
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/json/JsonWriter.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+
+using namespace Aws::Utils::Json;
+using namespace Aws::Utils;
+
+TEST(JsonWriterTest, TestMatchesJsonValueOutput)
+{
+    JsonValue item;
+    item.WithString("S", "value");
+    Array<JsonValue> numbers(3);
+    numbers[0].AsInteger(1);
+    numbers[1].AsInt64(-1234567890123ll);
+    numbers[2].AsDouble(0.1);
+    JsonValue expected;
+    expected.WithString("TableName", "table")
+        .WithObject("Item", std::move(item))
+        .WithArray("Numbers", std::move(numbers))
+        .WithBool("ConsistentRead", true)
+        .WithDouble("Timestamp", 1556150400.123)
+        .WithInteger("Limit", 25);
+
+    JsonWriter writer;
+    writer.StartObject()
+        .WithString("TableName", "table")
+        .Key("Item").StartObject().WithString("S", "value").EndObject()
+        .Key("Numbers").StartArray().AsInteger(1).AsInt64(-1234567890123ll).AsDouble(0.1).EndArray()
+        .WithBool("ConsistentRead", true)
+        .WithDouble("Timestamp", 1556150400.123)
+        .WithInteger("Limit", 25)
+        .EndObject();
+
+    ASSERT_EQ(expected.View().WriteCompact(), writer.GetString());
+    ASSERT_TRUE(JsonValue(writer.GetString()).WasParseSuccessful());
+}
+
+TEST(JsonWriterTest, TestEmptyContainers)
+{
+    JsonWriter writer;
+    writer.StartObject().Key("List").StartArray().EndArray().Key("Map").StartObject().EndObject().EndObject();
+    ASSERT_STREQ("{\"List\":[],\"Map\":{}}", writer.GetString().c_str());
+}
+
+TEST(JsonWriterTest, TestStringEscaping)
+{
+    Aws::String value("quote\" backslash\\ slash/ \b\f\n\r\t bell\a ");
+    value.push_back('\0');
+    value.append("after-nul \xC3\xA9");
+
+    JsonWriter writer;
+    writer.StartArray().AsString(value).EndArray();
+    ASSERT_STREQ("[\"quote\\\" backslash\\\\ slash/ \\b\\f\\n\\r\\t bell\\u0007 \\u0000after-nul \xC3\xA9\"]", writer.GetString().c_str());
+
+    JsonValue parsed(writer.GetString());
+    ASSERT_TRUE(parsed.WasParseSuccessful());
+}
+
+TEST(JsonWriterTest, TestNumbers)
+{
+    JsonWriter writer;
+    writer.StartArray()
+        .AsInteger(0)
+        .AsInteger(-2147483647 - 1)
+        .AsInt64(9007199254740993ll)
+        .AsInt64(-9223372036854775807ll - 1)
+        .AsDouble(1.5)
+        .AsDouble(1.0 / 3.0)
+        .AsDouble(1e300 * 1e300)
+        .AsNull()
+        .EndArray();
+    ASSERT_STREQ("[0,-2147483648,9007199254740993,-9223372036854775808,1.5,0.33333333333333331,null,null]", writer.GetString().c_str());
+}
+
+TEST(JsonWriterTest, TestEmbedView)
+{
+    JsonValue existing("{\"a\":[1,2]}");
+    JsonValue empty;
+
+    JsonWriter writer;
+    writer.StartObject().WithObject("existing", existing.View()).WithObject("empty", empty.View()).EndObject();
+    ASSERT_STREQ("{\"existing\":{\"a\":[1,2]},\"empty\":{}}", writer.GetString().c_str());
+}
+
+TEST(JsonWriterTest, TestTakeOwnershipResetsWriter)
+{
+    JsonWriter writer(64);
+    writer.StartArray().AsBool(false).EndArray();
+    ASSERT_STREQ("[false]", writer.TakeOwnershipOfString().c_str());
+    ASSERT_TRUE(writer.GetString().empty());
+
+    writer.StartArray().AsBool(true).EndArray();
+    ASSERT_STREQ("[true]", writer.GetString().c_str());
+}
@@ -18,9 +18,11 @@
 #include <aws/external/gtest.h>
 
 #include <aws/core/utils/logging/DefaultLogSystem.h>
+#include <aws/core/utils/logging/RingBufferLogSystem.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/memory/AWSMemory.h>
 #include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/threading/Semaphore.h>
 
 #include <thread>
 
@@ -99,12 +101,13 @@ void VerifyAllLogsAtOrBelow(LogLevel logLevel, const Aws::String& tag, const Aws
     }
 }
 
+template<typename LogSystemType = DefaultLogSystem>
 void DoLogTest(LogLevel logLevel, const char *testTag)
 {
     auto ss = Aws::MakeShared<Aws::StringStream>(AllocationTag);
 
     {
-        ScopedLogger loggingScope(Aws::MakeShared<DefaultLogSystem>(AllocationTag, logLevel, ss));
+        ScopedLogger loggingScope(Aws::MakeShared<LogSystemType>(AllocationTag, logLevel, ss));
 
         LogAllPossibilities(testTag);
     }
@@ -142,3 +145,187 @@ TEST(LoggingTest, testTraceLogLevel)
 {
     DoLogTest(LogLevel::Trace, "LoggingTest_testTraceLogLevel");    
 }
+
+TEST(LoggingTest, testRingBufferLogLevels)
+{
+    DoLogTest<RingBufferLogSystem>(LogLevel::Error, "LoggingTest_testRingBufferLogLevels");
+    DoLogTest<RingBufferLogSystem>(LogLevel::Trace, "LoggingTest_testRingBufferLogLevels");
+}
+
+TEST(LoggingTest, testRingBufferLongMessages)
+{
+    auto ss = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    Aws::String longMessage(1000, 'x');
+    Aws::String longTag(100, 't');
+
+    {
+        RingBufferLogSystem logSystem(LogLevel::Trace, ss, 4);
+        logSystem.Log(LogLevel::Info, "LongMessages", "%s", longMessage.c_str());
+        Aws::OStringStream message;
+        message << longMessage << "y";
+        logSystem.LogStream(LogLevel::Warn, longTag.c_str(), message);
+        logSystem.Flush();
+
+        Aws::Vector<Aws::String> loggedStatements = StringUtils::SplitOnLine(ss->str());
+        ASSERT_EQ(2u, loggedStatements.size());
+        ASSERT_EQ(0u, loggedStatements[0].find("[INFO] "));
+        ASSERT_NE(Aws::String::npos, loggedStatements[0].find(" LongMessages ["));
+        ASSERT_EQ(longMessage, loggedStatements[0].substr(loggedStatements[0].size() - longMessage.size()));
+        ASSERT_EQ(0u, loggedStatements[1].find("[WARN] "));
+        ASSERT_NE(Aws::String::npos, loggedStatements[1].find(longTag.substr(0, 47) + " ["));
+        ASSERT_EQ(Aws::String::npos, loggedStatements[1].find(longTag.substr(0, 48)));
+        ASSERT_EQ(longMessage + "y", loggedStatements[1].substr(loggedStatements[1].size() - longMessage.size() - 1));
+    }
+}
+
+TEST(LoggingTest, testRingBufferKeepsEveryLineFromManyThreads)
+{
+    static const int THREADS = 8;
+    static const int LINES_PER_THREAD = 2000;
+    auto ss = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+
+    {
+        // small buffers, so that threads keep finding theirs full
+        RingBufferLogSystem logSystem(LogLevel::Trace, ss, 8);
+        Aws::Vector<std::thread> threads;
+        for (int i = 0; i < THREADS; ++i)
+        {
+            threads.emplace_back([&logSystem, i]()
+            {
+                for (int j = 0; j < LINES_PER_THREAD; ++j)
+                {
+                    logSystem.Log(LogLevel::Debug, "ManyThreads", "thread %d line %d", i, j);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    Aws::Vector<Aws::String> loggedStatements = StringUtils::SplitOnLine(ss->str());
+    ASSERT_EQ(static_cast<size_t>(THREADS * LINES_PER_THREAD), loggedStatements.size());
+
+    // each thread's lines come out in the order it logged them
+    int nextLine[THREADS] = {};
+    for (const auto& statement : loggedStatements)
+    {
+        auto threadPos = statement.find("thread ");
+        ASSERT_NE(Aws::String::npos, threadPos);
+        int thread = 0, line = 0;
+        ASSERT_EQ(2, sscanf(statement.c_str() + threadPos, "thread %d line %d", &thread, &line));
+        ASSERT_EQ(nextLine[thread], line);
+        nextLine[thread]++;
+    }
+}
+
+/**
+ * Stream buffer whose first write blocks until the test lets it through, to hold up a logger's background thread.
+ */
+class BlockingStreamBuf : public std::streambuf
+{
+public:
+    BlockingStreamBuf() : m_writing(0, 1), m_release(0, 1), m_blocked(false) {}
+
+    Aws::Utils::Threading::Semaphore m_writing;
+    Aws::Utils::Threading::Semaphore m_release;
+    Aws::String m_contents;
+
+protected:
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        Block();
+        m_contents.append(s, static_cast<size_t>(n));
+        return n;
+    }
+
+    int_type overflow(int_type c) override
+    {
+        Block();
+        if (c != traits_type::eof())
+        {
+            m_contents.push_back(traits_type::to_char_type(c));
+        }
+        return c;
+    }
+
+private:
+    void Block()
+    {
+        if (!m_blocked)
+        {
+            m_blocked = true;
+            m_writing.Release();
+            m_release.WaitOne();
+        }
+    }
+
+    bool m_blocked;
+};
+
+TEST(LoggingTest, testRingBufferDropsLinesWhenBufferStaysFull)
+{
+    BlockingStreamBuf streamBuf;
+    auto stream = Aws::MakeShared<Aws::OStream>(AllocationTag, &streamBuf);
+
+    {
+        RingBufferLogSystem logSystem(LogLevel::Trace, stream, 2);
+        logSystem.Log(LogLevel::Info, "FullBuffer", "line 0");
+        // the background thread is stuck writing the first line, so the two records of this thread's buffer fill up and the next line
+        // is dropped.
+        streamBuf.m_writing.WaitOne();
+        logSystem.Log(LogLevel::Info, "FullBuffer", "line 1");
+        logSystem.Log(LogLevel::Info, "FullBuffer", "line 2");
+        logSystem.Log(LogLevel::Info, "FullBuffer", "line 3");
+        ASSERT_EQ(1u, logSystem.GetDroppedLineCount());
+
+        streamBuf.m_release.Release();
+        logSystem.Flush();
+    }
+
+    Aws::Vector<Aws::String> loggedStatements = StringUtils::SplitOnLine(streamBuf.m_contents);
+    ASSERT_EQ(4u, loggedStatements.size());
+    for (size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ("line " + StringUtils::to_string(i), loggedStatements[i].substr(loggedStatements[i].size() - 6));
+    }
+    ASSERT_EQ(0u, loggedStatements[3].find("[WARN] "));
+    ASSERT_NE(Aws::String::npos, loggedStatements[3].find("Dropped 1 log lines"));
+}
+
+static int CountEvaluation(int& evaluations)
+{
+    return ++evaluations;
+}
+
+TEST(LoggingTest, testTagFilterSkipsStatementsAboveItsLevel)
+{
+    auto ss = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    int evaluations = 0;
+
+    {
+        ScopedLogger loggingScope(Aws::MakeShared<DefaultLogSystem>(AllocationTag, LogLevel::Debug, ss));
+        ASSERT_TRUE(SetLogLevelForTag("LoggingTest_Filtered", LogLevel::Warn));
+        ASSERT_FALSE(SetLogLevelForTag(Aws::String(64, 't').c_str(), LogLevel::Warn));
+
+        AWS_LOGSTREAM_DEBUG("LoggingTest_Filtered", "skipped " << CountEvaluation(evaluations));
+        AWS_LOG_INFO("LoggingTest_Filtered", "skipped %d", CountEvaluation(evaluations));
+        AWS_LOGSTREAM_WARN("LoggingTest_Filtered", "kept " << CountEvaluation(evaluations));
+        AWS_LOGSTREAM_DEBUG("LoggingTest_Unfiltered", "kept " << CountEvaluation(evaluations));
+        // the filter can't make a tag more verbose than the log system
+        ASSERT_TRUE(SetLogLevelForTag("LoggingTest_Unfiltered", LogLevel::Trace));
+        AWS_LOGSTREAM_TRACE("LoggingTest_Unfiltered", "skipped " << CountEvaluation(evaluations));
+
+        ClearLogLevelsForTags();
+        AWS_LOGSTREAM_DEBUG("LoggingTest_Filtered", "kept " << CountEvaluation(evaluations));
+    }
+
+    ASSERT_EQ(3, evaluations);
+    Aws::Vector<Aws::String> loggedStatements = StringUtils::SplitOnLine(ss->str());
+    ASSERT_EQ(3u, loggedStatements.size());
+    for (const auto& statement : loggedStatements)
+    {
+        ASSERT_NE(Aws::String::npos, statement.find("kept"));
+    }
+}
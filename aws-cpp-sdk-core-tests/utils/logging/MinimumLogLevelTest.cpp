@@ -0,0 +1,55 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+// what building with -DMINIMUM_LOG_LEVEL=Info does to every translation unit
+#define AWS_MINIMUM_LOG_LEVEL 4
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/logging/DefaultLogSystem.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/StringUtils.h>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Logging;
+
+static const char* AllocationTag = "MinimumLogLevelTest";
+
+TEST(MinimumLogLevelTest, testStatementsBelowMinimumAreCompiledOut)
+{
+    static_assert(AWS_LOG_LEVEL_COMPILED_IN(LogLevel::Info), "Info statements should be compiled in");
+    static_assert(!AWS_LOG_LEVEL_COMPILED_IN(LogLevel::Debug), "Debug statements should be compiled out");
+
+    auto ss = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    int evaluations = 0;
+
+    {
+        PushLogger(Aws::MakeShared<DefaultLogSystem>(AllocationTag, LogLevel::Trace, ss));
+
+        AWS_LOGSTREAM_TRACE("MinimumLogLevelTest", "compiled out " << ++evaluations);
+        AWS_LOG_DEBUG("MinimumLogLevelTest", "compiled out %d", ++evaluations);
+        AWS_LOGSTREAM_INFO("MinimumLogLevelTest", "compiled in " << ++evaluations);
+        AWS_LOG_ERROR("MinimumLogLevelTest", "compiled in %d", ++evaluations);
+
+        PopLogger();
+    }
+
+    ASSERT_EQ(2, evaluations);
+    Aws::Vector<Aws::String> loggedStatements = StringUtils::SplitOnLine(ss->str());
+    ASSERT_EQ(2u, loggedStatements.size());
+    ASSERT_NE(Aws::String::npos, loggedStatements[0].find("[INFO]"));
+    ASSERT_NE(Aws::String::npos, loggedStatements[1].find("[ERROR]"));
+}
@@ -0,0 +1,86 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/memory/MonotonicArena.h>
+
+#include <cstdint>
+#include <cstring>
+
+using namespace Aws::Utils::Memory;
+
+static bool IsAligned(const void* ptr, size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(MonotonicArenaTest, TestAllocationsAreAlignedAndDistinct)
+{
+    MonotonicArena arena(256);
+    ASSERT_EQ(0u, arena.GetReservedBytes());
+
+    char* first = static_cast<char*>(arena.AllocateMemory(3, 1));
+    char* second = static_cast<char*>(arena.AllocateMemory(8, 8));
+    char* third = static_cast<char*>(arena.AllocateMemory(1, 1));
+    void* wide = arena.AllocateMemory(16, 64);
+
+    ASSERT_TRUE(IsAligned(first, alignof(std::max_align_t)));
+    ASSERT_TRUE(IsAligned(second, 8));
+    ASSERT_TRUE(IsAligned(third, alignof(std::max_align_t)));
+    ASSERT_TRUE(IsAligned(wide, 64));
+    ASSERT_LE(first + 3, second);
+    ASSERT_LE(second + 8, third);
+    ASSERT_EQ(256u, arena.GetReservedBytes());
+
+    memset(first, 'a', 3);
+    memset(second, 'b', 8);
+    memset(third, 'c', 1);
+    ASSERT_EQ('a', first[2]);
+    ASSERT_EQ('b', second[7]);
+}
+
+TEST(MonotonicArenaTest, TestGrowsByDoublingBlocks)
+{
+    MonotonicArena arena(128);
+    for (int i = 0; i < 16; ++i)
+    {
+        memset(arena.AllocateMemory(32, 8), i, 32);
+    }
+    ASSERT_EQ(128u + 256u + 512u, arena.GetReservedBytes());
+
+    //an allocation larger than the next block gets a block of its own size.
+    memset(arena.AllocateMemory(4096, 8), 0, 4096);
+    ASSERT_EQ(128u + 256u + 512u + 4096u, arena.GetReservedBytes());
+}
+
+TEST(MonotonicArenaTest, TestResetKeepsLargestBlock)
+{
+    MonotonicArena arena(64);
+    void* first = nullptr;
+    for (int i = 0; i < 10; ++i)
+    {
+        first = arena.AllocateMemory(40, 8);
+    }
+    ASSERT_EQ(64u + 128u + 256u, arena.GetReservedBytes());
+
+    arena.Reset();
+    ASSERT_EQ(256u, arena.GetReservedBytes());
+    void* reused = arena.AllocateMemory(40, 8);
+    ASSERT_NE(first, reused);
+    ASSERT_EQ(256u, arena.GetReservedBytes());
+
+    arena.FreeMemory(reused);
+    ASSERT_EQ(256u, arena.GetReservedBytes());
+}
@@ -16,6 +16,10 @@
 #include <aws/external/gtest.h>
 
 #include <aws/core/utils/ratelimiter/DefaultRateLimiter.h>
+#include <aws/core/utils/ratelimiter/AtomicRateLimiter.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+#include <thread>
 
 using namespace Aws::Utils::RateLimits;
 
@@ -276,4 +280,148 @@ TEST_F(DefaultRateLimitTest, fractionalLimitTest)
     SetMillisecondsElapsed(10);
     delay = limiter.ApplyCost(0);
     ASSERT_TRUE(delay.count() == 0);    
-}
\ No newline at end of file
+}
+
+using TestAtomicRateLimiter = AtomicRateLimiter<>;
+
+class AtomicRateLimitTest : public ::testing::Test {
+
+    public:
+
+        static TestAtomicRateLimiter::InternalTimePointType m_currentTime;
+
+        static TestAtomicRateLimiter::InternalTimePointType GetTestTime() { return m_currentTime; }
+
+        using Clock = TestAtomicRateLimiter::InternalTimePointType::clock;
+        using Ms = std::chrono::milliseconds;
+
+        static void SetMillisecondsElapsed(int64_t millisecondsElapsed) {
+            m_currentTime = std::chrono::time_point_cast<Clock::duration>(std::chrono::time_point<Clock, Ms>(Ms(millisecondsElapsed)));
+        }
+
+    protected:
+
+        void SetUp()
+        {
+            SetMillisecondsElapsed(0);
+        }
+
+};
+
+TestAtomicRateLimiter::InternalTimePointType AtomicRateLimitTest::m_currentTime;
+
+TEST_F(AtomicRateLimitTest, limitEdgeTest)
+{
+    TestAtomicRateLimiter limiter(10, 0, AtomicRateLimitTest::GetTestTime);
+
+    ASSERT_EQ(0, limiter.ApplyCost(0).count());
+    ASSERT_EQ(0, limiter.ApplyCost(10).count());
+    ASSERT_EQ(0, limiter.ApplyCost(0).count());
+}
+
+TEST_F(AtomicRateLimitTest, doubleLimitTest)
+{
+    TestAtomicRateLimiter limiter(10, 0, AtomicRateLimitTest::GetTestTime);
+
+    ASSERT_EQ(0, limiter.ApplyCost(20).count());
+    ASSERT_EQ(1000, limiter.ApplyCost(0).count());
+}
+
+TEST_F(AtomicRateLimitTest, delayedOverLimitTest)
+{
+    TestAtomicRateLimiter limiter(10, 0, AtomicRateLimitTest::GetTestTime);
+    limiter.ApplyCost(10);
+
+    SetMillisecondsElapsed(500);
+
+    ASSERT_EQ(0, limiter.ApplyCost(6).count());
+    ASSERT_EQ(100, limiter.ApplyCost(0).count());
+}
+
+TEST_F(AtomicRateLimitTest, longDelayLimitTest)
+{
+    TestAtomicRateLimiter limiter(100, 0, AtomicRateLimitTest::GetTestTime);
+    limiter.ApplyCost(150);
+    ASSERT_EQ(500, limiter.ApplyCost(0).count());
+
+    // long wait, should decay to nothing but a full budget
+    SetMillisecondsElapsed(100000);
+
+    ASSERT_EQ(0, limiter.ApplyCost(99).count());
+    ASSERT_EQ(0, limiter.ApplyCost(0).count());
+    ASSERT_EQ(0, limiter.ApplyCost(11).count());
+    ASSERT_EQ(100, limiter.ApplyCost(0).count());
+}
+
+TEST_F(AtomicRateLimitTest, changeRateKeepsDelayTest)
+{
+    TestAtomicRateLimiter limiter(100, 0, AtomicRateLimitTest::GetTestTime);
+
+    limiter.ApplyCost(700);
+    ASSERT_EQ(6000, limiter.ApplyCost(0).count());
+
+    SetMillisecondsElapsed(1000);
+    limiter.SetRate(10);
+    ASSERT_EQ(5000, limiter.ApplyCost(0).count());
+
+    // 5 units now take half a second to pay for
+    limiter.ApplyCost(5);
+    ASSERT_EQ(5500, limiter.ApplyCost(0).count());
+
+    SetMillisecondsElapsed(1400);
+    limiter.SetRate(100);
+    limiter.ApplyCost(60);
+
+    SetMillisecondsElapsed(2100);
+    ASSERT_EQ(5000, limiter.ApplyCost(0).count());
+
+    limiter.SetRate(100, true);
+    ASSERT_EQ(0, limiter.ApplyCost(100).count());
+    ASSERT_EQ(0, limiter.ApplyCost(0).count());
+}
+
+TEST_F(AtomicRateLimitTest, leasedCreditTest)
+{
+    TestAtomicRateLimiter limiter(100, 100, AtomicRateLimitTest::GetTestTime);
+
+    // the first cost leases the whole budget, the rest are paid out of the lease
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_EQ(0, limiter.ApplyCost(10).count());
+        ASSERT_EQ(0, limiter.ApplyCost(0).count());
+    }
+
+    // the lease ran out, so the next cost leases a budget that isn't there yet
+    ASSERT_EQ(0, limiter.ApplyCost(10).count());
+    ASSERT_EQ(1000, limiter.ApplyCost(0).count());
+
+    // costs larger than a lease are leased whole
+    ASSERT_EQ(1000, limiter.ApplyCost(300).count());
+    ASSERT_EQ(4000, limiter.ApplyCost(0).count());
+}
+
+TEST_F(AtomicRateLimitTest, concurrentCostsAreAllAccountedTest)
+{
+    static const int THREADS = 8;
+    static const int COSTS_PER_THREAD = 1000;
+
+    TestAtomicRateLimiter limiter(1000, 0, AtomicRateLimitTest::GetTestTime);
+    Aws::Vector<std::thread> threads;
+    for (int i = 0; i < THREADS; ++i)
+    {
+        threads.emplace_back([&limiter]()
+        {
+            for (int j = 0; j < COSTS_PER_THREAD; ++j)
+            {
+                limiter.ApplyCost(1);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // one second of the eight was covered by the initial budget
+    ASSERT_EQ(7000, limiter.ApplyCost(0).count());
+}
@@ -0,0 +1,148 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/stream/FileRangeStreamBuf.h>
+#include <aws/core/platform/FileSystem.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <fstream>
+
+using namespace Aws::Utils::Stream;
+
+class FileRangeStreamBufTest : public ::testing::Test
+{
+public:
+    Aws::String filePath;
+    Aws::String fileContents;
+
+    void SetUp() override
+    {
+        // bigger than the internal get area, so single character reads have to refill it.
+        for (size_t i = 0; i < 5000; ++i)
+        {
+            fileContents.push_back(static_cast<char>('a' + i % 26));
+        }
+
+        filePath = Aws::FileSystem::CreateTempFilePath();
+        std::ofstream file(filePath.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        file.write(fileContents.c_str(), static_cast<std::streamsize>(fileContents.size()));
+    }
+
+    void TearDown() override
+    {
+        EXPECT_TRUE(Aws::FileSystem::RemoveFileIfExists(filePath.c_str()));
+    }
+};
+
+TEST_F(FileRangeStreamBufTest, TestReadRange)
+{
+    FileRangeStreamBuf streamBuf(filePath, 5, 10);
+    Aws::IOStream ioStream(&streamBuf);
+
+    char readBuf[32] = {};
+    ioStream.read(readBuf, sizeof(readBuf));
+    ASSERT_EQ(10, ioStream.gcount());
+    ASSERT_EQ(fileContents.substr(5, 10), Aws::String(readBuf, 10));
+    ASSERT_TRUE(ioStream.eof());
+}
+
+TEST_F(FileRangeStreamBufTest, TestSeekAndReadAgain)
+{
+    FileRangeStreamBuf streamBuf(filePath, 1000, 3000);
+    Aws::IOStream ioStream(&streamBuf);
+
+    ioStream.seekg(0, std::ios_base::end);
+    ASSERT_EQ(3000, static_cast<int>(ioStream.tellg()));
+    ioStream.seekg(0, std::ios_base::beg);
+
+    Aws::String firstRead(3000, '\0');
+    ioStream.read(&firstRead[0], 3000);
+    ASSERT_EQ(3000, ioStream.gcount());
+    ASSERT_EQ(fileContents.substr(1000, 3000), firstRead);
+
+    ioStream.clear();
+    ioStream.seekg(2990);
+    ASSERT_EQ(2990, static_cast<int>(ioStream.tellg()));
+    char tail[16] = {};
+    ioStream.read(tail, sizeof(tail));
+    ASSERT_EQ(10, ioStream.gcount());
+    ASSERT_EQ(fileContents.substr(3990, 10), Aws::String(tail, 10));
+
+    ioStream.clear();
+    ioStream.seekg(0);
+    Aws::String secondRead(3000, '\0');
+    ioStream.read(&secondRead[0], 3000);
+    ASSERT_EQ(firstRead, secondRead);
+
+    ioStream.clear();
+    ioStream.seekg(3001);
+    ASSERT_TRUE(ioStream.fail());
+}
+
+TEST_F(FileRangeStreamBufTest, TestReadByCharacter)
+{
+    FileRangeStreamBuf streamBuf(filePath, 3, 4000);
+    Aws::IOStream ioStream(&streamBuf);
+
+    Aws::String read;
+    bool seeked = false;
+    char c;
+    while (ioStream.get(c))
+    {
+        read.push_back(c);
+        if (read.size() == 1500 && !seeked)
+        {
+            // a relative seek inside the buffered characters must not lose them.
+            ioStream.seekg(-500, std::ios_base::cur);
+            read.resize(1000);
+            seeked = true;
+        }
+    }
+    ASSERT_EQ(fileContents.substr(3, 4000), read);
+}
+
+TEST_F(FileRangeStreamBufTest, TestSeekAfterReadPastGetArea)
+{
+    FileRangeStreamBuf streamBuf(filePath, 0, 5000);
+    Aws::IOStream ioStream(&streamBuf);
+
+    // fills the get area, then reads most of the rest straight from the file
+    ASSERT_EQ(fileContents[0], static_cast<char>(ioStream.get()));
+    Aws::String read(3000, '\0');
+    ioStream.read(&read[0], 3000);
+    ASSERT_EQ(3000, ioStream.gcount());
+    ASSERT_EQ(fileContents.substr(1, 3000), read);
+
+    // a position that would fall inside the get area if it still claimed to end where the direct read did
+    ioStream.seekg(2500);
+    ASSERT_EQ(2500, static_cast<int>(ioStream.tellg()));
+    ASSERT_EQ(fileContents[2500], static_cast<char>(ioStream.get()));
+
+    ioStream.seekg(2);
+    ASSERT_EQ(fileContents[2], static_cast<char>(ioStream.get()));
+    ASSERT_EQ(fileContents[3], static_cast<char>(ioStream.get()));
+}
+
+TEST_F(FileRangeStreamBufTest, TestMissingFile)
+{
+    FileRangeStreamBuf streamBuf(filePath + "missing", 0, 10);
+    Aws::IOStream ioStream(&streamBuf);
+
+    char readBuf[10];
+    ioStream.read(readBuf, sizeof(readBuf));
+    ASSERT_EQ(0, ioStream.gcount());
+    ASSERT_TRUE(ioStream.fail());
+}
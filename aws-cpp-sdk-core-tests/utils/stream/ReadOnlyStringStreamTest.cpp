@@ -0,0 +1,85 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/stream/ReadOnlyStringStream.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+
+using namespace Aws::Utils::Stream;
+
+static const char ALLOCATION_TAG[] = "ReadOnlyStringStreamTest";
+static const char payload[] = "This is a serialized payload.";
+
+TEST(ReadOnlyStringStreamTest, TestReadWholeString)
+{
+    ReadOnlyStringStream stream{Aws::String(payload)};
+
+    Aws::String readBack;
+    std::getline(stream, readBack);
+    ASSERT_STREQ(payload, readBack.c_str());
+    ASSERT_TRUE(stream.eof());
+}
+
+TEST(ReadOnlyStringStreamTest, TestSharesStringWithoutCopying)
+{
+    auto value = Aws::MakeShared<Aws::String>(ALLOCATION_TAG, payload);
+    ReadOnlyStringStream first(value);
+    ReadOnlyStringStream second(value);
+
+    ASSERT_EQ(value->data(), first.str().data());
+    ASSERT_EQ(value->data(), second.str().data());
+
+    char buf[5] = {};
+    first.read(buf, 4);
+    ASSERT_STREQ("This", buf);
+    //reading from one stream doesn't move the other one.
+    second.read(buf, 4);
+    ASSERT_STREQ("This", buf);
+}
+
+TEST(ReadOnlyStringStreamTest, TestSeekAndTell)
+{
+    ReadOnlyStringStream stream{Aws::String(payload)};
+
+    stream.seekg(0, std::ios_base::end);
+    ASSERT_EQ(static_cast<std::streamoff>(sizeof(payload) - 1), static_cast<std::streamoff>(stream.tellg()));
+
+    stream.seekg(10, std::ios_base::beg);
+    stream.seekg(-2, std::ios_base::cur);
+    ASSERT_EQ(8, static_cast<std::streamoff>(stream.tellg()));
+    ASSERT_EQ('a', stream.get());
+
+    //running off the end fails without moving the stream.
+    stream.seekg(1, std::ios_base::end);
+    ASSERT_TRUE(stream.fail());
+    stream.clear();
+    ASSERT_EQ(9, static_cast<std::streamoff>(stream.tellg()));
+
+    //retries rewind exactly like this before sending the body again.
+    stream.seekg(0);
+    Aws::String readBack;
+    std::getline(stream, readBack);
+    ASSERT_STREQ(payload, readBack.c_str());
+}
+
+TEST(ReadOnlyStringStreamTest, TestWriteFails)
+{
+    ReadOnlyStringStream stream{Aws::String(payload)};
+
+    stream << "overwrite";
+    ASSERT_TRUE(stream.bad());
+    ASSERT_STREQ(payload, stream.str().c_str());
+}
@@ -0,0 +1,179 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/core/utils/threading/Semaphore.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <atomic>
+#include <mutex>
+
+using namespace Aws::Utils::Threading;
+
+TEST(FairQueueingExecutor, RunsHigherPriorityTasksFirst)
+{
+    Semaphore release(0, 1);
+    Semaphore done(0, 1);
+    std::mutex orderLock;
+    Aws::Vector<TaskPriority> order;
+    FairQueueingExecutor exec(1);
+    auto low = exec.CreateQueue(TaskPriority::LOW);
+    auto high = exec.CreateQueue(TaskPriority::HIGH);
+
+    // hold the only worker while both queues fill up.
+    ASSERT_TRUE(exec.Submit([&] { release.WaitOne(); }));
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(low->Submit([&] {
+            std::lock_guard<std::mutex> locker(orderLock);
+            order.push_back(TaskPriority::LOW);
+            if (order.size() == 20)
+            {
+                done.Release();
+            }
+        }));
+        ASSERT_TRUE(high->Submit([&] {
+            std::lock_guard<std::mutex> locker(orderLock);
+            order.push_back(TaskPriority::HIGH);
+        }));
+    }
+    release.Release();
+    done.WaitOne();
+
+    ASSERT_EQ(20u, order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        ASSERT_EQ(i < 10 ? TaskPriority::HIGH : TaskPriority::LOW, order[i]);
+    }
+}
+
+TEST(FairQueueingExecutor, SharesWorkersByWeight)
+{
+    Semaphore release(0, 1);
+    Semaphore done(0, 1);
+    std::mutex orderLock;
+    Aws::Vector<int> order;
+    FairQueueingExecutor exec(1);
+    auto heavy = exec.CreateQueue(TaskPriority::NORMAL, 3);
+    auto light = exec.CreateQueue(TaskPriority::NORMAL, 1);
+
+    ASSERT_TRUE(exec.Submit([&] { release.WaitOne(); }));
+    auto record = [&](int queue) {
+        std::lock_guard<std::mutex> locker(orderLock);
+        order.push_back(queue);
+        if (order.size() == 80)
+        {
+            done.Release();
+        }
+    };
+    for (int i = 0; i < 40; ++i)
+    {
+        ASSERT_TRUE(heavy->Submit(record, 3));
+        ASSERT_TRUE(light->Submit(record, 1));
+    }
+    release.Release();
+    done.WaitOne();
+
+    // while both queues have tasks, the heavier one gets three turns for each of the lighter one's.
+    int heavyTurns = 0;
+    for (size_t i = 0; i < 40; ++i)
+    {
+        heavyTurns += order[i] == 3 ? 1 : 0;
+    }
+    ASSERT_GE(heavyTurns, 29);
+    ASSERT_LE(heavyTurns, 31);
+}
+
+TEST(FairQueueingExecutor, SharesWorkersWithQueueActivatedAfterHigherPriorityTasks)
+{
+    Semaphore release(0, 1);
+    Semaphore done(0, 1);
+    std::mutex orderLock;
+    Aws::Vector<int> order;
+    FairQueueingExecutor exec(1);
+    auto high = exec.CreateQueue(TaskPriority::HIGH);
+    auto waitingLow = exec.CreateQueue(TaskPriority::LOW);
+    auto lateLow = exec.CreateQueue(TaskPriority::LOW);
+
+    auto record = [&](int queue) {
+        std::lock_guard<std::mutex> locker(orderLock);
+        order.push_back(queue);
+        if (order.size() == 20)
+        {
+            done.Release();
+        }
+    };
+    ASSERT_TRUE(exec.Submit([&] { release.WaitOne(); }));
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(waitingLow->Submit(record, 1));
+    }
+    for (int i = 0; i < 20; ++i)
+    {
+        ASSERT_TRUE(high->Submit([] {}));
+    }
+    // the second low priority queue only gets tasks once the high priority ones have run.
+    ASSERT_TRUE(high->Submit([&] {
+        for (int i = 0; i < 10; ++i)
+        {
+            lateLow->Submit(record, 2);
+        }
+    }));
+    release.Release();
+    done.WaitOne();
+
+    // the high priority tasks don't count against the late queue, the two low priority queues take turns from the start.
+    int lateTurns = 0;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        lateTurns += order[i] == 2 ? 1 : 0;
+    }
+    ASSERT_GE(lateTurns, 4);
+    ASSERT_LE(lateTurns, 6);
+}
+
+TEST(FairQueueingExecutor, RunsTasksOfReleasedQueues)
+{
+    Semaphore release(0, 1);
+    Semaphore done(0, 1);
+    std::atomic<int> ran(0);
+    FairQueueingExecutor exec(2);
+    ASSERT_TRUE(exec.Submit([&] { release.WaitOne(); }));
+    {
+        auto queue = exec.CreateQueue(TaskPriority::LOW);
+        for (int i = 0; i < 100; ++i)
+        {
+            ASSERT_TRUE(queue->Submit([&] {
+                if (++ran == 100)
+                {
+                    done.Release();
+                }
+            }));
+        }
+    }
+    done.WaitOne();
+    release.Release();
+    ASSERT_EQ(100, ran.load());
+}
+
+TEST(FairQueueingExecutor, RejectsTasksAfterDestruction)
+{
+    std::shared_ptr<Executor> queue;
+    {
+        FairQueueingExecutor exec(1);
+        queue = exec.CreateQueue(TaskPriority::HIGH);
+    }
+    ASSERT_FALSE(queue->Submit([] {}));
+}
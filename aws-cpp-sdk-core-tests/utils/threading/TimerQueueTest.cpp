@@ -0,0 +1,74 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/threading/TimerQueue.h>
+#include <aws/core/utils/threading/Semaphore.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <mutex>
+#include <chrono>
+
+using namespace Aws::Utils::Threading;
+
+TEST(TimerQueue, TasksRunInDeadlineOrder)
+{
+    TimerQueue timer;
+    Semaphore ev(0, 1);
+    std::mutex mutex;
+    Aws::Vector<int> order;
+    auto record = [&](int value)
+    {
+        std::lock_guard<std::mutex> locker(mutex);
+        order.push_back(value);
+        if (order.size() == 3)
+        {
+            ev.Release();
+        }
+    };
+
+    timer.Schedule(std::chrono::milliseconds(60), [&] { record(3); });
+    timer.Schedule(std::chrono::milliseconds(30), [&] { record(2); });
+    timer.Schedule(std::chrono::milliseconds(0), [&] { record(1); });
+    ev.WaitOne();
+
+    std::lock_guard<std::mutex> locker(mutex);
+    ASSERT_EQ(3u, order.size());
+    ASSERT_EQ(1, order[0]);
+    ASSERT_EQ(2, order[1]);
+    ASSERT_EQ(3, order[2]);
+    ASSERT_EQ(0u, timer.GetPendingTaskCount());
+}
+
+TEST(TimerQueue, TaskDoesNotRunBeforeDeadline)
+{
+    TimerQueue timer;
+    Semaphore ev(0, 1);
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point ranAt;
+    timer.Schedule(std::chrono::milliseconds(50), [&] { ranAt = std::chrono::steady_clock::now(); ev.Release(); });
+    ev.WaitOne();
+    ASSERT_GE(std::chrono::duration_cast<std::chrono::milliseconds>(ranAt - start).count(), 50);
+}
+
+TEST(TimerQueue, PendingTasksAreDiscardedOnDestruction)
+{
+    bool ran = false;
+    {
+        TimerQueue timer;
+        timer.Schedule(std::chrono::hours(1), [&] { ran = true; });
+        ASSERT_EQ(1u, timer.GetPendingTaskCount());
+    }
+    ASSERT_FALSE(ran);
+}
@@ -0,0 +1,111 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/core/utils/threading/Semaphore.h>
+#include <atomic>
+#include <thread>
+
+using namespace Aws::Utils::Threading;
+
+TEST(WorkStealingExecutor, RunsTasksSubmittedFromManyThreads)
+{
+    const int submitters = 4;
+    const int tasksPerSubmitter = 5000;
+    std::atomic<int> ran(0);
+    Semaphore done(0, 1);
+    {
+        WorkStealingExecutor exec(4);
+        std::thread threads[submitters];
+        for (auto& thread : threads)
+        {
+            thread = std::thread([&] {
+                for (int i = 0; i < tasksPerSubmitter; ++i)
+                {
+                    ASSERT_TRUE(exec.Submit([&] {
+                        if (++ran == submitters * tasksPerSubmitter)
+                        {
+                            done.Release();
+                        }
+                    }));
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        done.WaitOne();
+    }
+    ASSERT_EQ(submitters * tasksPerSubmitter, ran.load());
+}
+
+TEST(WorkStealingExecutor, QueuesTasksBeyondQueueCapacity)
+{
+    // more tasks than the worker's queue has slots, submitted while the worker is busy.
+    const int taskCount = 5000;
+    std::atomic<int> ran(0);
+    Semaphore release(0, 1);
+    Semaphore done(0, 1);
+    WorkStealingExecutor exec(1);
+    ASSERT_TRUE(exec.Submit([&] { release.WaitOne(); }));
+    for (int i = 0; i < taskCount; ++i)
+    {
+        ASSERT_TRUE(exec.Submit([&] {
+            if (++ran == taskCount)
+            {
+                done.Release();
+            }
+        }));
+    }
+    release.Release();
+    done.WaitOne();
+    ASSERT_EQ(taskCount, ran.load());
+}
+
+TEST(WorkStealingExecutor, IdleWorkersStealFromBusyWorkersQueues)
+{
+    // the first worker blocks on its task; what is queued behind it must still run on the other worker.
+    std::atomic<int> ran(0);
+    Semaphore release(0, 1);
+    Semaphore done(0, 1);
+    WorkStealingExecutor exec(2);
+    ASSERT_TRUE(exec.Submit([&] { release.WaitOne(); }));
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(exec.Submit([&] {
+            if (++ran == 100)
+            {
+                done.Release();
+            }
+        }));
+    }
+    done.WaitOne();
+    ASSERT_EQ(100, ran.load());
+    release.Release();
+}
+
+TEST(WorkStealingExecutor, RejectsTasksWhenBusyWithRejectPolicy)
+{
+    Semaphore release(0, 1);
+    Semaphore started(0, 1);
+    WorkStealingExecutor exec(1, OverflowPolicy::REJECT_IMMEDIATELY);
+    ASSERT_TRUE(exec.Submit([&] { started.Release(); release.WaitOne(); }));
+    started.WaitOne();
+    ASSERT_TRUE(exec.Submit([] {}));
+    ASSERT_FALSE(exec.Submit([] {}));
+    release.Release();
+}
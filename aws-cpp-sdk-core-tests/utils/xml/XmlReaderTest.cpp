@@ -0,0 +1,229 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  * 
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  * 
+  *  http://aws.amazon.com/apache2.0
+  * 
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/xml/XmlReader.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/StringUtils.h>
+
+using namespace Aws::Utils::Xml;
+
+typedef XmlReader::NodeType NodeType;
+
+TEST(XmlReaderTest, TestReadsNodesInDocumentOrder)
+{
+    Aws::StringStream xml;
+    xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<!DOCTYPE ToDo>\n"
+        "<!-- Our to do list data -->\n"
+        "<ToDo xmlns=\"http://example.com/\">"
+        "<Item priority=\"1\" owner='me &amp; you'>Go to the <bold>Toy store!</bold></Item>"
+        "<Empty/>"
+        "<Empty2 a=\"b\" />"
+        "</ToDo>\n<!-- trailing -->";
+
+    XmlReader reader(xml);
+    ASSERT_EQ(NodeType::StartElement, reader.Read());
+    ASSERT_EQ("ToDo", reader.GetName());
+    ASSERT_EQ(1u, reader.GetDepth());
+    ASSERT_EQ("http://example.com/", reader.GetAttributeValue("xmlns"));
+
+    ASSERT_EQ(NodeType::StartElement, reader.Read());
+    ASSERT_EQ("Item", reader.GetName());
+    ASSERT_EQ(2u, reader.GetDepth());
+    ASSERT_EQ("1", reader.GetAttributeValue("priority"));
+    ASSERT_EQ("me & you", reader.GetAttributeValue("owner"));
+    ASSERT_EQ("", reader.GetAttributeValue("missing"));
+
+    ASSERT_EQ(NodeType::Text, reader.Read());
+    ASSERT_EQ("Go to the ", reader.GetText());
+    ASSERT_EQ(NodeType::StartElement, reader.Read());
+    ASSERT_EQ("bold", reader.GetName());
+    ASSERT_EQ(3u, reader.GetDepth());
+    ASSERT_EQ(NodeType::Text, reader.Read());
+    ASSERT_EQ("Toy store!", reader.GetText());
+    ASSERT_EQ(NodeType::EndElement, reader.Read());
+    ASSERT_EQ("bold", reader.GetName());
+    ASSERT_EQ(3u, reader.GetDepth());
+    ASSERT_EQ(NodeType::EndElement, reader.Read());
+    ASSERT_EQ("Item", reader.GetName());
+    ASSERT_EQ(2u, reader.GetDepth());
+
+    ASSERT_EQ(NodeType::StartElement, reader.Read());
+    ASSERT_EQ("Empty", reader.GetName());
+    ASSERT_EQ(NodeType::EndElement, reader.Read());
+    ASSERT_EQ("Empty", reader.GetName());
+    ASSERT_EQ(2u, reader.GetDepth());
+
+    ASSERT_EQ(NodeType::StartElement, reader.Read());
+    ASSERT_EQ("Empty2", reader.GetName());
+    ASSERT_EQ("b", reader.GetAttributeValue("a"));
+    ASSERT_EQ(NodeType::EndElement, reader.Read());
+
+    ASSERT_EQ(NodeType::EndElement, reader.Read());
+    ASSERT_EQ("ToDo", reader.GetName());
+    ASSERT_EQ(1u, reader.GetDepth());
+    ASSERT_EQ(NodeType::EndDocument, reader.Read());
+    ASSERT_EQ(NodeType::EndDocument, reader.Read());
+    ASSERT_FALSE(reader.HasError());
+}
+
+TEST(XmlReaderTest, TestDecodesText)
+{
+    Aws::StringStream xml;
+    xml << "<a>&lt;tag&gt; &quot;q&quot; &apos;s&apos; &amp;amp; &#65;&#x42;&#xe9;&#x1F600; &unknown; & alone\r\nline\rend"
+        "<![CDATA[<raw> &amp;]]></a>";
+
+    XmlReader reader(xml);
+    ASSERT_TRUE(reader.ReadRootElement());
+    ASSERT_EQ("<tag> \"q\" 's' &amp; AB\xC3\xA9\xF0\x9F\x98\x80 &unknown; & alone\nline\nend<raw> &amp;", reader.ReadElementText());
+    ASSERT_EQ(NodeType::EndElement, reader.GetNodeType());
+    ASSERT_EQ(NodeType::EndDocument, reader.Read());
+}
+
+TEST(XmlReaderTest, TestReadChildElementAndSkip)
+{
+    Aws::StringStream xml;
+    xml << "<Root>\n  <Name>bucket</Name>\n  <Ignored><Deep><Deeper>x</Deeper></Deep></Ignored>\n"
+        "  <Contents><Key>a</Key><Size>1</Size></Contents>\n  <Contents><Key>b</Key><Size>2</Size></Contents>\n"
+        "  <Empty/>\n</Root>";
+
+    XmlReader reader(xml);
+    ASSERT_TRUE(reader.ReadRootElement());
+    Aws::String name;
+    Aws::Vector<Aws::String> keys;
+    size_t children = 0;
+    const size_t depth = reader.GetDepth();
+    while (reader.ReadChildElement(depth))
+    {
+        ++children;
+        if (reader.GetName() == "Name")
+        {
+            name = reader.ReadElementText();
+        }
+        else if (reader.GetName() == "Contents")
+        {
+            const size_t contentsDepth = reader.GetDepth();
+            while (reader.ReadChildElement(contentsDepth))
+            {
+                if (reader.GetName() == "Key")
+                {
+                    keys.push_back(reader.ReadElementText());
+                }
+                else
+                {
+                    reader.SkipElement();
+                }
+            }
+        }
+        else
+        {
+            reader.SkipElement();
+        }
+    }
+
+    ASSERT_FALSE(reader.HasError());
+    ASSERT_EQ(5u, children);
+    ASSERT_EQ("bucket", name);
+    ASSERT_EQ(2u, keys.size());
+    ASSERT_EQ("a", keys[0]);
+    ASSERT_EQ("b", keys[1]);
+    ASSERT_EQ(NodeType::EndElement, reader.GetNodeType());
+    ASSERT_EQ("Root", reader.GetName());
+    ASSERT_EQ(NodeType::EndDocument, reader.Read());
+}
+
+TEST(XmlReaderTest, TestTokensSpanningReadChunks)
+{
+    // long names, attribute values and text force tokens across the reader's internal chunk boundaries.
+    const Aws::String longText(40000, 'x');
+    const Aws::String longName = "Element" + Aws::String(20000, 'n');
+    Aws::StringStream xml;
+    xml << "<Root attr=\"" << longText << "\">";
+    for (int i = 0; i < 2000; ++i)
+    {
+        xml << "<Key>key-" << i << "&amp;</Key>";
+    }
+    xml << "<" << longName << ">" << longText << "</" << longName << "><!--" << longText << "--></Root>";
+
+    XmlReader reader(xml);
+    ASSERT_TRUE(reader.ReadRootElement());
+    ASSERT_EQ(longText, reader.GetAttributeValue("attr"));
+    const size_t depth = reader.GetDepth();
+    int keys = 0;
+    while (reader.ReadChildElement(depth))
+    {
+        if (reader.GetName() == "Key")
+        {
+            ASSERT_EQ("key-" + Aws::Utils::StringUtils::to_string(keys++) + "&", reader.ReadElementText());
+        }
+        else
+        {
+            ASSERT_EQ(longName, reader.GetName());
+            ASSERT_EQ(longText, reader.ReadElementText());
+        }
+    }
+    ASSERT_FALSE(reader.HasError());
+    ASSERT_EQ(2000, keys);
+}
+
+TEST(XmlReaderTest, TestMalformedDocuments)
+{
+    const char* documents[] = {
+        "text",
+        "<a>",
+        "<a></b>",
+        "<a><b></a>",
+        "<a attr></a>",
+        "<a attr=unquoted></a>",
+        "<a attr=\"unterminated></a>",
+        "<a><!-- unterminated</a>",
+        "<a><![CDATA[unterminated</a>",
+        "<a/ >",
+        "<>",
+    };
+
+    for (const char* document : documents)
+    {
+        Aws::StringStream xml;
+        xml << document;
+        XmlReader reader(xml);
+        while (reader.Read() != NodeType::EndDocument && !reader.HasError())
+        {
+        }
+        ASSERT_TRUE(reader.HasError()) << document;
+        ASSERT_FALSE(reader.GetErrorMessage().empty());
+        ASSERT_EQ(NodeType::Error, reader.Read());
+        ASSERT_FALSE(reader.ReadRootElement());
+    }
+}
+
+TEST(XmlReaderTest, TestEmptyDocument)
+{
+    const char* documents[] = { "", "   \n", "<?xml version=\"1.0\"?>\n<!-- nothing -->\n" };
+
+    for (const char* document : documents)
+    {
+        Aws::StringStream xml;
+        xml << document;
+        XmlReader reader(xml);
+        ASSERT_FALSE(reader.ReadRootElement()) << document;
+        ASSERT_FALSE(reader.HasError());
+        ASSERT_EQ(NodeType::EndDocument, reader.GetNodeType());
+        ASSERT_EQ(NodeType::EndDocument, reader.Read());
+    }
+}
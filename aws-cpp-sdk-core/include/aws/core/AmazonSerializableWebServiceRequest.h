@@ -32,7 +32,7 @@ namespace Aws
     static const char AMZN_EVENTSTREAM_CONTENT_TYPE[]      = "application/vnd.amazon.eventstream";
 
     /**
-     * High-level abstraction over AWS requests. GetBody() calls SerializePayload() and uses a stringbuf under the hood.
+     * High-level abstraction over AWS requests. GetBody() calls SerializePayload() and hands the result to a read only stream without copying it.
      * This is for payloads such as query, xml, or json
      */
     class AWS_CORE_API AmazonSerializableWebServiceRequest : public AmazonWebServiceRequest
@@ -57,7 +57,8 @@ namespace Aws
         virtual Aws::String SerializePayload() const = 0;
 
         /**
-         * Loads serialized payload into string buf and returns the stream
+         * Serializes the payload and returns a stream over it. Every call serializes again, callers sending the same
+         * request more than once (e.g. retries) should hold on to the stream and rewind it.
          */
         std::shared_ptr<Aws::IOStream> GetBody() const override;
     };
@@ -32,6 +32,11 @@ namespace Aws
         class URI;
     } // namespace Http
 
+    namespace Client
+    {
+        class HedgingPolicy;
+    } // namespace Client
+
     class AmazonWebServiceRequest;
 
     /**
@@ -155,6 +160,14 @@ namespace Aws
          * get closure for notification that a request is being retried
          */
         inline virtual const RequestRetryHandler& GetRequestRetryHandler() const { return m_requestRetryHandler; }
+        /**
+         * Opts the request into hedging with policy; see HedgingPolicy. Null, the default, never hedges.
+         */
+        inline void SetHedgingPolicy(const std::shared_ptr<Aws::Client::HedgingPolicy>& policy) { m_hedgingPolicy = policy; }
+        /**
+         * Get the hedging policy of the request, if any.
+         */
+        inline const std::shared_ptr<Aws::Client::HedgingPolicy>& GetHedgingPolicy() const { return m_hedgingPolicy; }
         /**
          * If this is set to true, content-md5 needs to be computed and set on the request
          */
@@ -177,6 +190,7 @@ namespace Aws
         Aws::Http::ContinueRequestHandler m_continueRequest;
         RequestSignedHandler m_onRequestSigned;
         RequestRetryHandler m_requestRetryHandler;
+        std::shared_ptr<Aws::Client::HedgingPolicy> m_hedgingPolicy;
     };
 
 } // namespace Aws
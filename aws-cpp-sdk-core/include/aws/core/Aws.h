@@ -72,7 +72,7 @@ namespace Aws
      */
     struct HttpOptions
     {
-        HttpOptions() : initAndCleanupCurl(true), installSigPipeHandler(false)
+        HttpOptions() : initAndCleanupCurl(true), installSigPipeHandler(false), shareCurlCaches(false)
         { }
 
         /**
@@ -92,6 +92,13 @@ namespace Aws
          * NOTE: CURLOPT_NOSIGNAL is already being set.
          */
         bool installSigPipeHandler;
+        /**
+         * If CURL is being used, makes every CurlHttpClient in the process share one DNS cache and one TLS session cache through a
+         * libcurl share object, so a new service client resolves and fully handshakes with a host only if no other client has yet.
+         * Connections themselves are not shared, libcurl doesn't support sharing them between threads.
+         * All clients must be destroyed before calling ShutdownAPI.
+         */
+        bool shareCurlCaches;
     };
 
     /**
@@ -20,6 +20,7 @@
 #include <aws/core/Region.h>
 #include <aws/core/utils/memory/AWSMemory.h>
 #include <aws/core/utils/memory/stl/AWSSet.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 #include <aws/core/utils/DateTime.h>
 #include <aws/core/utils/Array.h>
 #include <aws/core/utils/threading/ReaderWriterLock.h>
@@ -81,6 +82,12 @@ namespace Aws
              */
             virtual bool SignRequest(Aws::Http::HttpRequest& request, bool signBody) const { AWS_UNREFERENCED_PARAM(signBody); return SignRequest(request); }
 
+            /**
+             * Whether SignRequest(request, signBody) computes a SHA256 of the request's payload. A caller that reads the
+             * payload anyway can hash it in the same pass and hand the result over with HttpRequest::SetContentBodySha256.
+             */
+            virtual bool SignsPayload(const Aws::Http::HttpRequest&, bool /* signBody */) const { return false; }
+
             /**
              * Signs a single event message in an event stream.
              * The input message buffer is copied and signed. The message's input buffer will be deallocated and a new
@@ -195,6 +202,11 @@ namespace Aws
             */
             bool SignRequest(Aws::Http::HttpRequest& request, bool signBody) const override;
 
+            /**
+            * True when the payload signing policy, signBody and the request's scheme call for a payload hash.
+            */
+            bool SignsPayload(const Aws::Http::HttpRequest& request, bool signBody) const override;
+
             /**
             * Takes a request and signs the URI based on the HttpMethod, URI and other info from the request.
             * the region the signer was initialized with will be used for the signature.
@@ -241,10 +253,17 @@ namespace Aws
             Aws::String GenerateStringToSign(const Aws::String& dateValue, const Aws::String& simpleDate,
                     const Aws::String& canonicalRequestHash, const Aws::String& region,
                     const Aws::String& serviceName) const;
-            Aws::Utils::ByteBuffer ComputeHash(const Aws::String& secretKey, const Aws::String& simpleDate) const;
             Aws::Utils::ByteBuffer ComputeHash(const Aws::String& secretKey,
                     const Aws::String& simpleDate, const Aws::String& region, const Aws::String& serviceName) const;
 
+            struct SigningKey;
+            typedef Aws::Vector<std::shared_ptr<const SigningKey>> SigningKeyList;
+
+            /**
+             * Returns the derived signing key for the scope, from the cache if it has been derived recently.
+             */
+            std::shared_ptr<const SigningKey> GetSigningKey(const Aws::String& secretKey,
+                    const Aws::String& simpleDate, const Aws::String& region, const Aws::String& serviceName) const;
 
             std::shared_ptr<Auth::AWSCredentialsProvider> m_credentialsProvider;
             const Aws::String m_serviceName;
@@ -254,13 +273,10 @@ namespace Aws
 
             Aws::Set<Aws::String> m_unsignedHeaders;
 
-            //these next four fields are ONLY for caching purposes and do not change
-            //the logical state of the signer. They are marked mutable so the
-            //interface can remain const.
-            mutable Aws::Utils::ByteBuffer m_partialSignature;
-            mutable Aws::String m_currentDateStr;
-            mutable Aws::String m_currentSecretKey;
-            mutable Utils::Threading::ReaderWriterLock m_partialSignatureLock;
+            //recently derived signing keys, most recent first. This is ONLY for caching purposes and does not change
+            //the logical state of the signer. The list is never modified once published; it is swapped out as a
+            //whole with the std::atomic_* shared_ptr functions, so readers never take a lock.
+            mutable std::shared_ptr<const SigningKeyList> m_signingKeys;
             PayloadSigningPolicy m_payloadSigningPolicy;
             bool m_urlEscapePath;
         };
@@ -17,13 +17,20 @@
 
 #include <aws/core/Core_EXPORTS.h>
 #include <aws/core/client/CoreErrors.h>
+#include <aws/core/client/AWSError.h>
 #include <aws/core/http/HttpTypes.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <aws/core/AmazonWebServiceResult.h>
 #include <aws/core/utils/crypto/Hash.h>
+#include <aws/core/utils/Outcome.h>
+#include <aws/core/utils/stream/ResponseStream.h>
+#include <aws/core/utils/xml/XmlReader.h>
 #include <aws/core/auth/AWSAuthSignerProvider.h>
 #include <memory>
 #include <atomic>
+#include <functional>
+#include <chrono>
+#include <mutex>
 
 struct aws_array_list;
 
@@ -53,6 +60,12 @@ namespace Aws
         {
             class MD5;
         } // namespace Crypto
+
+        namespace Threading
+        {
+            class TimerQueue;
+            class Executor;
+        } // namespace Threading
     } // namespace Utils
 
     namespace Http
@@ -88,6 +101,8 @@ namespace Aws
 
         typedef Utils::Outcome<std::shared_ptr<Aws::Http::HttpResponse>, AWSError<CoreErrors>> HttpResponseOutcome;
         typedef Utils::Outcome<AmazonWebServiceResult<Utils::Stream::ResponseStream>, AWSError<CoreErrors>> StreamOutcome;
+        typedef std::function<void(const HttpResponseOutcome&)> HttpResponseOutcomeHandler;
+        typedef std::function<void(const StreamOutcome&)> StreamOutcomeHandler;
 
         /**
          * Abstract AWS Client. Contains most of the functionality necessary to build an http request, get it signed, and send it accross the wire.
@@ -159,6 +174,12 @@ namespace Aws
              */
             void EnableRequestProcessing();
 
+            /**
+             * Opens up to connectionCount connections to the host of endpoint, e.g. a bucket's virtual-hosted S3 endpoint, before requests
+             * need them. Returns how many were opened; http clients that don't pool connections open none.
+             */
+            size_t WarmUpConnections(const Aws::Http::URI& endpoint, size_t connectionCount);
+
             inline virtual const char* GetServiceClientName() const { return nullptr; }
 
         protected:
@@ -183,6 +204,32 @@ namespace Aws
                     const char* signerName,
                     const char* requestName = "") const;
 
+            /**
+             * Asynchronous counterpart of AttemptExhaustively. The first attempt is signed on the calling thread and handed to the
+             * http client's MakeRequestAsync; retries are scheduled on a timer instead of sleeping, so no thread is held
+             * while a request is in flight or backing off. Retries, and attempts the retry strategy held back, are built and signed
+             * on executor, so that hashing and signing the payload holds up neither the http client's I/O thread nor the timer's;
+             * without an executor, or if it rejects them, they are built where the wait ended. handler is called exactly once with the
+             * final outcome, on the thread that completed the last attempt: usually the http client's I/O thread, or the thread that
+             * built the attempt if signing failed.
+             *
+             * With an http client that does not support non-blocking requests, each attempt runs synchronously on the thread
+             * that issues it. request is shared so that it stays alive until handler has been called. The client must outlive
+             * every outstanding call.
+             */
+            void AttemptExhaustivelyAsync(const Aws::Http::URI& uri,
+                    const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+                    Http::HttpMethod httpMethod,
+                    const char* signerName,
+                    const HttpResponseOutcomeHandler& handler,
+                    const std::shared_ptr<Aws::Utils::Threading::Executor>& executor = nullptr) const;
+
+            /**
+             * Returns true if the underlying http client completes MakeRequestAsync without blocking the calling thread,
+             * i.e. if AttemptExhaustivelyAsync is worth using over submitting AttemptExhaustively to an executor.
+             */
+            bool SupportsNonBlockingRequests() const;
+
             /**
              * Build an Http Request from the AmazonWebServiceRequest object. Signs the request, sends it accross the wire
              * then reports the http response.
@@ -223,6 +270,18 @@ namespace Aws
                     const char* signerName = Aws::Auth::SIGV4_SIGNER,
                     const char* requestName = "") const;
 
+            /**
+             * Asynchronous counterpart of MakeRequestWithUnparsedResponse built on AttemptExhaustivelyAsync. handler is called
+             * with the response stream, which it then owns, or the error; on executor, so that whatever it reads from the stream
+             * doesn't hold up the http client's I/O thread, or without an executor on the thread that completed the request. Retries are built and signed on executor too.
+             */
+            void MakeRequestWithUnparsedResponseAsync(const Aws::Http::URI& uri,
+                    const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+                    Http::HttpMethod method,
+                    const char* signerName,
+                    const std::shared_ptr<Aws::Utils::Threading::Executor>& executor,
+                    const StreamOutcomeHandler& handler) const;
+
             /**
              * Abstract.  Subclassing clients should override this to tell the client how to marshall error payloads
              */
@@ -264,11 +323,73 @@ namespace Aws
              */
             std::shared_ptr<Aws::Http::HttpResponse> MakeHttpRequest(std::shared_ptr<Aws::Http::HttpRequest>& request) const;
         private:
+            struct AsyncRequestContext;
+            struct HedgedAttempts;
+
             /**
              * Try to adjust signer's clock
              * return true if signer's clock is adjusted, false otherwise.
              */
             bool AdjustClockSkew(HttpResponseOutcome& outcome, const char* signerName) const;
+            /**
+             * Builds the http request from request, with body as its payload, and signs it. Returns false if signing failed.
+             * If previousAttempt carried the same body, its content-length, content-md5 and payload hash are reused instead of
+             * being computed again.
+             */
+            bool BuildAndSignAttempt(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest, const Aws::AmazonWebServiceRequest& request,
+                                     const std::shared_ptr<Aws::IOStream>& body, const std::shared_ptr<Aws::Http::HttpRequest>& previousAttempt,
+                                     const char* signerName) const;
+            HttpResponseOutcome AttemptOneRequest(const std::shared_ptr<Http::HttpRequest>& httpRequest, const Aws::AmazonWebServiceRequest& request,
+                                                  const std::shared_ptr<Aws::IOStream>& body, const std::shared_ptr<Aws::Http::HttpRequest>& previousAttempt,
+                                                  const char* signerName) const;
+            /**
+             * Like AttemptOneRequest, but sends a duplicate of the attempt if it is outstanding for longer than the hedge delay of the request's
+             * hedging policy. The first of the two to complete is used and the other is cancelled; httpRequest is set to the one used.
+             * Neither attempt is sent on the calling thread, which returns as soon as one of them has completed.
+             */
+            HttpResponseOutcome AttemptHedgedRequest(std::shared_ptr<Http::HttpRequest>& httpRequest, const Aws::Http::URI& uri, Http::HttpMethod method,
+                                                     const Aws::AmazonWebServiceRequest& request, const std::shared_ptr<Aws::IOStream>& body,
+                                                     const std::shared_ptr<Aws::Http::HttpRequest>& previousAttempt, const char* signerName) const;
+            /**
+             * Builds, signs and claims the slot of the duplicate attempt, unless it can't or shouldn't be sent; index is set to its slot.
+             */
+            std::shared_ptr<Aws::Http::HttpRequest> StartHedgeAttempt(const std::shared_ptr<HedgedAttempts>& attempts, const Aws::Http::URI& uri,
+                                                                      Http::HttpMethod method, const Aws::AmazonWebServiceRequest& request,
+                                                                      const std::shared_ptr<Aws::IOStream>& body, const char* signerName,
+                                                                      size_t& index) const;
+            void CancelAttemptOnceLost(const std::shared_ptr<HedgedAttempts>& attempts, size_t index,
+                                       const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest) const;
+            void SendHedgedAttempt(const std::shared_ptr<HedgedAttempts>& attempts, size_t index, const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest) const;
+            std::shared_ptr<Aws::Utils::Threading::Executor> GetHedgeExecutor() const;
+            void BuildHttpRequest(const Aws::AmazonWebServiceRequest& request, const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest,
+                                  const std::shared_ptr<Aws::IOStream>& body) const;
+            HttpResponseOutcome BuildAttemptOutcome(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest,
+                                                    const std::shared_ptr<Aws::Http::HttpResponse>& httpResponse) const;
+            /**
+             * Decides whether a failed attempt is retried and, if so, rewinds body and sets delay to how long to back off.
+             * May update the error inside outcome. If the request has a retry handler, body is fetched from the request again
+             * since the handler may have changed it.
+             */
+            bool PrepareRetry(HttpResponseOutcome& outcome, const Aws::AmazonWebServiceRequest& request, long retries,
+                              const char* signerName, std::shared_ptr<Aws::IOStream>& body, std::chrono::milliseconds& delay) const;
+            /**
+             * Sleeps for as long as the retry strategy wants the next attempt held back, or until request processing is disabled.
+             */
+            void WaitForSendToken() const;
+            /**
+             * Reports the outcome of an attempt to the retry strategy.
+             */
+            void RecordAttemptOutcome(const HttpResponseOutcome& outcome, long retries) const;
+            /**
+             * Sends the attempt of context once the retry strategy lets it go, scheduling it on the retry timer if it has to wait.
+             */
+            void AttemptOneRequestAsync(const std::shared_ptr<AsyncRequestContext>& context) const;
+            void SendAttemptAsync(const std::shared_ptr<AsyncRequestContext>& context) const;
+            /**
+             * Runs step, which builds and sends the next attempt of context, on the executor of context, or inline without one.
+             */
+            void ContinueAttemptAsync(const std::shared_ptr<AsyncRequestContext>& context, const std::function<void()>& step) const;
+            void OnAsyncAttemptCompleted(const std::shared_ptr<AsyncRequestContext>& context, HttpResponseOutcome& outcome) const;
             void AddHeadersToRequest(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest, const Http::HeaderValueCollection& headerValues) const;
             void AddContentBodyToRequest(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest, const std::shared_ptr<Aws::IOStream>& body,
                                          bool needsContentMd5 = false, bool isChunked = false) const;
@@ -286,9 +407,15 @@ namespace Aws
             Aws::String m_userAgent;
             std::shared_ptr<Aws::Utils::Crypto::Hash> m_hash;
             bool m_enableClockSkewAdjustment;
+            std::shared_ptr<Aws::Utils::Threading::TimerQueue> m_retryTimer;
+            size_t m_hedgePoolSize;
+            mutable std::mutex m_hedgeExecutorLock;
+            // sends the attempts of hedged requests on blocking http clients; declared last so that it waits for them before anything they use is destroyed
+            mutable std::shared_ptr<Aws::Utils::Threading::Executor> m_hedgeExecutor;
         };
 
         typedef Utils::Outcome<AmazonWebServiceResult<Utils::Json::JsonValue>, AWSError<CoreErrors>> JsonOutcome;
+        typedef std::function<void(const JsonOutcome&)> JsonOutcomeHandler;
         AWS_CORE_API Aws::String GetAuthorizationHeader(const Aws::Http::HttpRequest& httpRequest);
 
         /**
@@ -347,10 +474,26 @@ namespace Aws
                 const char* signerName = Aws::Auth::SIGV4_SIGNER,
                 const char* requestName = "") const;
 
+            /**
+             * Asynchronous counterpart of MakeRequest built on AttemptExhaustivelyAsync. Once the request completes, the response is
+             * parsed and handler is called with the Json document or the error, both on executor so that neither holds up the http
+             * client's I/O thread; without an executor, or if it won't take the task, on the thread that completed the request. Retries are built and signed on executor too.
+             */
+            void MakeRequestAsync(const Aws::Http::URI& uri,
+                const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+                Http::HttpMethod method,
+                const char* signerName,
+                const std::shared_ptr<Aws::Utils::Threading::Executor>& executor,
+                const JsonOutcomeHandler& handler) const;
+
             JsonOutcome MakeEventStreamRequest(std::shared_ptr<Aws::Http::HttpRequest>& request) const;
+
+        private:
+            static JsonOutcome ParseJsonOutcome(const HttpResponseOutcome& httpOutcome);
         };
 
         typedef Utils::Outcome<AmazonWebServiceResult<Utils::Xml::XmlDocument>, AWSError<CoreErrors>> XmlOutcome;
+        typedef std::function<void(const XmlOutcome&)> XmlOutcomeHandler;
 
         /**
         *  AWSClient that handles marshalling xml response bodies. You would inherit from this class
@@ -404,6 +547,18 @@ namespace Aws
                 const char* signerName = Aws::Auth::SIGV4_SIGNER,
                 const char* requestName = "") const;
 
+            /**
+             * Asynchronous counterpart of MakeRequest built on AttemptExhaustivelyAsync. Once the request completes, the response is
+             * parsed and handler is called with the xml document or the error, both on executor so that neither holds up the http
+             * client's I/O thread; without an executor, or if it won't take the task, on the thread that completed the request. Retries are built and signed on executor too.
+             */
+            void MakeRequestAsync(const Aws::Http::URI& uri,
+                const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+                Http::HttpMethod method,
+                const char* signerName,
+                const std::shared_ptr<Aws::Utils::Threading::Executor>& executor,
+                const XmlOutcomeHandler& handler) const;
+
             /**
             * This is used for event stream response.
             */
@@ -421,6 +576,32 @@ namespace Aws
                 Http::HttpMethod method = Http::HttpMethod::HTTP_POST,
                 const char* signerName = Aws::Auth::SIGV4_SIGNER,
                 const char* requestName = "") const;
+
+            /**
+             * Deserializes RESULT_TYPE straight from the response stream of outcome with an XmlReader, without building
+             * a document first. RESULT_TYPE must be constructible from the result and a reader positioned before the root element.
+             */
+            template<typename OUTCOME_TYPE, typename RESULT_TYPE>
+            static OUTCOME_TYPE ReadXmlResult(const StreamOutcome& outcome)
+            {
+                if (!outcome.IsSuccess())
+                {
+                    return OUTCOME_TYPE(outcome.GetError());
+                }
+
+                Utils::Xml::XmlReader reader(outcome.GetResult().GetPayload().GetUnderlyingStream());
+                RESULT_TYPE result(outcome.GetResult(), reader);
+                if (reader.HasError())
+                {
+                    return OUTCOME_TYPE(BuildXmlParseError(reader));
+                }
+
+                return OUTCOME_TYPE(std::move(result));
+            }
+
+        private:
+            static XmlOutcome ParseXmlOutcome(const HttpResponseOutcome& httpOutcome);
+            static AWSError<CoreErrors> BuildXmlParseError(const Utils::Xml::XmlReader& reader);
         };
 
     } // namespace Client
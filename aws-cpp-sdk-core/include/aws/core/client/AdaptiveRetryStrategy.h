@@ -0,0 +1,160 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/client/RetryStrategy.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <random>
+
+namespace Aws
+{
+namespace Client
+{
+
+/**
+ * Retry budget shared by all the requests of a client. Every retry takes tokens out of the bucket and no retry is made once it runs dry,
+ * so a client facing a failing service stops multiplying its load. A retry that succeeds puts its tokens back, and so does, one token at
+ * a time, every request that succeeds on its first attempt.
+ */
+class AWS_CORE_API RetryTokenBucket
+{
+public:
+    RetryTokenBucket(long capacity);
+
+    /**
+     * Takes tokens out of the bucket. Returns false, and takes nothing, if fewer than that are left.
+     */
+    bool TryAcquire(long tokens);
+
+    /**
+     * Puts tokens back in the bucket, up to its capacity.
+     */
+    void Release(long tokens);
+
+    long GetAvailableTokens() const { return m_available.load(); }
+
+private:
+    const long m_capacity;
+    std::atomic<long> m_available;
+};
+
+/**
+ * Client side limit on the rate attempts are sent at. Attempts go out unpaced until the first throttling error; from then on they are paced by
+ * a token bucket. Each throttling error cuts its fill rate to a fraction of the rate the client was measured sending at, and while attempts
+ * get through the rate grows back along a cubic curve, the way CUBIC grows a congestion window: fast at first, flat around the rate that was
+ * throttled, then probing beyond it.
+ */
+class AWS_CORE_API SendRateLimiter
+{
+public:
+    using ClockFunctionType = std::function<std::chrono::steady_clock::time_point()>;
+
+    SendRateLimiter(ClockFunctionType clock = std::chrono::steady_clock::now);
+
+    /**
+     * Takes the token for one attempt and returns 0, or, if there is none yet, returns the time in milliseconds until there should be one.
+     * The caller then has to wait that long and ask again.
+     */
+    long AcquireToken();
+
+    /**
+     * Feeds the outcome of an attempt into the measured send rate and the fill rate.
+     */
+    void UpdateSendRate(bool throttled);
+
+    bool IsEnabled() const;
+
+    /**
+     * Attempts per second the bucket is filled at, meaningful once enabled.
+     */
+    double GetFillRate() const;
+
+    /**
+     * Smoothed attempts per second the client was measured sending at.
+     */
+    double GetMeasuredSendRate() const;
+
+private:
+    double Now() const;
+    void Refill(double now);
+    void UpdateMeasuredRate(double now);
+
+    ClockFunctionType m_clock;
+    const std::chrono::steady_clock::time_point m_start;
+    bool m_enabled;
+    double m_fillRate;
+    double m_maxCapacity;
+    double m_capacity;
+    double m_lastRefill;
+    double m_measuredSendRate;
+    double m_lastRateBucket;
+    long m_requestsInBucket;
+    double m_lastMaxRate;
+    double m_lastThrottle;
+    double m_timeWindow;
+    mutable std::mutex m_lock;
+};
+
+/**
+ * Retry strategy for clients that share a throttled service with others. On top of capped exponential backoff with full jitter, so that
+ * clients that failed together don't retry together, it keeps a RetryTokenBucket that bounds how many retries the client makes overall and
+ * a SendRateLimiter that slows every attempt down, first attempts included, when the service starts throttling. A single instance holds the
+ * state for the client it is configured on, so don't share one instance across unrelated clients.
+ */
+class AWS_CORE_API AdaptiveRetryStrategy : public RetryStrategy
+{
+public:
+
+    AdaptiveRetryStrategy(long maxRetries = 3, long scaleFactor = 25, long maxBackoffMs = 20000, long retryTokens = 500);
+
+    bool ShouldRetry(const AWSError<CoreErrors>& error, long attemptedRetries) const override;
+
+    long CalculateDelayBeforeNextRetry(const AWSError<CoreErrors>& error, long attemptedRetries) const override;
+
+    long AcquireSendToken() override;
+
+    void OnAttemptSucceeded(long attemptedRetries) override;
+
+    void OnAttemptFailed(const AWSError<CoreErrors>& error, long attemptedRetries) override;
+
+    const RetryTokenBucket& GetRetryTokenBucket() const { return m_retryTokens; }
+
+    const SendRateLimiter& GetSendRateLimiter() const { return m_sendRateLimiter; }
+
+    /**
+     * Returns true if error means the service is throttling the client.
+     */
+    static bool IsThrottlingError(const AWSError<CoreErrors>& error);
+
+protected:
+    long m_scaleFactor;
+    long m_maxRetries;
+    long m_maxBackoff;
+
+private:
+    mutable RetryTokenBucket m_retryTokens;
+    SendRateLimiter m_sendRateLimiter;
+    mutable std::mutex m_randomLock;
+    mutable std::default_random_engine m_random;
+};
+
+} // namespace Client
+} // namespace Aws
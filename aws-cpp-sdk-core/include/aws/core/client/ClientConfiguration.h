@@ -75,6 +75,16 @@ namespace Aws
              * Max concurrent tcp connections for a single http client to use. Default 25.
              */
             unsigned maxConnections;
+            /**
+             * Max of those maxConnections connections for a single http client to use to any one host. Default 0, no limit beyond maxConnections.
+             * Only for CURL client currently.
+             */
+            unsigned maxConnectionsPerHost;
+            /**
+             * Connections left unused for longer than this are closed. Default 0, connections are kept open until the client is destroyed
+             * or need to make room for connections to other hosts. Only for CURL client currently.
+             */
+            unsigned long idleConnectionTimeoutMs;
             /**
              * This is currently only applicable for Curl to set the http request level timeout, including possible dns lookup time, connection establish time, ssl handshake time and actual data transmission time.
              * the corresponding Curl option is CURLOPT_TIMEOUT_MS
@@ -111,6 +121,7 @@ namespace Aws
             unsigned long lowSpeedLimit;
             /**
              * Strategy to use in case of failed requests. Default is DefaultRetryStrategy (e.g. exponential backoff)
+             * Clients of services that throttle can use AdaptiveRetryStrategy, which also bounds retries and slows the client down while throttled.
              */
             std::shared_ptr<RetryStrategy> retryStrategy;
             /**
@@ -163,7 +174,8 @@ namespace Aws
             */
             Aws::String proxySSLKeyPassword;
             /**
-            * Threading Executor implementation. Default uses std::thread::detach()
+            * Threading Executor implementation. Default uses std::thread::detach(). To keep clients sharing a thread pool from starving each
+            * other, give each one a queue of a shared FairQueueingExecutor, see FairQueueingExecutor::CreateQueue.
             */
             std::shared_ptr<Aws::Utils::Threading::Executor> executor;
             /**
@@ -184,7 +196,8 @@ namespace Aws
              */
              Aws::String caFile;
             /**
-             * Rate Limiter implementation for outgoing bandwidth. Default is wide-open.
+             * Rate Limiter implementation for outgoing bandwidth. Default is wide-open. Prefer AtomicRateLimiter over DefaultRateLimiter when
+             * the limiter is shared by many concurrent transfers.
              */
             std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> writeRateLimiter;
             /**
@@ -195,6 +208,11 @@ namespace Aws
              * Override the http implementation the default factory returns.
              */
             Aws::Http::TransferLibType httpLibOverride;
+            /**
+             * Number of I/O threads driving requests when httpLibOverride is CURL_MULTI_CLIENT. Each thread runs its own curl multi
+             * event loop and can keep many requests in flight at once. Default 1.
+             */
+            unsigned httpIoThreadCount;
             /**
              * If set to true the http stack will follow 300 redirect codes.
              */
@@ -211,6 +229,15 @@ namespace Aws
              */
             bool disableExpectHeader;
 
+            /**
+             * Only works for Curl http client.
+             * By default a curl handle is reset with curl_easy_reset and given the client's default options again every time a request
+             * is done with it. Set this option to true to skip that and only override the options each request sets, which saves a
+             * little work per request. Connections and TLS sessions are reused either way.
+             * The default value will be false.
+             */
+            bool disableCurlHandleReset;
+
             /**
              * If set to true clock skew will be adjusted after each http attempt, default to true.
              */
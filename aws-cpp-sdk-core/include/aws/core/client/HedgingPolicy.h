@@ -0,0 +1,84 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Client
+    {
+        /**
+         * Opt-in hedging for an operation. Set the same policy on every request of the operation with AmazonWebServiceRequest::SetHedgingPolicy;
+         * once an attempt of one of them has been outstanding for longer than the given percentile of the latencies recently seen for the operation,
+         * a duplicate attempt is sent on another connection, the first of the two to complete is used and the other is cancelled.
+         *
+         * Only set it on idempotent operations, since both attempts may reach the service. Requests whose body is a stream the caller owns, such as
+         * uploads, are never hedged because both attempts would read it, and each attempt gets its own response stream from the request's response
+         * stream factory, so the factory mustn't hand out streams that write to the same place. Hedging applies to requests made through the
+         * blocking operation calls.
+         */
+        class AWS_CORE_API HedgingPolicy
+        {
+        public:
+            /**
+             * percentile is the latency percentile, between 0 and 100, after which an attempt is hedged. Until minSamples latencies have been
+             * recorded attempts are hedged after initialDelay. The percentile is taken over the last sampleWindow latencies.
+             */
+            HedgingPolicy(double percentile = 95.0, std::chrono::milliseconds initialDelay = std::chrono::milliseconds(100),
+                          size_t sampleWindow = 1024, size_t minSamples = 32);
+
+            /**
+             * How long an attempt may be outstanding before it is hedged.
+             */
+            std::chrono::microseconds GetHedgeDelay() const;
+
+            /**
+             * Records how long a completed attempt took.
+             */
+            void RecordLatency(std::chrono::steady_clock::duration latency);
+
+            /**
+             * Records that a hedge was sent, and whether it completed before the attempt it duplicated.
+             */
+            void RecordHedge(bool won);
+
+            size_t GetHedgesSent() const { return m_hedgesSent.load(); }
+
+            size_t GetHedgesWon() const { return m_hedgesWon.load(); }
+
+        private:
+            const double m_percentile;
+            const std::chrono::microseconds m_initialDelay;
+            const size_t m_sampleWindow;
+            const size_t m_minSamples;
+            mutable std::mutex m_lock;
+            Aws::Vector<int64_t> m_samples;
+            size_t m_nextSample;
+            mutable size_t m_samplesSinceUpdate;
+            mutable std::chrono::microseconds m_hedgeDelay;
+            mutable Aws::Vector<int64_t> m_scratch;
+            std::atomic<size_t> m_hedgesSent;
+            std::atomic<size_t> m_hedgesWon;
+        };
+
+    } // namespace Client
+} // namespace Aws
@@ -43,6 +43,21 @@ namespace Aws
              */
             virtual long CalculateDelayBeforeNextRetry(const AWSError<CoreErrors>& error, long attemptedRetries) const = 0;
 
+            /**
+             * Called before every attempt of a request, the first one included. Returns 0 if the attempt may be sent now, otherwise the time in milliseconds
+             * the client should wait before calling it again. Strategies that don't pace the client never hold an attempt back.
+             */
+            virtual long AcquireSendToken() { return 0; }
+
+            /**
+             * Called once an attempt got a successful response, attemptedRetries being the number of retries that preceded it.
+             */
+            virtual void OnAttemptSucceeded(long /*attemptedRetries*/) {}
+
+            /**
+             * Called once an attempt failed, before ShouldRetry is asked whether to retry it.
+             */
+            virtual void OnAttemptFailed(const AWSError<CoreErrors>& /*error*/, long /*attemptedRetries*/) {}
         };
 
     } // namespace Client
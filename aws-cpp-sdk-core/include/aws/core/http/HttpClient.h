@@ -19,6 +19,7 @@
 #include <aws/core/utils/UnreferencedParam.h>
 
 #include <memory>
+#include <functional>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
@@ -37,6 +38,12 @@ namespace Aws
     {
         class HttpRequest;
         class HttpResponse;
+        class URI;
+
+        /**
+         * Invoked once an asynchronously issued http request has completed. The response is nullptr if the request could not be made.
+         */
+        typedef std::function<void(const std::shared_ptr<HttpRequest>&, const std::shared_ptr<HttpResponse>&)> HttpRequestCompletedHandler;
 
         /**
           * Abstract HttpClient. All it does is make HttpRequests and return their response.
@@ -69,6 +76,35 @@ namespace Aws
                 return nullptr;
             }
 
+            /**
+             * Takes an http request, makes it, and passes the newly allocated HttpResponse to handler once the request completes.
+             * Default implementation makes the request synchronously on the calling thread and then invokes handler.
+             * Clients that drive requests from their own I/O threads return immediately and invoke handler from one of those threads,
+             * so handler should hand off any expensive work rather than do it inline.
+             */
+            virtual void MakeRequestAsync(const std::shared_ptr<HttpRequest>& request,
+                const HttpRequestCompletedHandler& handler,
+                Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+                Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const;
+
+            /**
+             * If yes, MakeRequestAsync returns without tying up the calling thread for the duration of the request.
+             */
+            virtual bool SupportsNonBlockingRequests() const { return false; }
+
+            /**
+             * Opens up to connectionCount connections to the host of endpoint ahead of the requests that will use them, so that those
+             * requests skip the TCP and TLS handshakes, and returns how many were opened. Each connection is opened with an unsigned
+             * HEAD request to endpoint, whose response is discarded; connections that were already open to the host aren't counted.
+             * The default implementation opens none.
+             */
+            virtual size_t WarmUpConnections(const URI& endpoint, size_t connectionCount) const
+            {
+                AWS_UNREFERENCED_PARAM(endpoint);
+                AWS_UNREFERENCED_PARAM(connectionCount);
+                return 0;
+            }
+
             /**
              * If yes, the http client supports transfer-encoding:chunked.
              */
@@ -63,6 +63,10 @@ namespace Aws
          */
         AWS_CORE_API void SetInitCleanupCurlFlag(bool initCleanupFlag);
         AWS_CORE_API void SetInstallSigPipeHandlerFlag(bool installHandler);
+        /**
+         * If CURL is being used, shares DNS and TLS session caches across all CurlHttpClients created after InitHttp().
+         */
+        AWS_CORE_API void SetShareCurlCachesFlag(bool shareCaches);
         AWS_CORE_API void InitHttp();
         AWS_CORE_API void CleanupHttp();
         AWS_CORE_API void SetHttpClientFactory(const std::shared_ptr<HttpClientFactory>& factory);
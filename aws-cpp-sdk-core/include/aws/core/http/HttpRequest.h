@@ -68,6 +68,10 @@ namespace Aws
          * Closure type for handling whether or not a request should be canceled.
          */
         typedef std::function<bool(const HttpRequest*)> ContinueRequestHandler;
+        /**
+         * Called with the name and value of a header.
+         */
+        typedef std::function<void(const Aws::String&, const Aws::String&)> HeaderVisitor;
 
         /**
           * Abstract class for representing an HttpRequest.
@@ -88,6 +92,17 @@ namespace Aws
              * Get All headers for this request.
              */
             virtual HeaderValueCollection GetHeaders() const = 0;
+            /**
+             * Calls visitor with every header, ordered by name. Implementations should override this to visit their headers
+             * in place; the default visits a copy from GetHeaders.
+             */
+            virtual void VisitHeaders(const HeaderVisitor& visitor) const
+            {
+                for (const auto& header : GetHeaders())
+                {
+                    visitor(header.first, header.second);
+                }
+            }
             /**
              * Get the value for a Header based on its name. (in default StandardHttpRequest implementation, an empty string will be returned if headerName dosen't exist)
              */
@@ -507,6 +522,16 @@ namespace Aws
             */
             inline void SetSigningRegion(const Aws::String& region) { m_signingRegion = region; }
 
+            /**
+             * Gets the hex encoded sha256 of the content body, empty if it hasn't been computed yet.
+             */
+            inline const Aws::String& GetContentBodySha256() const { return m_contentBodySha256; }
+            /**
+             * Sets the hex encoded sha256 of the content body. The signer fills this in when it hashes the body, and uses
+             * it instead of hashing again if it is already set, e.g. when a retry reuses the body of a previous attempt.
+             */
+            inline void SetContentBodySha256(const Aws::String& sha256) { m_contentBodySha256 = sha256; }
+
             /**
              * Add a request metric
              * @param key, HttpClientMetricsKey defined in HttpClientMetrics.cpp
@@ -541,6 +566,7 @@ namespace Aws
             ContinueRequestHandler m_continueRequest;
             Aws::String m_signingRegion;
             Aws::String m_signingAccessKey;
+            Aws::String m_contentBodySha256;
             Aws::String m_resolvedRemoteHost;
             HttpClientMetricsCollection m_httpRequestMetrics;
         };
@@ -16,8 +16,13 @@
 #pragma once
 
 #include <aws/core/utils/ResourceManager.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/threading/ReaderWriterLock.h>
 
 #include <utility>
+#include <memory>
+#include <chrono>
 #include <curl/curl.h>
 
 namespace Aws
@@ -28,8 +33,14 @@ namespace Http
 /**
   * Simple Connection pool manager for Curl. It maintains connections in a thread safe manner. You
   * can call into acquire a handle, then put it back when finished. It is assumed that reusing an already
-  * initialized handle is preferable (especially for synchronous clients). The pool doubles in capacity as
-  * needed up to the maximum amount of connections.
+  * initialized handle is preferable (especially for synchronous clients), so the handle released last is
+  * the next one handed out.
+  *
+  * A curl handle keeps the connections it has opened, so handles are pooled per host: a handle is handed
+  * back out for the host it was last used with, where its connection and TLS session can be reused. New
+  * handles are created as needed up to the maximum amount of connections overall and, if set, per host.
+  * At the overall maximum, an idle handle of the host with the most idle handles is closed to make room.
+  * If an idle timeout is set, handles left idle for longer than it are closed.
   */
 class CurlHandleContainer
 {
@@ -37,20 +48,31 @@ public:
     /**
       * Initializes an empty stack of CURL handles. If you are only making synchronous calls via your http client
       * then a small size is best. For async support, a good value would be 6 * number of Processors.   *
+      * maxSizePerHost of 0 lets a single host use all maxSize handles; idleTimeoutMs of 0 never closes idle handles.
+      * If share is set, every handle is attached to it; it must outlive the container.
       */
     CurlHandleContainer(unsigned maxSize = 50, long httpRequestTimeout = 0, long connectTimeout = 1000, bool tcpKeepAlive = true, 
-                        unsigned long tcpKeepAliveIntervalMs = 30000, long lowSpeedTime = 3000, unsigned long lowSpeedLimit = 1);
+                        unsigned long tcpKeepAliveIntervalMs = 30000, long lowSpeedTime = 3000, unsigned long lowSpeedLimit = 1,
+                        bool resetHandlesOnRelease = true, unsigned maxSizePerHost = 0, unsigned long idleTimeoutMs = 0,
+                        CURLSH* share = nullptr);
     ~CurlHandleContainer();
 
     /**
       * Blocks until a curl handle from the pool is available for use.
       */
-    CURL* AcquireCurlHandle();
+    CURL* AcquireCurlHandle(const Aws::String& host = "");
+    /**
+      * Returns a curl handle from the pool if one is available or the pool can still grow, otherwise returns nullptr
+      * without waiting. Handles obtained this way must be released with ReleaseCurlHandle() as well.
+      */
+    CURL* TryAcquireCurlHandle(const Aws::String& host = "");
     /**
       * Returns a handle to the pool for reuse. It is imperative that this is called
-      * after you are finished with the handle.
+      * after you are finished with the handle, with the host it was acquired for. Unless the container was created
+      * with resetHandlesOnRelease set to false, the handle's options are reset to the container's defaults; otherwise
+      * the handle keeps the options of the request it just made, and the next user has to override all of them it relies on.
       */
-    void ReleaseCurlHandle(CURL* handle);
+    void ReleaseCurlHandle(CURL* handle, const Aws::String& host = "");
 
 private:
     CurlHandleContainer(const CurlHandleContainer&) = delete;
@@ -58,21 +80,50 @@ private:
     CurlHandleContainer(const CurlHandleContainer&&) = delete;
     const CurlHandleContainer& operator = (const CurlHandleContainer&&) = delete;
 
-    bool CheckAndGrowPool();
+    struct IdleHandle
+    {
+        CURL* handle;
+        std::chrono::steady_clock::time_point releasedAt;
+    };
+
+    struct HostPool
+    {
+        HostPool(size_t capacity) : idleHandles(capacity), size(0), idleCount(0) {}
+
+        Aws::Utils::LockFreeOwnershipResourceManager<IdleHandle> idleHandles;
+        // handles belonging to the host, idle or not; only changed under m_containerLock.
+        unsigned size;
+        std::atomic<unsigned> idleCount;
+    };
+
+    CURL* AcquireCurlHandle(const Aws::String& host, bool wait);
+    bool TryAcquireIdleHandle(HostPool& pool, CURL*& handle);
+    std::shared_ptr<HostPool> FindHostPool(const Aws::String& host);
+    std::shared_ptr<HostPool> GetOrCreateHostPool(const Aws::String& host);
+    CURL* CreateHandle(HostPool& pool);
+    bool CloseIdleHandleOfAnotherHost(const HostPool& pool);
+    void CloseExpiredIdleHandles();
     void SetDefaultOptionsOnHandle(CURL* handle);
 
-    Aws::Utils::ExclusiveOwnershipResourceManager<CURL*> m_handleContainer;
+    Aws::Map<Aws::String, std::shared_ptr<HostPool>> m_hostPools;
+    Aws::Utils::Threading::ReaderWriterLock m_hostPoolsLock;
     unsigned m_maxPoolSize;
+    unsigned m_maxPoolSizePerHost;
     unsigned long m_httpRequestTimeout;
     unsigned long m_connectTimeout;
     bool m_enableTcpKeepAlive;
     unsigned long m_tcpKeepAliveIntervalMs;
     unsigned long m_lowSpeedTime;
     unsigned long m_lowSpeedLimit;
+    bool m_resetHandlesOnRelease;
+    CURLSH* m_share;
+    std::chrono::milliseconds m_idleTimeout;
+    std::atomic<int64_t> m_nextIdleCheck;
     unsigned m_poolSize;
+    std::atomic<size_t> m_waiters;
     std::mutex m_containerLock;
+    std::condition_variable m_handleReleased;
 };
 
 } // namespace Http
 } // namespace Aws
-
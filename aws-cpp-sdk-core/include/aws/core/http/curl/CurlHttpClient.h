@@ -21,6 +21,7 @@
 #include <aws/core/http/curl/CurlHandleContainer.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/DateTime.h>
 #include <atomic>
 
 namespace Aws
@@ -32,6 +33,47 @@ namespace Standard
     class StandardHttpResponse;
 }
 
+class CurlHttpClient;
+
+/**
+ * State handed to curl's write and header callbacks for the lifetime of a transfer.
+ */
+struct CurlWriteCallbackContext
+{
+    CurlWriteCallbackContext(const CurlHttpClient* client,
+                             HttpRequest* request,
+                             HttpResponse* response,
+                             Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter) :
+        m_client(client),
+        m_request(request),
+        m_response(response),
+        m_rateLimiter(rateLimiter),
+        m_numBytesResponseReceived(0)
+    {}
+
+    const CurlHttpClient* m_client;
+    HttpRequest* m_request;
+    HttpResponse* m_response;
+    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
+    int64_t m_numBytesResponseReceived;
+};
+
+/**
+ * State handed to curl's read and seek callbacks for the lifetime of a transfer.
+ */
+struct CurlReadCallbackContext
+{
+    CurlReadCallbackContext(const CurlHttpClient* client, HttpRequest* request, Aws::Utils::RateLimits::RateLimiterInterface* limiter) :
+        m_client(client),
+        m_rateLimiter(limiter),
+        m_request(request)
+    {}
+
+    const CurlHttpClient* m_client;
+    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
+    HttpRequest* m_request;
+};
+
 //Curl implementation of an http client. Right now it is only synchronous.
 class AWS_CORE_API CurlHttpClient: public HttpClient
 {
@@ -50,11 +92,80 @@ public:
     std::shared_ptr<HttpResponse> MakeRequest(const std::shared_ptr<HttpRequest>& request, Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
             Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override;
 
+    /**
+     * Acquires up to connectionCount handles for the endpoint's host from the pool and opens a connection on each, one after another
+     * on the calling thread. Handles already connected to the host keep their connection and aren't counted.
+     */
+    size_t WarmUpConnections(const URI& endpoint, size_t connectionCount) const override;
+
     static void InitGlobalState();
     static void CleanupGlobalState();
 
-private:
+    /**
+     * Creates the process wide libcurl share object holding the DNS and TLS session caches of every CurlHttpClient created
+     * until CleanupSharedCaches() is called. Clients created before this keep their own caches.
+     */
+    static void InitSharedCaches();
+    /**
+     * Releases the shared caches. All clients using them must have been destroyed.
+     */
+    static void CleanupSharedCaches();
+
+protected:
+    /**
+     * Builds the curl header list for request. Caller owns the returned list and must free it with curl_slist_free_all
+     * once the transfer using it has finished.
+     */
+    struct curl_slist* BuildHeaderList(const HttpRequest& request) const;
+
+    /**
+     * Applies the url, method, headers, callbacks and client level settings for request onto connectionHandle.
+     * The contexts must outlive the transfer.
+     */
+    void ConfigureConnectionHandle(CURL* connectionHandle, HttpRequest& request, HttpResponse* response, struct curl_slist* headers,
+        CurlWriteCallbackContext& writeContext, CurlReadCallbackContext& readContext) const;
+
+    /**
+     * Fills in response (or resets it to nullptr on failure) and records request metrics once the transfer on connectionHandle is done.
+     * The handle is not released here.
+     */
+    void OnTransferComplete(CURL* connectionHandle, CURLcode curlResponseCode, HttpRequest& request,
+        std::shared_ptr<Standard::StandardHttpResponse>& response, const CurlWriteCallbackContext& writeContext,
+        const Aws::Utils::DateTime& startTransmissionTime) const;
+
+    /**
+     * Records whether connectionHandle's last transfer reused a connection and, if it didn't, how long connecting took. Nothing is
+     * recorded for a transfer that failed or never got a connection. dnsTime is the transfer's name lookup time in seconds.
+     */
+    static void RecordConnectionMetrics(CURL* connectionHandle, CURLcode curlResponseCode, HttpRequest& request, double dnsTime);
+
+    /**
+     * Creates the unsigned HEAD request that WarmUpConnections opens a connection with.
+     */
+    static std::shared_ptr<HttpRequest> CreateWarmUpRequest(const URI& endpoint);
+
+    /**
+     * Whether the completed request went out on a connection opened for it, going by the metrics RecordConnectionMetrics left on it.
+     */
+    static bool OpenedNewConnection(const HttpRequest& request);
+
+    /**
+     * Makes request on connectionHandle with curl_easy_perform, blocking the calling thread until it completes.
+     */
+    CURLcode MakeRequestOnHandle(CURL* connectionHandle, HttpRequest& request, std::shared_ptr<Standard::StandardHttpResponse>& response,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const;
+
+    /**
+     * Makes request on a pooled handle with curl_easy_perform, blocking the calling thread until it completes.
+     */
+    void MakeRequestInternal(HttpRequest& request, std::shared_ptr<Standard::StandardHttpResponse>& response,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const;
+
     mutable CurlHandleContainer m_curlHandleContainer;
+
+private:
     bool m_isUsingProxy;
     Aws::String m_proxyUserName;
     Aws::String m_proxyPassword;
@@ -70,13 +181,10 @@ private:
     Aws::String m_caPath;
     Aws::String m_caFile;
     bool m_disableExpectHeader;
+    bool m_disableCurlHandleReset;
     bool m_allowRedirects;
     static std::atomic<bool> isInit;
-
-    void MakeRequestInternal(HttpRequest& request, std::shared_ptr<Standard::StandardHttpResponse>& response,
-        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter, 
-        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const;
-
+    static CURLSH* sharedCaches;
 
 };
 
@@ -0,0 +1,83 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/http/curl/CurlHttpClient.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <atomic>
+
+namespace Aws
+{
+namespace Http
+{
+
+/**
+ * Curl implementation of an http client that drives requests through curl_multi event loops instead of curl_easy_perform.
+ * Requests issued with MakeRequestAsync are handed to one of a small, fixed number of I/O threads and complete via callback,
+ * so no thread is tied up for the duration of a request. Synchronous MakeRequest calls are routed through the same event loops.
+ *
+ * Connection handles come from the same CurlHandleContainer (sized by maxConnections) used by CurlHttpClient. Requests submitted
+ * while every handle is in use are queued on the event loop until a handle is released.
+ *
+ * Completion handlers run on an I/O thread: keep them short and never destroy this client from inside one.
+ * Rate limiters passed in are applied on the I/O thread as well, and will stall every request on that loop while they wait.
+ */
+class AWS_CORE_API CurlMultiHttpClient: public CurlHttpClient
+{
+public:
+
+    using Base = CurlHttpClient;
+
+    //Creates client and starts clientConfig.httpIoThreadCount event loops.
+    CurlMultiHttpClient(const Aws::Client::ClientConfiguration& clientConfig);
+    //Stops the event loops. Requests still in flight complete with a null response.
+    ~CurlMultiHttpClient();
+
+    //Makes request and receives response synchronously on the calling thread, bypassing the event loops.
+    AWS_DEPRECATED("This funciton in base class has been deprecated")
+    std::shared_ptr<HttpResponse> MakeRequest(HttpRequest& request, Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+            Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override;
+
+    //Submits request to an event loop and blocks until it completes
+    std::shared_ptr<HttpResponse> MakeRequest(const std::shared_ptr<HttpRequest>& request, Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+            Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override;
+
+    //Submits request to an event loop and returns immediately, handler is invoked on the I/O thread when the request completes
+    void MakeRequestAsync(const std::shared_ptr<HttpRequest>& request, const HttpRequestCompletedHandler& handler,
+            Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+            Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override;
+
+    bool SupportsNonBlockingRequests() const override { return true; }
+
+    //Starts connectionCount warm up requests together on one event loop, so the connections open in parallel, and blocks until they complete
+    size_t WarmUpConnections(const URI& endpoint, size_t connectionCount) const override;
+
+private:
+    class EventLoop;
+    struct Transfer;
+
+    //Wakes up every event loop that has requests waiting for a connection handle.
+    void NotifyHandleReleased() const;
+
+    Aws::Vector<Aws::UniquePtr<EventLoop>> m_eventLoops;
+    mutable std::atomic<size_t> m_nextEventLoop;
+};
+
+} // namespace Http
+} // namespace Aws
+
@@ -42,6 +42,10 @@ namespace Aws
                  * Get All headers for this request.
                  */
                 virtual HeaderValueCollection GetHeaders() const override;
+                /**
+                 * Calls visitor with every header, ordered by name, without copying them.
+                 */
+                virtual void VisitHeaders(const HeaderVisitor& visitor) const override;
                 /**
                  * Get the value for a Header based on its name.
                  * This function doesn't check the existence of headerName.
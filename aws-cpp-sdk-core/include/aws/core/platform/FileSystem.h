@@ -18,6 +18,7 @@
 #include <aws/core/utils/memory/stl/AWSVector.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/DateTime.h>
 #include <functional>
 
 namespace Aws
@@ -87,6 +88,12 @@ namespace FileSystem
      */
     AWS_CORE_API Aws::UniquePtr<Directory> OpenDirectory(const Aws::String& path, const Aws::String& relativePath = "");
 
+    /**
+     * Returns the entry for a single path, with its type, size and last modified time filled in. The path is not followed if it is a symlink.
+     * The bool operator of the result is false if the path doesn't exist or can't be read.
+     */
+    AWS_CORE_API DirectoryEntry GetFileInfo(const char* path);
+
     /**
      * Joins the leftSegment and rightSegment of a path together using platform specific delimiter.
      * e.g. C:\users\name\ and .aws becomes C:\users\name\.aws
@@ -120,6 +127,7 @@ namespace FileSystem
         Aws::String relativePath;
         FileType fileType;
         int64_t fileSize;
+        Aws::Utils::DateTime lastModified;
     };
 
     /**
@@ -232,5 +240,32 @@ namespace FileSystem
         Aws::UniquePtr<Directory> m_dir;
     };
 
+    /**
+     * A file opened for writing at explicit offsets. Writes don't go through a shared file position, so several threads
+     * may write disjoint ranges of the same file at once without any locking.
+     */
+    class AWS_CORE_API PositionalFileWriter
+    {
+    public:
+        virtual ~PositionalFileWriter() = default;
+
+        /**
+         * If the file was opened and sized successfully.
+         */
+        virtual operator bool() const = 0;
+
+        /**
+         * Writes length bytes from data starting at offset in the file. Returns true only if all of them were written.
+         */
+        virtual bool WriteAt(uint64_t offset, const unsigned char* data, size_t length) = 0;
+    };
+
+    /**
+     * Opens a file for positional writes, creating it if it doesn't exist, and sets its length to size. Where the platform
+     * supports it, the disk space is reserved up front so that later writes don't fail for lack of space or fragment the file.
+     * Content already in the file below size is kept. Check the bool operator of the result for failure.
+     */
+    AWS_CORE_API Aws::UniquePtr<PositionalFileWriter> OpenFileForPositionalWrite(const char* path, uint64_t size);
+
 } // namespace FileSystem
 } // namespace Aws
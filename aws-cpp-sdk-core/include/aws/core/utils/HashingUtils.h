@@ -87,6 +87,12 @@ namespace Aws
             */
             static ByteBuffer CalculateMD5(Aws::IOStream& stream);
 
+            /**
+            * Calculates the MD5 and SHA256 digests of a stream (not hex encoded) reading it only once, for bodies that need both.
+            * The stream position is restored afterwards. Returns false if either digest couldn't be computed.
+            */
+            static bool CalculateMD5AndSHA256(Aws::IOStream& stream, ByteBuffer& md5, ByteBuffer& sha256);
+
             static int HashString(const char* strToHash);
 
         };
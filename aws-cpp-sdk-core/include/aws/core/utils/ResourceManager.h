@@ -14,11 +14,13 @@
   */
 #pragma once
 
+#include <aws/core/utils/memory/AWSMemory.h>
 #include <aws/core/utils/memory/stl/AWSVector.h>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 #include <cassert>
+#include <cstdint>
 
 namespace Aws
 {
@@ -60,6 +62,23 @@ namespace Aws
                 return resource;
             }
 
+            /**
+             * Non-blocking variant of Acquire(). If a resource is available, moves it into resource and returns true,
+             * otherwise returns false immediately.
+             */
+            bool TryAcquire(RESOURCE_TYPE& resource)
+            {
+                std::lock_guard<std::mutex> locker(m_queueLock);
+                if (m_shutdown.load() || m_resources.size() == 0)
+                {
+                    return false;
+                }
+
+                resource = m_resources.back();
+                m_resources.pop_back();
+                return true;
+            }
+
             /**
              * Returns whether or not resources are currently available for acquisition
              *
@@ -128,5 +147,222 @@ namespace Aws
             std::condition_variable m_semaphore;
             std::atomic<bool> m_shutdown;
         };
+
+        /**
+         * Same contract as ExclusiveOwnershipResourceManager for at most capacity resources, without a lock on the Acquire/Release path
+         * unless Acquire has to wait. Available resources are kept on a lock-free stack, so the resource released last is the next one
+         * acquired and the resources in use stay few and warm (e.g. connections with live TLS sessions).
+         *
+         * The stack is threaded through slots by index. Each resource sits in a slot taken from a second stack of empty slots, and both
+         * stack heads carry a counter bumped on every change so that a slot popped and pushed back between another thread's read and
+         * compare-exchange can't be mistaken for an unchanged head. Slots are allocated in blocks as resources are first released, so a
+         * large capacity costs little until it is used; blocks are never moved or freed before destruction.
+         */
+        template< typename RESOURCE_TYPE>
+        class LockFreeOwnershipResourceManager
+        {
+        public:
+            LockFreeOwnershipResourceManager(size_t capacity) :
+                m_blocks((capacity + SLOTS_PER_BLOCK - 1) / SLOTS_PER_BLOCK, nullptr), m_blockCount(0), m_available(Pack(NO_SLOT, 0)),
+                m_empty(Pack(NO_SLOT, 0)), m_waiters(0), m_shutdown(false)
+            {
+                assert(capacity < NO_SLOT);
+            }
+
+            ~LockFreeOwnershipResourceManager()
+            {
+                for (size_t block = 0; block < m_blockCount; ++block)
+                {
+                    Aws::DeleteArray(m_blocks[block]);
+                }
+            }
+
+            /**
+             * Returns a resource with exclusive ownership, blocking until one is available. You must call Release on the resource when you
+             * are finished or other threads will block waiting to acquire it.
+             */
+            RESOURCE_TYPE Acquire()
+            {
+                RESOURCE_TYPE resource;
+                if (TryAcquire(resource))
+                {
+                    return resource;
+                }
+
+                std::unique_lock<std::mutex> locker(m_waitLock);
+                ++m_waiters;
+                m_resourceReleased.wait(locker, [&](){ return m_shutdown.load() || TryAcquire(resource); });
+                --m_waiters;
+
+                assert(!m_shutdown.load());
+                return resource;
+            }
+
+            /**
+             * Non-blocking variant of Acquire(). If a resource is available, moves it into resource and returns true,
+             * otherwise returns false immediately.
+             */
+            bool TryAcquire(RESOURCE_TYPE& resource)
+            {
+                return !m_shutdown.load() && TakeAvailable(resource);
+            }
+
+            /**
+             * Returns whether or not resources are currently available for acquisition. This is only a hint.
+             */
+            bool HasResourcesAvailable()
+            {
+                return Index(m_available.load()) != NO_SLOT && !m_shutdown.load();
+            }
+
+            /**
+             * Releases a resource back to the pool. This will unblock one waiting Acquire call if any are waiting.
+             * Never hold more than capacity resources in the pool.
+             */
+            void Release(RESOURCE_TYPE resource)
+            {
+                uint32_t slot = Pop(m_empty);
+                if (slot == NO_SLOT)
+                {
+                    slot = AddBlock();
+                }
+                assert(slot != NO_SLOT);
+                GetSlot(slot).resource = resource;
+                Push(m_available, slot);
+
+                // a waiter counts itself before it tries the stack, so either it sees this resource or we see it waiting.
+                if (m_waiters.load() > 0)
+                {
+                    {
+                        std::lock_guard<std::mutex> locker(m_waitLock);
+                    }
+                    m_resourceReleased.notify_one();
+                }
+            }
+
+            /**
+             * Waits for all aquired resources to be released, then empties the pool.
+             * After calling ShutdownAndWait(), you must not call Acquire any more.
+             *
+             * @params resourceCount the number of resources you've added to the resource manager.
+             * @return the previously managed resources that are now available for cleanup.
+             */
+            Aws::Vector<RESOURCE_TYPE> ShutdownAndWait(size_t resourceCount)
+            {
+                Aws::Vector<RESOURCE_TYPE> resources;
+                std::unique_lock<std::mutex> locker(m_waitLock);
+                m_shutdown = true;
+                ++m_waiters;
+                m_resourceReleased.wait(locker, [&]()
+                {
+                    RESOURCE_TYPE resource;
+                    while (TakeAvailable(resource))
+                    {
+                        resources.push_back(resource);
+                    }
+                    return resources.size() >= resourceCount;
+                });
+                --m_waiters;
+
+                return resources;
+            }
+
+        private:
+            LockFreeOwnershipResourceManager(const LockFreeOwnershipResourceManager&) = delete;
+            LockFreeOwnershipResourceManager& operator=(const LockFreeOwnershipResourceManager&) = delete;
+
+            static const uint32_t NO_SLOT = 0xFFFFFFFF;
+            static const size_t SLOTS_PER_BLOCK = 16;
+
+            struct Slot
+            {
+                RESOURCE_TYPE resource;
+                std::atomic<uint32_t> next;
+            };
+
+            Slot& GetSlot(uint32_t slot) { return m_blocks[slot / SLOTS_PER_BLOCK][slot % SLOTS_PER_BLOCK]; }
+
+            /**
+             * Allocates the next block of slots, keeps its first slot for the caller and pushes the rest onto the empty stack. Returns
+             * NO_SLOT when every block is allocated already. A block is stored before any of its slots is pushed, and slot indexes are
+             * only ever read off the stack heads, so threads outside the lock see it before they touch it.
+             */
+            uint32_t AddBlock()
+            {
+                std::lock_guard<std::mutex> locker(m_blockLock);
+                // another thread may have added a block while we waited for the lock.
+                uint32_t slot = Pop(m_empty);
+                if (slot != NO_SLOT || m_blockCount == m_blocks.size())
+                {
+                    return slot;
+                }
+
+                m_blocks[m_blockCount] = Aws::NewArray<Slot>(SLOTS_PER_BLOCK, "LockFreeOwnershipResourceManager");
+                slot = static_cast<uint32_t>(m_blockCount * SLOTS_PER_BLOCK);
+                ++m_blockCount;
+                for (uint32_t index = slot + SLOTS_PER_BLOCK - 1; index > slot; --index)
+                {
+                    Push(m_empty, index);
+                }
+                return slot;
+            }
+
+            static uint64_t Pack(size_t index, uint64_t version) { return (version << 32) | static_cast<uint32_t>(index); }
+            static uint32_t Index(uint64_t head) { return static_cast<uint32_t>(head); }
+            static uint64_t Version(uint64_t head) { return head >> 32; }
+
+            bool TakeAvailable(RESOURCE_TYPE& resource)
+            {
+                uint32_t slot = Pop(m_available);
+                if (slot == NO_SLOT)
+                {
+                    return false;
+                }
+
+                resource = GetSlot(slot).resource;
+                Push(m_empty, slot);
+                return true;
+            }
+
+            uint32_t Pop(std::atomic<uint64_t>& head)
+            {
+                uint64_t current = head.load();
+                for (;;)
+                {
+                    uint32_t slot = Index(current);
+                    if (slot == NO_SLOT)
+                    {
+                        return NO_SLOT;
+                    }
+
+                    // may read a slot another thread has already popped; the version check below then fails and we retry.
+                    uint32_t next = GetSlot(slot).next.load(std::memory_order_relaxed);
+                    if (head.compare_exchange_weak(current, Pack(next, Version(current) + 1)))
+                    {
+                        return slot;
+                    }
+                }
+            }
+
+            void Push(std::atomic<uint64_t>& head, uint32_t slot)
+            {
+                uint64_t current = head.load();
+                do
+                {
+                    GetSlot(slot).next.store(Index(current), std::memory_order_relaxed);
+                } while (!head.compare_exchange_weak(current, Pack(slot, Version(current) + 1)));
+            }
+
+            Aws::Vector<Slot*> m_blocks;
+            // only changed under m_blockLock.
+            size_t m_blockCount;
+            std::mutex m_blockLock;
+            std::atomic<uint64_t> m_available;
+            std::atomic<uint64_t> m_empty;
+            std::atomic<size_t> m_waiters;
+            std::atomic<bool> m_shutdown;
+            std::mutex m_waitLock;
+            std::condition_variable m_resourceReleased;
+        };
     }
 }
@@ -17,6 +17,7 @@
 
 #include <aws/core/Core_EXPORTS.h>
 #include <aws/core/utils/crypto/HashResult.h>
+#include <aws/core/utils/Outcome.h>
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 
@@ -46,6 +47,18 @@ namespace Aws
                 */
                 virtual HashResult Calculate(Aws::IStream& stream) = 0;
 
+                /**
+                * Adds bufferSize bytes to a digest that is built up incrementally, for data that is read in pieces anyway.
+                * Call GetHash once all of it has been added. Implementations that can't hash incrementally ignore the
+                * data and fail GetHash.
+                */
+                virtual void Update(const unsigned char* /*buffer*/, size_t /*bufferSize*/) {}
+
+                /**
+                * Returns the digest of everything passed to Update since the last call to GetHash, and starts a new one.
+                */
+                virtual HashResult GetHash() { return HashResult(); }
+
                 // when hashing streams, this is the size of our internal buffer we read the stream into
                 static const uint32_t INTERNAL_HASH_STREAM_BUFFER_SIZE = 8192;
             };
@@ -65,6 +65,16 @@ namespace Aws
                 */
                 virtual HashResult Calculate(Aws::IStream& stream) override;
 
+                /**
+                * Adds bufferSize bytes to the digest being built up incrementally.
+                */
+                virtual void Update(const unsigned char* buffer, size_t bufferSize) override;
+
+                /**
+                * Returns the digest of everything passed to Update since the last call, and starts a new one.
+                */
+                virtual HashResult GetHash() override;
+
             private:
 
                 std::shared_ptr<Hash> m_hashImpl;
@@ -78,10 +78,19 @@ namespace Aws
                  * Calculates a Hash on the stream without loading the entire stream into memory at once.
                  */
                 HashResult Calculate(Aws::IStream& stream);
+                /**
+                 * Adds bufferSize bytes to the incremental hash, which has its own hash object so it can be interleaved with Calculate.
+                 */
+                void Update(const unsigned char* buffer, size_t bufferSize);
+                /**
+                 * Finishes the incremental hash; the next Update starts a new one.
+                 */
+                HashResult GetHash();
 
             private:
 
                 bool IsValid() const;
+                bool CreateIncrementalHash();
 
                 HashResult HashData(const BCryptHashContext& context, PBYTE data, ULONG dataLength);
                 bool HashStream(Aws::IStream& stream);
@@ -94,6 +103,10 @@ namespace Aws
                 DWORD m_hashObjectLength;
                 PBYTE m_hashObject;
 
+                PBYTE m_incrementalHashObject;
+                BCRYPT_HASH_HANDLE m_incrementalHashHandle;
+                bool m_incrementalHashFailed;
+
                 //I'm 99% sure the algorithm handle for windows is not thread safe, but I can't 
                 //prove or disprove that theory. Therefore, we have to lock to be safe.
                 std::mutex m_algorithmMutex;
@@ -119,6 +132,14 @@ namespace Aws
                  * Calculates a md5 hash on the stream without loading the entire stream into memory at once.
                  */
                 virtual HashResult Calculate(Aws::IStream& stream) override;
+                /**
+                 * Adds bufferSize bytes to the digest being built up incrementally.
+                 */
+                virtual void Update(const unsigned char* buffer, size_t bufferSize) override;
+                /**
+                 * Returns the digest of everything passed to Update since the last call, and starts a new one.
+                 */
+                virtual HashResult GetHash() override;
 
             private:
                 BCryptHashImpl m_impl;
@@ -144,6 +165,14 @@ namespace Aws
                  * Calculates a sha256 hash on the stream without loading the entire stream into memory at once.
                  */
                 virtual HashResult Calculate(Aws::IStream& stream) override;
+                /**
+                 * Adds bufferSize bytes to the digest being built up incrementally.
+                 */
+                virtual void Update(const unsigned char* buffer, size_t bufferSize) override;
+                /**
+                 * Returns the digest of everything passed to Update since the last call, and starts a new one.
+                 */
+                virtual HashResult GetHash() override;
 
             private:
                 BCryptHashImpl m_impl;
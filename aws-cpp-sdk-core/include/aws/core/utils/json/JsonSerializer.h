@@ -35,6 +35,11 @@ namespace Aws
             /**
              * JSON DOM manipulation class.
              * To read or serialize use @ref View function.
+             *
+             * A JsonValue constructed by parsing keeps its DOM inside a copy of the parsed text: strings point into that
+             * buffer and nodes are allocated in blocks, so parsing costs a handful of allocations however large the
+             * document is. The first modification through one of the With/As functions moves the DOM to the heap, which
+             * invalidates any outstanding views.
              */
             class AWS_CORE_API JsonValue
             {
@@ -50,7 +55,8 @@ namespace Aws
                 JsonValue(const Aws::String& value);
 
                 /**
-                 * Constructs a JSON DOM by parsing the text in the input stream.
+                 * Constructs a JSON DOM by parsing the text in the input stream. The stream is read into the parse buffer
+                 * directly, in a single allocation when the stream can report its remaining size.
                  */
                 JsonValue(Aws::IStream& istream);
 
@@ -214,9 +220,23 @@ namespace Aws
                 JsonView View() const;
 
             private:
+                struct ParsedDocument;
+
                 void Destroy();
                 JsonValue(cJSON* value);
+                void Parse(Aws::String&& text, const char* errorPrefix);
+                /**
+                 * Moves a DOM that lives in the parse buffer to the heap, so it can be modified.
+                 */
+                void DetachFromParseBuffer();
+                /**
+                 * Gives up ownership of the DOM to the caller, who will free it with cJSON_Delete.
+                 */
+                cJSON* ReleaseValue();
+
                 cJSON* m_value;
+                //non-null if m_value was produced by Parse, owns the text and the nodes m_value points into.
+                ParsedDocument* m_document;
                 bool m_wasParseSuccessful;
                 Aws::String m_errorMessage;
                 friend class JsonView;
@@ -0,0 +1,108 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/memory/stl/AWSString.h>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Json
+        {
+            class JsonView;
+
+            /**
+             * Forward only JSON writer. Values are written as compact JSON text straight into a single growing buffer
+             * in the order they are given, without building a DOM first. This is what generated requests use to serialize
+             * their payloads; use JsonValue instead if the document needs to be inspected or modified before it is written.
+             *
+             * Inside an object, every value must be preceded by a call to Key (the With* functions do both). The writer
+             * does not validate the sequence of calls, unbalanced or misplaced calls produce invalid JSON.
+             */
+            class AWS_CORE_API JsonWriter
+            {
+            public:
+                JsonWriter();
+
+                /**
+                 * Reserves initialCapacity bytes up front, for callers that can estimate the size of the document.
+                 */
+                explicit JsonWriter(size_t initialCapacity);
+
+                JsonWriter& StartObject();
+                JsonWriter& EndObject();
+                JsonWriter& StartArray();
+                JsonWriter& EndArray();
+
+                /**
+                 * Writes the key of the next member of the current object.
+                 */
+                JsonWriter& Key(const char* key);
+                JsonWriter& Key(const Aws::String& key);
+
+                JsonWriter& AsString(const Aws::String& value);
+                JsonWriter& AsString(const char* value);
+                JsonWriter& AsBool(bool value);
+                JsonWriter& AsInteger(int value);
+                JsonWriter& AsInt64(long long value);
+                /**
+                 * Writes value with the same formatting as JsonValue. NaN and infinity are written as null.
+                 */
+                JsonWriter& AsDouble(double value);
+                JsonWriter& AsNull();
+                /**
+                 * Writes an existing DOM as the next value, an empty view is written as an empty object.
+                 */
+                JsonWriter& AsObject(const JsonView& value);
+
+                JsonWriter& WithString(const char* key, const Aws::String& value) { return Key(key).AsString(value); }
+                JsonWriter& WithString(const Aws::String& key, const Aws::String& value) { return Key(key).AsString(value); }
+                JsonWriter& WithBool(const char* key, bool value) { return Key(key).AsBool(value); }
+                JsonWriter& WithBool(const Aws::String& key, bool value) { return Key(key).AsBool(value); }
+                JsonWriter& WithInteger(const char* key, int value) { return Key(key).AsInteger(value); }
+                JsonWriter& WithInteger(const Aws::String& key, int value) { return Key(key).AsInteger(value); }
+                JsonWriter& WithInt64(const char* key, long long value) { return Key(key).AsInt64(value); }
+                JsonWriter& WithInt64(const Aws::String& key, long long value) { return Key(key).AsInt64(value); }
+                JsonWriter& WithDouble(const char* key, double value) { return Key(key).AsDouble(value); }
+                JsonWriter& WithDouble(const Aws::String& key, double value) { return Key(key).AsDouble(value); }
+                JsonWriter& WithObject(const char* key, const JsonView& value);
+                JsonWriter& WithObject(const Aws::String& key, const JsonView& value);
+
+                /**
+                 * The JSON written so far.
+                 */
+                inline const Aws::String& GetString() const { return m_buffer; }
+
+                /**
+                 * Moves the JSON written so far out of the writer and leaves the writer empty, ready to write a new document.
+                 */
+                Aws::String TakeOwnershipOfString();
+
+            private:
+                void WriteSeparator();
+                void WriteQuoted(const char* value, size_t length);
+
+                Aws::String m_buffer;
+                //true once the current object or array holds a value, so the next one needs a comma in front of it.
+                bool m_needsComma;
+            };
+
+        } // namespace Json
+    } // namespace Utils
+} // namespace Aws
@@ -25,6 +25,7 @@ namespace Aws
         namespace Logging
         {
             class LogSystemInterface;
+            enum class LogLevel : int;
 
             // Standard interface
 
@@ -43,6 +44,25 @@ namespace Aws
              */
             AWS_CORE_API LogSystemInterface* GetLogSystem();
 
+            // Per tag filtering
+
+            /**
+             * Caps the level statements logged with tag are logged at, below the level of the log system, e.g. to keep a chatty component
+             * at Warn while everything else logs at Debug. The log macros skip statements above the cap before building their message.
+             * Up to 32 tags, of fewer than 64 characters each, can be capped; returns false if tag can't be.
+             */
+            AWS_CORE_API bool SetLogLevelForTag(const char* tag, LogLevel logLevel);
+
+            /**
+             * Lifts the caps set with SetLogLevelForTag.
+             */
+            AWS_CORE_API void ClearLogLevelsForTags();
+
+            /**
+             * Returns false if statements at logLevel are filtered out for tag. Used by the log macros.
+             */
+            AWS_CORE_API bool IsLogTagEnabled(LogLevel logLevel, const char* tag);
+
             // Testing interface
 
             /**
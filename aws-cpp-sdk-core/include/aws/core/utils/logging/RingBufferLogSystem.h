@@ -0,0 +1,120 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/logging/LogSystemInterface.h>
+#include <aws/core/utils/logging/LogLevel.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Logging
+        {
+            /**
+             * Logger for high volume logging from many threads. Writes the same lines, to the same kind of output, as DefaultLogSystem, but
+             * a logging thread only copies the raw message, level, tag, thread id and time into a slot of a fixed size ring buffer, without
+             * taking a lock, and everything else, formatting included, happens on the background thread. Threads are spread over a few ring
+             * buffers by thread id; a thread whose buffer is full waits up to 100ms for the background thread to make room, after which
+             * its line is dropped and counted. The log says how many lines were dropped.
+             *
+             * Lines from different threads can be written slightly out of order.
+             */
+            class AWS_CORE_API RingBufferLogSystem : public LogSystemInterface
+            {
+            public:
+                using Base = LogSystemInterface;
+
+                /**
+                 * Initialize the logging system to write to the supplied logfile output. Creates logging thread on construction.
+                 * recordsPerBuffer is rounded up to a power of two.
+                 */
+                RingBufferLogSystem(LogLevel logLevel, const std::shared_ptr<Aws::OStream>& logFile, size_t recordsPerBuffer = 1024);
+                /**
+                 * Initialize the logging system to write to a computed file path filenamePrefix + "timestamp.log", rolled every hour.
+                 * Creates logging thread on construction.
+                 */
+                RingBufferLogSystem(LogLevel logLevel, const Aws::String& filenamePrefix, size_t recordsPerBuffer = 1024);
+
+                virtual ~RingBufferLogSystem();
+
+                LogLevel GetLogLevel(void) const override { return m_logLevel; }
+
+                void SetLogLevel(LogLevel logLevel) { m_logLevel.store(logLevel); }
+
+                /**
+                 * Does a printf style output to the ring buffer. Don't use this, it's unsafe. See LogStream
+                 */
+                void Log(LogLevel logLevel, const char* tag, const char* formatStr, ...) override;
+
+                void LogStream(LogLevel logLevel, const char* tag, const Aws::OStringStream &messageStream) override;
+
+                /**
+                 * Waits for the background thread to write out and flush what was logged before the call, from any thread.
+                 */
+                void Flush() override;
+
+                /**
+                 * Number of lines dropped so far because their ring buffer stayed full.
+                 */
+                size_t GetDroppedLineCount() const { return m_droppedLines.load(); }
+
+            private:
+                struct Record;
+                struct RecordBuffer;
+
+                RingBufferLogSystem(const RingBufferLogSystem& rhs) = delete;
+                RingBufferLogSystem& operator =(const RingBufferLogSystem& rhs) = delete;
+
+                void Init(size_t recordsPerBuffer);
+                Record* ClaimRecord(LogLevel logLevel, const char* tag);
+                void PublishRecord(Record* record);
+                void WriteRecords(const std::shared_ptr<Aws::OStream>& logFile, const Aws::String& filenamePrefix, bool rollLog);
+                void FormatRecord(size_t bufferIndex, const Record& record);
+
+                std::atomic<LogLevel> m_logLevel;
+                RecordBuffer* m_buffers;
+
+                std::mutex m_signalMutex;
+                std::condition_variable m_writeSignal;
+                std::condition_variable m_flushSignal;
+                uint64_t m_flushesRequested;
+                uint64_t m_flushesCompleted;
+                bool m_stopLogging;
+                std::atomic<size_t> m_droppedLines;
+
+                // only used by the background thread
+                size_t m_reportedDroppedLines;
+                Aws::String m_batch;
+                int64_t m_cachedSecond;
+                Aws::String m_cachedTimestamp;
+
+                std::thread m_loggingThread;
+            };
+
+        } // namespace Logging
+    } // namespace Utils
+} // namespace Aws
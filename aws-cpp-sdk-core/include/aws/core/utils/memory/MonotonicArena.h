@@ -0,0 +1,97 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/MemorySystemInterface.h>
+
+#include <cstddef>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Memory
+        {
+            /**
+             * Memory system that hands out memory from a list of blocks by bumping a pointer, and gives it all back at once
+             * when the arena is reset or destroyed. Intended for the many small, same-lifetime allocations made while
+             * handling a single request or response, e.g. the nodes of a parsed document.
+             *
+             * Blocks come from Aws::Malloc, so a memory system installed with InitializeAWSMemorySystem sees a few large
+             * allocations instead of many small ones. FreeMemory does nothing and destructors of objects placed in the
+             * arena are never run, so only trivially destructible objects, or ones the caller destroys, belong here.
+             *
+             * Not thread safe; an arena is meant to be owned by whatever is working on the request.
+             */
+            class AWS_CORE_API MonotonicArena : public MemorySystemInterface
+            {
+            public:
+                /**
+                 * initialBlockSize is the usable size of the first block, which is allocated on first use.
+                 * Each block after that is twice the size of the one before, or larger if a single allocation needs it.
+                 */
+                explicit MonotonicArena(std::size_t initialBlockSize = 4096, const char* allocationTag = "MonotonicArena");
+                ~MonotonicArena();
+
+                MonotonicArena(const MonotonicArena&) = delete;
+                MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+                void Begin() override {}
+                void End() override {}
+
+                /**
+                 * Alignment must be a power of two. An alignment of 1, which is what Aws::Malloc asks for, is treated like
+                 * malloc and gives memory suitably aligned for any type.
+                 */
+                void* AllocateMemory(std::size_t blockSize, std::size_t alignment, const char* allocationTag = nullptr) override;
+
+                /**
+                 * No-op, memory is reclaimed by Reset or when the arena is destroyed.
+                 */
+                void FreeMemory(void* memoryPtr) override;
+
+                /**
+                 * Releases everything allocated so far. The largest block is kept for reuse.
+                 */
+                void Reset();
+
+                /**
+                 * Total size of the blocks currently held, including the unused space at their ends.
+                 */
+                std::size_t GetReservedBytes() const { return m_reservedBytes; }
+
+            private:
+                struct Block
+                {
+                    Block* previous;
+                    std::size_t size;
+                };
+
+                void AddBlock(std::size_t minimumSize);
+                void FreeBlocks(Block* last);
+
+                const char* m_allocationTag;
+                Block* m_currentBlock;
+                char* m_cursor;
+                char* m_end;
+                std::size_t m_nextBlockSize;
+                std::size_t m_reservedBytes;
+            };
+
+        } // namespace Memory
+    } // namespace Utils
+} // namespace Aws
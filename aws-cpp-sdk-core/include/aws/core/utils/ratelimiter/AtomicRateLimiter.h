@@ -0,0 +1,194 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/ratelimiter/RateLimiterInterface.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace RateLimits
+        {
+            /**
+             * Rate limiter for limiters shared by many threads, such as a ClientConfiguration::readRateLimiter or writeRateLimiter used by a
+             * transfer with many parts in flight. It behaves like DefaultRateLimiter, rate changes included, but applying a cost is a single
+             * compare and swap on the time the budget is spent up to, rather than a lock.
+             *
+             * With a non-zero leaseSize, threads take the budget out in leases of at least that size into one of a few per thread credit slots
+             * and pay for the smaller costs that follow out of that slot, so that most calls don't touch the shared state at all. Up to one
+             * lease per slot can go unused, which the rate can be exceeded by, so keep leaseSize small compared to the rate.
+             */
+            template<typename CLOCK = std::chrono::steady_clock, typename DUR = std::chrono::seconds>
+            class AtomicRateLimiter : public RateLimiterInterface
+            {
+            public:
+                using Base = RateLimiterInterface;
+
+                using InternalTimePointType = std::chrono::time_point<CLOCK>;
+                using ElapsedTimeFunctionType = std::function< InternalTimePointType() >;
+
+                AtomicRateLimiter(int64_t maxRate, int64_t leaseSize = 0, ElapsedTimeFunctionType elapsedTimeFunction = CLOCK::now) :
+                    m_elapsedTimeFunction(elapsedTimeFunction),
+                    m_epoch(elapsedTimeFunction()),
+                    m_leaseSize((std::max)(static_cast<int64_t>(0), leaseSize)),
+                    m_maxRate(1),
+                    m_spentUntil(0)
+                {
+                    static_assert(DUR::period::num > 0, "Rate duration must have positive numerator");
+                    static_assert(DUR::period::den > 0, "Rate duration must have positive denominator");
+
+                    for (auto& slot : m_credit)
+                    {
+                        slot.m_value = 0;
+                    }
+                    AtomicRateLimiter::SetRate(maxRate, true);
+                }
+
+                virtual ~AtomicRateLimiter() = default;
+
+                /**
+                 * Calculates time in milliseconds that should be delayed before letting anymore data through.
+                 */
+                virtual DelayType ApplyCost(int64_t cost) override
+                {
+                    if (cost <= 0)
+                    {
+                        return ToDelay(m_spentUntil.load(std::memory_order_acquire) - Now());
+                    }
+
+                    if (m_leaseSize == 0)
+                    {
+                        return Spend(cost);
+                    }
+
+                    auto& credit = m_credit[std::hash<std::thread::id>()(std::this_thread::get_id()) % CREDIT_SLOTS].m_value;
+                    int64_t available = credit.load(std::memory_order_relaxed);
+                    while (available >= cost)
+                    {
+                        if (credit.compare_exchange_weak(available, available - cost, std::memory_order_relaxed))
+                        {
+                            return DelayType(0);
+                        }
+                    }
+
+                    int64_t lease = (std::max)(cost, m_leaseSize);
+                    auto delay = Spend(lease);
+                    credit.fetch_add(lease - cost, std::memory_order_relaxed);
+                    return delay;
+                }
+
+                /**
+                 * Same as ApplyCost() but then goes ahead and sleeps the current thread.
+                 */
+                virtual void ApplyAndPayForCost(int64_t cost) override
+                {
+                    auto costInMilliseconds = ApplyCost(cost);
+                    if (costInMilliseconds.count() > 0)
+                    {
+                        std::this_thread::sleep_for(costInMilliseconds);
+                    }
+                }
+
+                /**
+                 * Update the bandwidth rate to allow. Without resetAccumulator, the delay already owed is kept as it is.
+                 */
+                virtual void SetRate(int64_t rate, bool resetAccumulator = false) override
+                {
+                    m_maxRate.store((std::max)(static_cast<int64_t>(1), rate), std::memory_order_relaxed);
+
+                    if (resetAccumulator)
+                    {
+                        for (auto& slot : m_credit)
+                        {
+                            slot.m_value.store(0, std::memory_order_relaxed);
+                        }
+                        m_spentUntil.store(Now() - RateDuration(), std::memory_order_release);
+                    }
+                }
+
+            private:
+
+                static const size_t CREDIT_SLOTS = 16;
+
+                static int64_t RateDuration()
+                {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(DUR(1)).count();
+                }
+
+                int64_t Now() const
+                {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(m_elapsedTimeFunction() - m_epoch).count();
+                }
+
+                static DelayType ToDelay(int64_t nanoseconds)
+                {
+                    return std::chrono::duration_cast<DelayType>(std::chrono::nanoseconds((std::max)(static_cast<int64_t>(0), nanoseconds)));
+                }
+
+                /**
+                 * Moves the time the budget is spent up to forward by cost, starting no earlier than one full budget ago, and returns the
+                 * delay owed by earlier costs; as with DefaultRateLimiter, the next call ends up paying for this one.
+                 */
+                DelayType Spend(int64_t cost)
+                {
+                    auto now = Now();
+                    auto duration = RateDuration();
+                    auto spent = static_cast<int64_t>(static_cast<double>(cost) * duration / m_maxRate.load(std::memory_order_relaxed));
+
+                    int64_t spentUntil = m_spentUntil.load(std::memory_order_relaxed);
+                    int64_t start = 0;
+                    do
+                    {
+                        start = (std::max)(spentUntil, now - duration);
+                    } while (!m_spentUntil.compare_exchange_weak(spentUntil, start + spent, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+                    return ToDelay(start - now);
+                }
+
+                /// Credit slots each get a cache line of their own, so threads paying out of different slots don't contend
+                struct alignas(64) CreditSlot
+                {
+                    std::atomic<int64_t> m_value;
+                };
+
+                /// Function that returns the current time
+                ElapsedTimeFunctionType m_elapsedTimeFunction;
+
+                /// Time points are kept as nanoseconds since construction so that they fit in an atomic
+                const InternalTimePointType m_epoch;
+
+                const int64_t m_leaseSize;
+
+                std::atomic<int64_t> m_maxRate;
+
+                /// Time, in nanoseconds since m_epoch, at which everything applied so far will have been paid for at m_maxRate.
+                /// It starts a cache line of its own; the credit slots after it start the next ones.
+                alignas(64) std::atomic<int64_t> m_spentUntil;
+
+                CreditSlot m_credit[CREDIT_SLOTS];
+            };
+
+        } // namespace RateLimits
+    } // namespace Utils
+} // namespace Aws
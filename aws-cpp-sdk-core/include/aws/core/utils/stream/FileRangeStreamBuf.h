@@ -0,0 +1,77 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <fstream>
+#include <streambuf>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Stream
+        {
+            /**
+             * Read only stream buf over a byte range of a file. The file isn't opened until the stream is first read, so these can
+             * be created well ahead of use without holding a file handle or a buffer, and large reads go straight from the file
+             * into the caller's memory. Seeking is relative to the start of the range and can't go past its end, so the same
+             * range can be read again, e.g. when a request body is resent.
+             */
+            class AWS_CORE_API FileRangeStreamBuf : public std::streambuf
+            {
+            public:
+                /**
+                 * @param path file to read from.
+                 * @param offset position in the file where the range starts.
+                 * @param length number of bytes in the range.
+                 */
+                FileRangeStreamBuf(const Aws::String& path, uint64_t offset, uint64_t length);
+
+                FileRangeStreamBuf(const FileRangeStreamBuf&) = delete;
+                FileRangeStreamBuf& operator=(const FileRangeStreamBuf&) = delete;
+
+                FileRangeStreamBuf(FileRangeStreamBuf&& toMove) = delete;
+                FileRangeStreamBuf& operator=(FileRangeStreamBuf&&) = delete;
+
+            protected:
+                pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+                pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+
+                int_type underflow() override;
+                std::streamsize xsgetn(char* s, std::streamsize n) override;
+                std::streamsize showmanyc() override;
+
+            private:
+                std::streamsize ReadFile(char* s, std::streamsize n);
+
+                static const size_t GET_AREA_SIZE = 1024;
+
+                const Aws::String m_path;
+                const uint64_t m_offset;
+                const uint64_t m_length;
+                // how far into the range the file has been read, the get area ends here.
+                uint64_t m_position;
+                bool m_seekPending;
+                bool m_openFailed;
+                std::filebuf m_file;
+                char m_getArea[GET_AREA_SIZE];
+            };
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <memory>
+#include <streambuf>
+
+namespace Aws
+{
+namespace Utils
+{
+namespace Stream
+{
+    /**
+     * Stream buffer that reads directly from an immutable string it shares ownership of. It has no put area,
+     * so writes through it fail instead of modifying the string.
+     */
+    class AWS_CORE_API ReadOnlyStringBuf : public std::streambuf
+    {
+        public:
+            explicit ReadOnlyStringBuf(const std::shared_ptr<const Aws::String>& value);
+
+            ReadOnlyStringBuf(const ReadOnlyStringBuf&) = delete;
+            ReadOnlyStringBuf& operator=(const ReadOnlyStringBuf&) = delete;
+
+            ReadOnlyStringBuf(ReadOnlyStringBuf&& toMove) = delete;
+            ReadOnlyStringBuf& operator=(ReadOnlyStringBuf&&) = delete;
+
+            const std::shared_ptr<const Aws::String>& GetValue() const { return m_value; }
+
+        protected:
+            std::streampos seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in) override;
+            std::streampos seekpos(std::streampos pos, std::ios_base::openmode which = std::ios_base::in) override;
+
+        private:
+            std::shared_ptr<const Aws::String> m_value;
+    };
+
+    /**
+     * IOStream over an immutable string, used for serialized request payloads. Creating one does not copy the
+     * string, and any number of streams can read the same string independently.
+     */
+    class AWS_CORE_API ReadOnlyStringStream : public Aws::IOStream
+    {
+        public:
+            explicit ReadOnlyStringStream(const std::shared_ptr<const Aws::String>& value);
+            /**
+             * Takes ownership of value without copying it.
+             */
+            explicit ReadOnlyStringStream(Aws::String&& value);
+
+            ReadOnlyStringStream(const ReadOnlyStringStream&) = delete;
+            ReadOnlyStringStream& operator=(const ReadOnlyStringStream&) = delete;
+
+            /**
+             * The bytes this stream reads, for callers that want them without going through the stream.
+             */
+            const Aws::String& str() const { return *m_buf.GetValue(); }
+
+        private:
+            ReadOnlyStringBuf m_buf;
+    };
+}
+}
+}
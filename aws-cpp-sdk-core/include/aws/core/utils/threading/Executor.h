@@ -21,8 +21,11 @@
 #include <aws/core/utils/memory/stl/AWSMap.h>
 #include <aws/core/utils/threading/Semaphore.h>
 #include <functional>
+#include <memory>
 #include <future>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <atomic>
 
 namespace Aws
@@ -123,6 +126,103 @@ namespace Aws
                 friend class ThreadTask;
             };
 
+            /**
+            * Thread pool executor that gives each worker thread a bounded task queue of its own. Submissions are spread over the queues round
+            * robin and a worker whose queue is empty takes tasks from the others' queues, all without locking; the pool's lock and condition
+            * variable are only touched to put idle workers to sleep and wake them up. Tasks are moved into slots preallocated in the queues, so
+            * a submission doesn't allocate beyond what its std::function already holds. If every queue is full, tasks wait in a locked
+            * overflow queue. Like PooledThreadExecutor, tasks still queued when the executor is destroyed are dropped without running.
+            */
+            class AWS_CORE_API WorkStealingExecutor : public Executor
+            {
+            public:
+                WorkStealingExecutor(size_t poolSize, OverflowPolicy overflowPolicy = OverflowPolicy::QUEUE_TASKS_EVENLY_ACCROSS_THREADS);
+                ~WorkStealingExecutor();
+
+                /**
+                * Rule of 5 stuff.
+                * Don't copy or move
+                */
+                WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+                WorkStealingExecutor& operator =(const WorkStealingExecutor&) = delete;
+                WorkStealingExecutor(WorkStealingExecutor&&) = delete;
+                WorkStealingExecutor& operator =(WorkStealingExecutor&&) = delete;
+
+            protected:
+                bool SubmitToThread(std::function<void()>&&) override;
+
+            private:
+                class TaskQueue;
+
+                void Work(size_t workerIndex);
+                bool TakeTask(size_t workerIndex, std::function<void()>& task);
+
+                Aws::Vector<TaskQueue*> m_queues;
+                Aws::Vector<std::thread> m_workers;
+                std::atomic<size_t> m_nextQueue;
+                // submitted and not yet taken by a worker, counted before the task is queued.
+                std::atomic<size_t> m_pendingTasks;
+                std::atomic<size_t> m_sleepingWorkers;
+                std::atomic<size_t> m_overflowSize;
+                std::atomic<bool> m_stopping;
+                std::mutex m_overflowLock;
+                Aws::Queue<std::function<void()>> m_overflowTasks;
+                std::mutex m_sleepLock;
+                std::condition_variable m_wakeUp;
+                size_t m_poolSize;
+                OverflowPolicy m_overflowPolicy;
+            };
+
+            enum class TaskPriority
+            {
+                LOW,
+                NORMAL,
+                HIGH
+            };
+
+            /**
+            * Thread pool executor that schedules tasks from several queues instead of first come, first served. Each queue has a priority
+            * and a weight: a worker always takes the next task from the highest priority queue that has any, and queues of equal priority
+            * share the workers in proportion to their weights (weighted fair queueing, counting every task as the same amount of work).
+            * CreateQueue returns an Executor that submits into one such queue; set it as ClientConfiguration::executor so that, for example,
+            * a client making latency-sensitive calls doesn't wait behind a backlog of bulk transfer parts submitted by another client sharing
+            * the same threads. Tasks submitted to the FairQueueingExecutor itself go to a NORMAL priority queue of weight 1.
+            * Queues outlive their Executors until they have run what was submitted to them. Tasks still queued when the FairQueueingExecutor
+            * is destroyed are dropped without running, and submitting to one of its queues after that fails.
+            */
+            class AWS_CORE_API FairQueueingExecutor : public Executor
+            {
+            public:
+                FairQueueingExecutor(size_t poolSize);
+                ~FairQueueingExecutor();
+
+                /**
+                * Rule of 5 stuff.
+                * Don't copy or move
+                */
+                FairQueueingExecutor(const FairQueueingExecutor&) = delete;
+                FairQueueingExecutor& operator =(const FairQueueingExecutor&) = delete;
+                FairQueueingExecutor(FairQueueingExecutor&&) = delete;
+                FairQueueingExecutor& operator =(FairQueueingExecutor&&) = delete;
+
+                /**
+                * Creates a queue scheduled on this executor's threads and returns an Executor that submits to it.
+                * weight must be at least 1.
+                */
+                std::shared_ptr<Executor> CreateQueue(TaskPriority priority, size_t weight = 1);
+
+            protected:
+                bool SubmitToThread(std::function<void()>&&) override;
+
+            private:
+                class Scheduler;
+                class QueueExecutor;
+
+                std::shared_ptr<Scheduler> m_scheduler;
+                std::shared_ptr<QueueExecutor> m_defaultQueue;
+                Aws::Vector<std::thread> m_workers;
+            };
+
 
         } // namespace Threading
     } // namespace Utils
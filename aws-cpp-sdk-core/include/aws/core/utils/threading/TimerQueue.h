@@ -0,0 +1,93 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Threading
+        {
+            /**
+             * Runs tasks after a delay on a single background thread, ordered by deadline.
+             * The thread is started the first time a task is scheduled, so an idle TimerQueue costs nothing.
+             *
+             * Tasks run on the timer thread one at a time and should only hand work off (e.g. start an async request),
+             * anything long running delays every task scheduled behind it.
+             */
+            class AWS_CORE_API TimerQueue
+            {
+            public:
+                TimerQueue();
+
+                /**
+                 * Stops the timer thread. Tasks that have not fired yet are discarded without being run.
+                 * Must not be called from within a scheduled task.
+                 */
+                ~TimerQueue();
+
+                TimerQueue(const TimerQueue&) = delete;
+                TimerQueue& operator=(const TimerQueue&) = delete;
+                TimerQueue(TimerQueue&&) = delete;
+                TimerQueue& operator=(TimerQueue&&) = delete;
+
+                /**
+                 * Runs task on the timer thread once delay has elapsed. Tasks with the same deadline run in the order they were scheduled.
+                 */
+                void Schedule(std::chrono::milliseconds delay, const std::function<void()>& task);
+
+                /**
+                 * Number of tasks waiting for their deadline.
+                 */
+                size_t GetPendingTaskCount() const;
+
+            private:
+                struct ScheduledTask
+                {
+                    std::chrono::steady_clock::time_point deadline;
+                    unsigned long long sequence;
+                    std::function<void()> task;
+                };
+
+                struct LaterDeadline
+                {
+                    bool operator()(const ScheduledTask& lhs, const ScheduledTask& rhs) const
+                    {
+                        return lhs.deadline == rhs.deadline ? lhs.sequence > rhs.sequence : lhs.deadline > rhs.deadline;
+                    }
+                };
+
+                void Run();
+
+                //min-heap on deadline, maintained with std::push_heap/std::pop_heap
+                Aws::Vector<ScheduledTask> m_tasks;
+                unsigned long long m_nextSequence;
+                bool m_stopped;
+                std::thread m_thread;
+                mutable std::mutex m_mutex;
+                std::condition_variable m_signal;
+            };
+        } // namespace Threading
+    } // namespace Utils
+} // namespace Aws
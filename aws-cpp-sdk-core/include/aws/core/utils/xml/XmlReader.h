@@ -0,0 +1,164 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+#include <utility>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Xml
+        {
+            /**
+             * Forward only pull parser over an xml stream. The stream is read in small chunks as the document is walked,
+             * so memory use depends on the size of the largest token rather than the size of the document, and no DOM is built.
+             *
+             * Entity and character references are decoded, CDATA sections are reported as text, and comments, processing
+             * instructions and the document type declaration are skipped. Parsing stops at the end of the root element;
+             * anything after it is never read. A stream with no root element at all reads as EndDocument, not as an error.
+             *
+             * Typical use, with the reader positioned on an element:
+             *
+             *     const size_t depth = reader.GetDepth();
+             *     while (reader.ReadChildElement(depth))
+             *     {
+             *         if (reader.GetName() == "Key") key = reader.ReadElementText();
+             *         else reader.SkipElement();
+             *     }
+             */
+            class AWS_CORE_API XmlReader
+            {
+            public:
+                enum class NodeType
+                {
+                    None,
+                    StartElement,
+                    EndElement,
+                    Text,
+                    EndDocument,
+                    Error
+                };
+
+                /**
+                 * The stream must outlive the reader. Nothing is read until the first call to Read.
+                 */
+                XmlReader(Aws::IStream& stream);
+
+                XmlReader(const XmlReader&) = delete;
+                XmlReader& operator=(const XmlReader&) = delete;
+
+                /**
+                 * Advances to the next node and returns its type. An empty element (<a/>) is reported as a StartElement
+                 * followed by an EndElement. Once EndDocument or Error is returned, every later call returns it again.
+                 */
+                NodeType Read();
+
+                NodeType GetNodeType() const { return m_nodeType; }
+
+                /**
+                 * Name, including any namespace prefix, of the element for StartElement and EndElement nodes.
+                 */
+                const Aws::String& GetName() const { return m_name; }
+
+                /**
+                 * Decoded text of a Text node.
+                 */
+                const Aws::String& GetText() const { return m_text; }
+
+                /**
+                 * Number of elements open, counting the current one for StartElement and EndElement nodes. The root element is at depth 1.
+                 */
+                size_t GetDepth() const { return m_depth; }
+
+                /**
+                 * Decoded value of the attribute on the current StartElement, or an empty string if it isn't there.
+                 */
+                Aws::String GetAttributeValue(const char* name) const;
+
+                /**
+                 * Advances to the root element. Returns false if the document is empty or malformed; only the latter sets HasError.
+                 */
+                bool ReadRootElement();
+
+                /**
+                 * Advances to the next child element of the element at parentDepth, skipping text. Returns false,
+                 * positioned on the parent's EndElement, once there are no more children.
+                 * Each child must be consumed, with ReadElementText, SkipElement or by reading its own children,
+                 * before asking for the next one.
+                 */
+                bool ReadChildElement(size_t parentDepth);
+
+                /**
+                 * Reads the text content of the current StartElement and advances to its EndElement. Text inside nested
+                 * elements is included.
+                 */
+                Aws::String ReadElementText();
+
+                /**
+                 * Advances to the EndElement of the current StartElement, skipping everything inside it.
+                 */
+                void SkipElement();
+
+                bool HasError() const { return m_nodeType == NodeType::Error; }
+                const Aws::String& GetErrorMessage() const { return m_errorMessage; }
+
+            private:
+                int Peek(size_t offset);
+                bool StartsWith(const char* token);
+                size_t Find(const char* token);
+                bool SkipPast(const char* terminator);
+                bool Fill();
+
+                NodeType ReadMarkup();
+                NodeType ReadStartElement();
+                NodeType ReadEndElement();
+                NodeType ReadCharacterData();
+                NodeType ReadText();
+                bool ReadName(Aws::String& name);
+                bool ReadAttributeValue(Aws::String& value);
+                void SkipWhitespace();
+                void AppendDecoded(Aws::String& out, const char* begin, const char* end);
+                NodeType Fail(const char* message);
+
+                Aws::IStream& m_stream;
+                Aws::String m_buffer;
+                size_t m_position;
+                bool m_endOfStream;
+
+                NodeType m_nodeType;
+                Aws::String m_name;
+                Aws::String m_text;
+                Aws::String m_errorMessage;
+                size_t m_depth;
+                bool m_pendingEndElement;
+                bool m_rootClosed;
+
+                //open elements, names are reused between elements to avoid allocating.
+                Aws::Vector<Aws::String> m_openElements;
+                Aws::Vector<std::pair<Aws::String, Aws::String>> m_attributes;
+                size_t m_attributeCount;
+            };
+
+        } // namespace Xml
+    } // namespace Utils
+} // namespace Aws
@@ -14,19 +14,18 @@
   */
 
 #include <aws/core/AmazonSerializableWebServiceRequest.h>
-#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/stream/ReadOnlyStringStream.h>
 
 using namespace Aws;
 
 std::shared_ptr<Aws::IOStream> AmazonSerializableWebServiceRequest::GetBody() const
 {
-    Aws::String&& payload = SerializePayload();
+    Aws::String payload = SerializePayload();
     std::shared_ptr<Aws::IOStream> payloadBody;
 
     if (!payload.empty())
     {
-      payloadBody = Aws::MakeShared<Aws::StringStream>("AmazonSerializableWebServiceRequest");
-      *payloadBody << payload;
+      payloadBody = Aws::MakeShared<Aws::Utils::Stream::ReadOnlyStringStream>("AmazonSerializableWebServiceRequest", std::move(payload));
     }
 
     return payloadBody;
@@ -24,7 +24,8 @@ AmazonWebServiceRequest::AmazonWebServiceRequest() :
     m_onDataSent(nullptr),
     m_continueRequest(nullptr),
     m_onRequestSigned(nullptr),
-    m_requestRetryHandler(nullptr)
+    m_requestRetryHandler(nullptr),
+    m_hedgingPolicy(nullptr)
 {
 }
 
@@ -101,6 +101,7 @@ namespace Aws
 
         Aws::Http::SetInitCleanupCurlFlag(options.httpOptions.initAndCleanupCurl);
         Aws::Http::SetInstallSigPipeHandlerFlag(options.httpOptions.installSigPipeHandler);
+        Aws::Http::SetShareCurlCachesFlag(options.httpOptions.shareCurlCaches);
         Aws::Http::InitHttp();
         Aws::InitializeEnumOverflowContainer();
         cJSON_Hooks hooks;
@@ -31,6 +31,8 @@
 #include <aws/core/utils/event/EventMessage.h>
 #include <aws/core/utils/event/EventHeader.h>
 
+#include <algorithm>
+#include <cctype>
 #include <cstdio>
 #include <iomanip>
 #include <math.h>
@@ -64,6 +66,14 @@ static const char* LONG_DATE_FORMAT_STR = "%Y%m%dT%H%M%SZ";
 static const char* SIMPLE_DATE_FORMAT_STR = "%Y%m%d";
 static const char* EMPTY_STRING_SHA256 = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
 
+static const size_t SIMPLE_DATE_LENGTH = 8;
+//a handful of regions and services per signer, plus the previous day's keys around midnight.
+static const size_t SIGNING_KEY_CACHE_SIZE = 16;
+//room for the fixed parts of the strings built while signing, so they are allocated once.
+static const size_t CANONICAL_REQUEST_RESERVE = 1024;
+static const size_t STRING_TO_SIGN_RESERVE = 64;
+static const size_t AUTHORIZATION_RESERVE = 192;
+
 static const char v4LogTag[] = "AWSAuthV4Signer";
 static const char v4StreamingLogTag[] = "AWSAuthEventStreamV4Signer";
 
@@ -80,81 +90,194 @@ namespace Aws
     }
 }
 
-static Aws::String CanonicalizeRequestSigningString(HttpRequest& request, bool urlEscapePath)
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+static bool IsSpace(char c)
 {
-    request.CanonicalizeRequest();
-    Aws::StringStream signingStringStream;
-    signingStringStream << HttpMethodMapper::GetNameForHttpMethod(request.GetMethod());
+    return c >= 0 && ::isspace(c) != 0;
+}
 
-    URI uriCpy = request.GetUri();
-    // Many AWS services do not decode the URL before calculating SignatureV4 on their end.
-    // This results in the signature getting calculated with a double encoded URL.
-    // That means we have to double encode it here for the signature to match on the service side.
-    if(urlEscapePath)
+static void TrimRange(const char*& begin, const char*& end)
+{
+    while (begin < end && IsSpace(*begin))
     {
-        // RFC3986 is how we encode the URL before sending it on the wire.
-        auto rfc3986EncodedPath = URI::URLEncodePathRFC3986(uriCpy.GetPath());
-        uriCpy.SetPath(rfc3986EncodedPath);
-        // However, SignatureV4 uses this URL encoding scheme
-        signingStringStream << NEWLINE << uriCpy.GetURLEncodedPath() << NEWLINE;
+        ++begin;
     }
-    else
+    while (end > begin && IsSpace(*(end - 1)))
     {
-        // For the services that DO decode the URL first; we don't need to double encode it.
-        uriCpy.SetPath(uriCpy.GetURLEncodedPath());
-        signingStringStream << NEWLINE << uriCpy.GetPath() << NEWLINE;
+        --end;
     }
+}
 
-    if (request.GetQueryString().find('=') != std::string::npos)
-    {
-        signingStringStream << request.GetQueryString().substr(1) << NEWLINE;
-    }
-    else if (request.GetQueryString().size() > 1)
+static void AppendPercentEncoded(Aws::String& out, unsigned char c)
+{
+    out.push_back('%');
+    out.push_back(HEX_DIGITS[c >> 4]);
+    out.push_back(HEX_DIGITS[c & 0xF]);
+}
+
+/**
+ * Appends the path as SignatureV4 expects it, segment by segment without copying the uri.
+ * Segments are url encoded; with urlEscapePath they are RFC 3986 encoded first, so anything that encoding escapes ends up
+ * double encoded (%25XX), the same as URLEncodePathRFC3986 followed by URLEncodePath.
+ */
+static void AppendCanonicalPath(Aws::String& out, const Aws::String& path, bool urlEscapePath)
+{
+    const char* cursor = path.c_str();
+    const char* end = cursor + path.size();
+    while (cursor < end)
     {
-        signingStringStream << request.GetQueryString().substr(1) << "=" << NEWLINE;
+        const char* segmentEnd = std::find(cursor, end, '/');
+        if (segmentEnd != cursor)
+        {
+            out.push_back('/');
+        }
+        for (; cursor < segmentEnd; ++cursor)
+        {
+            const unsigned char c = static_cast<unsigned char>(*cursor);
+            if (StringUtils::IsAlnum(c) || c == '-' || c == '_' || c == '.' || c == '~')
+            {
+                out.push_back(c);
+                continue;
+            }
+
+            if (urlEscapePath)
+            {
+                switch (c)
+                {
+                    case '$': case '&': case ',':
+                    case ':': case '=': case '@':
+                        break;
+                    default:
+                        out.append("%25");
+                        out.push_back(HEX_DIGITS[c >> 4]);
+                        out.push_back(HEX_DIGITS[c & 0xF]);
+                        continue;
+                }
+            }
+            AppendPercentEncoded(out, c);
+        }
+        cursor = segmentEnd == end ? end : segmentEnd + 1;
     }
-    else
+
+    //if the last character was also a slash, then add that back here.
+    if (path.empty() || path.back() == '/')
     {
-        signingStringStream << NEWLINE;
+        out.push_back('/');
     }
-
-    return signingStringStream.str();
 }
 
-static Http::HeaderValueCollection CanonicalizeHeaders(Http::HeaderValueCollection&& headers)
+/**
+ * Appends the header value with surrounding whitespace trimmed, lines joined as line1,line2 and runs of spaces collapsed to one.
+ */
+static void AppendCanonicalHeaderValue(Aws::String& out, const Aws::String& value)
 {
-    Http::HeaderValueCollection canonicalHeaders;
-    for (const auto& header : headers)
-    {
-        auto trimmedHeaderName = StringUtils::Trim(header.first.c_str());
-        auto trimmedHeaderValue = StringUtils::Trim(header.second.c_str());
+    const char* cursor = value.c_str();
+    const char* end = cursor + value.size();
+    TrimRange(cursor, end);
+
+    const size_t valueStart = out.size();
+    bool firstLine = true;
+    while (cursor < end)
+    {
+        const char* lineBegin = cursor;
+        const char* lineEnd = std::find(cursor, end, '\n');
+        cursor = lineEnd == end ? end : lineEnd + 1;
+        if (lineBegin == lineEnd)
+        {
+            continue;
+        }
 
-        //multiline gets converted to line1,line2,etc...
-        auto headerMultiLine = StringUtils::SplitOnLine(trimmedHeaderValue);
-        Aws::String headerValue = headerMultiLine.size() == 0 ? "" : headerMultiLine[0];
+        if (!firstLine)
+        {
+            out.push_back(',');
+            TrimRange(lineBegin, lineEnd);
+        }
+        firstLine = false;
 
-        if (headerMultiLine.size() > 1)
+        for (; lineBegin < lineEnd; ++lineBegin)
         {
-            for(size_t i = 1; i < headerMultiLine.size(); ++i)
+            if (*lineBegin == ' ' && out.size() > valueStart && out.back() == ' ')
             {
-                headerValue += ",";
-                headerValue += StringUtils::Trim(headerMultiLine[i].c_str());
+                continue;
             }
+            out.push_back(*lineBegin);
         }
+    }
+}
 
-        //duplicate spaces need to be converted to one.
-        Aws::String::iterator new_end =
-            std::unique(headerValue.begin(), headerValue.end(),
-                [=](char lhs, char rhs) { return (lhs == rhs) && (lhs == ' '); }
-        );
-        headerValue.erase(new_end, headerValue.end());
+/**
+ * Appends "name:value\n" for every header the signer signs to canonicalHeaders and their names, separated by ';', to signedHeaders.
+ */
+template<typename SIGNER>
+static void CanonicalizeHeaders(const SIGNER& signer, const HttpRequest& request,
+        Aws::String& canonicalHeaders, Aws::String& signedHeaders)
+{
+    request.VisitHeaders([&](const Aws::String& name, const Aws::String& value)
+    {
+        const char* nameBegin = name.c_str();
+        const char* nameEnd = nameBegin + name.size();
+        TrimRange(nameBegin, nameEnd);
+        const bool trimmed = nameBegin != name.c_str() || nameEnd != name.c_str() + name.size();
+        if (trimmed ? !signer.ShouldSignHeader(Aws::String(nameBegin, nameEnd)) : !signer.ShouldSignHeader(name))
+        {
+            return;
+        }
 
-        canonicalHeaders[trimmedHeaderName] = headerValue;       
-    }
+        canonicalHeaders.append(nameBegin, nameEnd);
+        canonicalHeaders.push_back(':');
+        AppendCanonicalHeaderValue(canonicalHeaders, value);
+        canonicalHeaders.append(NEWLINE);
 
-    return canonicalHeaders;
+        if (!signedHeaders.empty())
+        {
+            signedHeaders.push_back(';');
+        }
+        signedHeaders.append(nameBegin, nameEnd);
+    });
+}
+
+/**
+ * Appends the method, path and query string lines of the canonical request.
+ */
+static void AppendCanonicalRequestLines(Aws::String& out, HttpRequest& request, bool urlEscapePath)
+{
+    request.CanonicalizeRequest();
+    out.append(HttpMethodMapper::GetNameForHttpMethod(request.GetMethod()));
+    out.append(NEWLINE);
+    // Many AWS services do not decode the URL before calculating SignatureV4 on their end.
+    // This results in the signature getting calculated with a double encoded URL.
+    // That means we have to double encode it here for the signature to match on the service side.
+    AppendCanonicalPath(out, request.GetUri().GetPath(), urlEscapePath);
+    out.append(NEWLINE);
+
+    const Aws::String& queryString = request.GetQueryString();
+    if (queryString.find('=') != std::string::npos)
+    {
+        out.append(queryString, 1, Aws::String::npos);
+    }
+    else if (queryString.size() > 1)
+    {
+        out.append(queryString, 1, Aws::String::npos);
+        out.append(EQ);
+    }
+    out.append(NEWLINE);
 }
 
+struct AWSAuthV4Signer::SigningKey
+{
+    bool Matches(const Aws::String& secret, const Aws::String& date, const Aws::String& keyRegion, const Aws::String& keyService) const
+    {
+        return simpleDate == date && region == keyRegion && serviceName == keyService && secretKey == secret;
+    }
+
+    Aws::String secretKey;
+    Aws::String simpleDate;
+    Aws::String region;
+    Aws::String serviceName;
+    ByteBuffer key;
+};
+
 AWSAuthV4Signer::AWSAuthV4Signer(const std::shared_ptr<Auth::AWSCredentialsProvider>& credentialsProvider,
     const char* serviceName, const Aws::String& region, PayloadSigningPolicy signingPolicy, bool urlEscapePath) :
     m_includeSha256HashHeader(true),
@@ -164,11 +287,14 @@ AWSAuthV4Signer::AWSAuthV4Signer(const std::shared_ptr<Auth::AWSCredentialsProvi
     m_hash(Aws::MakeUnique<Aws::Utils::Crypto::Sha256>(v4LogTag)),
     m_HMAC(Aws::MakeUnique<Aws::Utils::Crypto::Sha256HMAC>(v4LogTag)),
     m_unsignedHeaders({USER_AGENT, X_AMZN_TRACE_ID}),
+    m_signingKeys(),
     m_payloadSigningPolicy(signingPolicy),
     m_urlEscapePath(urlEscapePath)
 {
+    m_signingKeys = Aws::MakeShared<SigningKeyList>(v4LogTag);
     //go ahead and warm up the signing cache.
-    ComputeHash(credentialsProvider->GetAWSCredentials().GetAWSSecretKey(), DateTime::CalculateGmtTimestampAsString(SIMPLE_DATE_FORMAT_STR));
+    GetSigningKey(credentialsProvider->GetAWSCredentials().GetAWSSecretKey(), DateTime::CalculateGmtTimestampAsString(SIMPLE_DATE_FORMAT_STR),
+            m_region, m_serviceName);
 }
 
 AWSAuthV4Signer::~AWSAuthV4Signer()
@@ -179,6 +305,11 @@ AWSAuthV4Signer::~AWSAuthV4Signer()
 
 bool AWSAuthV4Signer::ShouldSignHeader(const Aws::String& header) const
 {
+    //headers are almost always lowercased already, skip the copy for them.
+    if (std::none_of(header.cbegin(), header.cend(), [](char c) { return c >= 'A' && c <= 'Z'; }))
+    {
+        return m_unsignedHeaders.find(header) == m_unsignedHeaders.cend();
+    }
     return m_unsignedHeaders.find(Aws::Utils::StringUtils::ToLower(header.c_str())) == m_unsignedHeaders.cend();
 }
 
@@ -203,21 +334,7 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, bool signBody
     }
 
     Aws::String payloadHash(UNSIGNED_PAYLOAD);
-    switch(m_payloadSigningPolicy)
-    {
-        case PayloadSigningPolicy::Always:
-            signBody = true;
-            break;
-        case PayloadSigningPolicy::Never:
-            signBody = false;
-            break;
-        case PayloadSigningPolicy::RequestDependent:
-            // respect the request setting
-        default:
-            break;
-    }
-
-    if(signBody || request.GetUri().GetScheme() != Http::Scheme::HTTPS)
+    if(SignsPayload(request, signBody))
     {
         payloadHash = ComputePayloadHash(request);
         if (payloadHash.empty())
@@ -228,6 +345,7 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, bool signBody
     else
     {
         AWS_LOGSTREAM_DEBUG(v4LogTag, "Note: Http payloads are not being signed. signPayloads=" << signBody
+                << " payloadSigningPolicy=" << static_cast<int>(m_payloadSigningPolicy)
                 << " http scheme=" << Http::SchemeMapper::ToString(request.GetUri().GetScheme()));
     }
 
@@ -241,36 +359,16 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, bool signBody
     Aws::String dateHeaderValue = now.ToGmtString(LONG_DATE_FORMAT_STR);
     request.SetHeaderValue(AWS_DATE_HEADER, dateHeaderValue);
 
-    Aws::StringStream headersStream;
-    Aws::StringStream signedHeadersStream;
-
-    for (const auto& header : CanonicalizeHeaders(request.GetHeaders()))
-    {
-        if(ShouldSignHeader(header.first))
-        {
-            headersStream << header.first.c_str() << ":" << header.second.c_str() << NEWLINE;
-            signedHeadersStream << header.first.c_str() << ";";
-        }
-    }
-
-    Aws::String canonicalHeadersString = headersStream.str();
-    AWS_LOGSTREAM_DEBUG(v4LogTag, "Canonical Header String: " << canonicalHeadersString);
-
-    //calculate signed headers parameter
-    Aws::String signedHeadersValue = signedHeadersStream.str();
-    //remove that last semi-colon
-    if (!signedHeadersValue.empty())
-    {
-        signedHeadersValue.pop_back();
-    }
+    //generate generalized canonicalized request string, headers are canonicalized straight into it.
+    Aws::String canonicalRequestString;
+    canonicalRequestString.reserve(CANONICAL_REQUEST_RESERVE + request.GetUri().GetPath().size() * 3 + request.GetQueryString().size());
+    AppendCanonicalRequestLines(canonicalRequestString, request, m_urlEscapePath);
 
+    Aws::String signedHeadersValue;
+    CanonicalizeHeaders(*this, request, canonicalRequestString, signedHeadersValue);
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Signed Headers value:" << signedHeadersValue);
 
-    //generate generalized canonicalized request string.
-    Aws::String canonicalRequestString = CanonicalizeRequestSigningString(request, m_urlEscapePath);
-
     //append v4 stuff to the canonical request string.
-    canonicalRequestString.append(canonicalHeadersString);
     canonicalRequestString.append(NEWLINE);
     canonicalRequestString.append(signedHeadersValue);
     canonicalRequestString.append(NEWLINE);
@@ -287,20 +385,21 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, bool signBody
         return false;
     }
 
-    auto sha256Digest = hashResult.GetResult();
-    Aws::String cannonicalRequestHash = HashingUtils::HexEncode(sha256Digest);
-    Aws::String simpleDate = now.ToGmtString(SIMPLE_DATE_FORMAT_STR);
+    Aws::String cannonicalRequestHash = HashingUtils::HexEncode(hashResult.GetResult());
+    Aws::String simpleDate = dateHeaderValue.substr(0, SIMPLE_DATE_LENGTH);
 
     Aws::String stringToSign = GenerateStringToSign(dateHeaderValue, simpleDate, cannonicalRequestHash, m_region,
             m_serviceName);
     auto finalSignature = GenerateSignature(credentials, stringToSign, simpleDate);
 
-    Aws::StringStream ss;
-    ss << AWS_HMAC_SHA256 << " " << CREDENTIAL << EQ << credentials.GetAWSAccessKeyId() << "/" << simpleDate
-        << "/" << m_region << "/" << m_serviceName << "/" << AWS4_REQUEST << ", " << SIGNED_HEADERS << EQ
-        << signedHeadersValue << ", " << SIGNATURE << EQ << finalSignature;
+    Aws::String awsAuthString;
+    awsAuthString.reserve(AUTHORIZATION_RESERVE + credentials.GetAWSAccessKeyId().size() + m_region.size() + m_serviceName.size()
+            + signedHeadersValue.size());
+    awsAuthString.append(AWS_HMAC_SHA256).append(" ").append(CREDENTIAL).append(EQ).append(credentials.GetAWSAccessKeyId())
+        .append("/").append(simpleDate).append("/").append(m_region).append("/").append(m_serviceName).append("/").append(AWS4_REQUEST)
+        .append(", ").append(SIGNED_HEADERS).append(EQ).append(signedHeadersValue)
+        .append(", ").append(SIGNATURE).append(EQ).append(finalSignature);
 
-    auto awsAuthString = ss.str();
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Signing request with: " << awsAuthString);
     request.SetAwsAuthorization(awsAuthString);
     request.SetSigningAccessKey(credentials.GetAWSAccessKeyId());
@@ -308,6 +407,25 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, bool signBody
     return true;
 }
 
+bool AWSAuthV4Signer::SignsPayload(const Aws::Http::HttpRequest& request, bool signBody) const
+{
+    switch(m_payloadSigningPolicy)
+    {
+        case PayloadSigningPolicy::Always:
+            signBody = true;
+            break;
+        case PayloadSigningPolicy::Never:
+            signBody = false;
+            break;
+        case PayloadSigningPolicy::RequestDependent:
+            // respect the request setting
+        default:
+            break;
+    }
+
+    return signBody || request.GetUri().GetScheme() != Http::Scheme::HTTPS;
+}
+
 bool AWSAuthV4Signer::PresignRequest(Aws::Http::HttpRequest& request, long long expirationTimeInSeconds) const
 {
     return PresignRequest(request, m_region.c_str(), expirationTimeInSeconds);
@@ -342,45 +460,31 @@ bool AWSAuthV4Signer::PresignRequest(Aws::Http::HttpRequest& request, const char
     Aws::String dateQueryValue = now.ToGmtString(LONG_DATE_FORMAT_STR);
     request.AddQueryStringParameter(Http::AWS_DATE_HEADER, dateQueryValue);
 
-    Aws::StringStream headersStream;
-    Aws::StringStream signedHeadersStream;
-    for (const auto& header : CanonicalizeHeaders(request.GetHeaders()))
-    {
-        if(ShouldSignHeader(header.first))
-        {
-            headersStream << header.first.c_str() << ":" << header.second.c_str() << NEWLINE;
-            signedHeadersStream << header.first.c_str() << ";";
-        }
-    }
-
-    Aws::String canonicalHeadersString = headersStream.str();
+    //the signed headers go into the query string, so the headers are canonicalized before the rest of the request.
+    Aws::String canonicalHeadersString;
+    Aws::String signedHeadersValue;
+    CanonicalizeHeaders(*this, request, canonicalHeadersString, signedHeadersValue);
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Canonical Header String: " << canonicalHeadersString);
 
-    //calculate signed headers parameter
-    Aws::String signedHeadersValue(signedHeadersStream.str());
-    //remove that last semi-colon
-    if (!signedHeadersValue.empty())
-    {
-        signedHeadersValue.pop_back();
-    }
-
     request.AddQueryStringParameter(X_AMZ_SIGNED_HEADERS, signedHeadersValue);
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Signed Headers value: " << signedHeadersValue);
 
-    Aws::StringStream ss;
-    Aws::String simpleDate = now.ToGmtString(SIMPLE_DATE_FORMAT_STR);
-    ss << credentials.GetAWSAccessKeyId() << "/" << simpleDate
-        << "/" << region << "/" << serviceName << "/" << AWS4_REQUEST;
+    Aws::String simpleDate = dateQueryValue.substr(0, SIMPLE_DATE_LENGTH);
+    Aws::String credentialScope(credentials.GetAWSAccessKeyId());
+    credentialScope.append("/").append(simpleDate).append("/").append(region).append("/").append(serviceName)
+        .append("/").append(AWS4_REQUEST);
 
     request.AddQueryStringParameter(X_AMZ_ALGORITHM, AWS_HMAC_SHA256);
-    request.AddQueryStringParameter(X_AMZ_CREDENTIAL, ss.str());
-    ss.str("");
+    request.AddQueryStringParameter(X_AMZ_CREDENTIAL, credentialScope);
 
     request.SetSigningAccessKey(credentials.GetAWSAccessKeyId());
     request.SetSigningRegion(region);
 
     //generate generalized canonicalized request string.
-    Aws::String canonicalRequestString = CanonicalizeRequestSigningString(request, m_urlEscapePath);
+    Aws::String canonicalRequestString;
+    canonicalRequestString.reserve(CANONICAL_REQUEST_RESERVE + request.GetUri().GetPath().size() * 3 + request.GetQueryString().size()
+            + canonicalHeadersString.size());
+    AppendCanonicalRequestLines(canonicalRequestString, request, m_urlEscapePath);
 
     //append v4 stuff to the canonical request string.
     canonicalRequestString.append(canonicalHeadersString);
@@ -437,23 +541,21 @@ bool AWSAuthV4Signer::ServiceRequireUnsignedPayload(const Aws::String& serviceNa
 Aws::String AWSAuthV4Signer::GenerateSignature(const AWSCredentials& credentials, const Aws::String& stringToSign,
         const Aws::String& simpleDate) const
 {
-    auto key = ComputeHash(credentials.GetAWSSecretKey(), simpleDate);
-    return GenerateSignature(stringToSign, key);
+    auto signingKey = GetSigningKey(credentials.GetAWSSecretKey(), simpleDate, m_region, m_serviceName);
+    return GenerateSignature(stringToSign, signingKey->key);
 }
 
 Aws::String AWSAuthV4Signer::GenerateSignature(const AWSCredentials& credentials, const Aws::String& stringToSign,
         const Aws::String& simpleDate, const Aws::String& region, const Aws::String& serviceName) const
 {
-    auto key = ComputeHash(credentials.GetAWSSecretKey(), simpleDate, region, serviceName);
-    return GenerateSignature(stringToSign, key);
+    auto signingKey = GetSigningKey(credentials.GetAWSSecretKey(), simpleDate, region, serviceName);
+    return GenerateSignature(stringToSign, signingKey->key);
 }
 
 Aws::String AWSAuthV4Signer::GenerateSignature(const Aws::String& stringToSign, const ByteBuffer& key) const
 {
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Final String to sign: " << stringToSign);
 
-    Aws::StringStream ss;
-
     auto hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)stringToSign.c_str(), stringToSign.length()), key);
     if (!hashResult.IsSuccess())
     {
@@ -479,6 +581,12 @@ Aws::String AWSAuthV4Signer::ComputePayloadHash(Aws::Http::HttpRequest& request)
         return EMPTY_STRING_SHA256;
     }
 
+    if (!request.GetContentBodySha256().empty())
+    {
+        AWS_LOGSTREAM_DEBUG(v4LogTag, "Using previously calculated sha256 " << request.GetContentBodySha256() << " for payload.");
+        return request.GetContentBodySha256();
+    }
+
     //compute hash on payload if it exists.
     auto hashResult =  m_hash->Calculate(*request.GetContentBody());
 
@@ -498,6 +606,7 @@ Aws::String AWSAuthV4Signer::ComputePayloadHash(Aws::Http::HttpRequest& request)
 
     Aws::String payloadHash(HashingUtils::HexEncode(sha256Digest));
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Calculated sha256 " << payloadHash << " for payload.");
+    request.SetContentBodySha256(payloadHash);
     return payloadHash;
 }
 
@@ -505,29 +614,61 @@ Aws::String AWSAuthV4Signer::GenerateStringToSign(const Aws::String& dateValue,
         const Aws::String& canonicalRequestHash, const Aws::String& region, const Aws::String& serviceName) const
 {
     //generate the actual string we will use in signing the final request.
-    Aws::StringStream ss;
+    Aws::String stringToSign;
+    stringToSign.reserve(STRING_TO_SIGN_RESERVE + dateValue.size() + simpleDate.size() + region.size() + serviceName.size()
+            + canonicalRequestHash.size());
+    stringToSign.append(AWS_HMAC_SHA256).append(NEWLINE).append(dateValue).append(NEWLINE).append(simpleDate).append("/")
+        .append(region).append("/").append(serviceName).append("/").append(AWS4_REQUEST).append(NEWLINE).append(canonicalRequestHash);
 
-    ss << AWS_HMAC_SHA256 << NEWLINE << dateValue << NEWLINE << simpleDate << "/" << region << "/"
-        << serviceName << "/" << AWS4_REQUEST << NEWLINE << canonicalRequestHash;
-
-    return ss.str();
+    return stringToSign;
 }
 
-ByteBuffer AWSAuthV4Signer::ComputeHash(const Aws::String& secretKey, const Aws::String& simpleDate) const
+std::shared_ptr<const AWSAuthV4Signer::SigningKey> AWSAuthV4Signer::GetSigningKey(const Aws::String& secretKey,
+        const Aws::String& simpleDate, const Aws::String& region, const Aws::String& serviceName) const
 {
-    Utils::Threading::ReaderLockGuard guard(m_partialSignatureLock);
-    if (m_currentDateStr != simpleDate || m_currentSecretKey != secretKey)
+    auto signingKeys = std::atomic_load(&m_signingKeys);
+    for (const auto& cached : *signingKeys)
     {
-        guard.UpgradeToWriterLock();
-        // check again to prevent racing writers
-        if (m_currentDateStr != simpleDate || m_currentSecretKey != secretKey)
+        if (cached->Matches(secretKey, simpleDate, region, serviceName))
         {
-            m_currentSecretKey = secretKey;
-            m_currentDateStr = simpleDate;
-            m_partialSignature = ComputeHash(m_currentSecretKey, m_currentDateStr, m_region, m_serviceName);
+            return cached;
         }
     }
-    return m_partialSignature;
+
+    auto signingKey = Aws::MakeShared<SigningKey>(v4LogTag);
+    signingKey->secretKey = secretKey;
+    signingKey->simpleDate = simpleDate;
+    signingKey->region = region;
+    signingKey->serviceName = serviceName;
+    signingKey->key = ComputeHash(secretKey, simpleDate, region, serviceName);
+    if (signingKey->key.GetLength() == 0)
+    {
+        return signingKey;
+    }
+
+    //publish a copy of the list with the new key in front, dropping the oldest once full.
+    //if another thread published first, rebuild from its list; a key it added for the same scope is not duplicated.
+    std::shared_ptr<const SigningKeyList> updatedKeys;
+    do
+    {
+        auto keys = Aws::MakeShared<SigningKeyList>(v4LogTag);
+        keys->reserve(SIGNING_KEY_CACHE_SIZE);
+        keys->push_back(signingKey);
+        for (const auto& cached : *signingKeys)
+        {
+            if (keys->size() == SIGNING_KEY_CACHE_SIZE)
+            {
+                break;
+            }
+            if (!cached->Matches(secretKey, simpleDate, region, serviceName))
+            {
+                keys->push_back(cached);
+            }
+        }
+        updatedKeys = keys;
+    } while (!std::atomic_compare_exchange_weak(&m_signingKeys, &signingKeys, updatedKeys));
+
+    return signingKey;
 }
 
 Aws::Utils::ByteBuffer AWSAuthV4Signer::ComputeHash(const Aws::String& secretKey,
@@ -605,36 +746,16 @@ bool AWSAuthEventStreamV4Signer::SignRequest(Aws::Http::HttpRequest& request, bo
     Aws::String dateHeaderValue = now.ToGmtString(LONG_DATE_FORMAT_STR);
     request.SetHeaderValue(AWS_DATE_HEADER, dateHeaderValue);
 
-    Aws::StringStream headersStream;
-    Aws::StringStream signedHeadersStream;
-
-    for (const auto& header : CanonicalizeHeaders(request.GetHeaders()))
-    {
-        if(ShouldSignHeader(header.first))
-        {
-            headersStream << header.first.c_str() << ":" << header.second.c_str() << NEWLINE;
-            signedHeadersStream << header.first.c_str() << ";";
-        }
-    }
-
-    Aws::String canonicalHeadersString = headersStream.str();
-    AWS_LOGSTREAM_DEBUG(v4StreamingLogTag, "Canonical Header String: " << canonicalHeadersString);
-
-    //calculate signed headers parameter
-    Aws::String signedHeadersValue = signedHeadersStream.str();
-    //remove that last semi-colon
-    if (!signedHeadersValue.empty())
-    {
-        signedHeadersValue.pop_back();
-    }
+    //generate generalized canonicalized request string, headers are canonicalized straight into it.
+    Aws::String canonicalRequestString;
+    canonicalRequestString.reserve(CANONICAL_REQUEST_RESERVE + request.GetUri().GetPath().size() * 3 + request.GetQueryString().size());
+    AppendCanonicalRequestLines(canonicalRequestString, request, true/* m_urlEscapePath */);
 
+    Aws::String signedHeadersValue;
+    CanonicalizeHeaders(*this, request, canonicalRequestString, signedHeadersValue);
     AWS_LOGSTREAM_DEBUG(v4StreamingLogTag, "Signed Headers value:" << signedHeadersValue);
 
-    //generate generalized canonicalized request string.
-    Aws::String canonicalRequestString = CanonicalizeRequestSigningString(request, true/* m_urlEscapePath */);
-
     //append v4 stuff to the canonical request string.
-    canonicalRequestString.append(canonicalHeadersString);
     canonicalRequestString.append(NEWLINE);
     canonicalRequestString.append(signedHeadersValue);
     canonicalRequestString.append(NEWLINE);
@@ -794,12 +915,13 @@ Aws::String AWSAuthEventStreamV4Signer::GenerateStringToSign(const Aws::String&
         const Aws::String& canonicalRequestHash, const Aws::String& region, const Aws::String& serviceName) const
 {
     //generate the actual string we will use in signing the final request.
-    Aws::StringStream ss;
-
-    ss << AWS_HMAC_SHA256 << NEWLINE << dateValue << NEWLINE << simpleDate << "/" << region << "/"
-        << serviceName << "/" << AWS4_REQUEST << NEWLINE << canonicalRequestHash;
+    Aws::String stringToSign;
+    stringToSign.reserve(STRING_TO_SIGN_RESERVE + dateValue.size() + simpleDate.size() + region.size() + serviceName.size()
+            + canonicalRequestHash.size());
+    stringToSign.append(AWS_HMAC_SHA256).append(NEWLINE).append(dateValue).append(NEWLINE).append(simpleDate).append("/")
+        .append(region).append("/").append(serviceName).append("/").append(AWS4_REQUEST).append(NEWLINE).append(canonicalRequestHash);
 
-    return ss.str();
+    return stringToSign;
 }
 
 ByteBuffer AWSAuthEventStreamV4Signer::ComputeHash(const Aws::String& secretKey, const Aws::String& simpleDate) const
@@ -21,6 +21,7 @@
 #include <aws/core/client/AWSErrorMarshaller.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/client/CoreErrors.h>
+#include <aws/core/client/HedgingPolicy.h>
 #include <aws/core/client/RetryStrategy.h>
 #include <aws/core/http/HttpClient.h>
 #include <aws/core/http/HttpClientFactory.h>
@@ -41,9 +42,13 @@
 #include <aws/core/http/URI.h>
 #include <aws/core/monitoring/MonitoringManager.h>
 #include <aws/core/utils/event/EventStream.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/core/utils/threading/TimerQueue.h>
 
 #include <cstring>
 #include <cassert>
+#include <mutex>
+#include <condition_variable>
 
 using namespace Aws;
 using namespace Aws::Client;
@@ -61,6 +66,97 @@ static const std::chrono::milliseconds TIME_DIFF_MAX = std::chrono::minutes(4);
 //-4 Minutes
 static const std::chrono::milliseconds TIME_DIFF_MIN = std::chrono::minutes(-4);
 
+struct AWSClient::AsyncRequestContext
+{
+    Aws::Http::URI uri;
+    std::shared_ptr<const Aws::AmazonWebServiceRequest> request;
+    HttpMethod method;
+    const char* signerName;
+    HttpResponseOutcomeHandler handler;
+    std::shared_ptr<Aws::Utils::Threading::Executor> executor;
+    std::shared_ptr<HttpRequest> httpRequest;
+    std::shared_ptr<Aws::IOStream> body;
+    std::shared_ptr<HttpRequest> previousAttempt;
+    Aws::Vector<void*> monitoringContexts;
+    Aws::Monitoring::CoreMetricsCollection coreMetrics;
+    long retries;
+};
+
+/**
+ * The attempts of a hedged request: the original one and, once it has been outstanding for the hedge delay, its duplicate.
+ * The first to complete wins, unless it got no response at all while the other is still in flight.
+ */
+struct AWSClient::HedgedAttempts
+{
+    static const size_t MAX_ATTEMPTS = 2;
+
+    HedgedAttempts() : started(0), completed(0), winner(-1) {}
+
+    bool HasLost(size_t index) const
+    {
+        int decided = winner.load();
+        return decided >= 0 && static_cast<size_t>(decided) != index;
+    }
+
+    /**
+     * Waits up to timeout for a winner; returns true if there is one.
+     */
+    bool WaitForWinner(std::chrono::microseconds timeout)
+    {
+        std::unique_lock<std::mutex> locker(lock);
+        return decided.wait_for(locker, timeout, [this] { return winner.load() >= 0; });
+    }
+
+    void WaitForWinner()
+    {
+        std::unique_lock<std::mutex> locker(lock);
+        decided.wait(locker, [this] { return winner.load() >= 0; });
+    }
+
+    /**
+     * Claims the slot of the next attempt; fails if a winner is already known, in which case the attempt shouldn't be sent.
+     */
+    bool TryStart(const std::shared_ptr<HttpRequest>& httpRequest, size_t& index)
+    {
+        std::lock_guard<std::mutex> locker(lock);
+        if (winner.load() >= 0 || started == MAX_ATTEMPTS)
+        {
+            return false;
+        }
+        index = started++;
+        requests[index] = httpRequest;
+        startTimes[index] = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    void Complete(size_t index, const std::shared_ptr<HttpResponse>& httpResponse)
+    {
+        std::lock_guard<std::mutex> locker(lock);
+        if (winner.load() >= 0)
+        {
+            return;
+        }
+        responses[index] = httpResponse;
+        latencies[index] = std::chrono::steady_clock::now() - startTimes[index];
+        completed++;
+        if (httpResponse || completed == started)
+        {
+            winner = static_cast<int>(index);
+            decided.notify_all();
+        }
+    }
+
+    std::mutex lock;
+    std::condition_variable decided;
+    size_t started;
+    size_t completed;
+    std::atomic<int> winner;
+    std::shared_ptr<HttpRequest> requests[MAX_ATTEMPTS];
+    std::shared_ptr<HttpResponse> responses[MAX_ATTEMPTS];
+    std::chrono::steady_clock::time_point startTimes[MAX_ATTEMPTS];
+    std::chrono::steady_clock::duration latencies[MAX_ATTEMPTS];
+};
+
 static CoreErrors GuessBodylessErrorType(Aws::Http::HttpResponseCode responseCode)
 {
     switch (responseCode)
@@ -86,7 +182,9 @@ AWSClient::AWSClient(const Aws::Client::ClientConfiguration& configuration,
     m_readRateLimiter(configuration.readRateLimiter),
     m_userAgent(configuration.userAgent),
     m_hash(Aws::Utils::Crypto::CreateMD5Implementation()),
-    m_enableClockSkewAdjustment(configuration.enableClockSkewAdjustment)
+    m_enableClockSkewAdjustment(configuration.enableClockSkewAdjustment),
+    m_retryTimer(Aws::MakeShared<Aws::Utils::Threading::TimerQueue>(AWS_CLIENT_LOG_TAG)),
+    m_hedgePoolSize((std::max)(configuration.maxConnections, 1u))
 {
 }
 
@@ -101,7 +199,9 @@ AWSClient::AWSClient(const Aws::Client::ClientConfiguration& configuration,
     m_readRateLimiter(configuration.readRateLimiter),
     m_userAgent(configuration.userAgent),
     m_hash(Aws::Utils::Crypto::CreateMD5Implementation()),
-    m_enableClockSkewAdjustment(configuration.enableClockSkewAdjustment)
+    m_enableClockSkewAdjustment(configuration.enableClockSkewAdjustment),
+    m_retryTimer(Aws::MakeShared<Aws::Utils::Threading::TimerQueue>(AWS_CLIENT_LOG_TAG)),
+    m_hedgePoolSize((std::max)(configuration.maxConnections, 1u))
 {
 }
 
@@ -115,6 +215,11 @@ void AWSClient::EnableRequestProcessing()
     m_httpClient->EnableRequestProcessing();
 }
 
+size_t AWSClient::WarmUpConnections(const Aws::Http::URI& endpoint, size_t connectionCount)
+{
+    return m_httpClient->WarmUpConnections(endpoint, connectionCount);
+}
+
 Aws::Client::AWSAuthSigner* AWSClient::GetSignerByName(const char* name) const
 {
     const auto& signer =  m_signerProvider->GetSigner(name);
@@ -177,11 +282,17 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
     HttpResponseOutcome outcome;
     Aws::Monitoring::CoreMetricsCollection coreMetrics;
     auto contexts = Aws::Monitoring::OnRequestStarted(this->GetServiceClientName(), request.GetServiceRequestName(), httpRequest);
+    //serialize the payload once, every attempt rewinds and resends the same stream.
+    std::shared_ptr<Aws::IOStream> body = request.GetBody();
+    std::shared_ptr<HttpRequest> previousAttempt;
 
     for (long retries = 0;; retries++)
     {
-        outcome = AttemptOneRequest(httpRequest, request, signerName);
+        WaitForSendToken();
+        outcome = request.GetHedgingPolicy() ? AttemptHedgedRequest(httpRequest, uri, method, request, body, previousAttempt, signerName)
+                                             : AttemptOneRequest(httpRequest, request, body, previousAttempt, signerName);
         coreMetrics.httpClientMetrics = httpRequest->GetRequestMetrics();
+        RecordAttemptOutcome(outcome, retries);
         if (outcome.IsSuccess())
         {
             Aws::Monitoring::OnRequestSucceeded(this->GetServiceClientName(), request.GetServiceRequestName(), httpRequest, outcome, coreMetrics, contexts);
@@ -191,38 +302,18 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
 
         Aws::Monitoring::OnRequestFailed(this->GetServiceClientName(), request.GetServiceRequestName(), httpRequest, outcome, coreMetrics, contexts);
 
-        if (!m_httpClient->IsRequestProcessingEnabled())
-        {
-            AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Request was cancelled externally.");
-            break;
-        }
-
-        long sleepMillis = m_retryStrategy->CalculateDelayBeforeNextRetry(outcome.GetError(), retries);
-        //AdjustClockSkew returns true means clock skew was the problem and skew was adjusted, false otherwise.
-        //sleep if clock skew was NOT the problem. AdjustClockSkew may update error inside outcome.
-        bool shouldSleep = !AdjustClockSkew(outcome, signerName);
-
-        if (!m_retryStrategy->ShouldRetry(outcome.GetError(), retries))
+        std::chrono::milliseconds delay(0);
+        auto previousBody = body;
+        if (!PrepareRetry(outcome, request, retries, signerName, body, delay))
         {
             break;
         }
 
-        AWS_LOGSTREAM_WARN(AWS_CLIENT_LOG_TAG, "Request failed, now waiting " << sleepMillis << " ms before attempting again.");
-        if(request.GetBody())
-        {
-            request.GetBody()->clear();
-            request.GetBody()->seekg(0);
-        }
-
-        if (request.GetRequestRetryHandler())
+        if (delay.count() > 0)
         {
-            request.GetRequestRetryHandler()(request);
-        }
-
-        if (shouldSleep)
-        {
-            m_httpClient->RetryRequestSleep(std::chrono::milliseconds(sleepMillis));
+            m_httpClient->RetryRequestSleep(delay);
         }
+        previousAttempt = body == previousBody ? httpRequest : nullptr;
         httpRequest = CreateHttpRequest(uri, method, request.GetResponseStreamFactory());
         Aws::Monitoring::OnRequestRetry(this->GetServiceClientName(), request.GetServiceRequestName(), httpRequest, contexts);
     }
@@ -239,8 +330,10 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri, Ht
 
     for (long retries = 0;; retries++)
     {
+        WaitForSendToken();
         outcome = AttemptOneRequest(httpRequest, signerName);
         coreMetrics.httpClientMetrics = httpRequest->GetRequestMetrics();
+        RecordAttemptOutcome(outcome, retries);
         if (outcome.IsSuccess())
         {
             Aws::Monitoring::OnRequestSucceeded(this->GetServiceClientName(), requestName, httpRequest, outcome, coreMetrics, contexts);
@@ -279,6 +372,31 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri, Ht
     return outcome;
 }
 
+void AWSClient::WaitForSendToken() const
+{
+    for (long sendDelay = m_retryStrategy->AcquireSendToken(); sendDelay > 0; sendDelay = m_retryStrategy->AcquireSendToken())
+    {
+        if (!m_httpClient->IsRequestProcessingEnabled())
+        {
+            return;
+        }
+        AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Retry strategy is pacing requests, waiting " << sendDelay << " ms before sending.");
+        m_httpClient->RetryRequestSleep(std::chrono::milliseconds(sendDelay));
+    }
+}
+
+void AWSClient::RecordAttemptOutcome(const HttpResponseOutcome& outcome, long retries) const
+{
+    if (outcome.IsSuccess())
+    {
+        m_retryStrategy->OnAttemptSucceeded(retries);
+    }
+    else
+    {
+        m_retryStrategy->OnAttemptFailed(outcome.GetError(), retries);
+    }
+}
+
 static bool DoesResponseGenerateError(const std::shared_ptr<HttpResponse>& response)
 {
     if (!response) return true;
@@ -288,15 +406,199 @@ static bool DoesResponseGenerateError(const std::shared_ptr<HttpResponse>& respo
 
 }
 
-HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpRequest>& httpRequest,
-    const Aws::AmazonWebServiceRequest& request, const char* signerName) const
+bool AWSClient::PrepareRetry(HttpResponseOutcome& outcome, const Aws::AmazonWebServiceRequest& request, long retries,
+    const char* signerName, std::shared_ptr<Aws::IOStream>& body, std::chrono::milliseconds& delay) const
+{
+    if (!m_httpClient->IsRequestProcessingEnabled())
+    {
+        AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Request was cancelled externally.");
+        return false;
+    }
+
+    long sleepMillis = m_retryStrategy->CalculateDelayBeforeNextRetry(outcome.GetError(), retries);
+    //AdjustClockSkew returns true means clock skew was the problem and skew was adjusted, false otherwise.
+    //sleep if clock skew was NOT the problem. AdjustClockSkew may update error inside outcome.
+    bool shouldSleep = !AdjustClockSkew(outcome, signerName);
+
+    if (!m_retryStrategy->ShouldRetry(outcome.GetError(), retries))
+    {
+        return false;
+    }
+
+    AWS_LOGSTREAM_WARN(AWS_CLIENT_LOG_TAG, "Request failed, now waiting " << sleepMillis << " ms before attempting again.");
+    if(body)
+    {
+        body->clear();
+        body->seekg(0);
+    }
+
+    if (request.GetRequestRetryHandler())
+    {
+        request.GetRequestRetryHandler()(request);
+        //the handler may have modified the request, so its payload can't be assumed to be the one already serialized.
+        body = request.GetBody();
+    }
+
+    delay = std::chrono::milliseconds(shouldSleep ? sleepMillis : 0);
+    return true;
+}
+
+void AWSClient::AttemptExhaustivelyAsync(const Aws::Http::URI& uri,
+    const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+    HttpMethod method,
+    const char* signerName,
+    const HttpResponseOutcomeHandler& handler,
+    const std::shared_ptr<Aws::Utils::Threading::Executor>& executor) const
+{
+    auto context = Aws::MakeShared<AsyncRequestContext>(AWS_CLIENT_LOG_TAG);
+    context->uri = uri;
+    context->request = request;
+    context->method = method;
+    context->signerName = signerName;
+    context->handler = handler;
+    context->executor = executor;
+    context->httpRequest = CreateHttpRequest(uri, method, request->GetResponseStreamFactory());
+    context->monitoringContexts = Aws::Monitoring::OnRequestStarted(this->GetServiceClientName(), request->GetServiceRequestName(), context->httpRequest);
+    context->body = request->GetBody();
+    context->retries = 0;
+
+    AttemptOneRequestAsync(context);
+}
+
+bool AWSClient::SupportsNonBlockingRequests() const
+{
+    return m_httpClient->SupportsNonBlockingRequests();
+}
+
+void AWSClient::AttemptOneRequestAsync(const std::shared_ptr<AsyncRequestContext>& context) const
+{
+    long sendDelay = m_httpClient->IsRequestProcessingEnabled() ? m_retryStrategy->AcquireSendToken() : 0;
+    if (sendDelay > 0)
+    {
+        AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Retry strategy is pacing requests, waiting " << sendDelay << " ms before sending.");
+        m_retryTimer->Schedule(std::chrono::milliseconds(sendDelay), [this, context]()
+        {
+            ContinueAttemptAsync(context, [this, context]() { AttemptOneRequestAsync(context); });
+        });
+        return;
+    }
+    SendAttemptAsync(context);
+}
+
+void AWSClient::ContinueAttemptAsync(const std::shared_ptr<AsyncRequestContext>& context, const std::function<void()>& step) const
+{
+    if (!context->executor || !context->executor->Submit(step))
+    {
+        step();
+    }
+}
+
+void AWSClient::SendAttemptAsync(const std::shared_ptr<AsyncRequestContext>& context) const
+{
+    if (!BuildAndSignAttempt(context->httpRequest, *context->request, context->body, context->previousAttempt, context->signerName))
+    {
+        HttpResponseOutcome outcome(AWSError<CoreErrors>(CoreErrors::CLIENT_SIGNING_FAILURE, "", "SDK failed to sign the request", false/*retryable*/));
+        OnAsyncAttemptCompleted(context, outcome);
+        return;
+    }
+
+    m_httpClient->MakeRequestAsync(context->httpRequest,
+        [this, context](const std::shared_ptr<HttpRequest>& httpRequest, const std::shared_ptr<HttpResponse>& httpResponse)
+        {
+            HttpResponseOutcome outcome = BuildAttemptOutcome(httpRequest, httpResponse);
+            OnAsyncAttemptCompleted(context, outcome);
+        },
+        m_readRateLimiter.get(), m_writeRateLimiter.get());
+}
+
+void AWSClient::OnAsyncAttemptCompleted(const std::shared_ptr<AsyncRequestContext>& context, HttpResponseOutcome& outcome) const
+{
+    const char* requestName = context->request->GetServiceRequestName();
+    context->coreMetrics.httpClientMetrics = context->httpRequest->GetRequestMetrics();
+    RecordAttemptOutcome(outcome, context->retries);
+    if (outcome.IsSuccess())
+    {
+        Aws::Monitoring::OnRequestSucceeded(this->GetServiceClientName(), requestName, context->httpRequest, outcome, context->coreMetrics, context->monitoringContexts);
+        AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Request successful returning.");
+    }
+    else
+    {
+        Aws::Monitoring::OnRequestFailed(this->GetServiceClientName(), requestName, context->httpRequest, outcome, context->coreMetrics, context->monitoringContexts);
+
+        std::chrono::milliseconds delay(0);
+        auto previousBody = context->body;
+        if (PrepareRetry(outcome, *context->request, context->retries, context->signerName, context->body, delay))
+        {
+            context->previousAttempt = context->body == previousBody ? context->httpRequest : nullptr;
+            auto retry = [this, context]()
+            {
+                context->retries++;
+                context->httpRequest = CreateHttpRequest(context->uri, context->method, context->request->GetResponseStreamFactory());
+                Aws::Monitoring::OnRequestRetry(this->GetServiceClientName(), context->request->GetServiceRequestName(), context->httpRequest, context->monitoringContexts);
+                AttemptOneRequestAsync(context);
+            };
+
+            // this is the http client's I/O thread, and the timer has one thread for every client's retries; neither builds the retry.
+            if (delay.count() > 0)
+            {
+                m_retryTimer->Schedule(delay, [this, context, retry]() { ContinueAttemptAsync(context, retry); });
+            }
+            else
+            {
+                ContinueAttemptAsync(context, retry);
+            }
+            return;
+        }
+    }
+
+    Aws::Monitoring::OnFinish(this->GetServiceClientName(), requestName, context->httpRequest, context->monitoringContexts);
+    // this may be one of the executor's threads, which mustn't be left holding the last reference to it.
+    context->executor = nullptr;
+    context->handler(outcome);
+}
+
+bool AWSClient::BuildAndSignAttempt(const std::shared_ptr<HttpRequest>& httpRequest, const Aws::AmazonWebServiceRequest& request,
+    const std::shared_ptr<Aws::IOStream>& body, const std::shared_ptr<HttpRequest>& previousAttempt, const char* signerName) const
 {
-    BuildHttpRequest(request, httpRequest);
+    //the previous attempt sent the same bytes, so whatever it computed about them still holds.
+    if (previousAttempt && body)
+    {
+        if (previousAttempt->HasHeader(Http::CONTENT_LENGTH_HEADER))
+        {
+            httpRequest->SetContentLength(previousAttempt->GetContentLength());
+        }
+        if (previousAttempt->HasHeader(Http::CONTENT_MD5_HEADER))
+        {
+            httpRequest->SetHeaderValue(Http::CONTENT_MD5_HEADER, previousAttempt->GetHeaderValue(Http::CONTENT_MD5_HEADER));
+        }
+    }
+
     auto signer = GetSignerByName(signerName);
+
+    //a body that needs a content-md5 and is going to be hashed by the signer as well is read once for both.
+    if (body && request.ShouldComputeContentMd5() && !request.IsEventStreamRequest() && !httpRequest->HasHeader(Http::CONTENT_MD5_HEADER)
+        && httpRequest->GetContentBodySha256().empty() && signer->SignsPayload(*httpRequest, request.SignBody()))
+    {
+        ByteBuffer md5;
+        ByteBuffer sha256;
+        if (HashingUtils::CalculateMD5AndSHA256(*body, md5, sha256))
+        {
+            httpRequest->SetHeaderValue(Http::CONTENT_MD5_HEADER, HashingUtils::Base64Encode(md5));
+            httpRequest->SetContentBodySha256(HashingUtils::HexEncode(sha256));
+        }
+    }
+
+    BuildHttpRequest(request, httpRequest, body);
+
+    if (previousAttempt && body)
+    {
+        httpRequest->SetContentBodySha256(previousAttempt->GetContentBodySha256());
+    }
+
     if (!signer->SignRequest(*httpRequest, request.SignBody()))
     {
         AWS_LOGSTREAM_ERROR(AWS_CLIENT_LOG_TAG, "Request signing failed. Returning error.");
-        return HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::CLIENT_SIGNING_FAILURE, "", "SDK failed to sign the request", false/*retryable*/));
+        return false;
     }
 
     if (request.GetRequestSignedHandler())
@@ -305,9 +607,12 @@ HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpReque
     }
 
     AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Request Successfully signed");
-    std::shared_ptr<HttpResponse> httpResponse(
-        m_httpClient->MakeRequest(httpRequest, m_readRateLimiter.get(), m_writeRateLimiter.get()));
+    return true;
+}
 
+HttpResponseOutcome AWSClient::BuildAttemptOutcome(const std::shared_ptr<HttpRequest>& httpRequest,
+    const std::shared_ptr<HttpResponse>& httpResponse) const
+{
     if (DoesResponseGenerateError(httpResponse))
     {
         AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Request returned error. Attempting to generate appropriate error codes from response");
@@ -325,6 +630,147 @@ HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpReque
     return HttpResponseOutcome(httpResponse);
 }
 
+HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpRequest>& httpRequest,
+    const Aws::AmazonWebServiceRequest& request, const char* signerName) const
+{
+    return AttemptOneRequest(httpRequest, request, request.GetBody(), nullptr, signerName);
+}
+
+HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpRequest>& httpRequest, const Aws::AmazonWebServiceRequest& request,
+    const std::shared_ptr<Aws::IOStream>& body, const std::shared_ptr<HttpRequest>& previousAttempt, const char* signerName) const
+{
+    if (!BuildAndSignAttempt(httpRequest, request, body, previousAttempt, signerName))
+    {
+        return HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::CLIENT_SIGNING_FAILURE, "", "SDK failed to sign the request", false/*retryable*/));
+    }
+
+    std::shared_ptr<HttpResponse> httpResponse(
+        m_httpClient->MakeRequest(httpRequest, m_readRateLimiter.get(), m_writeRateLimiter.get()));
+
+    return BuildAttemptOutcome(httpRequest, httpResponse);
+}
+
+HttpResponseOutcome AWSClient::AttemptHedgedRequest(std::shared_ptr<HttpRequest>& httpRequest, const Aws::Http::URI& uri, HttpMethod method,
+    const Aws::AmazonWebServiceRequest& request, const std::shared_ptr<Aws::IOStream>& body,
+    const std::shared_ptr<HttpRequest>& previousAttempt, const char* signerName) const
+{
+    if (!BuildAndSignAttempt(httpRequest, request, body, previousAttempt, signerName))
+    {
+        return HttpResponseOutcome(AWSError<CoreErrors>(CoreErrors::CLIENT_SIGNING_FAILURE, "", "SDK failed to sign the request", false/*retryable*/));
+    }
+
+    const auto& policy = request.GetHedgingPolicy();
+    auto hedgeDelay = policy->GetHedgeDelay();
+    auto attempts = Aws::MakeShared<HedgedAttempts>(AWS_CLIENT_LOG_TAG);
+    size_t index = 0;
+    attempts->TryStart(httpRequest, index);
+    CancelAttemptOnceLost(attempts, index, httpRequest);
+
+    // both attempts go out off this thread, which only waits for the first of them to complete.
+    SendHedgedAttempt(attempts, index, httpRequest);
+    if (!attempts->WaitForWinner(hedgeDelay))
+    {
+        auto hedgeRequest = StartHedgeAttempt(attempts, uri, method, request, body, signerName, index);
+        if (hedgeRequest)
+        {
+            SendHedgedAttempt(attempts, index, hedgeRequest);
+        }
+    }
+    attempts->WaitForWinner();
+
+    size_t winner = static_cast<size_t>(attempts->winner.load());
+    if (attempts->started > 1)
+    {
+        policy->RecordHedge(winner > 0);
+    }
+    policy->RecordLatency(attempts->latencies[winner]);
+    httpRequest = attempts->requests[winner];
+    return BuildAttemptOutcome(httpRequest, attempts->responses[winner]);
+}
+
+std::shared_ptr<HttpRequest> AWSClient::StartHedgeAttempt(const std::shared_ptr<HedgedAttempts>& attempts, const Aws::Http::URI& uri,
+    HttpMethod method, const Aws::AmazonWebServiceRequest& request, const std::shared_ptr<Aws::IOStream>& body, const char* signerName,
+    size_t& index) const
+{
+    if (!m_httpClient->IsRequestProcessingEnabled())
+    {
+        return nullptr;
+    }
+
+    // the duplicate needs a payload of its own; a body the request hands out again as is would be read by both attempts at once.
+    auto hedgeBody = request.GetBody();
+    if (body && hedgeBody == body)
+    {
+        AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Not hedging " << request.GetServiceRequestName() << ", its body can't be sent twice at once.");
+        return nullptr;
+    }
+
+    // the duplicate is an attempt like any other as far as the retry strategy's pacing goes, but it isn't worth waiting for a token.
+    if (m_retryStrategy->AcquireSendToken() > 0)
+    {
+        AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Not hedging " << request.GetServiceRequestName() << ", the retry strategy is pacing requests.");
+        return nullptr;
+    }
+
+    auto hedgeRequest = CreateHttpRequest(uri, method, request.GetResponseStreamFactory());
+    if (!BuildAndSignAttempt(hedgeRequest, request, hedgeBody, nullptr, signerName) || !attempts->TryStart(hedgeRequest, index))
+    {
+        return nullptr;
+    }
+
+    AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Hedging " << request.GetServiceRequestName() << " after "
+            << request.GetHedgingPolicy()->GetHedgeDelay().count() << " us.");
+    CancelAttemptOnceLost(attempts, index, hedgeRequest);
+    return hedgeRequest;
+}
+
+void AWSClient::CancelAttemptOnceLost(const std::shared_ptr<HedgedAttempts>& attempts, size_t index, const std::shared_ptr<HttpRequest>& httpRequest) const
+{
+    // the attempt that loses is cancelled through its continue handler, which the http client polls while the transfer is in progress.
+    // attempts holds the request, so the handler only holds on to it weakly.
+    auto continueRequest = httpRequest->GetContinueRequestHandler();
+    std::weak_ptr<HedgedAttempts> weakAttempts(attempts);
+    httpRequest->SetContinueRequestHandle([weakAttempts, index, continueRequest](const HttpRequest* request)
+    {
+        auto pending = weakAttempts.lock();
+        return !(pending && pending->HasLost(index)) && (!continueRequest || continueRequest(request));
+    });
+}
+
+void AWSClient::SendHedgedAttempt(const std::shared_ptr<HedgedAttempts>& attempts, size_t index, const std::shared_ptr<HttpRequest>& httpRequest) const
+{
+    if (m_httpClient->SupportsNonBlockingRequests())
+    {
+        m_httpClient->MakeRequestAsync(httpRequest, [attempts, index](const std::shared_ptr<HttpRequest>&, const std::shared_ptr<HttpResponse>& httpResponse)
+        {
+            attempts->Complete(index, httpResponse);
+        }, m_readRateLimiter.get(), m_writeRateLimiter.get());
+        return;
+    }
+
+    // a blocking http client only notices that an attempt lost when it next polls the continue handler, which for a stalled transfer can
+    // take a while; the thread it blocks meanwhile is one of the hedge executor's rather than the caller's.
+    auto httpClient = m_httpClient;
+    auto readLimiter = m_readRateLimiter.get();
+    auto writeLimiter = m_writeRateLimiter.get();
+    GetHedgeExecutor()->Submit([attempts, index, httpRequest, httpClient, readLimiter, writeLimiter]()
+    {
+        attempts->Complete(index, httpClient->MakeRequest(httpRequest, readLimiter, writeLimiter));
+    });
+}
+
+std::shared_ptr<Aws::Utils::Threading::Executor> AWSClient::GetHedgeExecutor() const
+{
+    // created on first use, most clients never hedge on a blocking http client. A blocking client can't have more than maxConnections
+    // transfers in flight, so neither does the pool.
+    std::lock_guard<std::mutex> locker(m_hedgeExecutorLock);
+    if (!m_hedgeExecutor)
+    {
+        m_hedgeExecutor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(AWS_CLIENT_LOG_TAG, m_hedgePoolSize);
+    }
+    return m_hedgeExecutor;
+}
+
 HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpRequest>& httpRequest, const char* signerName, const char* requestName) const
 {
     AWS_UNREFERENCED_PARAM(requestName);
@@ -354,12 +800,8 @@ HttpResponseOutcome AWSClient::AttemptOneRequest(const std::shared_ptr<HttpReque
     return HttpResponseOutcome(httpResponse);
 }
 
-StreamOutcome AWSClient::MakeRequestWithUnparsedResponse(const Aws::Http::URI& uri,
-    const Aws::AmazonWebServiceRequest& request,
-    Http::HttpMethod method,
-    const char* signerName) const
+static StreamOutcome TakeResponseStream(const HttpResponseOutcome& httpResponseOutcome)
 {
-    HttpResponseOutcome httpResponseOutcome = AttemptExhaustively(uri, request, method, signerName);
     if (httpResponseOutcome.IsSuccess())
     {
         return StreamOutcome(AmazonWebServiceResult<Stream::ResponseStream>(
@@ -370,18 +812,35 @@ StreamOutcome AWSClient::MakeRequestWithUnparsedResponse(const Aws::Http::URI& u
     return StreamOutcome(httpResponseOutcome.GetError());
 }
 
+StreamOutcome AWSClient::MakeRequestWithUnparsedResponse(const Aws::Http::URI& uri,
+    const Aws::AmazonWebServiceRequest& request,
+    Http::HttpMethod method,
+    const char* signerName) const
+{
+    return TakeResponseStream(AttemptExhaustively(uri, request, method, signerName));
+}
+
 StreamOutcome AWSClient::MakeRequestWithUnparsedResponse(const Aws::Http::URI& uri, Http::HttpMethod method, 
         const char* signerName, const char* requestName) const
 {
-    HttpResponseOutcome httpResponseOutcome = AttemptExhaustively(uri, method, signerName, requestName);
-    if (httpResponseOutcome.IsSuccess())
-    {
-        return StreamOutcome(AmazonWebServiceResult<Stream::ResponseStream>(
-            httpResponseOutcome.GetResult()->SwapResponseStreamOwnership(),
-            httpResponseOutcome.GetResult()->GetHeaders(), httpResponseOutcome.GetResult()->GetResponseCode()));
-    }
+    return TakeResponseStream(AttemptExhaustively(uri, method, signerName, requestName));
+}
 
-    return StreamOutcome(httpResponseOutcome.GetError());
+void AWSClient::MakeRequestWithUnparsedResponseAsync(const Aws::Http::URI& uri,
+    const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+    Http::HttpMethod method,
+    const char* signerName,
+    const std::shared_ptr<Aws::Utils::Threading::Executor>& executor,
+    const StreamOutcomeHandler& handler) const
+{
+    AttemptExhaustivelyAsync(uri, request, method, signerName,
+        [executor, handler](const HttpResponseOutcome& httpOutcome)
+        {
+            if (!executor || !executor->Submit([handler, httpOutcome]() { handler(TakeResponseStream(httpOutcome)); }))
+            {
+                handler(TakeResponseStream(httpOutcome));
+            }
+        }, executor);
 }
 
 XmlOutcome AWSXMLClient::MakeRequestWithEventStream(const Aws::Http::URI& uri,
@@ -503,17 +962,23 @@ Aws::String Aws::Client::GetAuthorizationHeader(const Aws::Http::HttpRequest& ht
 
 void AWSClient::BuildHttpRequest(const Aws::AmazonWebServiceRequest& request,
     const std::shared_ptr<HttpRequest>& httpRequest) const
+{
+    BuildHttpRequest(request, httpRequest, request.GetBody());
+}
+
+void AWSClient::BuildHttpRequest(const Aws::AmazonWebServiceRequest& request,
+    const std::shared_ptr<HttpRequest>& httpRequest, const std::shared_ptr<Aws::IOStream>& body) const
 {
     //do headers first since the request likely will set content-length as it's own header.
     AddHeadersToRequest(httpRequest, request.GetHeaders());
 
     if (request.IsEventStreamRequest())
     {
-        httpRequest->AddContentBody(request.GetBody());
+        httpRequest->AddContentBody(body);
     }
     else
     {
-        AddContentBodyToRequest(httpRequest, request.GetBody(), request.ShouldComputeContentMd5(), request.IsStreaming() && request.IsChunked() && m_httpClient->SupportsChunkedTransferEncoding());
+        AddContentBodyToRequest(httpRequest, body, request.ShouldComputeContentMd5(), request.IsStreaming() && request.IsChunked() && m_httpClient->SupportsChunkedTransferEncoding());
     }
 
     // Pass along handlers for processing data sent/received in bytes
@@ -664,28 +1129,11 @@ JsonOutcome AWSJsonClient::MakeRequest(const Aws::Http::URI& uri,
     Http::HttpMethod method,
     const char* signerName) const
 {
-    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, request, method, signerName));
-    if (!httpOutcome.IsSuccess())
-    {
-        return JsonOutcome(httpOutcome.GetError());
-    }
-
-    if (httpOutcome.GetResult()->GetResponseBody().tellp() > 0)
-        //this is stupid, but gcc doesn't pick up the covariant on the dereference so we have to give it a little hint.
-        return JsonOutcome(AmazonWebServiceResult<JsonValue>(JsonValue(httpOutcome.GetResult()->GetResponseBody()),
-        httpOutcome.GetResult()->GetHeaders(),
-        httpOutcome.GetResult()->GetResponseCode()));
-
-    else
-        return JsonOutcome(AmazonWebServiceResult<JsonValue>(JsonValue(), httpOutcome.GetResult()->GetHeaders()));
+    return ParseJsonOutcome(BASECLASS::AttemptExhaustively(uri, request, method, signerName));
 }
 
-JsonOutcome AWSJsonClient::MakeRequest(const Aws::Http::URI& uri,
-    Http::HttpMethod method,
-    const char* signerName,
-    const char* requestName) const
+JsonOutcome AWSJsonClient::ParseJsonOutcome(const HttpResponseOutcome& httpOutcome)
 {
-    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, method, signerName, requestName));
     if (!httpOutcome.IsSuccess())
     {
         return JsonOutcome(httpOutcome.GetError());
@@ -708,6 +1156,31 @@ JsonOutcome AWSJsonClient::MakeRequest(const Aws::Http::URI& uri,
     return JsonOutcome(AmazonWebServiceResult<JsonValue>(JsonValue(), httpOutcome.GetResult()->GetHeaders()));
 }
 
+JsonOutcome AWSJsonClient::MakeRequest(const Aws::Http::URI& uri,
+    Http::HttpMethod method,
+    const char* signerName,
+    const char* requestName) const
+{
+    return ParseJsonOutcome(BASECLASS::AttemptExhaustively(uri, method, signerName, requestName));
+}
+
+void AWSJsonClient::MakeRequestAsync(const Aws::Http::URI& uri,
+    const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+    Http::HttpMethod method,
+    const char* signerName,
+    const std::shared_ptr<Aws::Utils::Threading::Executor>& executor,
+    const JsonOutcomeHandler& handler) const
+{
+    BASECLASS::AttemptExhaustivelyAsync(uri, request, method, signerName,
+        [executor, handler](const HttpResponseOutcome& httpOutcome)
+        {
+            if (!executor || !executor->Submit([handler, httpOutcome]() { handler(ParseJsonOutcome(httpOutcome)); }))
+            {
+                handler(ParseJsonOutcome(httpOutcome));
+            }
+        }, executor);
+}
+
 JsonOutcome AWSJsonClient::MakeEventStreamRequest(std::shared_ptr<Aws::Http::HttpRequest>& request) const
 {
     // request is assumed to be signed
@@ -722,23 +1195,7 @@ JsonOutcome AWSJsonClient::MakeEventStreamRequest(std::shared_ptr<Aws::Http::Htt
 
     AWS_LOGSTREAM_DEBUG(AWS_CLIENT_LOG_TAG, "Request returned successful response.");
 
-    HttpResponseOutcome httpOutcome(httpResponse);
-
-    if (httpOutcome.GetResult()->GetResponseBody().tellp() > 0)
-    {
-        JsonValue jsonValue(httpOutcome.GetResult()->GetResponseBody());
-        if (!jsonValue.WasParseSuccessful())
-        {
-            return JsonOutcome(AWSError<CoreErrors>(CoreErrors::UNKNOWN, "Json Parser Error", jsonValue.GetErrorMessage(), false));
-        }
-
-        //this is stupid, but gcc doesn't pick up the covariant on the dereference so we have to give it a little hint.
-        return JsonOutcome(AmazonWebServiceResult<JsonValue>(std::move(jsonValue),
-            httpOutcome.GetResult()->GetHeaders(),
-            httpOutcome.GetResult()->GetResponseCode()));
-    }
-
-    return JsonOutcome(AmazonWebServiceResult<JsonValue>(JsonValue(), httpOutcome.GetResult()->GetHeaders()));
+    return ParseJsonOutcome(HttpResponseOutcome(httpResponse));
 }
 
 AWSError<CoreErrors> AWSJsonClient::BuildAWSError(
@@ -789,12 +1246,8 @@ AWSXMLClient::AWSXMLClient(const Aws::Client::ClientConfiguration& configuration
 {
 }
 
-XmlOutcome AWSXMLClient::MakeRequest(const Aws::Http::URI& uri,
-    const Aws::AmazonWebServiceRequest& request,
-    Http::HttpMethod method,
-    const char* signerName) const
+XmlOutcome AWSXMLClient::ParseXmlOutcome(const HttpResponseOutcome& httpOutcome)
 {
-    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, request, method, signerName));
     if (!httpOutcome.IsSuccess())
     {
         return XmlOutcome(httpOutcome.GetError());
@@ -817,25 +1270,43 @@ XmlOutcome AWSXMLClient::MakeRequest(const Aws::Http::URI& uri,
     return XmlOutcome(AmazonWebServiceResult<XmlDocument>(XmlDocument(), httpOutcome.GetResult()->GetHeaders()));
 }
 
+AWSError<CoreErrors> AWSXMLClient::BuildXmlParseError(const XmlReader& reader)
+{
+    AWS_LOGSTREAM_ERROR(AWS_CLIENT_LOG_TAG, "Xml parsing for response failed with message " << reader.GetErrorMessage().c_str());
+    return AWSError<CoreErrors>(CoreErrors::UNKNOWN, "Xml Parse Error", reader.GetErrorMessage(), false);
+}
+
 XmlOutcome AWSXMLClient::MakeRequest(const Aws::Http::URI& uri,
+    const Aws::AmazonWebServiceRequest& request,
     Http::HttpMethod method,
-    const char* signerName,
-    const char* requestName) const
+    const char* signerName) const
 {
-    HttpResponseOutcome httpOutcome(BASECLASS::AttemptExhaustively(uri, method, signerName, requestName));
-    if (!httpOutcome.IsSuccess())
-    {
-        return XmlOutcome(httpOutcome.GetError());
-    }
+    return ParseXmlOutcome(BASECLASS::AttemptExhaustively(uri, request, method, signerName));
+}
 
-    if (httpOutcome.GetResult()->GetResponseBody().tellp() > 0)
-    {
-        return XmlOutcome(AmazonWebServiceResult<XmlDocument>(
-            XmlDocument::CreateFromXmlStream(httpOutcome.GetResult()->GetResponseBody()),
-            httpOutcome.GetResult()->GetHeaders(), httpOutcome.GetResult()->GetResponseCode()));
-    }
+void AWSXMLClient::MakeRequestAsync(const Aws::Http::URI& uri,
+    const std::shared_ptr<const Aws::AmazonWebServiceRequest>& request,
+    Http::HttpMethod method,
+    const char* signerName,
+    const std::shared_ptr<Aws::Utils::Threading::Executor>& executor,
+    const XmlOutcomeHandler& handler) const
+{
+    BASECLASS::AttemptExhaustivelyAsync(uri, request, method, signerName,
+        [executor, handler](const HttpResponseOutcome& httpOutcome)
+        {
+            if (!executor || !executor->Submit([handler, httpOutcome]() { handler(ParseXmlOutcome(httpOutcome)); }))
+            {
+                handler(ParseXmlOutcome(httpOutcome));
+            }
+        }, executor);
+}
 
-    return XmlOutcome(AmazonWebServiceResult<XmlDocument>(XmlDocument(), httpOutcome.GetResult()->GetHeaders()));
+XmlOutcome AWSXMLClient::MakeRequest(const Aws::Http::URI& uri,
+    Http::HttpMethod method,
+    const char* signerName,
+    const char* requestName) const
+{
+    return ParseXmlOutcome(BASECLASS::AttemptExhaustively(uri, method, signerName, requestName));
 }
 
 AWSError<CoreErrors> AWSXMLClient::BuildAWSError(const std::shared_ptr<Http::HttpResponse>& httpResponse) const
@@ -0,0 +1,273 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/core/client/AdaptiveRetryStrategy.h>
+
+#include <aws/core/client/AWSError.h>
+#include <aws/core/client/CoreErrors.h>
+#include <aws/core/utils/UnreferencedParam.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Aws;
+using namespace Aws::Client;
+
+// tokens a retry takes out of the retry bucket, and what a request that succeeds on its first attempt puts back
+static const long RETRY_COST = 5;
+static const long NO_RETRY_INCREMENT = 1;
+
+// fraction of the measured send rate the fill rate is cut to on throttling, and how steep the cubic regrowth is
+static const double BETA = 0.7;
+static const double SCALE_CONSTANT = 0.4;
+// weight of the newest sample in the smoothed send rate, and the length in seconds of the intervals it is sampled over
+static const double SMOOTH = 0.8;
+static const double RATE_BUCKET_SECONDS = 0.5;
+static const double MIN_FILL_RATE = 0.5;
+static const double MIN_CAPACITY = 1.0;
+
+static const char* const THROTTLING_EXCEPTION_NAMES[] =
+{
+    "Throttling",
+    "ThrottlingException",
+    "ThrottledException",
+    "RequestThrottledException",
+    "RequestThrottled",
+    "TooManyRequestsException",
+    "ProvisionedThroughputExceededException",
+    "TransactionInProgressException",
+    "RequestLimitExceeded",
+    "BandwidthLimitExceeded",
+    "LimitExceededException",
+    "PriorRequestNotComplete",
+    "EC2ThrottledException",
+    "SlowDown",
+    "SlowDownException",
+};
+
+RetryTokenBucket::RetryTokenBucket(long capacity) :
+    m_capacity(capacity), m_available(capacity)
+{
+}
+
+bool RetryTokenBucket::TryAcquire(long tokens)
+{
+    long available = m_available.load();
+    do
+    {
+        if (available < tokens)
+        {
+            return false;
+        }
+    } while (!m_available.compare_exchange_weak(available, available - tokens));
+    return true;
+}
+
+void RetryTokenBucket::Release(long tokens)
+{
+    long available = m_available.load();
+    while (available < m_capacity && !m_available.compare_exchange_weak(available, (std::min)(m_capacity, available + tokens)))
+    {
+    }
+}
+
+SendRateLimiter::SendRateLimiter(ClockFunctionType clock) :
+    m_clock(clock),
+    m_start(m_clock()),
+    m_enabled(false),
+    m_fillRate(0),
+    m_maxCapacity(0),
+    m_capacity(0),
+    m_lastRefill(0),
+    m_measuredSendRate(0),
+    m_lastRateBucket(0),
+    m_requestsInBucket(0),
+    m_lastMaxRate(0),
+    m_lastThrottle(0),
+    m_timeWindow(0)
+{
+}
+
+double SendRateLimiter::Now() const
+{
+    return std::chrono::duration<double>(m_clock() - m_start).count();
+}
+
+void SendRateLimiter::Refill(double now)
+{
+    m_capacity = (std::min)(m_maxCapacity, m_capacity + (now - m_lastRefill) * m_fillRate);
+    m_lastRefill = now;
+}
+
+void SendRateLimiter::UpdateMeasuredRate(double now)
+{
+    double rateBucket = std::floor(now / RATE_BUCKET_SECONDS) * RATE_BUCKET_SECONDS;
+    m_requestsInBucket++;
+    if (rateBucket > m_lastRateBucket)
+    {
+        double currentRate = m_requestsInBucket / (rateBucket - m_lastRateBucket);
+        m_measuredSendRate = currentRate * SMOOTH + m_measuredSendRate * (1 - SMOOTH);
+        m_requestsInBucket = 0;
+        m_lastRateBucket = rateBucket;
+    }
+}
+
+long SendRateLimiter::AcquireToken()
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    if (!m_enabled)
+    {
+        return 0;
+    }
+
+    Refill(Now());
+    if (m_capacity >= 1)
+    {
+        m_capacity -= 1;
+        return 0;
+    }
+    // no debt is taken on: the caller asks again once the token should be there, by which time the rate may have changed
+    return (std::max)(1L, static_cast<long>(std::ceil((1 - m_capacity) / m_fillRate * 1000)));
+}
+
+void SendRateLimiter::UpdateSendRate(bool throttled)
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    double now = Now();
+    UpdateMeasuredRate(now);
+
+    double calculatedRate;
+    if (throttled)
+    {
+        double rateToUse = m_enabled ? (std::min)(m_measuredSendRate, m_fillRate) : m_measuredSendRate;
+        m_lastMaxRate = rateToUse;
+        m_timeWindow = std::cbrt(m_lastMaxRate * (1 - BETA) / SCALE_CONSTANT);
+        m_lastThrottle = now;
+        calculatedRate = rateToUse * BETA;
+        m_enabled = true;
+    }
+    else if (m_enabled)
+    {
+        calculatedRate = SCALE_CONSTANT * std::pow(now - m_lastThrottle - m_timeWindow, 3) + m_lastMaxRate;
+    }
+    else
+    {
+        return;
+    }
+
+    // never let the rate run ahead of twice what the client actually sends, or a quiet client would build up an unbounded allowance
+    double newRate = (std::min)(calculatedRate, 2 * m_measuredSendRate);
+    Refill(now);
+    m_fillRate = (std::max)(newRate, MIN_FILL_RATE);
+    m_maxCapacity = (std::max)(newRate, MIN_CAPACITY);
+    m_capacity = (std::min)(m_capacity, m_maxCapacity);
+}
+
+bool SendRateLimiter::IsEnabled() const
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    return m_enabled;
+}
+
+double SendRateLimiter::GetFillRate() const
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    return m_fillRate;
+}
+
+double SendRateLimiter::GetMeasuredSendRate() const
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    return m_measuredSendRate;
+}
+
+AdaptiveRetryStrategy::AdaptiveRetryStrategy(long maxRetries, long scaleFactor, long maxBackoffMs, long retryTokens) :
+    m_scaleFactor(scaleFactor),
+    m_maxRetries(maxRetries),
+    m_maxBackoff(maxBackoffMs),
+    m_retryTokens(retryTokens),
+    m_sendRateLimiter(),
+    m_randomLock(),
+    m_random(static_cast<std::default_random_engine::result_type>(std::chrono::steady_clock::now().time_since_epoch().count()))
+{
+}
+
+bool AdaptiveRetryStrategy::ShouldRetry(const AWSError<CoreErrors>& error, long attemptedRetries) const
+{
+    if (attemptedRetries >= m_maxRetries || !error.ShouldRetry())
+    {
+        return false;
+    }
+
+    return m_retryTokens.TryAcquire(RETRY_COST);
+}
+
+long AdaptiveRetryStrategy::CalculateDelayBeforeNextRetry(const AWSError<CoreErrors>& error, long attemptedRetries) const
+{
+    AWS_UNREFERENCED_PARAM(error);
+
+    // full jitter: anywhere between no wait and the exponential backoff, capped so the shift can't overflow either
+    long ceiling = m_maxBackoff;
+    if (attemptedRetries < 30 && (1L << attemptedRetries) < m_maxBackoff / (std::max)(m_scaleFactor, 1L))
+    {
+        ceiling = (1L << attemptedRetries) * m_scaleFactor;
+    }
+
+    std::uniform_int_distribution<long> distribution(0, ceiling);
+    std::lock_guard<std::mutex> locker(m_randomLock);
+    return distribution(m_random);
+}
+
+long AdaptiveRetryStrategy::AcquireSendToken()
+{
+    return m_sendRateLimiter.AcquireToken();
+}
+
+void AdaptiveRetryStrategy::OnAttemptSucceeded(long attemptedRetries)
+{
+    m_retryTokens.Release(attemptedRetries == 0 ? NO_RETRY_INCREMENT : RETRY_COST);
+    m_sendRateLimiter.UpdateSendRate(false);
+}
+
+void AdaptiveRetryStrategy::OnAttemptFailed(const AWSError<CoreErrors>& error, long attemptedRetries)
+{
+    AWS_UNREFERENCED_PARAM(attemptedRetries);
+    m_sendRateLimiter.UpdateSendRate(IsThrottlingError(error));
+}
+
+bool AdaptiveRetryStrategy::IsThrottlingError(const AWSError<CoreErrors>& error)
+{
+    if (error.GetErrorType() == CoreErrors::THROTTLING || error.GetErrorType() == CoreErrors::SLOW_DOWN ||
+        error.GetResponseCode() == Aws::Http::HttpResponseCode::TOO_MANY_REQUESTS)
+    {
+        return true;
+    }
+
+    // errors the core marshaller doesn't know keep the service's full exception name, e.g. "com.amazonaws.dynamodb.v20120810#ProvisionedThroughputExceededException"
+    const Aws::String& exceptionName = error.GetExceptionName();
+    auto nameStart = exceptionName.find_last_of('#');
+    nameStart = nameStart == Aws::String::npos ? 0 : nameStart + 1;
+    auto nameEnd = exceptionName.find_first_of(':', nameStart);
+    Aws::String name = exceptionName.substr(nameStart, nameEnd == Aws::String::npos ? Aws::String::npos : nameEnd - nameStart);
+
+    for (const char* throttlingName : THROTTLING_EXCEPTION_NAMES)
+    {
+        if (name == throttlingName)
+        {
+            return true;
+        }
+    }
+    return false;
+}
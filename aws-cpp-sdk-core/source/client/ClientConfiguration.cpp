@@ -49,6 +49,8 @@ ClientConfiguration::ClientConfiguration() :
     region(Region::US_EAST_1),
     useDualStack(false),
     maxConnections(25),
+    maxConnectionsPerHost(0),
+    idleConnectionTimeoutMs(0),
     httpRequestTimeoutMs(0),
     requestTimeoutMs(3000),
     connectTimeoutMs(1000),
@@ -63,8 +65,10 @@ ClientConfiguration::ClientConfiguration() :
     writeRateLimiter(nullptr),
     readRateLimiter(nullptr),
     httpLibOverride(Aws::Http::TransferLibType::DEFAULT_CLIENT),
+    httpIoThreadCount(1),
     followRedirects(true),
     disableExpectHeader(false),
+    disableCurlHandleReset(false),
     enableClockSkewAdjustment(true),
     enableHostPrefixInjection(true),
     enableEndpointDiscovery(false)
@@ -0,0 +1,83 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/core/client/HedgingPolicy.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Aws::Client;
+
+// the percentile is recomputed at most once per this many new latencies, so that asking for the delay stays cheap
+static const size_t SAMPLES_PER_UPDATE = 16;
+
+HedgingPolicy::HedgingPolicy(double percentile, std::chrono::milliseconds initialDelay, size_t sampleWindow, size_t minSamples) :
+    m_percentile((std::min)((std::max)(percentile, 0.0), 100.0)),
+    m_initialDelay(initialDelay),
+    m_sampleWindow((std::max)(sampleWindow, static_cast<size_t>(1))),
+    m_minSamples((std::max)((std::min)(minSamples, m_sampleWindow), static_cast<size_t>(1))),
+    m_nextSample(0),
+    m_samplesSinceUpdate(0),
+    m_hedgeDelay(initialDelay),
+    m_hedgesSent(0),
+    m_hedgesWon(0)
+{
+    m_samples.reserve(m_sampleWindow);
+}
+
+std::chrono::microseconds HedgingPolicy::GetHedgeDelay() const
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+    if (m_samples.size() < m_minSamples)
+    {
+        return m_initialDelay;
+    }
+
+    if (m_samplesSinceUpdate >= SAMPLES_PER_UPDATE || m_samples.size() == m_minSamples)
+    {
+        m_scratch = m_samples;
+        size_t rank = static_cast<size_t>(std::ceil(m_percentile / 100.0 * m_scratch.size()));
+        auto nth = m_scratch.begin() + ((std::max)(rank, static_cast<size_t>(1)) - 1);
+        std::nth_element(m_scratch.begin(), nth, m_scratch.end());
+        m_hedgeDelay = std::chrono::microseconds(*nth);
+        m_samplesSinceUpdate = 0;
+    }
+    return m_hedgeDelay;
+}
+
+void HedgingPolicy::RecordLatency(std::chrono::steady_clock::duration latency)
+{
+    int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    std::lock_guard<std::mutex> locker(m_lock);
+    if (m_samples.size() < m_sampleWindow)
+    {
+        m_samples.push_back(micros);
+    }
+    else
+    {
+        m_samples[m_nextSample] = micros;
+    }
+    m_nextSample = (m_nextSample + 1) % m_sampleWindow;
+    m_samplesSinceUpdate++;
+}
+
+void HedgingPolicy::RecordHedge(bool won)
+{
+    m_hedgesSent++;
+    if (won)
+    {
+        m_hedgesWon++;
+    }
+}
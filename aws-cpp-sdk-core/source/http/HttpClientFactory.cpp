@@ -17,6 +17,7 @@
 
 #if ENABLE_CURL_CLIENT
 #include <aws/core/http/curl/CurlHttpClient.h>
+#include <aws/core/http/curl/CurlMultiHttpClient.h>
 #include <signal.h>
 
 #elif ENABLE_WINDOWS_CLIENT
@@ -47,6 +48,7 @@ namespace Aws
         static std::shared_ptr<HttpClientFactory> s_HttpClientFactory(nullptr);
         static bool s_InitCleanupCurlFlag(false);
         static bool s_InstallSigPipeHandler(false);
+        static bool s_ShareCurlCaches(false);
 
         static const char* HTTP_CLIENT_FACTORY_ALLOCATION_TAG = "HttpClientFactory";
 
@@ -100,6 +102,11 @@ namespace Aws
                 }
 #endif // ENABLE_WINDOWS_IXML_HTTP_REQUEST_2_CLIENT
 #elif ENABLE_CURL_CLIENT
+                if (clientConfiguration.httpLibOverride == TransferLibType::CURL_MULTI_CLIENT)
+                {
+                    AWS_LOGSTREAM_INFO(HTTP_CLIENT_FACTORY_ALLOCATION_TAG, "Creating curl multi http client.");
+                    return Aws::MakeShared<CurlMultiHttpClient>(HTTP_CLIENT_FACTORY_ALLOCATION_TAG, clientConfiguration);
+                }
                 return Aws::MakeShared<CurlHttpClient>(HTTP_CLIENT_FACTORY_ALLOCATION_TAG, clientConfiguration);
 #else
                 // When neither of these clients is enabled, gcc gives a warning (converted
@@ -132,6 +139,10 @@ namespace Aws
                 {
                     CurlHttpClient::InitGlobalState();
                 }
+                if(s_ShareCurlCaches)
+                {
+                    CurlHttpClient::InitSharedCaches();
+                }
 #if !defined (_WIN32)
                 if(s_InstallSigPipeHandler)
                 {
@@ -146,6 +157,10 @@ namespace Aws
             virtual void CleanupStaticState() override
             {
 #if ENABLE_CURL_CLIENT
+                if(s_ShareCurlCaches)
+                {
+                    CurlHttpClient::CleanupSharedCaches();
+                }
                 if(s_InitCleanupCurlFlag)
                 {
                     CurlHttpClient::CleanupGlobalState();
@@ -164,6 +179,11 @@ namespace Aws
             s_InstallSigPipeHandler = install;
         }
 
+        void SetShareCurlCachesFlag(bool shareCaches)
+        {
+            s_ShareCurlCaches = shareCaches;
+        }
+
         void InitHttp()
         {
             if(!s_HttpClientFactory)
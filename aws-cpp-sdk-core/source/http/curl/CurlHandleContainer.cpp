@@ -17,95 +17,287 @@
 #include <aws/core/utils/logging/LogMacros.h>
 
 #include <algorithm>
+#include <cassert>
 
 using namespace Aws::Utils::Logging;
+using namespace Aws::Utils::Threading;
 using namespace Aws::Http;
 
 static const char* CURL_HANDLE_CONTAINER_TAG = "CurlHandleContainer";
 
 
 CurlHandleContainer::CurlHandleContainer(unsigned maxSize, long httpRequestTimeout, long connectTimeout, bool enableTcpKeepAlive, 
-                                        unsigned long tcpKeepAliveIntervalMs, long lowSpeedTime, unsigned long lowSpeedLimit) :
-                m_maxPoolSize(maxSize), m_httpRequestTimeout(httpRequestTimeout), m_connectTimeout(connectTimeout), m_enableTcpKeepAlive(enableTcpKeepAlive), 
-                m_tcpKeepAliveIntervalMs(tcpKeepAliveIntervalMs), m_lowSpeedTime(lowSpeedTime), m_lowSpeedLimit(lowSpeedLimit), m_poolSize(0)
+                                        unsigned long tcpKeepAliveIntervalMs, long lowSpeedTime, unsigned long lowSpeedLimit,
+                                        bool resetHandlesOnRelease, unsigned maxSizePerHost, unsigned long idleTimeoutMs, CURLSH* share) :
+                m_maxPoolSize(maxSize), m_maxPoolSizePerHost(maxSizePerHost > 0 ? (std::min)(maxSizePerHost, maxSize) : maxSize),
+                m_httpRequestTimeout(httpRequestTimeout), m_connectTimeout(connectTimeout),
+                m_enableTcpKeepAlive(enableTcpKeepAlive), m_tcpKeepAliveIntervalMs(tcpKeepAliveIntervalMs), m_lowSpeedTime(lowSpeedTime),
+                m_lowSpeedLimit(lowSpeedLimit), m_resetHandlesOnRelease(resetHandlesOnRelease), m_share(share), m_idleTimeout(idleTimeoutMs),
+                m_nextIdleCheck(0), m_poolSize(0), m_waiters(0)
 {
-    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Initializing CurlHandleContainer with size " << maxSize);
+    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Initializing CurlHandleContainer with size " << maxSize << " and size per host " << m_maxPoolSizePerHost);
 }
 
 CurlHandleContainer::~CurlHandleContainer()
 {
     AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Cleaning up CurlHandleContainer.");
-    for (CURL* handle : m_handleContainer.ShutdownAndWait(m_poolSize))
+    for (auto& hostPool : m_hostPools)
     {
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Cleaning up " << handle);
-        curl_easy_cleanup(handle);
+        for (const IdleHandle& idleHandle : hostPool.second->idleHandles.ShutdownAndWait(hostPool.second->size))
+        {
+            AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Cleaning up " << idleHandle.handle);
+            curl_easy_cleanup(idleHandle.handle);
+        }
     }
 }
 
-CURL* CurlHandleContainer::AcquireCurlHandle()
+CURL* CurlHandleContainer::AcquireCurlHandle(const Aws::String& host)
+{
+    return AcquireCurlHandle(host, true);
+}
+
+CURL* CurlHandleContainer::TryAcquireCurlHandle(const Aws::String& host)
+{
+    return AcquireCurlHandle(host, false);
+}
+
+CURL* CurlHandleContainer::AcquireCurlHandle(const Aws::String& host, bool wait)
 {
-    AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Attempting to acquire curl connection.");
+    AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Attempting to acquire curl connection for host " << host);
 
-    if(!m_handleContainer.HasResourcesAvailable())
+    CURL* handle = nullptr;
+    auto hostPool = FindHostPool(host);
+    if (!hostPool || !TryAcquireIdleHandle(*hostPool, handle))
     {
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "No current connections available in pool. Attempting to create new connections.");
-        CheckAndGrowPool();
+        std::unique_lock<std::mutex> locker(m_containerLock);
+        // count ourselves before looking again, so that a handle released from here on is either found below or wakes us up.
+        ++m_waiters;
+        for (;;)
+        {
+            hostPool = GetOrCreateHostPool(host);
+            if (TryAcquireIdleHandle(*hostPool, handle))
+            {
+                break;
+            }
+
+            if (hostPool->size < m_maxPoolSizePerHost && (m_poolSize < m_maxPoolSize || CloseIdleHandleOfAnotherHost(*hostPool)))
+            {
+                handle = CreateHandle(*hostPool);
+                break;
+            }
+
+            if (!wait)
+            {
+                break;
+            }
+
+            AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "No connections available for host " << host << ", waiting for one to be released.");
+            m_handleReleased.wait(locker);
+        }
+        --m_waiters;
     }
 
-    CURL* handle = m_handleContainer.Acquire();
-    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Connection has been released. Continuing.");
     AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Returning connection handle " << handle);
     return handle;
 }
 
-void CurlHandleContainer::ReleaseCurlHandle(CURL* handle)
+void CurlHandleContainer::ReleaseCurlHandle(CURL* handle, const Aws::String& host)
 {
     if (handle)
     {
-        curl_easy_reset(handle);
-        SetDefaultOptionsOnHandle(handle);
+        if (m_resetHandlesOnRelease)
+        {
+            curl_easy_reset(handle);
+            SetDefaultOptionsOnHandle(handle);
+        }
         AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Releasing curl handle " << handle);
-        m_handleContainer.Release(handle);
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Notified waiting threads.");
+
+        // the host's pool can't go away while it has handles out.
+        auto hostPool = FindHostPool(host);
+        assert(hostPool);
+        IdleHandle idleHandle = { handle, std::chrono::steady_clock::now() };
+        ++hostPool->idleCount;
+        hostPool->idleHandles.Release(idleHandle);
+
+        if (m_waiters.load() > 0)
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_containerLock);
+            }
+            // waiters may be after another host's handle or waiting for room to create one, wake them all to look.
+            m_handleReleased.notify_all();
+            AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Notified waiting threads.");
+        }
+
+        if (m_idleTimeout.count() > 0)
+        {
+            CloseExpiredIdleHandles();
+        }
     }
 }
 
-bool CurlHandleContainer::CheckAndGrowPool()
+bool CurlHandleContainer::TryAcquireIdleHandle(HostPool& hostPool, CURL*& handle)
 {
-    std::lock_guard<std::mutex> locker(m_containerLock);
-    if (m_poolSize < m_maxPoolSize)
+    IdleHandle idleHandle;
+    if (!hostPool.idleHandles.TryAcquire(idleHandle))
     {
-        unsigned multiplier = m_poolSize > 0 ? m_poolSize : 1;
-        unsigned amountToAdd = (std::min)(multiplier * 2, m_maxPoolSize - m_poolSize);
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "attempting to grow pool size by " << amountToAdd);
+        return false;
+    }
 
-        unsigned actuallyAdded = 0;
-        for (unsigned i = 0; i < amountToAdd; ++i)
+    --hostPool.idleCount;
+    handle = idleHandle.handle;
+    return true;
+}
+
+std::shared_ptr<CurlHandleContainer::HostPool> CurlHandleContainer::FindHostPool(const Aws::String& host)
+{
+    ReaderLockGuard guard(m_hostPoolsLock);
+    auto iter = m_hostPools.find(host);
+    return iter != m_hostPools.end() ? iter->second : nullptr;
+}
+
+std::shared_ptr<CurlHandleContainer::HostPool> CurlHandleContainer::GetOrCreateHostPool(const Aws::String& host)
+{
+    // called with m_containerLock held, which pools are only added and removed under.
+    auto iter = m_hostPools.find(host);
+    if (iter != m_hostPools.end())
+    {
+        return iter->second;
+    }
+
+    auto hostPool = Aws::MakeShared<HostPool>(CURL_HANDLE_CONTAINER_TAG, m_maxPoolSizePerHost);
+    WriterLockGuard guard(m_hostPoolsLock);
+    m_hostPools.emplace(host, hostPool);
+    return hostPool;
+}
+
+CURL* CurlHandleContainer::CreateHandle(HostPool& hostPool)
+{
+    CURL* curlHandle = curl_easy_init();
+    if (!curlHandle)
+    {
+        AWS_LOGSTREAM_ERROR(CURL_HANDLE_CONTAINER_TAG, "curl_easy_init failed to allocate.");
+        return nullptr;
+    }
+
+    SetDefaultOptionsOnHandle(curlHandle);
+    if (m_share)
+    {
+        // survives curl_easy_reset, so it is set only once.
+        curl_easy_setopt(curlHandle, CURLOPT_SHARE, m_share);
+    }
+    ++hostPool.size;
+    ++m_poolSize;
+    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool grown to " << m_poolSize << " connections, " << hostPool.size << " for this host.");
+    return curlHandle;
+}
+
+bool CurlHandleContainer::CloseIdleHandleOfAnotherHost(const HostPool& hostPool)
+{
+    // take from the host with the most handles sitting idle, falling back to any other if that one's are taken meanwhile.
+    auto victim = m_hostPools.end();
+    for (auto iter = m_hostPools.begin(); iter != m_hostPools.end(); ++iter)
+    {
+        if (iter->second.get() != &hostPool && (victim == m_hostPools.end() || iter->second->idleCount > victim->second->idleCount))
         {
-            CURL* curlHandle = curl_easy_init();
+            victim = iter;
+        }
+    }
 
-            if (curlHandle)
-            {
-                SetDefaultOptionsOnHandle(curlHandle);
-                m_handleContainer.Release(curlHandle);
-                ++actuallyAdded;
-            }
-            else
+    CURL* handle = nullptr;
+    if (victim == m_hostPools.end() || !TryAcquireIdleHandle(*victim->second, handle))
+    {
+        for (victim = m_hostPools.begin(); victim != m_hostPools.end(); ++victim)
+        {
+            if (victim->second.get() != &hostPool && TryAcquireIdleHandle(*victim->second, handle))
             {
-                AWS_LOGSTREAM_ERROR(CURL_HANDLE_CONTAINER_TAG, "curl_easy_init failed to allocate.");
                 break;
             }
         }
+    }
 
-        AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool grown by " << actuallyAdded);
-        m_poolSize += actuallyAdded;
+    if (!handle)
+    {
+        AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool cannot be grown any further, already at max size.");
+        return false;
+    }
 
-        return actuallyAdded > 0;
+    AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Closing idle connection handle " << handle << " of host " << victim->first << " to make room.");
+    curl_easy_cleanup(handle);
+    --m_poolSize;
+    if (--victim->second->size == 0)
+    {
+        WriterLockGuard guard(m_hostPoolsLock);
+        m_hostPools.erase(victim);
     }
+    return true;
+}
 
-    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool cannot be grown any further, already at max size.");
+void CurlHandleContainer::CloseExpiredIdleHandles()
+{
+    auto now = std::chrono::steady_clock::now();
+    int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    int64_t nextCheck = m_nextIdleCheck.load();
+    // check at most twice per timeout, on whichever release gets there first.
+    if (nowMs < nextCheck || !m_nextIdleCheck.compare_exchange_strong(nextCheck, nowMs + m_idleTimeout.count() / 2))
+    {
+        return;
+    }
+
+    unsigned closed = 0;
+    {
+        std::lock_guard<std::mutex> locker(m_containerLock);
+        for (auto iter = m_hostPools.begin(); iter != m_hostPools.end();)
+        {
+            HostPool& hostPool = *iter->second;
+            Aws::Vector<IdleHandle> keep;
+            IdleHandle idleHandle;
+            while (hostPool.idleHandles.TryAcquire(idleHandle))
+            {
+                if (now - idleHandle.releasedAt >= m_idleTimeout)
+                {
+                    AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Closing connection handle " << idleHandle.handle << " of host " << iter->first
+                            << " after being idle for longer than " << m_idleTimeout.count() << "ms.");
+                    curl_easy_cleanup(idleHandle.handle);
+                    --hostPool.idleCount;
+                    --hostPool.size;
+                    --m_poolSize;
+                    ++closed;
+                }
+                else
+                {
+                    keep.push_back(idleHandle);
+                }
+            }
+
+            // handles come off most recently released first, put them back in the same order.
+            for (auto keptHandle = keep.rbegin(); keptHandle != keep.rend(); ++keptHandle)
+            {
+                hostPool.idleHandles.Release(*keptHandle);
+            }
+
+            if (hostPool.size == 0)
+            {
+                WriterLockGuard guard(m_hostPoolsLock);
+                iter = m_hostPools.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
 
-    return false;
+        if (closed > 0)
+        {
+            AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Closed " << closed << " idle connections, pool size is now " << m_poolSize);
+        }
+    }
+
+    if (closed > 0)
+    {
+        // room to create handles for other hosts again.
+        m_handleReleased.notify_all();
+    }
 }
 
 void CurlHandleContainer::SetDefaultOptionsOnHandle(CURL* handle)
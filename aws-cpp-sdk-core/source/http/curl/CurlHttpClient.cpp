@@ -15,14 +15,18 @@
 
 #include <aws/core/http/curl/CurlHttpClient.h>
 #include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/standard/StandardHttpRequest.h>
 #include <aws/core/http/standard/StandardHttpResponse.h>
 #include <aws/core/utils/StringUtils.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/ratelimiter/RateLimiterInterface.h>
 #include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/stream/ResponseStream.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 #include <aws/core/monitoring/HttpClientMetrics.h>
 #include <cassert>
 #include <algorithm>
+#include <mutex>
 
 
 using namespace Aws::Client;
@@ -130,39 +134,6 @@ static char* strdup_callback(const char* str)
 
 #endif
 
-struct CurlWriteCallbackContext
-{
-    CurlWriteCallbackContext(const CurlHttpClient* client,
-                             HttpRequest* request,
-                             HttpResponse* response,
-                             Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter) :
-        m_client(client),
-        m_request(request),
-        m_response(response),
-        m_rateLimiter(rateLimiter),
-        m_numBytesResponseReceived(0)
-    {}
-
-    const CurlHttpClient* m_client;
-    HttpRequest* m_request;
-    HttpResponse* m_response;
-    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
-    int64_t m_numBytesResponseReceived;
-};
-
-struct CurlReadCallbackContext
-{
-    CurlReadCallbackContext(const CurlHttpClient* client, HttpRequest* request, Aws::Utils::RateLimits::RateLimiterInterface* limiter) :
-        m_client(client),
-        m_rateLimiter(limiter),
-        m_request(request)
-    {}
-
-    const CurlHttpClient* m_client;
-    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
-    HttpRequest* m_request;
-};
-
 static const char* CURL_HTTP_CLIENT_TAG = "CurlHttpClient";
 
 static size_t WriteData(char* ptr, size_t size, size_t nmemb, void* userdata)
@@ -299,6 +270,16 @@ static size_t SeekBody(void* userdata, curl_off_t offset, int origin)
     return CURL_SEEKFUNC_OK;
 }
 
+#if LIBCURL_VERSION_NUM >= 0x072000 // 7.32.0
+static int CheckContinueRequest(void* userdata, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+{
+    CurlWriteCallbackContext* context = reinterpret_cast<CurlWriteCallbackContext*>(userdata);
+
+    const CurlHttpClient* client = context->m_client;
+    return client->ContinueRequest(*context->m_request) && client->IsRequestProcessingEnabled() ? 0 : 1;
+}
+#endif
+
 void SetOptCodeForHttpMethod(CURL* requestHandle, const HttpRequest& request)
 {
     switch (request.GetMethod())
@@ -356,6 +337,18 @@ void SetOptCodeForHttpMethod(CURL* requestHandle, const HttpRequest& request)
 
 
 std::atomic<bool> CurlHttpClient::isInit(false);
+CURLSH* CurlHttpClient::sharedCaches(nullptr);
+static std::mutex s_sharedCacheLocks[CURL_LOCK_DATA_LAST];
+
+static void LockSharedCache(CURL*, curl_lock_data data, curl_lock_access, void*)
+{
+    s_sharedCacheLocks[data].lock();
+}
+
+static void UnlockSharedCache(CURL*, curl_lock_data data, void*)
+{
+    s_sharedCacheLocks[data].unlock();
+}
 
 void CurlHttpClient::InitGlobalState()
 {
@@ -379,6 +372,42 @@ void CurlHttpClient::CleanupGlobalState()
     curl_global_cleanup();
 }
 
+void CurlHttpClient::InitSharedCaches()
+{
+    if (sharedCaches)
+    {
+        return;
+    }
+
+    sharedCaches = curl_share_init();
+    if (!sharedCaches)
+    {
+        AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "curl_share_init failed, clients will keep their own DNS and TLS session caches.");
+        return;
+    }
+
+    // a single lock per kind of data; libcurl asks for the one it needs, shared or exclusive alike.
+    curl_share_setopt(sharedCaches, CURLSHOPT_LOCKFUNC, LockSharedCache);
+    curl_share_setopt(sharedCaches, CURLSHOPT_UNLOCKFUNC, UnlockSharedCache);
+    curl_share_setopt(sharedCaches, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(sharedCaches, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    AWS_LOGSTREAM_INFO(CURL_HTTP_CLIENT_TAG, "Sharing DNS and TLS session caches across curl clients.");
+}
+
+void CurlHttpClient::CleanupSharedCaches()
+{
+    if (sharedCaches)
+    {
+        CURLSHcode code = curl_share_cleanup(sharedCaches);
+        if (code != CURLSHE_OK)
+        {
+            // still attached to handles of clients that weren't destroyed; leave it to them rather than pull it out from under them.
+            AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Failed to clean up shared curl caches: " << curl_share_strerror(code));
+        }
+        sharedCaches = nullptr;
+    }
+}
+
 Aws::String CurlInfoTypeToString(curl_infotype type)
 {
     switch(type)
@@ -431,7 +460,8 @@ int CurlDebugCallback(CURL *handle, curl_infotype type, char *data, size_t size,
 CurlHttpClient::CurlHttpClient(const ClientConfiguration& clientConfig) :
     Base(),
     m_curlHandleContainer(clientConfig.maxConnections, clientConfig.httpRequestTimeoutMs, clientConfig.connectTimeoutMs, clientConfig.enableTcpKeepAlive,
-                          clientConfig.tcpKeepAliveIntervalMs, clientConfig.requestTimeoutMs, clientConfig.lowSpeedLimit),
+                          clientConfig.tcpKeepAliveIntervalMs, clientConfig.requestTimeoutMs, clientConfig.lowSpeedLimit, !clientConfig.disableCurlHandleReset,
+                          clientConfig.maxConnectionsPerHost, clientConfig.idleConnectionTimeoutMs, sharedCaches),
     m_isUsingProxy(!clientConfig.proxyHost.empty()), m_proxyUserName(clientConfig.proxyUserName),
     m_proxyPassword(clientConfig.proxyPassword), m_proxyScheme(SchemeMapper::ToString(clientConfig.proxyScheme)), m_proxyHost(clientConfig.proxyHost),
     m_proxySSLCertPath(clientConfig.proxySSLCertPath), m_proxySSLCertType(clientConfig.proxySSLCertType),
@@ -440,27 +470,16 @@ CurlHttpClient::CurlHttpClient(const ClientConfiguration& clientConfig) :
     m_proxyPort(clientConfig.proxyPort), m_verifySSL(clientConfig.verifySSL), m_caPath(clientConfig.caPath),
     m_caFile(clientConfig.caFile),
     m_disableExpectHeader(clientConfig.disableExpectHeader),
+    m_disableCurlHandleReset(clientConfig.disableCurlHandleReset),
     m_allowRedirects(clientConfig.followRedirects)
 {
 }
 
 
-void CurlHttpClient::MakeRequestInternal(HttpRequest& request,
-        std::shared_ptr<StandardHttpResponse>& response,
-        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
-        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+struct curl_slist* CurlHttpClient::BuildHeaderList(const HttpRequest& request) const
 {
-    URI uri = request.GetUri();
-    Aws::String url = uri.GetURIString();
-
-    AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Making request to " << url);
     struct curl_slist* headers = NULL;
 
-    if (writeLimiter != nullptr)
-    {
-        writeLimiter->ApplyAndPayForCost(request.GetSize());
-    }
-
     Aws::StringStream headerStream;
     HeaderValueCollection requestHeaders = request.GetHeaders();
 
@@ -495,204 +514,349 @@ void CurlHttpClient::MakeRequestInternal(HttpRequest& request,
         headers = curl_slist_append(headers, "Expect:");
     }
 
-    CURL* connectionHandle = m_curlHandleContainer.AcquireCurlHandle();
+    return headers;
+}
 
-    if (connectionHandle)
-    {
-        AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Obtained connection handle " << connectionHandle);
+void CurlHttpClient::ConfigureConnectionHandle(CURL* connectionHandle, HttpRequest& request, HttpResponse* response, struct curl_slist* headers,
+        CurlWriteCallbackContext& writeContext, CurlReadCallbackContext& readContext) const
+{
+    Aws::String url = request.GetUri().GetURIString();
+    AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Making request to " << url);
 
-        if (headers)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_HTTPHEADER, headers);
-        }
+    if (m_disableCurlHandleReset)
+    {
+        // The handle still has the options of its previous request. Put back those that aren't set for every request below;
+        // CURLOPT_HTTPGET also turns off CURLOPT_NOBODY, CURLOPT_POST and CURLOPT_UPLOAD.
+        curl_easy_setopt(connectionHandle, CURLOPT_HTTPHEADER, nullptr);
+        curl_easy_setopt(connectionHandle, CURLOPT_CUSTOMREQUEST, nullptr);
+        curl_easy_setopt(connectionHandle, CURLOPT_HTTPGET, 1L);
+        curl_easy_setopt(connectionHandle, CURLOPT_READFUNCTION, nullptr);
+        curl_easy_setopt(connectionHandle, CURLOPT_READDATA, nullptr);
+        curl_easy_setopt(connectionHandle, CURLOPT_SEEKFUNCTION, nullptr);
+        curl_easy_setopt(connectionHandle, CURLOPT_SEEKDATA, nullptr);
+    }
 
-        CurlWriteCallbackContext writeContext(this, &request, response.get(), readLimiter);
-        CurlReadCallbackContext readContext(this, &request, writeLimiter);
+    if (headers)
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_HTTPHEADER, headers);
+    }
 
-        SetOptCodeForHttpMethod(connectionHandle, request);
+    SetOptCodeForHttpMethod(connectionHandle, request);
 
-        curl_easy_setopt(connectionHandle, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(connectionHandle, CURLOPT_WRITEFUNCTION, WriteData);
-        curl_easy_setopt(connectionHandle, CURLOPT_WRITEDATA, &writeContext);
-        curl_easy_setopt(connectionHandle, CURLOPT_HEADERFUNCTION, WriteHeader);
-        curl_easy_setopt(connectionHandle, CURLOPT_HEADERDATA, response.get());
+    curl_easy_setopt(connectionHandle, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(connectionHandle, CURLOPT_WRITEFUNCTION, WriteData);
+    curl_easy_setopt(connectionHandle, CURLOPT_WRITEDATA, &writeContext);
+    curl_easy_setopt(connectionHandle, CURLOPT_HEADERFUNCTION, WriteHeader);
+    curl_easy_setopt(connectionHandle, CURLOPT_HEADERDATA, response);
 
-        //we only want to override the default path if someone has explicitly told us to.
-        if(!m_caPath.empty())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, m_caPath.c_str());
-        }
-        if(!m_caFile.empty())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_CAINFO, m_caFile.c_str());
-        }
+    //we only want to override the default path if someone has explicitly told us to.
+    if(!m_caPath.empty())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, m_caPath.c_str());
+    }
+    if(!m_caFile.empty())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_CAINFO, m_caFile.c_str());
+    }
 
-	// only set by android test builds because the emulator is missing a cert needed for aws services
+// only set by android test builds because the emulator is missing a cert needed for aws services
 #ifdef TEST_CERT_PATH
-	curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, TEST_CERT_PATH);
+    curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, TEST_CERT_PATH);
 #endif // TEST_CERT_PATH
 
-        if (m_verifySSL)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 1L);
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 2L);
+    if (m_verifySSL)
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 2L);
 
 #if LIBCURL_VERSION_MAJOR >= 7
 #if LIBCURL_VERSION_MINOR >= 34
-            curl_easy_setopt(connectionHandle, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1);
 #endif //LIBCURL_VERSION_MINOR
 #endif //LIBCURL_VERSION_MAJOR
-        }
-        else
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 0L);
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 0L);
-        }
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 0L);
+    }
 
-        if (m_allowRedirects)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 1L);
-        }
-        else
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 0L);
-        }
+    if (m_allowRedirects)
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 1L);
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 0L);
+    }
 
 #ifdef ENABLE_CURL_LOGGING
-        curl_easy_setopt(connectionHandle, CURLOPT_VERBOSE, 1);
-        curl_easy_setopt(connectionHandle, CURLOPT_DEBUGFUNCTION, CurlDebugCallback);
+    curl_easy_setopt(connectionHandle, CURLOPT_VERBOSE, 1);
+    curl_easy_setopt(connectionHandle, CURLOPT_DEBUGFUNCTION, CurlDebugCallback);
 #endif
-        if (m_isUsingProxy)
+    if (m_isUsingProxy)
+    {
+        Aws::StringStream ss;
+        ss << m_proxyScheme << "://" << m_proxyHost;
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXY, ss.str().c_str());
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXYPORT, (long) m_proxyPort);
+        if (!m_proxyUserName.empty() || !m_proxyPassword.empty())
+        {
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXYUSERNAME, m_proxyUserName.c_str());
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXYPASSWORD, m_proxyPassword.c_str());
+        }
+#ifdef CURL_HAS_TLS_PROXY
+        if (!m_proxySSLCertPath.empty())
         {
-            Aws::StringStream ss;
-            ss << m_proxyScheme << "://" << m_proxyHost;
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXY, ss.str().c_str());
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXYPORT, (long) m_proxyPort);
-            if (!m_proxyUserName.empty() || !m_proxyPassword.empty())
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERT, m_proxySSLCertPath.c_str());
+            if (!m_proxySSLCertType.empty())
             {
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXYUSERNAME, m_proxyUserName.c_str());
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXYPASSWORD, m_proxyPassword.c_str());
+                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERTTYPE, m_proxySSLCertType.c_str());
             }
-#ifdef CURL_HAS_TLS_PROXY
-            if (!m_proxySSLCertPath.empty())
+        }
+        if (!m_proxySSLKeyPath.empty())
+        {
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEY, m_proxySSLKeyPath.c_str());
+            if (!m_proxySSLKeyType.empty())
             {
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERT, m_proxySSLCertPath.c_str());
-                if (!m_proxySSLCertType.empty())
-                {
-                    curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERTTYPE, m_proxySSLCertType.c_str());
-                }
+                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEYTYPE, m_proxySSLKeyType.c_str());
             }
-            if (!m_proxySSLKeyPath.empty())
+            if (!m_proxyKeyPasswd.empty())
             {
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEY, m_proxySSLKeyPath.c_str());
-                if (!m_proxySSLKeyType.empty())
-                {
-                    curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEYTYPE, m_proxySSLKeyType.c_str());
-                }
-                if (!m_proxyKeyPasswd.empty())
-                {
-                    curl_easy_setopt(connectionHandle, CURLOPT_PROXY_KEYPASSWD, m_proxyKeyPasswd.c_str());
-                }
+                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_KEYPASSWD, m_proxyKeyPasswd.c_str());
             }
-#endif //CURL_HAS_TLS_PROXY
-        }
-        else
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXY, "");
         }
+#endif //CURL_HAS_TLS_PROXY
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXY, "");
+    }
 
-        if (request.GetContentBody())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_READFUNCTION, ReadBody);
-            curl_easy_setopt(connectionHandle, CURLOPT_READDATA, &readContext);
-            curl_easy_setopt(connectionHandle, CURLOPT_SEEKFUNCTION, SeekBody);
-            curl_easy_setopt(connectionHandle, CURLOPT_SEEKDATA, &readContext);
-        }
-        Aws::Utils::DateTime startTransmissionTime = Aws::Utils::DateTime::Now();
-        CURLcode curlResponseCode = curl_easy_perform(connectionHandle);
-        bool shouldContinueRequest = ContinueRequest(request);
-        if (curlResponseCode != CURLE_OK && shouldContinueRequest)
-        {
-            response = nullptr;
-            AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Curl returned error code " << curlResponseCode
-                    << " - " << curl_easy_strerror(curlResponseCode));
-        }
-        else if(!shouldContinueRequest)
+#if LIBCURL_VERSION_NUM >= 0x072000
+    // the body callbacks only see the continue handler once data flows; polling it from the progress callback too lets a request be
+    // cancelled while it waits on the connection or on the response.
+    if (request.GetContinueRequestHandler())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(connectionHandle, CURLOPT_XFERINFOFUNCTION, CheckContinueRequest);
+        curl_easy_setopt(connectionHandle, CURLOPT_XFERINFODATA, &writeContext);
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_NOPROGRESS, 1L);
+    }
+#endif
+
+    if (request.GetContentBody())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_READFUNCTION, ReadBody);
+        curl_easy_setopt(connectionHandle, CURLOPT_READDATA, &readContext);
+        curl_easy_setopt(connectionHandle, CURLOPT_SEEKFUNCTION, SeekBody);
+        curl_easy_setopt(connectionHandle, CURLOPT_SEEKDATA, &readContext);
+    }
+}
+
+void CurlHttpClient::RecordConnectionMetrics(CURL* connectionHandle, CURLcode curlResponseCode, HttpRequest& request, double dnsTime)
+{
+    // a transfer that failed may not have had a connection at all, opening none doesn't make it a reuse.
+    const char* ip = nullptr;
+    if (curlResponseCode != CURLE_OK || curl_easy_getinfo(connectionHandle, CURLINFO_PRIMARY_IP, &ip) != CURLE_OK || !ip || !*ip)
+    {
+        return;
+    }
+
+    long newConnections = 0;
+    if (curl_easy_getinfo(connectionHandle, CURLINFO_NUM_CONNECTS, &newConnections) != CURLE_OK)
+    {
+        return;
+    }
+    request.AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::ConnectionReused), newConnections == 0 ? 1 : 0);
+
+    // curl's times count from the start of the transfer, and a reused connection has no connect or TLS handshake to report.
+    double connectTime = 0;
+    if (newConnections == 0 || curl_easy_getinfo(connectionHandle, CURLINFO_CONNECT_TIME, &connectTime) != CURLE_OK)
+    {
+        return;
+    }
+    request.AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::TcpLatency), static_cast<int64_t>((connectTime - dnsTime) * 1000));
+
+    double sslTime = 0;
+    if (curl_easy_getinfo(connectionHandle, CURLINFO_APPCONNECT_TIME, &sslTime) == CURLE_OK && sslTime > 0)
+    {
+        request.AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::SslLatency), static_cast<int64_t>((sslTime - connectTime) * 1000));
+        connectTime = sslTime;
+    }
+    request.AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::ConnectLatency), static_cast<int64_t>(connectTime * 1000));
+}
+
+void CurlHttpClient::OnTransferComplete(CURL* connectionHandle, CURLcode curlResponseCode, HttpRequest& request,
+        std::shared_ptr<StandardHttpResponse>& response, const CurlWriteCallbackContext& writeContext,
+        const Aws::Utils::DateTime& startTransmissionTime) const
+{
+    bool shouldContinueRequest = ContinueRequest(request);
+    if (curlResponseCode != CURLE_OK && shouldContinueRequest)
+    {
+        response = nullptr;
+        AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Curl returned error code " << curlResponseCode
+                << " - " << curl_easy_strerror(curlResponseCode));
+    }
+    else if(!shouldContinueRequest)
+    {
+        response->SetResponseCode(HttpResponseCode::REQUEST_NOT_MADE);
+    }
+    else
+    {
+        long responseCode;
+        curl_easy_getinfo(connectionHandle, CURLINFO_RESPONSE_CODE, &responseCode);
+        response->SetResponseCode(static_cast<HttpResponseCode>(responseCode));
+        AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned http response code " << responseCode);
+
+        char* contentType = nullptr;
+        curl_easy_getinfo(connectionHandle, CURLINFO_CONTENT_TYPE, &contentType);
+        if (contentType)
         {
-            response->SetResponseCode(HttpResponseCode::REQUEST_NOT_MADE);
+            response->SetContentType(contentType);
+            AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned content type " << contentType);
         }
-        else
+
+        if (request.GetMethod() != HttpMethod::HTTP_HEAD &&
+            writeContext.m_client->IsRequestProcessingEnabled() &&
+            response->HasHeader(Aws::Http::CONTENT_LENGTH_HEADER))
         {
-            long responseCode;
-            curl_easy_getinfo(connectionHandle, CURLINFO_RESPONSE_CODE, &responseCode);
-            response->SetResponseCode(static_cast<HttpResponseCode>(responseCode));
-            AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned http response code " << responseCode);
-
-            char* contentType = nullptr;
-            curl_easy_getinfo(connectionHandle, CURLINFO_CONTENT_TYPE, &contentType);
-            if (contentType)
+            const Aws::String& contentLength = response->GetHeader(Aws::Http::CONTENT_LENGTH_HEADER);
+            int64_t numBytesResponseReceived = writeContext.m_numBytesResponseReceived;
+            AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response content-length header: " << contentLength);
+            AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response body length: " << numBytesResponseReceived);
+            if (StringUtils::ConvertToInt64(contentLength.c_str()) != numBytesResponseReceived)
             {
-                response->SetContentType(contentType);
-                AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned content type " << contentType);
+                response = nullptr;
+                AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Response body length doesn't match the content-length header.");
             }
+        }
 
-            if (request.GetMethod() != HttpMethod::HTTP_HEAD &&
-                writeContext.m_client->IsRequestProcessingEnabled() &&
-                response->HasHeader(Aws::Http::CONTENT_LENGTH_HEADER))
-            {
-                const Aws::String& contentLength = response->GetHeader(Aws::Http::CONTENT_LENGTH_HEADER);
-                int64_t numBytesResponseReceived = writeContext.m_numBytesResponseReceived;
-                AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response content-length header: " << contentLength);
-                AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response body length: " << numBytesResponseReceived);
-                if (StringUtils::ConvertToInt64(contentLength.c_str()) != numBytesResponseReceived)
-                {
-                    response = nullptr;
-                    AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Response body length doesn't match the content-length header.");
-                }
-            }
+        AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Releasing curl handle " << connectionHandle);
+    }
 
-            AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Releasing curl handle " << connectionHandle);
-        }
+    double dnsTime;
+    CURLcode ret = curl_easy_getinfo(connectionHandle, CURLINFO_NAMELOOKUP_TIME, &dnsTime); // DNS Resolve Latency, seconds.
+    if (ret == CURLE_OK)
+    {
+        request.AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::DnsLatency), static_cast<int64_t>(dnsTime * 1000));// to milliseconds
+    }
+    else
+    {
+        dnsTime = 0;
+    }
 
-        double timep;
-        CURLcode ret = curl_easy_getinfo(connectionHandle, CURLINFO_NAMELOOKUP_TIME, &timep); // DNS Resolve Latency, seconds.
-        if (ret == CURLE_OK)
-        {
-            request.AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::DnsLatency), static_cast<int64_t>(timep * 1000));// to milliseconds
-        }
+    RecordConnectionMetrics(connectionHandle, curlResponseCode, request, dnsTime);
 
-        ret = curl_easy_getinfo(connectionHandle, CURLINFO_STARTTRANSFER_TIME, &timep); // Connect Latency
-        if (ret == CURLE_OK)
-        {
-            request.AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::ConnectLatency), static_cast<int64_t>(timep * 1000));
-        }
+    const char* ip = nullptr;
+    auto curlGetInfoResult = curl_easy_getinfo(connectionHandle, CURLINFO_PRIMARY_IP, &ip); // Get the IP address of the remote endpoint
+    if (curlGetInfoResult == CURLE_OK && ip)
+    {
+        request.SetResolvedRemoteHost(ip);
+    }
 
-        ret = curl_easy_getinfo(connectionHandle, CURLINFO_APPCONNECT_TIME, &timep); // Ssl Latency
-        if (ret == CURLE_OK)
-        {
-            request.AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::SslLatency), static_cast<int64_t>(timep * 1000));
-        }
+    //go ahead and flush the response body stream
+    if(response)
+    {
+        response->GetResponseBody().flush();
+    }
+    request.AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::RequestLatency), (DateTime::Now() - startTransmissionTime).count());
+}
+
+CURLcode CurlHttpClient::MakeRequestOnHandle(CURL* connectionHandle, HttpRequest& request,
+        std::shared_ptr<StandardHttpResponse>& response,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Obtained connection handle " << connectionHandle);
+
+    struct curl_slist* headers = BuildHeaderList(request);
+    CurlWriteCallbackContext writeContext(this, &request, response.get(), readLimiter);
+    CurlReadCallbackContext readContext(this, &request, writeLimiter);
+    ConfigureConnectionHandle(connectionHandle, request, response.get(), headers, writeContext, readContext);
+
+    Aws::Utils::DateTime startTransmissionTime = Aws::Utils::DateTime::Now();
+    CURLcode curlResponseCode = curl_easy_perform(connectionHandle);
+    OnTransferComplete(connectionHandle, curlResponseCode, request, response, writeContext, startTransmissionTime);
 
-        const char* ip = nullptr;
-        auto curlGetInfoResult = curl_easy_getinfo(connectionHandle, CURLINFO_PRIMARY_IP, &ip); // Get the IP address of the remote endpoint
-        if (curlGetInfoResult == CURLE_OK && ip)
+    if (headers)
+    {
+        curl_slist_free_all(headers);
+    }
+    return curlResponseCode;
+}
+
+void CurlHttpClient::MakeRequestInternal(HttpRequest& request,
+        std::shared_ptr<StandardHttpResponse>& response,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    if (writeLimiter != nullptr)
+    {
+        writeLimiter->ApplyAndPayForCost(request.GetSize());
+    }
+
+    const Aws::String& host = request.GetUri().GetAuthority();
+    CURL* connectionHandle = m_curlHandleContainer.AcquireCurlHandle(host);
+
+    if (connectionHandle)
+    {
+        MakeRequestOnHandle(connectionHandle, request, response, readLimiter, writeLimiter);
+        m_curlHandleContainer.ReleaseCurlHandle(connectionHandle, host);
+    }
+}
+
+std::shared_ptr<HttpRequest> CurlHttpClient::CreateWarmUpRequest(const URI& endpoint)
+{
+    auto request = Aws::MakeShared<StandardHttpRequest>(CURL_HTTP_CLIENT_TAG, endpoint, HttpMethod::HTTP_HEAD);
+    request->SetResponseStreamFactory(Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    return request;
+}
+
+bool CurlHttpClient::OpenedNewConnection(const HttpRequest& request)
+{
+    const auto& metrics = request.GetRequestMetrics();
+    auto reused = metrics.find(GetHttpClientMetricNameByType(HttpClientMetricsType::ConnectionReused));
+    return reused != metrics.end() && reused->second == 0;
+}
+
+size_t CurlHttpClient::WarmUpConnections(const URI& endpoint, size_t connectionCount) const
+{
+    const Aws::String& host = endpoint.GetAuthority();
+    Aws::Vector<CURL*> connectionHandles;
+    while (connectionHandles.size() < connectionCount)
+    {
+        CURL* connectionHandle = m_curlHandleContainer.TryAcquireCurlHandle(host);
+        if (!connectionHandle)
         {
-            request.SetResolvedRemoteHost(ip);
+            break;
         }
+        connectionHandles.push_back(connectionHandle);
+    }
 
-        m_curlHandleContainer.ReleaseCurlHandle(connectionHandle);
-        //go ahead and flush the response body stream
-        if(response)
+    // all handles are held until every one has connected, otherwise the pool would hand the same handle out again.
+    size_t opened = 0;
+    for (CURL* connectionHandle : connectionHandles)
+    {
+        auto request = CreateWarmUpRequest(endpoint);
+        auto response = Aws::MakeShared<StandardHttpResponse>(CURL_HTTP_CLIENT_TAG, request);
+        MakeRequestOnHandle(connectionHandle, *request, response, nullptr, nullptr);
+        if (response && OpenedNewConnection(*request))
         {
-            response->GetResponseBody().flush();
+            ++opened;
         }
-        request.AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::RequestLatency), (DateTime::Now() - startTransmissionTime).count());
     }
 
-    if (headers)
+    for (CURL* connectionHandle : connectionHandles)
     {
-        curl_slist_free_all(headers);
+        m_curlHandleContainer.ReleaseCurlHandle(connectionHandle, host);
     }
+
+    AWS_LOGSTREAM_INFO(CURL_HTTP_CLIENT_TAG, "Opened " << opened << " of " << connectionCount << " connections to " << host);
+    return opened;
 }
 
 std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(HttpRequest& request,
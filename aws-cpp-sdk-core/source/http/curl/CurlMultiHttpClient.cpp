@@ -0,0 +1,484 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/core/http/curl/CurlMultiHttpClient.h>
+#include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/standard/StandardHttpResponse.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/ratelimiter/RateLimiterInterface.h>
+#include <aws/core/utils/memory/stl/AWSQueue.h>
+#include <aws/core/utils/memory/stl/AWSSet.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if !defined(CURL_HAS_MULTI_POLL) && !defined(_WIN32)
+// curl_multi_wait can't be interrupted, but it can wait on an extra descriptor: the read end of a pipe that Wakeup writes to.
+#define CURL_MULTI_WAKEUP_PIPE
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Aws::Client;
+using namespace Aws::Http;
+using namespace Aws::Http::Standard;
+using namespace Aws::Utils;
+using namespace Aws::Utils::Logging;
+
+static const char* CURL_MULTI_HTTP_CLIENT_TAG = "CurlMultiHttpClient";
+
+// Upper bound on how long an event loop sleeps when curl has nothing scheduled sooner.
+static const int EVENT_LOOP_MAX_WAIT_MS = 1000;
+#ifndef CURL_HAS_MULTI_POLL
+// Without a way to wake the loop, newly submitted requests are only noticed when the wait times out, so keep it short.
+static const int EVENT_LOOP_POLL_INTERVAL_MS = 5;
+#endif
+
+/**
+ * Everything a request needs while it is owned by an event loop. Curl callbacks point into the contexts, so a Transfer
+ * must not move once its handle has been configured.
+ */
+struct CurlMultiHttpClient::Transfer
+{
+    Transfer(const CurlMultiHttpClient* client, const std::shared_ptr<HttpRequest>& req, const HttpRequestCompletedHandler& onComplete,
+             Aws::Utils::RateLimits::RateLimiterInterface* readLimiter, Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) :
+        request(req),
+        response(Aws::MakeShared<StandardHttpResponse>(CURL_MULTI_HTTP_CLIENT_TAG, req)),
+        handler(onComplete),
+        writeContext(client, req.get(), response.get(), readLimiter),
+        readContext(client, req.get(), writeLimiter),
+        headers(nullptr),
+        connectionHandle(nullptr)
+    {}
+
+    std::shared_ptr<HttpRequest> request;
+    std::shared_ptr<StandardHttpResponse> response;
+    HttpRequestCompletedHandler handler;
+    CurlWriteCallbackContext writeContext;
+    CurlReadCallbackContext readContext;
+    struct curl_slist* headers;
+    CURL* connectionHandle;
+    DateTime startTransmissionTime;
+};
+
+/**
+ * One curl multi handle plus the thread that drives it. Other threads only ever touch the submission queue;
+ * everything else, including the multi handle, belongs to the loop thread.
+ */
+class CurlMultiHttpClient::EventLoop
+{
+public:
+    EventLoop(const CurlMultiHttpClient* client) :
+        m_client(client),
+        m_multiHandle(curl_multi_init()),
+        m_continue(true),
+        m_hasWaitingTransfers(false)
+    {
+#ifdef CURL_MULTI_WAKEUP_PIPE
+        m_wakeupPipe[0] = m_wakeupPipe[1] = -1;
+        if (pipe(m_wakeupPipe) == 0)
+        {
+            for (int fd : m_wakeupPipe)
+            {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                fcntl(fd, F_SETFD, FD_CLOEXEC);
+            }
+        }
+        else
+        {
+            AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "Failed to create the event loop's wakeup pipe, polling for new requests instead.");
+            m_wakeupPipe[0] = m_wakeupPipe[1] = -1;
+        }
+#endif
+        m_thread = std::thread(&EventLoop::Run, this);
+    }
+
+    ~EventLoop()
+    {
+        Stop();
+        curl_multi_cleanup(m_multiHandle);
+#ifdef CURL_MULTI_WAKEUP_PIPE
+        for (int fd : m_wakeupPipe)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    // Signals the loop thread to abort everything it owns and waits for it to exit.
+    void Stop()
+    {
+        if (m_thread.joinable())
+        {
+            assert(std::this_thread::get_id() != m_thread.get_id());
+            m_continue = false;
+            Wakeup();
+            m_thread.join();
+        }
+    }
+
+    void Submit(Transfer* transfer)
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_submissionLock);
+            m_submitted.push(transfer);
+        }
+        Wakeup();
+    }
+
+    // Submits transfers together, so that the loop starts them all in the same pass.
+    void Submit(const Aws::Vector<Transfer*>& transfers)
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_submissionLock);
+            for (Transfer* transfer : transfers)
+            {
+                m_submitted.push(transfer);
+            }
+        }
+        Wakeup();
+    }
+
+    void WakeupIfWaitingForHandle()
+    {
+        if (m_hasWaitingTransfers.load())
+        {
+            Wakeup();
+        }
+    }
+
+private:
+    void Wakeup()
+    {
+#ifdef CURL_HAS_MULTI_POLL
+        curl_multi_wakeup(m_multiHandle);
+#elif defined(CURL_MULTI_WAKEUP_PIPE)
+        // a full pipe already has a wakeup pending.
+        if (m_wakeupPipe[1] >= 0)
+        {
+            char wakeup = 0;
+            ssize_t written = write(m_wakeupPipe[1], &wakeup, 1);
+            AWS_UNREFERENCED_PARAM(written);
+        }
+#endif
+    }
+
+    // Waits up to waitMs for activity on the transfers or a Wakeup.
+    void Wait(int waitMs)
+    {
+#ifdef CURL_HAS_MULTI_POLL
+        curl_multi_poll(m_multiHandle, nullptr, 0, waitMs, nullptr);
+#elif defined(CURL_MULTI_WAKEUP_PIPE)
+        if (m_wakeupPipe[0] < 0)
+        {
+            curl_multi_wait(m_multiHandle, nullptr, 0, (std::min)(waitMs, EVENT_LOOP_POLL_INTERVAL_MS), nullptr);
+            return;
+        }
+
+        curl_waitfd wakeupFd;
+        wakeupFd.fd = m_wakeupPipe[0];
+        wakeupFd.events = CURL_WAIT_POLLIN;
+        wakeupFd.revents = 0;
+        curl_multi_wait(m_multiHandle, &wakeupFd, 1, waitMs, nullptr);
+        if (wakeupFd.revents)
+        {
+            char drained[64];
+            while (read(m_wakeupPipe[0], drained, sizeof(drained)) > 0)
+            {
+            }
+        }
+#else
+        curl_multi_wait(m_multiHandle, nullptr, 0, (std::min)(waitMs, EVENT_LOOP_POLL_INTERVAL_MS), nullptr);
+#endif
+    }
+
+    void Run()
+    {
+        while (m_continue.load())
+        {
+            StartWaitingTransfers();
+
+            int runningHandles = 0;
+            curl_multi_perform(m_multiHandle, &runningHandles);
+            ProcessCompletedTransfers();
+
+            long timeoutMs = -1;
+            curl_multi_timeout(m_multiHandle, &timeoutMs);
+            int waitMs = timeoutMs < 0 ? EVENT_LOOP_MAX_WAIT_MS : static_cast<int>((std::min)(timeoutMs, static_cast<long>(EVENT_LOOP_MAX_WAIT_MS)));
+            Wait(waitMs);
+        }
+
+        AbortAllTransfers();
+    }
+
+    // Moves newly submitted transfers onto the waiting queue, then attaches as many waiting transfers as there are free handles.
+    void StartWaitingTransfers()
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_submissionLock);
+            while (!m_submitted.empty())
+            {
+                m_waitingForHandle.push(m_submitted.front());
+                m_submitted.pop();
+            }
+        }
+
+        // Publish that we are waiting before trying the pool, so a handle released concurrently by another loop wakes us up.
+        m_hasWaitingTransfers = !m_waitingForHandle.empty();
+
+        // Goes through the queue once; a transfer whose host is at its connection limit goes to the back, in order, and doesn't hold up
+        // transfers to other hosts behind it.
+        Aws::Set<Aws::String> hostsWithoutHandle;
+        for (size_t waiting = m_waitingForHandle.size(); waiting > 0; --waiting)
+        {
+            Transfer* transfer = m_waitingForHandle.front();
+            m_waitingForHandle.pop();
+
+            const Aws::String& host = transfer->request->GetUri().GetAuthority();
+            CURL* connectionHandle = hostsWithoutHandle.count(host) ? nullptr : m_client->m_curlHandleContainer.TryAcquireCurlHandle(host);
+            if (!connectionHandle)
+            {
+                hostsWithoutHandle.insert(host);
+                m_waitingForHandle.push(transfer);
+                continue;
+            }
+            StartTransfer(transfer, connectionHandle);
+        }
+
+        if (!m_waitingForHandle.empty())
+        {
+            AWS_LOGSTREAM_DEBUG(CURL_MULTI_HTTP_CLIENT_TAG, m_waitingForHandle.size() << " requests waiting for a connection handle.");
+        }
+        m_hasWaitingTransfers = !m_waitingForHandle.empty();
+    }
+
+    void StartTransfer(Transfer* transfer, CURL* connectionHandle)
+    {
+        AWS_LOGSTREAM_DEBUG(CURL_MULTI_HTTP_CLIENT_TAG, "Obtained connection handle " << connectionHandle);
+        HttpRequest& request = *transfer->request;
+
+        transfer->connectionHandle = connectionHandle;
+        transfer->headers = m_client->BuildHeaderList(request);
+        m_client->ConfigureConnectionHandle(connectionHandle, request, transfer->response.get(), transfer->headers,
+                transfer->writeContext, transfer->readContext);
+        curl_easy_setopt(connectionHandle, CURLOPT_PRIVATE, transfer);
+
+        transfer->startTransmissionTime = DateTime::Now();
+        CURLMcode code = curl_multi_add_handle(m_multiHandle, connectionHandle);
+        if (code != CURLM_OK)
+        {
+            AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "Failed to add handle to curl multi: " << curl_multi_strerror(code));
+            CompleteTransfer(transfer, CURLE_FAILED_INIT);
+            return;
+        }
+        m_activeTransfers.insert(transfer);
+    }
+
+    void ProcessCompletedTransfers()
+    {
+        int messagesInQueue = 0;
+        while (CURLMsg* message = curl_multi_info_read(m_multiHandle, &messagesInQueue))
+        {
+            if (message->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+
+            Transfer* transfer = nullptr;
+            curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+            CURLcode result = message->data.result;
+            // message is invalidated as soon as its handle is removed from the multi handle.
+            curl_multi_remove_handle(m_multiHandle, transfer->connectionHandle);
+            m_activeTransfers.erase(transfer);
+            CompleteTransfer(transfer, result);
+        }
+    }
+
+    void CompleteTransfer(Transfer* transfer, CURLcode result)
+    {
+        m_client->OnTransferComplete(transfer->connectionHandle, result, *transfer->request, transfer->response,
+                transfer->writeContext, transfer->startTransmissionTime);
+
+        m_client->m_curlHandleContainer.ReleaseCurlHandle(transfer->connectionHandle, transfer->request->GetUri().GetAuthority());
+        m_client->NotifyHandleReleased();
+        curl_slist_free_all(transfer->headers);
+
+        std::shared_ptr<HttpResponse> response = transfer->response;
+        transfer->handler(transfer->request, response);
+        Aws::Delete(transfer);
+    }
+
+    // Called on the loop thread once it has been told to stop. Nothing in flight gets a response.
+    void AbortAllTransfers()
+    {
+        for (Transfer* transfer : m_activeTransfers)
+        {
+            curl_multi_remove_handle(m_multiHandle, transfer->connectionHandle);
+            transfer->response = nullptr;
+            m_client->m_curlHandleContainer.ReleaseCurlHandle(transfer->connectionHandle, transfer->request->GetUri().GetAuthority());
+            curl_slist_free_all(transfer->headers);
+            transfer->handler(transfer->request, nullptr);
+            Aws::Delete(transfer);
+        }
+        m_activeTransfers.clear();
+
+        {
+            std::lock_guard<std::mutex> locker(m_submissionLock);
+            while (!m_submitted.empty())
+            {
+                m_waitingForHandle.push(m_submitted.front());
+                m_submitted.pop();
+            }
+        }
+
+        while (!m_waitingForHandle.empty())
+        {
+            Transfer* transfer = m_waitingForHandle.front();
+            m_waitingForHandle.pop();
+            transfer->handler(transfer->request, nullptr);
+            Aws::Delete(transfer);
+        }
+    }
+
+    const CurlMultiHttpClient* m_client;
+    CURLM* m_multiHandle;
+    std::atomic<bool> m_continue;
+    std::atomic<bool> m_hasWaitingTransfers;
+#ifdef CURL_MULTI_WAKEUP_PIPE
+    int m_wakeupPipe[2];
+#endif
+    std::mutex m_submissionLock;
+    Aws::Queue<Transfer*> m_submitted;
+    Aws::Queue<Transfer*> m_waitingForHandle;
+    Aws::Set<Transfer*> m_activeTransfers;
+    std::thread m_thread;
+};
+
+CurlMultiHttpClient::CurlMultiHttpClient(const ClientConfiguration& clientConfig) :
+    Base(clientConfig),
+    m_nextEventLoop(0)
+{
+    unsigned eventLoopCount = (std::max)(clientConfig.httpIoThreadCount, 1u);
+    AWS_LOGSTREAM_INFO(CURL_MULTI_HTTP_CLIENT_TAG, "Starting " << eventLoopCount << " curl multi event loops.");
+    for (unsigned i = 0; i < eventLoopCount; ++i)
+    {
+        m_eventLoops.emplace_back(Aws::MakeUnique<EventLoop>(CURL_MULTI_HTTP_CLIENT_TAG, this));
+    }
+}
+
+CurlMultiHttpClient::~CurlMultiHttpClient()
+{
+    AWS_LOGSTREAM_INFO(CURL_MULTI_HTTP_CLIENT_TAG, "Stopping curl multi event loops.");
+    // Stop every loop before destroying any of them, since a running loop notifies all the others when it releases a handle.
+    // Each loop releases its handles back to the container, which must still be alive at that point.
+    for (const auto& eventLoop : m_eventLoops)
+    {
+        eventLoop->Stop();
+    }
+    m_eventLoops.clear();
+}
+
+std::shared_ptr<HttpResponse> CurlMultiHttpClient::MakeRequest(HttpRequest& request,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    auto response = Aws::MakeShared<StandardHttpResponse>(CURL_MULTI_HTTP_CLIENT_TAG, request);
+    MakeRequestInternal(request, response, readLimiter, writeLimiter);
+    return response;
+}
+
+std::shared_ptr<HttpResponse> CurlMultiHttpClient::MakeRequest(const std::shared_ptr<HttpRequest>& request,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    std::mutex completionLock;
+    std::condition_variable completionSignal;
+    bool completed = false;
+    std::shared_ptr<HttpResponse> result;
+
+    MakeRequestAsync(request, [&](const std::shared_ptr<HttpRequest>&, const std::shared_ptr<HttpResponse>& response)
+    {
+        std::lock_guard<std::mutex> locker(completionLock);
+        result = response;
+        completed = true;
+        completionSignal.notify_one();
+    }, readLimiter, writeLimiter);
+
+    std::unique_lock<std::mutex> locker(completionLock);
+    completionSignal.wait(locker, [&](){ return completed; });
+    return result;
+}
+
+void CurlMultiHttpClient::MakeRequestAsync(const std::shared_ptr<HttpRequest>& request, const HttpRequestCompletedHandler& handler,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    if (writeLimiter != nullptr)
+    {
+        writeLimiter->ApplyAndPayForCost(request->GetSize());
+    }
+
+    Transfer* transfer = Aws::New<Transfer>(CURL_MULTI_HTTP_CLIENT_TAG, this, request, handler, readLimiter, writeLimiter);
+    size_t eventLoopIndex = m_nextEventLoop++ % m_eventLoops.size();
+    AWS_LOGSTREAM_TRACE(CURL_MULTI_HTTP_CLIENT_TAG, "Submitting request to event loop " << eventLoopIndex);
+    m_eventLoops[eventLoopIndex]->Submit(transfer);
+}
+
+size_t CurlMultiHttpClient::WarmUpConnections(const URI& endpoint, size_t connectionCount) const
+{
+    std::mutex completionLock;
+    std::condition_variable completionSignal;
+    size_t completed = 0;
+    size_t opened = 0;
+
+    HttpRequestCompletedHandler handler = [&](const std::shared_ptr<HttpRequest>& request, const std::shared_ptr<HttpResponse>& response)
+    {
+        std::lock_guard<std::mutex> locker(completionLock);
+        if (response && OpenedNewConnection(*request))
+        {
+            ++opened;
+        }
+        ++completed;
+        completionSignal.notify_one();
+    };
+
+    // all on one loop in one go; transfers started one at a time could find the previous one's connection already free and reuse it.
+    Aws::Vector<Transfer*> transfers;
+    for (size_t i = 0; i < connectionCount; ++i)
+    {
+        transfers.push_back(Aws::New<Transfer>(CURL_MULTI_HTTP_CLIENT_TAG, this, CreateWarmUpRequest(endpoint), handler, nullptr, nullptr));
+    }
+    m_eventLoops[m_nextEventLoop++ % m_eventLoops.size()]->Submit(transfers);
+
+    std::unique_lock<std::mutex> locker(completionLock);
+    completionSignal.wait(locker, [&](){ return completed == connectionCount; });
+    AWS_LOGSTREAM_INFO(CURL_MULTI_HTTP_CLIENT_TAG, "Opened " << opened << " of " << connectionCount << " connections to " << endpoint.GetAuthority());
+    return opened;
+}
+
+void CurlMultiHttpClient::NotifyHandleReleased() const
+{
+    for (const auto& eventLoop : m_eventLoops)
+    {
+        eventLoop->WakeupIfWaitingForHandle();
+    }
+}
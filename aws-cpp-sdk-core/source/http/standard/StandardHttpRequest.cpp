@@ -67,6 +67,14 @@ HeaderValueCollection StandardHttpRequest::GetHeaders() const
     return headers;
 }
 
+void StandardHttpRequest::VisitHeaders(const HeaderVisitor& visitor) const
+{
+    for (const auto& header : headerMap)
+    {
+        visitor(header.first, header.second);
+    }
+}
+
 const Aws::String& StandardHttpRequest::GetHeaderValue(const char* headerName) const
 {
     auto iter = headerMap.find(headerName);
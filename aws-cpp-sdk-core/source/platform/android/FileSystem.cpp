@@ -15,11 +15,13 @@
 #include <aws/core/platform/FileSystem.h>
 
 #include <aws/core/platform/Android.h>
+#include <aws/core/utils/DateTime.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/StringUtils.h>
 
 #include <unistd.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <cerrno>
 #include <dirent.h>
 #include <cassert>
@@ -33,6 +35,36 @@ namespace FileSystem
 
 static const char* FILE_SYSTEM_UTILS_LOG_TAG = "FileSystem";
 
+    static bool StatEntry(DirectoryEntry& entry)
+    {
+        struct stat dirInfo;
+        if(lstat(entry.path.c_str(), &dirInfo))
+        {
+            return false;
+        }
+
+        if(S_ISDIR(dirInfo.st_mode))
+        {
+            AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type directory detected");
+            entry.fileType = FileType::Directory;
+        }
+        else if(S_ISLNK(dirInfo.st_mode))
+        {
+            AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type symlink detected");
+            entry.fileType = FileType::Symlink;
+        }
+        else if(S_ISREG(dirInfo.st_mode))
+        {
+            AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type file detected");
+            entry.fileType = FileType::File;
+        }
+
+        entry.fileSize = static_cast<int64_t>(dirInfo.st_size);
+        entry.lastModified = Aws::Utils::DateTime(static_cast<int64_t>(dirInfo.st_mtime) * 1000);
+        AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "file size detected as " << entry.fileSize);
+        return true;
+    }
+
     class AndroidDirectory : public Directory
     {
     public:
@@ -120,29 +152,7 @@ static const char* FILE_SYSTEM_UTILS_LOG_TAG = "FileSystem";
 
             AWS_LOGSTREAM_TRACE(FILE_SYSTEM_UTILS_LOG_TAG, "Calling stat on path " << entry.path);
 
-            struct stat dirInfo;
-            if(!lstat(entry.path.c_str(), &dirInfo))
-            {
-               if(S_ISDIR(dirInfo.st_mode))
-               {
-                   AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type directory detected");
-                   entry.fileType = FileType::Directory;
-               }
-               else if(S_ISLNK(dirInfo.st_mode))
-               {
-                   AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type symlink detected");
-                   entry.fileType = FileType::Symlink;
-               }
-               else if(S_ISREG(dirInfo.st_mode))
-               {
-                   AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type file detected");
-                   entry.fileType = FileType::File;
-               }
-
-               entry.fileSize = static_cast<int64_t>(dirInfo.st_size);
-               AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "file size detected as " << entry.fileSize);
-            }
-            else
+            if(!StatEntry(entry))
             {
                 AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Failed to stat file path " << entry.path << " with error code " << errno);
             }
@@ -153,6 +163,67 @@ static const char* FILE_SYSTEM_UTILS_LOG_TAG = "FileSystem";
         DIR* m_dir;
     };
 
+    class AndroidPositionalFileWriter : public PositionalFileWriter
+    {
+    public:
+        AndroidPositionalFileWriter(const char* path, uint64_t size) : m_path(path), m_fd(-1)
+        {
+            m_fd = open(path, O_WRONLY | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+            if (m_fd < 0)
+            {
+                AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not open file " << path << " for writing with error code " << errno);
+                return;
+            }
+
+            if (ftruncate(m_fd, static_cast<off_t>(size)))
+            {
+                AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not resize file " << path << " to " << size << " bytes with error code " << errno);
+                close(m_fd);
+                m_fd = -1;
+                return;
+            }
+        }
+
+        ~AndroidPositionalFileWriter()
+        {
+            if (m_fd >= 0)
+            {
+                close(m_fd);
+            }
+        }
+
+        operator bool() const override { return m_fd >= 0; }
+
+        bool WriteAt(uint64_t offset, const unsigned char* data, size_t length) override
+        {
+            assert(m_fd >= 0);
+            while (length > 0)
+            {
+                ssize_t written = pwrite(m_fd, data, length, static_cast<off_t>(offset));
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Failed to write " << length << " bytes at offset " << offset
+                            << " of file " << m_path << " with error code " << errno);
+                    return false;
+                }
+
+                data += written;
+                length -= static_cast<size_t>(written);
+                offset += static_cast<uint64_t>(written);
+            }
+            return true;
+        }
+
+    private:
+        Aws::String m_path;
+        int m_fd;
+    };
+
 Aws::String GetHomeDirectory()
 {
     return Aws::Platform::GetCacheDirectory();
@@ -252,6 +323,23 @@ Aws::UniquePtr<Directory> OpenDirectory(const Aws::String& path, const Aws::Stri
     return Aws::MakeUnique<AndroidDirectory>(FILE_SYSTEM_UTILS_LOG_TAG, path, relativePath);
 }
 
+DirectoryEntry GetFileInfo(const char* path)
+{
+    DirectoryEntry entry;
+    entry.path = path;
+    if(!StatEntry(entry))
+    {
+        AWS_LOGSTREAM_TRACE(FILE_SYSTEM_UTILS_LOG_TAG, "Could not stat " << path << " with error code " << errno);
+        entry.fileType = FileType::None;
+    }
+    return entry;
+}
+
+Aws::UniquePtr<PositionalFileWriter> OpenFileForPositionalWrite(const char* path, uint64_t size)
+{
+    return Aws::MakeUnique<AndroidPositionalFileWriter>(FILE_SYSTEM_UTILS_LOG_TAG, path, size);
+}
+
 } // namespace FileSystem
 } // namespace Aws
 
@@ -15,9 +15,11 @@
 #include <aws/core/platform/FileSystem.h>
 
 #include <aws/core/platform/Environment.h>
+#include <aws/core/utils/DateTime.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/StringUtils.h>
 #include <cassert>
+#include <algorithm>
 #include <iostream>
 #include <Userenv.h>
 
@@ -45,6 +47,15 @@ static inline Aws::WString ToLongPath(const Aws::WString& path)
     return path;
 }
 
+// FILETIME counts 100ns intervals since 1601-01-01.
+static DateTime FileTimeToDateTime(const FILETIME& fileTime)
+{
+    ULARGE_INTEGER ticks;
+    ticks.HighPart = fileTime.dwHighDateTime;
+    ticks.LowPart = fileTime.dwLowDateTime;
+    return DateTime(static_cast<int64_t>(ticks.QuadPart / 10000) - 11644473600000LL);
+}
+
 class User32Directory : public Directory
 {
 public:
@@ -120,6 +131,7 @@ private:
         fileSize.HighPart = ffd.nFileSizeHigh;
         fileSize.LowPart = ffd.nFileSizeLow;
         entry.fileSize = static_cast<int64_t>(fileSize.QuadPart);
+        entry.lastModified = FileTimeToDateTime(ffd.ftLastWriteTime);
 
         if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
         {
@@ -149,6 +161,71 @@ private:
     DWORD m_lastError;
 };
 
+class User32PositionalFileWriter : public PositionalFileWriter
+{
+public:
+    User32PositionalFileWriter(const char* path, uint64_t size) : m_path(path), m_file(INVALID_HANDLE_VALUE)
+    {
+        m_file = CreateFileW(ToLongPath(Aws::Utils::StringUtils::ToWString(path)).c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                             OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not open file " << path << " for writing with error code " << GetLastError());
+            return;
+        }
+
+        // setting the end of file allocates the space for the whole file.
+        LARGE_INTEGER fileSize;
+        fileSize.QuadPart = static_cast<LONGLONG>(size);
+        if (!SetFilePointerEx(m_file, fileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(m_file))
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not resize file " << path << " to " << size << " bytes with error code " << GetLastError());
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+    }
+
+    ~User32PositionalFileWriter()
+    {
+        if (m_file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+        }
+    }
+
+    operator bool() const override { return m_file != INVALID_HANDLE_VALUE; }
+
+    bool WriteAt(uint64_t offset, const unsigned char* data, size_t length) override
+    {
+        assert(m_file != INVALID_HANDLE_VALUE);
+        while (length > 0)
+        {
+            // the offset in the overlapped structure makes this a positional write on a synchronous handle.
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+            DWORD toWrite = static_cast<DWORD>((std::min)(length, static_cast<size_t>(MAXDWORD)));
+            DWORD written = 0;
+            if (!WriteFile(m_file, data, toWrite, &written, &overlapped))
+            {
+                AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Failed to write " << length << " bytes at offset " << offset
+                        << " of file " << m_path << " with error code " << GetLastError());
+                return false;
+            }
+
+            data += written;
+            length -= written;
+            offset += written;
+        }
+        return true;
+    }
+
+private:
+    Aws::String m_path;
+    HANDLE m_file;
+};
+
 Aws::String GetHomeDirectory()
 {
     static const char* HOME_DIR_ENV_VAR = "USERPROFILE";
@@ -342,5 +419,30 @@ Aws::UniquePtr<Directory> OpenDirectory(const Aws::String& path, const Aws::Stri
     return Aws::MakeUnique<User32Directory>(FILE_SYSTEM_UTILS_LOG_TAG, path, relativePath);
 }
 
+DirectoryEntry GetFileInfo(const char* path)
+{
+    DirectoryEntry entry;
+    entry.path = path;
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExW(ToLongPath(StringUtils::ToWString(path)).c_str(), GetFileExInfoStandard, &attributes))
+    {
+        AWS_LOGSTREAM_TRACE(FILE_SYSTEM_UTILS_LOG_TAG, "Could not get attributes of " << path << " with error code " << GetLastError());
+        return entry;
+    }
+
+    LARGE_INTEGER fileSize;
+    fileSize.HighPart = attributes.nFileSizeHigh;
+    fileSize.LowPart = attributes.nFileSizeLow;
+    entry.fileSize = static_cast<int64_t>(fileSize.QuadPart);
+    entry.lastModified = FileTimeToDateTime(attributes.ftLastWriteTime);
+    entry.fileType = (attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ? FileType::Directory : FileType::File;
+    return entry;
+}
+
+Aws::UniquePtr<PositionalFileWriter> OpenFileForPositionalWrite(const char* path, uint64_t size)
+{
+    return Aws::MakeUnique<User32PositionalFileWriter>(FILE_SYSTEM_UTILS_LOG_TAG, path, size);
+}
+
 } // namespace FileSystem
 } // namespace Aws
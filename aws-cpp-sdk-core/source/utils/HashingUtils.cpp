@@ -36,6 +36,9 @@ static Aws::Utils::Base64::Base64 s_base64;
 // Aws Glacier Tree Hash calculates hash value for each 1MB data
 const static size_t TREE_HASH_ONE_MB = 1024 * 1024;
 
+// reads for CalculateMD5AndSHA256 are large enough to keep both digests busy between calls into the stream
+const static size_t MULTI_HASH_READ_SIZE = 64 * 1024;
+
 Aws::String HashingUtils::Base64Encode(const ByteBuffer& message)
 {
     return s_base64.Encode(message);
@@ -231,6 +234,52 @@ ByteBuffer HashingUtils::CalculateMD5(Aws::IOStream& stream)
     return hash.Calculate(stream).GetResult();
 }
 
+bool HashingUtils::CalculateMD5AndSHA256(Aws::IOStream& stream, ByteBuffer& md5, ByteBuffer& sha256)
+{
+    MD5 md5Hash;
+    Sha256 sha256Hash;
+
+    auto currentPos = stream.tellg();
+    if (currentPos == -1)
+    {
+        currentPos = 0;
+        stream.clear();
+    }
+    stream.seekg(0, stream.beg);
+
+    ByteBuffer streamBuffer(MULTI_HASH_READ_SIZE);
+    while (stream.good())
+    {
+        stream.read(reinterpret_cast<char*>(streamBuffer.GetUnderlyingData()), MULTI_HASH_READ_SIZE);
+        auto bytesRead = stream.gcount();
+        if (bytesRead > 0)
+        {
+            md5Hash.Update(streamBuffer.GetUnderlyingData(), static_cast<size_t>(bytesRead));
+            sha256Hash.Update(streamBuffer.GetUnderlyingData(), static_cast<size_t>(bytesRead));
+        }
+    }
+
+    stream.clear();
+    stream.seekg(currentPos, stream.beg);
+
+    auto md5Result = md5Hash.GetHash();
+    auto sha256Result = sha256Hash.GetHash();
+    if (!md5Result.IsSuccess() || !sha256Result.IsSuccess())
+    {
+        //an implementation from a custom factory may not hash incrementally, fall back to reading the stream once per digest.
+        md5Result = md5Hash.Calculate(stream);
+        sha256Result = sha256Hash.Calculate(stream);
+        if (!md5Result.IsSuccess() || !sha256Result.IsSuccess())
+        {
+            return false;
+        }
+    }
+
+    md5 = md5Result.GetResult();
+    sha256 = sha256Result.GetResult();
+    return true;
+}
+
 int HashingUtils::HashString(const char* strToHash)
 {
     if (!strToHash)
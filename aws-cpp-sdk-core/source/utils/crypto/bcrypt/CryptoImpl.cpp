@@ -128,6 +128,9 @@ namespace Aws
                 m_hashBuffer(nullptr),
                 m_hashObjectLength(0),
                 m_hashObject(nullptr),
+                m_incrementalHashObject(nullptr),
+                m_incrementalHashHandle(nullptr),
+                m_incrementalHashFailed(false),
                 m_algorithmMutex()
             {
                 NTSTATUS status = BCryptOpenAlgorithmProvider(&m_algorithmHandle, algorithmName, MS_PRIMITIVE_PROVIDER, isHMAC ? BCRYPT_ALG_HANDLE_HMAC_FLAG : 0);
@@ -170,6 +173,11 @@ namespace Aws
 
             BCryptHashImpl::~BCryptHashImpl()
             {
+                if (m_incrementalHashHandle)
+                {
+                    BCryptDestroyHash(m_incrementalHashHandle);
+                }
+                Aws::DeleteArray(m_incrementalHashObject);
                 Aws::DeleteArray(m_hashObject);
                 Aws::DeleteArray(m_hashBuffer);
 
@@ -310,6 +318,88 @@ namespace Aws
                 return HashResult(ByteBuffer(m_hashBuffer, m_hashBufferLength));
             }
 
+            bool BCryptHashImpl::CreateIncrementalHash()
+            {
+                if (m_incrementalHashHandle)
+                {
+                    return true;
+                }
+
+                if (!m_incrementalHashObject)
+                {
+                    m_incrementalHashObject = Aws::NewArray<BYTE>(m_hashObjectLength, logTag);
+                }
+
+                NTSTATUS status = BCryptCreateHash(m_algorithmHandle, &m_incrementalHashHandle, m_incrementalHashObject, m_hashObjectLength, nullptr, 0, 0);
+                if (!NT_SUCCESS(status))
+                {
+                    AWS_LOGSTREAM_ERROR(logTag, "Error creating hash handle.");
+                    m_incrementalHashHandle = nullptr;
+                    return false;
+                }
+
+                return true;
+            }
+
+            void BCryptHashImpl::Update(const unsigned char* buffer, size_t bufferSize)
+            {
+                if (!IsValid())
+                {
+                    return;
+                }
+
+                std::lock_guard<std::mutex> locker(m_algorithmMutex);
+
+                if (m_incrementalHashFailed || !CreateIncrementalHash())
+                {
+                    m_incrementalHashFailed = true;
+                    return;
+                }
+
+                NTSTATUS status = BCryptHashData(m_incrementalHashHandle, (PBYTE)buffer, static_cast<ULONG>(bufferSize), 0);
+                if (!NT_SUCCESS(status))
+                {
+                    AWS_LOGSTREAM_ERROR(logTag, "Error computing hash.");
+                    m_incrementalHashFailed = true;
+                }
+            }
+
+            HashResult BCryptHashImpl::GetHash()
+            {
+                if (!IsValid())
+                {
+                    return HashResult();
+                }
+
+                std::lock_guard<std::mutex> locker(m_algorithmMutex);
+
+                bool success = !m_incrementalHashFailed && CreateIncrementalHash();
+                if (success)
+                {
+                    NTSTATUS status = BCryptFinishHash(m_incrementalHashHandle, m_hashBuffer, m_hashBufferLength, 0);
+                    success = NT_SUCCESS(status);
+                    if (!success)
+                    {
+                        AWS_LOGSTREAM_ERROR(logTag, "Error obtaining computed hash");
+                    }
+                }
+
+                //a finished hash can't take more data, the next Update creates a new one.
+                if (m_incrementalHashHandle)
+                {
+                    BCryptDestroyHash(m_incrementalHashHandle);
+                    m_incrementalHashHandle = nullptr;
+                }
+                m_incrementalHashFailed = false;
+
+                if (!success)
+                {
+                    return HashResult();
+                }
+
+                return HashResult(ByteBuffer(m_hashBuffer, m_hashBufferLength));
+            }
+
             MD5BcryptImpl::MD5BcryptImpl() :
                 m_impl(BCRYPT_MD5_ALGORITHM, false)
             {
@@ -325,6 +415,16 @@ namespace Aws
                 return m_impl.Calculate(stream);
             }
 
+            void MD5BcryptImpl::Update(const unsigned char* buffer, size_t bufferSize)
+            {
+                m_impl.Update(buffer, bufferSize);
+            }
+
+            HashResult MD5BcryptImpl::GetHash()
+            {
+                return m_impl.GetHash();
+            }
+
             Sha256BcryptImpl::Sha256BcryptImpl() :
                 m_impl(BCRYPT_SHA256_ALGORITHM, false)
             {
@@ -340,6 +440,16 @@ namespace Aws
                 return m_impl.Calculate(stream);
             }
 
+            void Sha256BcryptImpl::Update(const unsigned char* buffer, size_t bufferSize)
+            {
+                m_impl.Update(buffer, bufferSize);
+            }
+
+            HashResult Sha256BcryptImpl::GetHash()
+            {
+                return m_impl.GetHash();
+            }
+
             Sha256HMACBcryptImpl::Sha256HMACBcryptImpl() :
                 m_impl(BCRYPT_SHA256_ALGORITHM, true)
             {
@@ -151,6 +151,42 @@ namespace Aws
                 EVP_MD_CTX *m_ctx;
             };
 
+            static void UpdateDigest(EVP_MD_CTX*& ctx, const EVP_MD* md, bool allowNonFips, const unsigned char* buffer, size_t bufferSize)
+            {
+                if (!ctx)
+                {
+                    ctx = EVP_MD_CTX_create();
+                    assert(ctx != nullptr);
+                    if (allowNonFips)
+                    {
+                        EVP_MD_CTX_set_flags(ctx, EVP_MD_CTX_FLAG_NON_FIPS_ALLOW);
+                    }
+                    EVP_DigestInit_ex(ctx, md, nullptr);
+                }
+                EVP_DigestUpdate(ctx, buffer, bufferSize);
+            }
+
+            static HashResult FinishDigest(EVP_MD_CTX*& ctx, const EVP_MD* md, bool allowNonFips)
+            {
+                //creates the context if nothing was added, giving the digest of empty input.
+                UpdateDigest(ctx, md, allowNonFips, nullptr, 0);
+
+                ByteBuffer hash(EVP_MD_size(md));
+                EVP_DigestFinal_ex(ctx, hash.GetUnderlyingData(), nullptr);
+                //keep the context around, ready for the next digest.
+                EVP_DigestInit_ex(ctx, md, nullptr);
+
+                return HashResult(std::move(hash));
+            }
+
+            MD5OpenSSLImpl::~MD5OpenSSLImpl()
+            {
+                if (m_ctx)
+                {
+                    EVP_MD_CTX_destroy(m_ctx);
+                }
+            }
+
             HashResult MD5OpenSSLImpl::Calculate(const Aws::String& str)
             {
                 OpensslCtxRAIIGuard guard;
@@ -201,6 +237,24 @@ namespace Aws
                 return HashResult(std::move(hash));
             }
 
+            void MD5OpenSSLImpl::Update(const unsigned char* buffer, size_t bufferSize)
+            {
+                UpdateDigest(m_ctx, EVP_md5(), true, buffer, bufferSize);
+            }
+
+            HashResult MD5OpenSSLImpl::GetHash()
+            {
+                return FinishDigest(m_ctx, EVP_md5(), true);
+            }
+
+            Sha256OpenSSLImpl::~Sha256OpenSSLImpl()
+            {
+                if (m_ctx)
+                {
+                    EVP_MD_CTX_destroy(m_ctx);
+                }
+            }
+
             HashResult Sha256OpenSSLImpl::Calculate(const Aws::String& str)
             {
                 OpensslCtxRAIIGuard guard;
@@ -251,6 +305,16 @@ namespace Aws
                 return HashResult(std::move(hash));
             }
 
+            void Sha256OpenSSLImpl::Update(const unsigned char* buffer, size_t bufferSize)
+            {
+                UpdateDigest(m_ctx, EVP_sha256(), false, buffer, bufferSize);
+            }
+
+            HashResult Sha256OpenSSLImpl::GetHash()
+            {
+                return FinishDigest(m_ctx, EVP_sha256(), false);
+            }
+
             class HMACRAIIGuard {
             public:
                 HMACRAIIGuard() {
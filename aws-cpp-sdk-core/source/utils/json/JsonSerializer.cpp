@@ -14,56 +14,483 @@
   */
 
 #include <aws/core/utils/json/JsonSerializer.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/MonotonicArena.h>
 
 #include <iterator>
 #include <algorithm>
+#include <clocale>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
 
 using namespace Aws::Utils;
 using namespace Aws::Utils::Json;
 
-JsonValue::JsonValue() : m_wasParseSuccessful(true)
+static const char JSON_VALUE_ALLOCATION_TAG[] = "JsonValue";
+//bytes read from a stream at a time when it can't report how much is left.
+static const size_t STREAM_READ_CHUNK_SIZE = 64 * 1024;
+
+namespace
+{
+    /**
+     * Parses JSON text in place: strings are unescaped where they are and terminated by overwriting their closing quote,
+     * so node keys and values point straight into the text. Accepts the same input as cJSON_ParseWithOpts with
+     * require_null_terminated set.
+     */
+    class InSituParser
+    {
+    public:
+        InSituParser(char* text, Aws::Utils::Memory::MonotonicArena& nodes) : m_cursor(text), m_nodes(nodes), m_depth(0) {}
+
+        cJSON* ParseDocument()
+        {
+            if (m_cursor[0] == '\xEF' && m_cursor[1] == '\xBB' && m_cursor[2] == '\xBF')
+            {
+                m_cursor += 3;
+            }
+
+            cJSON* root = NewNode();
+            SkipWhitespace();
+            if (!ParseValue(root))
+            {
+                return nullptr;
+            }
+
+            SkipWhitespace();
+            return *m_cursor == '\0' ? root : nullptr;
+        }
+
+        //where parsing stopped, on failure this is the offending input.
+        const char* GetCursor() const { return m_cursor; }
+
+    private:
+        void SkipWhitespace()
+        {
+            while (*m_cursor != '\0' && static_cast<unsigned char>(*m_cursor) <= 32)
+            {
+                ++m_cursor;
+            }
+        }
+
+        bool ParseLiteral(const char* literal, size_t length)
+        {
+            if (strncmp(m_cursor, literal, length) != 0)
+            {
+                return false;
+            }
+            m_cursor += length;
+            return true;
+        }
+
+        bool ParseValue(cJSON* item)
+        {
+            switch (*m_cursor)
+            {
+                case 'n':
+                    item->type = cJSON_NULL;
+                    return ParseLiteral("null", 4);
+                case 'f':
+                    item->type = cJSON_False;
+                    return ParseLiteral("false", 5);
+                case 't':
+                    item->type = cJSON_True;
+                    item->valueint = 1;
+                    return ParseLiteral("true", 4);
+                case '"':
+                    item->type = cJSON_String;
+                    return ParseString(item->valuestring);
+                case '[':
+                    return ParseArray(item);
+                case '{':
+                    return ParseObject(item);
+                case '-':
+                case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9':
+                    return ParseNumber(item);
+                default:
+                    return false;
+            }
+        }
+
+        bool ParseNumber(cJSON* item)
+        {
+            //same as cJSON: hand strtod the characters that can be part of a number, with the locale's decimal point.
+            char number[64];
+            const char decimalPoint = localeconv()->decimal_point[0];
+            size_t length = 0;
+            for (; length < sizeof(number) - 1 && strchr("0123456789+-eE.", m_cursor[length]) && m_cursor[length] != '\0'; ++length)
+            {
+                number[length] = m_cursor[length] == '.' ? decimalPoint : m_cursor[length];
+            }
+            number[length] = '\0';
+
+            char* end = nullptr;
+            const double value = strtod(number, &end);
+            if (end == number)
+            {
+                return false;
+            }
+
+            item->type = cJSON_Number;
+            item->valuedouble = value;
+            if (value >= INT_MAX)
+            {
+                item->valueint = INT_MAX;
+            }
+            else if (value <= static_cast<double>(INT_MIN))
+            {
+                item->valueint = INT_MIN;
+            }
+            else
+            {
+                item->valueint = static_cast<int>(value);
+            }
+
+            m_cursor += end - number;
+            return true;
+        }
+
+        static int HexValue(char c)
+        {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        static bool ParseHex4(const char* input, unsigned& codeUnit)
+        {
+            codeUnit = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                const int digit = HexValue(input[i]);
+                if (digit < 0)
+                {
+                    return false;
+                }
+                codeUnit = (codeUnit << 4) | static_cast<unsigned>(digit);
+            }
+            return true;
+        }
+
+        //m_cursor is on the 'u' of a \u escape. Decodes it, and the low surrogate that must follow a high one, to UTF-8 at out.
+        bool ParseUtf16Escape(char*& out)
+        {
+            unsigned codePoint = 0;
+            if (!ParseHex4(m_cursor + 1, codePoint) || (codePoint >= 0xDC00 && codePoint <= 0xDFFF))
+            {
+                return false;
+            }
+            m_cursor += 5;
+
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+            {
+                unsigned lowSurrogate = 0;
+                if (m_cursor[0] != '\\' || m_cursor[1] != 'u' || !ParseHex4(m_cursor + 2, lowSurrogate) ||
+                    lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+                {
+                    return false;
+                }
+                m_cursor += 6;
+                codePoint = 0x10000 + (((codePoint & 0x3FF) << 10) | (lowSurrogate & 0x3FF));
+            }
+
+            //the escape sequence is at least as long as its UTF-8 encoding, so this never overtakes the cursor.
+            if (codePoint < 0x80)
+            {
+                *out++ = static_cast<char>(codePoint);
+            }
+            else if (codePoint < 0x800)
+            {
+                *out++ = static_cast<char>(0xC0 | (codePoint >> 6));
+                *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000)
+            {
+                *out++ = static_cast<char>(0xE0 | (codePoint >> 12));
+                *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                *out++ = static_cast<char>(0xF0 | (codePoint >> 18));
+                *out++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            return true;
+        }
+
+        //m_cursor is on the opening quote. On success value points at the unescaped, null terminated string.
+        bool ParseString(char*& value)
+        {
+            char* out = ++m_cursor;
+            value = out;
+
+            //nothing moves until the first escape sequence.
+            while (*m_cursor != '"' && *m_cursor != '\\' && *m_cursor != '\0')
+            {
+                ++m_cursor;
+            }
+            out = m_cursor;
+
+            while (*m_cursor != '"')
+            {
+                if (*m_cursor == '\0')
+                {
+                    return false;
+                }
+                if (*m_cursor != '\\')
+                {
+                    *out++ = *m_cursor++;
+                    continue;
+                }
+
+                ++m_cursor;
+                switch (*m_cursor)
+                {
+                    case 'b': *out++ = '\b'; break;
+                    case 'f': *out++ = '\f'; break;
+                    case 'n': *out++ = '\n'; break;
+                    case 'r': *out++ = '\r'; break;
+                    case 't': *out++ = '\t'; break;
+                    case '"':
+                    case '\\':
+                    case '/':
+                        *out++ = *m_cursor;
+                        break;
+                    case 'u':
+                        if (!ParseUtf16Escape(out))
+                        {
+                            return false;
+                        }
+                        continue;
+                    default:
+                        return false;
+                }
+                ++m_cursor;
+            }
+
+            ++m_cursor;
+            *out = '\0';
+            return true;
+        }
+
+        bool ParseArray(cJSON* item)
+        {
+            if (m_depth >= CJSON_NESTING_LIMIT)
+            {
+                return false;
+            }
+            ++m_depth;
+            item->type = cJSON_Array;
+
+            ++m_cursor;
+            SkipWhitespace();
+            cJSON* last = nullptr;
+            if (*m_cursor != ']')
+            {
+                for (;;)
+                {
+                    cJSON* element = NewNode();
+                    Append(item, last, element);
+                    SkipWhitespace();
+                    if (!ParseValue(element))
+                    {
+                        return false;
+                    }
+                    SkipWhitespace();
+                    if (*m_cursor != ',')
+                    {
+                        break;
+                    }
+                    ++m_cursor;
+                }
+
+                if (*m_cursor != ']')
+                {
+                    return false;
+                }
+            }
+
+            ++m_cursor;
+            --m_depth;
+            return true;
+        }
+
+        bool ParseObject(cJSON* item)
+        {
+            if (m_depth >= CJSON_NESTING_LIMIT)
+            {
+                return false;
+            }
+            ++m_depth;
+            item->type = cJSON_Object;
+
+            ++m_cursor;
+            SkipWhitespace();
+            cJSON* last = nullptr;
+            if (*m_cursor != '}')
+            {
+                for (;;)
+                {
+                    cJSON* member = NewNode();
+                    Append(item, last, member);
+                    SkipWhitespace();
+                    if (*m_cursor != '"' || !ParseString(member->string))
+                    {
+                        return false;
+                    }
+                    SkipWhitespace();
+                    if (*m_cursor != ':')
+                    {
+                        return false;
+                    }
+                    ++m_cursor;
+                    SkipWhitespace();
+                    if (!ParseValue(member))
+                    {
+                        return false;
+                    }
+                    SkipWhitespace();
+                    if (*m_cursor != ',')
+                    {
+                        break;
+                    }
+                    ++m_cursor;
+                }
+
+                if (*m_cursor != '}')
+                {
+                    return false;
+                }
+            }
+
+            ++m_cursor;
+            --m_depth;
+            return true;
+        }
+
+        cJSON* NewNode()
+        {
+            //nodes in the arena are never freed individually, cJSON_Delete must not be called on them.
+            void* node = m_nodes.AllocateMemory(sizeof(cJSON), alignof(cJSON));
+            return static_cast<cJSON*>(memset(node, 0, sizeof(cJSON)));
+        }
+
+        static void Append(cJSON* parent, cJSON*& last, cJSON* child)
+        {
+            if (last)
+            {
+                last->next = child;
+                child->prev = last;
+            }
+            else
+            {
+                parent->child = child;
+            }
+            last = child;
+        }
+
+        char* m_cursor;
+        Aws::Utils::Memory::MonotonicArena& m_nodes;
+        int m_depth;
+    };
+}
+
+/**
+ * Owns the text a JsonValue was parsed from and the nodes of its DOM.
+ */
+struct JsonValue::ParsedDocument
+{
+    //the first block holds one node per 16 bytes of text, plus a few; denser documents continue in larger blocks.
+    explicit ParsedDocument(Aws::String&& parsedText) :
+        text(std::move(parsedText)),
+        nodes((text.size() / 16 + 16) * sizeof(cJSON), JSON_VALUE_ALLOCATION_TAG)
+    {
+    }
+
+    Aws::String text;
+    Aws::Utils::Memory::MonotonicArena nodes;
+};
+
+static Aws::String ReadRemainingStream(Aws::IStream& istream)
+{
+    Aws::String text;
+    auto buffer = istream.rdbuf();
+
+    //response bodies can usually report their size, which lets the text be read with a single allocation.
+    const auto start = istream.tellg();
+    if (start != std::streampos(-1))
+    {
+        istream.seekg(0, std::ios_base::end);
+        const auto end = istream.tellg();
+        istream.seekg(start);
+        if (end != std::streampos(-1) && end > start)
+        {
+            text.resize(static_cast<size_t>(end - start));
+            text.resize(static_cast<size_t>(buffer->sgetn(&text[0], static_cast<std::streamsize>(text.size()))));
+        }
+    }
+
+    //read whatever is left in chunks, all of the stream if its size is unknown.
+    while (buffer->sgetc() != std::char_traits<char>::eof())
+    {
+        const size_t offset = text.size();
+        text.resize(offset + STREAM_READ_CHUNK_SIZE);
+        const auto read = buffer->sgetn(&text[offset], static_cast<std::streamsize>(STREAM_READ_CHUNK_SIZE));
+        text.resize(offset + static_cast<size_t>(read > 0 ? read : 0));
+        if (read < static_cast<std::streamsize>(STREAM_READ_CHUNK_SIZE))
+        {
+            break;
+        }
+    }
+
+    return text;
+}
+
+JsonValue::JsonValue() : m_value(nullptr), m_document(nullptr), m_wasParseSuccessful(true)
 {
-    m_value = nullptr;
 }
 
 JsonValue::JsonValue(cJSON* value) :
     m_value(cJSON_Duplicate(value, true /* recurse */)),
+    m_document(nullptr),
     m_wasParseSuccessful(true)
 {
 }
 
-JsonValue::JsonValue(const Aws::String& value) : m_wasParseSuccessful(true)
+JsonValue::JsonValue(const Aws::String& value) : m_value(nullptr), m_document(nullptr), m_wasParseSuccessful(true)
 {
-    const char* return_parse_end;
-    m_value = cJSON_ParseWithOpts(value.c_str(), &return_parse_end, 1/*require_null_terminated*/);
+    Parse(Aws::String(value), "Failed to parse JSON at: ");
+}
 
-    if (!m_value || cJSON_IsInvalid(m_value))
-    {
-        m_wasParseSuccessful = false;
-        m_errorMessage = "Failed to parse JSON at: ";
-        m_errorMessage += return_parse_end;
-    }
+JsonValue::JsonValue(Aws::IStream& istream) : m_value(nullptr), m_document(nullptr), m_wasParseSuccessful(true)
+{
+    Parse(ReadRemainingStream(istream), "Failed to parse JSON. Invalid input at: ");
 }
 
-JsonValue::JsonValue(Aws::IStream& istream) : m_wasParseSuccessful(true)
+void JsonValue::Parse(Aws::String&& text, const char* errorPrefix)
 {
-    Aws::StringStream memoryStream;
-    std::copy(std::istreambuf_iterator<char>(istream), std::istreambuf_iterator<char>(), std::ostreambuf_iterator<char>(memoryStream));
-    const char* return_parse_end;
-    const auto input = memoryStream.str();
-    m_value = cJSON_ParseWithOpts(input.c_str(), &return_parse_end, 1/*require_null_terminated*/);
+    m_document = Aws::New<ParsedDocument>(JSON_VALUE_ALLOCATION_TAG, std::move(text));
 
-    if (!m_value || cJSON_IsInvalid(m_value))
+    //unescaping only ever writes behind the cursor, so the text from the point of failure on is still the original input.
+    InSituParser parser(&m_document->text[0], m_document->nodes);
+    m_value = parser.ParseDocument();
+    if (!m_value)
     {
         m_wasParseSuccessful = false;
-        m_errorMessage = "Failed to parse JSON. Invalid input at: ";
-        m_errorMessage += return_parse_end;
+        m_errorMessage = errorPrefix;
+        m_errorMessage += parser.GetCursor();
+        Aws::Delete(m_document);
+        m_document = nullptr;
     }
 }
 
 JsonValue::JsonValue(const JsonValue& value) :
     m_value(cJSON_Duplicate(value.m_value, true/*recurse*/)),
+    m_document(nullptr),
     m_wasParseSuccessful(value.m_wasParseSuccessful),
     m_errorMessage(value.m_errorMessage)
 {
@@ -71,15 +498,44 @@ JsonValue::JsonValue(const JsonValue& value) :
 
 JsonValue::JsonValue(JsonValue&& value) :
     m_value(value.m_value),
+    m_document(value.m_document),
     m_wasParseSuccessful(value.m_wasParseSuccessful),
     m_errorMessage(std::move(value.m_errorMessage))
 {
     value.m_value = nullptr;
+    value.m_document = nullptr;
 }
 
 void JsonValue::Destroy()
 {
-    cJSON_Delete(m_value);
+    if (m_document)
+    {
+        Aws::Delete(m_document);
+        m_document = nullptr;
+    }
+    else
+    {
+        cJSON_Delete(m_value);
+    }
+    m_value = nullptr;
+}
+
+void JsonValue::DetachFromParseBuffer()
+{
+    if (m_document)
+    {
+        cJSON* copy = cJSON_Duplicate(m_value, true /*recurse*/);
+        Destroy();
+        m_value = copy;
+    }
+}
+
+cJSON* JsonValue::ReleaseValue()
+{
+    DetachFromParseBuffer();
+    cJSON* value = m_value;
+    m_value = nullptr;
+    return value;
 }
 
 JsonValue::~JsonValue()
@@ -110,6 +566,7 @@ JsonValue& JsonValue::operator=(JsonValue&& other)
 
     using std::swap;
     swap(m_value, other.m_value);
+    swap(m_document, other.m_document);
     swap(m_errorMessage, other.m_errorMessage);
     m_wasParseSuccessful = other.m_wasParseSuccessful;
     return *this;
@@ -130,6 +587,7 @@ static void AddOrReplace(cJSON* root, const char* key, cJSON* value)
 
 JsonValue& JsonValue::WithString(const char* key, const Aws::String& value)
 {
+    DetachFromParseBuffer();
     if (!m_value)
     {
         m_value = cJSON_CreateObject();
@@ -154,6 +612,7 @@ JsonValue& JsonValue::AsString(const Aws::String& value)
 
 JsonValue& JsonValue::WithBool(const char* key, bool value)
 {
+    DetachFromParseBuffer();
     if (!m_value)
     {
         m_value = cJSON_CreateObject();
@@ -210,6 +669,7 @@ JsonValue& JsonValue::AsInt64(long long value)
 
 JsonValue& JsonValue::WithDouble(const char* key, double value)
 {
+    DetachFromParseBuffer();
     if (!m_value)
     {
         m_value = cJSON_CreateObject();
@@ -234,6 +694,7 @@ JsonValue& JsonValue::AsDouble(double value)
 
 JsonValue& JsonValue::WithArray(const char* key, const Array<Aws::String>& array)
 {
+    DetachFromParseBuffer();
     if (!m_value)
     {
         m_value = cJSON_CreateObject();
@@ -256,6 +717,7 @@ JsonValue& JsonValue::WithArray(const Aws::String& key, const Array<Aws::String>
 
 JsonValue& JsonValue::WithArray(const Aws::String& key, const Array<JsonValue>& array)
 {
+    DetachFromParseBuffer();
     if (!m_value)
     {
         m_value = cJSON_CreateObject();
@@ -273,6 +735,7 @@ JsonValue& JsonValue::WithArray(const Aws::String& key, const Array<JsonValue>&
 
 JsonValue& JsonValue::WithArray(const Aws::String& key, Array<JsonValue>&& array)
 {
+    DetachFromParseBuffer();
     if (!m_value)
     {
         m_value = cJSON_CreateObject();
@@ -281,8 +744,7 @@ JsonValue& JsonValue::WithArray(const Aws::String& key, Array<JsonValue>&& array
     auto arrayValue = cJSON_CreateArray();
     for (unsigned i = 0; i < array.GetLength(); ++i)
     {
-        cJSON_AddItemToArray(arrayValue, array[i].m_value);
-        array[i].m_value = nullptr;
+        cJSON_AddItemToArray(arrayValue, array[i].ReleaseValue());
     }
 
     AddOrReplace(m_value, key.c_str(), arrayValue);
@@ -307,8 +769,7 @@ JsonValue& JsonValue::AsArray(Array<JsonValue>&& array)
     auto arrayValue = cJSON_CreateArray();
     for (unsigned i = 0; i < array.GetLength(); ++i)
     {
-        cJSON_AddItemToArray(arrayValue, array[i].m_value);
-        array[i].m_value = nullptr;
+        cJSON_AddItemToArray(arrayValue, array[i].ReleaseValue());
     }
 
     Destroy();
@@ -318,6 +779,7 @@ JsonValue& JsonValue::AsArray(Array<JsonValue>&& array)
 
 JsonValue& JsonValue::WithObject(const char* key, const JsonValue& value)
 {
+    DetachFromParseBuffer();
     if (!m_value)
     {
         m_value = cJSON_CreateObject();
@@ -335,13 +797,13 @@ JsonValue& JsonValue::WithObject(const Aws::String& key, const JsonValue& value)
 
 JsonValue& JsonValue::WithObject(const char* key, JsonValue&& value)
 {
+    DetachFromParseBuffer();
     if (!m_value)
     {
         m_value = cJSON_CreateObject();
     }
 
-    AddOrReplace(m_value, key, value.m_value == nullptr ? cJSON_CreateObject() : value.m_value);
-    value.m_value = nullptr;
+    AddOrReplace(m_value, key, value.m_value == nullptr ? cJSON_CreateObject() : value.ReleaseValue());
     return *this;
 }
 
@@ -0,0 +1,260 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/core/utils/json/JsonWriter.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Aws::Utils::Json;
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+JsonWriter::JsonWriter() : m_needsComma(false)
+{
+}
+
+JsonWriter::JsonWriter(size_t initialCapacity) : m_needsComma(false)
+{
+    m_buffer.reserve(initialCapacity);
+}
+
+void JsonWriter::WriteSeparator()
+{
+    if (m_needsComma)
+    {
+        m_buffer.push_back(',');
+    }
+}
+
+JsonWriter& JsonWriter::StartObject()
+{
+    WriteSeparator();
+    m_buffer.push_back('{');
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::EndObject()
+{
+    m_buffer.push_back('}');
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::StartArray()
+{
+    WriteSeparator();
+    m_buffer.push_back('[');
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::EndArray()
+{
+    m_buffer.push_back(']');
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::Key(const char* key)
+{
+    WriteSeparator();
+    WriteQuoted(key, strlen(key));
+    m_buffer.push_back(':');
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::Key(const Aws::String& key)
+{
+    WriteSeparator();
+    WriteQuoted(key.c_str(), key.size());
+    m_buffer.push_back(':');
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::AsString(const Aws::String& value)
+{
+    WriteSeparator();
+    WriteQuoted(value.c_str(), value.size());
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::AsString(const char* value)
+{
+    WriteSeparator();
+    WriteQuoted(value, strlen(value));
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::AsBool(bool value)
+{
+    WriteSeparator();
+    m_buffer.append(value ? "true" : "false");
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::AsInteger(int value)
+{
+    return AsInt64(value);
+}
+
+JsonWriter& JsonWriter::AsInt64(long long value)
+{
+    WriteSeparator();
+
+    //digits are produced backwards into the end of a local buffer, 20 digits and a sign cover every long long.
+    char digits[21];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    unsigned long long magnitude = value < 0 ? 0ull - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+    do
+    {
+        *--start = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+
+    if (value < 0)
+    {
+        *--start = '-';
+    }
+
+    m_buffer.append(start, end);
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::AsDouble(double value)
+{
+    WriteSeparator();
+    m_needsComma = true;
+
+    //NaN and infinity have no JSON representation
+    if (value * 0 != 0)
+    {
+        m_buffer.append("null");
+        return *this;
+    }
+
+    //same approach as cJSON: 15 significant digits unless they don't round trip, 17 always do.
+    char number[32];
+    int length = snprintf(number, sizeof(number), "%1.15g", value);
+    if (strtod(number, nullptr) != value)
+    {
+        length = snprintf(number, sizeof(number), "%1.17g", value);
+    }
+
+    const char decimalPoint = localeconv()->decimal_point[0];
+    for (int i = 0; i < length; ++i)
+    {
+        m_buffer.push_back(number[i] == decimalPoint ? '.' : number[i]);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::AsNull()
+{
+    WriteSeparator();
+    m_buffer.append("null");
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::AsObject(const JsonView& value)
+{
+    WriteSeparator();
+    m_buffer.append(value.WriteCompact());
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::WithObject(const char* key, const JsonView& value)
+{
+    return Key(key).AsObject(value);
+}
+
+JsonWriter& JsonWriter::WithObject(const Aws::String& key, const JsonView& value)
+{
+    return Key(key).AsObject(value);
+}
+
+Aws::String JsonWriter::TakeOwnershipOfString()
+{
+    Aws::String out(std::move(m_buffer));
+    m_buffer.clear();
+    m_needsComma = false;
+    return out;
+}
+
+void JsonWriter::WriteQuoted(const char* value, size_t length)
+{
+    m_buffer.push_back('"');
+
+    //copy runs of characters that don't need escaping in one go.
+    size_t runStart = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        const unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 32 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+
+        m_buffer.append(value + runStart, i - runStart);
+        runStart = i + 1;
+
+        m_buffer.push_back('\\');
+        switch (c)
+        {
+            case '"':
+                m_buffer.push_back('"');
+                break;
+            case '\\':
+                m_buffer.push_back('\\');
+                break;
+            case '\b':
+                m_buffer.push_back('b');
+                break;
+            case '\f':
+                m_buffer.push_back('f');
+                break;
+            case '\n':
+                m_buffer.push_back('n');
+                break;
+            case '\r':
+                m_buffer.push_back('r');
+                break;
+            case '\t':
+                m_buffer.push_back('t');
+                break;
+            default:
+                m_buffer.append("u00");
+                m_buffer.push_back(HEX_DIGITS[c >> 4]);
+                m_buffer.push_back(HEX_DIGITS[c & 0xf]);
+                break;
+        }
+    }
+
+    m_buffer.append(value + runStart, length - runStart);
+    m_buffer.push_back('"');
+}
@@ -16,9 +16,13 @@
 
 #include <aws/core/utils/logging/AWSLogging.h>
 #include <aws/core/utils/logging/LogSystemInterface.h>
+#include <aws/core/utils/logging/LogLevel.h>
 #include <aws/core/utils/memory/stl/AWSStack.h>
 
+#include <atomic>
+#include <cstring>
 #include <memory>
+#include <mutex>
 
 using namespace Aws::Utils;
 using namespace Aws::Utils::Logging;
@@ -26,6 +30,21 @@ using namespace Aws::Utils::Logging;
 static std::shared_ptr<LogSystemInterface> AWSLogSystem(nullptr);
 static std::shared_ptr<LogSystemInterface> OldLogger(nullptr);
 
+static const size_t MAX_TAG_FILTERS = 32;
+static const size_t MAX_TAG_LENGTH = 64;
+
+// Filters are only ever appended, and a filter's tag never changes once it is counted in, so that the log macros can read them without a
+// lock; clearing a filter sets its level back to Trace.
+struct TagFilter
+{
+    char tag[MAX_TAG_LENGTH];
+    std::atomic<int> level;
+};
+
+static TagFilter TagFilters[MAX_TAG_FILTERS];
+static std::atomic<size_t> TagFilterCount(0);
+static std::mutex TagFilterMutex;
+
 namespace Aws
 {
 namespace Utils
@@ -44,6 +63,58 @@ LogSystemInterface *GetLogSystem() {
     return AWSLogSystem.get();
 }
 
+bool SetLogLevelForTag(const char* tag, LogLevel logLevel)
+{
+    if (tag == nullptr || strlen(tag) >= MAX_TAG_LENGTH)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> locker(TagFilterMutex);
+    size_t count = TagFilterCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (strcmp(TagFilters[i].tag, tag) == 0)
+        {
+            TagFilters[i].level.store(static_cast<int>(logLevel), std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    if (count == MAX_TAG_FILTERS)
+    {
+        return false;
+    }
+
+    memcpy(TagFilters[count].tag, tag, strlen(tag) + 1);
+    TagFilters[count].level.store(static_cast<int>(logLevel), std::memory_order_relaxed);
+    TagFilterCount.store(count + 1, std::memory_order_release);
+    return true;
+}
+
+void ClearLogLevelsForTags()
+{
+    std::lock_guard<std::mutex> locker(TagFilterMutex);
+    size_t count = TagFilterCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i)
+    {
+        TagFilters[i].level.store(static_cast<int>(LogLevel::Trace), std::memory_order_relaxed);
+    }
+}
+
+bool IsLogTagEnabled(LogLevel logLevel, const char* tag)
+{
+    size_t count = TagFilterCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (strcmp(TagFilters[i].tag, tag) == 0)
+        {
+            return static_cast<int>(logLevel) <= TagFilters[i].level.load(std::memory_order_relaxed);
+        }
+    }
+    return true;
+}
+
 void PushLogger(const std::shared_ptr<LogSystemInterface> &logSystem)
 {
     OldLogger = AWSLogSystem;
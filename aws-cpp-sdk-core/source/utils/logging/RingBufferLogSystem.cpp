@@ -0,0 +1,460 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/core/utils/logging/RingBufferLogSystem.h>
+
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+#include <algorithm>
+#include <fstream>
+#include <cstdarg>
+#include <cstring>
+#include <stdio.h>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Logging;
+
+static const char* AllocationTag = "RingBufferLogSystem";
+
+// threads are spread over this many ring buffers by the hash of their id
+static const size_t BUFFER_COUNT = 16;
+static const size_t TAG_LENGTH = 48;
+static const size_t MESSAGE_LENGTH = 176;
+static const size_t BATCH_SIZE = 64 * 1024;
+// the background thread writes at least this often even when nobody wakes it up
+static const std::chrono::milliseconds WRITE_INTERVAL(10);
+// a thread whose buffer is full drops its line once it has waited this long for the background thread to make room
+static const std::chrono::milliseconds FULL_BUFFER_WAIT(100);
+
+/**
+ * One log line as it was handed to the logger. Messages that don't fit in the record are copied to the heap instead.
+ */
+struct RingBufferLogSystem::Record
+{
+    Record() : m_sequence(0), m_position(0), m_level(LogLevel::Off), m_longMessage(nullptr), m_length(0) {}
+
+    // position of the record in the ring the next time it is free to claim, plus one once it has been written and can be read
+    std::atomic<size_t> m_sequence;
+    size_t m_position;
+    LogLevel m_level;
+    std::thread::id m_threadId;
+    std::chrono::system_clock::time_point m_timestamp;
+    char* m_longMessage;
+    size_t m_length;
+    char m_tag[TAG_LENGTH];
+    char m_message[MESSAGE_LENGTH];
+};
+
+/**
+ * Bounded multi producer, single consumer ring of records. Producers claim a position with a compare and swap and publish the record
+ * through its sequence, so that neither side ever blocks the other.
+ */
+struct RingBufferLogSystem::RecordBuffer
+{
+    RecordBuffer() : m_records(nullptr), m_mask(0), m_claimPosition(0), m_readPosition(0) {}
+
+    Record* m_records;
+    size_t m_mask;
+    // producers contend on this, so it gets a cache line of its own
+    alignas(64) std::atomic<size_t> m_claimPosition;
+    // only used by the background thread
+    alignas(64) size_t m_readPosition;
+    std::thread::id m_lastThreadId;
+    Aws::String m_lastThreadIdString;
+};
+
+static std::shared_ptr<Aws::OFStream> MakeLogFile(const Aws::String& filenamePrefix)
+{
+    Aws::String newFileName = filenamePrefix + DateTime::CalculateGmtTimestampAsString("%Y-%m-%d-%H") + ".log";
+    return Aws::MakeShared<Aws::OFStream>(AllocationTag, newFileName.c_str(), Aws::OFStream::out | Aws::OFStream::app);
+}
+
+static const char* GetLevelPrefix(LogLevel logLevel)
+{
+    switch(logLevel)
+    {
+        case LogLevel::Fatal:
+            return "[FATAL] ";
+        case LogLevel::Error:
+            return "[ERROR] ";
+        case LogLevel::Warn:
+            return "[WARN] ";
+        case LogLevel::Info:
+            return "[INFO] ";
+        case LogLevel::Debug:
+            return "[DEBUG] ";
+        case LogLevel::Trace:
+            return "[TRACE] ";
+        default:
+            return "[UNKNOWN] ";
+    }
+}
+
+RingBufferLogSystem::RingBufferLogSystem(LogLevel logLevel, const std::shared_ptr<Aws::OStream>& logFile, size_t recordsPerBuffer) :
+    m_logLevel(logLevel),
+    m_buffers(nullptr),
+    m_flushesRequested(0),
+    m_flushesCompleted(0),
+    m_stopLogging(false),
+    m_droppedLines(0),
+    m_reportedDroppedLines(0),
+    m_cachedSecond(-1),
+    m_loggingThread()
+{
+    Init(recordsPerBuffer);
+    m_loggingThread = std::thread(&RingBufferLogSystem::WriteRecords, this, logFile, "", false);
+}
+
+RingBufferLogSystem::RingBufferLogSystem(LogLevel logLevel, const Aws::String& filenamePrefix, size_t recordsPerBuffer) :
+    m_logLevel(logLevel),
+    m_buffers(nullptr),
+    m_flushesRequested(0),
+    m_flushesCompleted(0),
+    m_stopLogging(false),
+    m_droppedLines(0),
+    m_reportedDroppedLines(0),
+    m_cachedSecond(-1),
+    m_loggingThread()
+{
+    Init(recordsPerBuffer);
+    m_loggingThread = std::thread(&RingBufferLogSystem::WriteRecords, this, MakeLogFile(filenamePrefix), filenamePrefix, true);
+}
+
+RingBufferLogSystem::~RingBufferLogSystem()
+{
+    {
+        std::lock_guard<std::mutex> locker(m_signalMutex);
+        m_stopLogging = true;
+    }
+    m_writeSignal.notify_one();
+    m_loggingThread.join();
+
+    for (size_t i = 0; i < BUFFER_COUNT; ++i)
+    {
+        Aws::DeleteArray(m_buffers[i].m_records);
+    }
+    Aws::DeleteArray(m_buffers);
+}
+
+void RingBufferLogSystem::Init(size_t recordsPerBuffer)
+{
+    size_t capacity = 2;
+    while (capacity < recordsPerBuffer)
+    {
+        capacity <<= 1;
+    }
+
+    m_batch.reserve(BATCH_SIZE);
+    m_buffers = Aws::NewArray<RecordBuffer>(BUFFER_COUNT, AllocationTag);
+    for (size_t i = 0; i < BUFFER_COUNT; ++i)
+    {
+        m_buffers[i].m_records = Aws::NewArray<Record>(capacity, AllocationTag);
+        m_buffers[i].m_mask = capacity - 1;
+        for (size_t j = 0; j < capacity; ++j)
+        {
+            m_buffers[i].m_records[j].m_sequence.store(j, std::memory_order_relaxed);
+        }
+    }
+}
+
+RingBufferLogSystem::Record* RingBufferLogSystem::ClaimRecord(LogLevel logLevel, const char* tag)
+{
+    auto threadId = std::this_thread::get_id();
+    auto& buffer = m_buffers[std::hash<std::thread::id>()(threadId) % BUFFER_COUNT];
+
+    Record* record = nullptr;
+    std::chrono::steady_clock::time_point giveUpTime;
+    size_t position = buffer.m_claimPosition.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        record = &buffer.m_records[position & buffer.m_mask];
+        size_t sequence = record->m_sequence.load(std::memory_order_acquire);
+        auto lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (lag == 0)
+        {
+            if (buffer.m_claimPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (lag < 0)
+        {
+            // the buffer is full, wait for the background thread to catch up, but not for ever
+            auto now = std::chrono::steady_clock::now();
+            if (giveUpTime == std::chrono::steady_clock::time_point())
+            {
+                giveUpTime = now + FULL_BUFFER_WAIT;
+            }
+            else if (now >= giveUpTime)
+            {
+                m_droppedLines.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            m_writeSignal.notify_one();
+            std::this_thread::yield();
+            position = buffer.m_claimPosition.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            position = buffer.m_claimPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->m_position = position;
+    record->m_level = logLevel;
+    record->m_threadId = threadId;
+    record->m_timestamp = std::chrono::system_clock::now();
+    record->m_longMessage = nullptr;
+    record->m_length = 0;
+#ifdef WIN32
+    strncpy_s(record->m_tag, TAG_LENGTH, tag, _TRUNCATE);
+#else
+    strncpy(record->m_tag, tag, TAG_LENGTH - 1);
+    record->m_tag[TAG_LENGTH - 1] = '\0';
+#endif
+    return record;
+}
+
+void RingBufferLogSystem::PublishRecord(Record* record)
+{
+    size_t position = record->m_position;
+    record->m_sequence.store(position + 1, std::memory_order_release);
+
+    // wake the background thread up every quarter of a buffer rather than wait for it to poll
+    if (((position + 1) & ((m_buffers[0].m_mask >> 2) | 1)) == 0)
+    {
+        m_writeSignal.notify_one();
+    }
+}
+
+void RingBufferLogSystem::Log(LogLevel logLevel, const char* tag, const char* formatStr, ...)
+{
+    Record* record = ClaimRecord(logLevel, tag);
+    if (!record)
+    {
+        return;
+    }
+
+    std::va_list args;
+    va_start(args, formatStr);
+
+    va_list tmp_args; //unfortunately you cannot consume a va_list twice
+    va_copy(tmp_args, args); //so we have to copy it
+#ifdef WIN32
+    const int requiredLength = _vscprintf(formatStr, tmp_args);
+#else
+    const int requiredLength = vsnprintf(nullptr, 0, formatStr, tmp_args);
+#endif
+    va_end(tmp_args);
+
+    if (requiredLength > 0)
+    {
+        record->m_length = static_cast<size_t>(requiredLength);
+        char* output = record->m_message;
+        if (record->m_length >= MESSAGE_LENGTH)
+        {
+            record->m_longMessage = static_cast<char*>(Aws::Malloc(AllocationTag, record->m_length + 1));
+            output = record->m_longMessage;
+        }
+#ifdef WIN32
+        vsnprintf_s(output, record->m_length + 1, _TRUNCATE, formatStr, args);
+#else
+        vsnprintf(output, record->m_length + 1, formatStr, args);
+#endif // WIN32
+    }
+    va_end(args);
+
+    PublishRecord(record);
+}
+
+void RingBufferLogSystem::LogStream(LogLevel logLevel, const char* tag, const Aws::OStringStream &messageStream)
+{
+    Record* record = ClaimRecord(logLevel, tag);
+    if (!record)
+    {
+        return;
+    }
+
+    auto message = messageStream.str();
+    record->m_length = message.size();
+    char* output = record->m_message;
+    if (record->m_length > MESSAGE_LENGTH)
+    {
+        record->m_longMessage = static_cast<char*>(Aws::Malloc(AllocationTag, record->m_length));
+        output = record->m_longMessage;
+    }
+    memcpy(output, message.data(), record->m_length);
+
+    PublishRecord(record);
+}
+
+void RingBufferLogSystem::Flush()
+{
+    std::unique_lock<std::mutex> locker(m_signalMutex);
+    uint64_t flush = ++m_flushesRequested;
+    m_writeSignal.notify_one();
+    m_flushSignal.wait(locker, [&](){ return m_stopLogging || m_flushesCompleted >= flush; });
+}
+
+void RingBufferLogSystem::WriteRecords(const std::shared_ptr<Aws::OStream>& logFile, const Aws::String& filenamePrefix, bool rollLog)
+{
+    // localtime requires access to env. variables to get Timezone, which is not thread-safe
+    int32_t lastRolledHour = DateTime::Now().GetHour(false /*localtime*/);
+    std::shared_ptr<Aws::OStream> log = logFile;
+
+    for(;;)
+    {
+        uint64_t flushes = 0;
+        bool stop = false;
+        bool flushing = false;
+        {
+            std::unique_lock<std::mutex> locker(m_signalMutex);
+            if (!m_stopLogging && m_flushesRequested == m_flushesCompleted)
+            {
+                m_writeSignal.wait_for(locker, WRITE_INTERVAL);
+            }
+            flushes = m_flushesRequested;
+            stop = m_stopLogging;
+            flushing = stop || flushes != m_flushesCompleted;
+        }
+
+        // everything claimed by now was logged before the flush was requested, and has to be written before the flush completes
+        size_t flushUpTo[BUFFER_COUNT] = {};
+        if (flushing)
+        {
+            for (size_t i = 0; i < BUFFER_COUNT; ++i)
+            {
+                flushUpTo[i] = m_buffers[i].m_claimPosition.load(std::memory_order_acquire);
+            }
+        }
+
+        if (rollLog)
+        {
+            int32_t currentHour = DateTime::Now().GetHour(false /*localtime*/);
+            if (currentHour != lastRolledHour)
+            {
+                log->flush();
+                log = MakeLogFile(filenamePrefix);
+                lastRolledHour = currentHour;
+            }
+        }
+
+        bool wroteRecords = false;
+        for (size_t i = 0; i < BUFFER_COUNT; ++i)
+        {
+            auto& buffer = m_buffers[i];
+            for (;;)
+            {
+                auto& record = buffer.m_records[buffer.m_readPosition & buffer.m_mask];
+                if (record.m_sequence.load(std::memory_order_acquire) != buffer.m_readPosition + 1)
+                {
+                    if (!flushing || buffer.m_readPosition >= flushUpTo[i])
+                    {
+                        break;
+                    }
+                    // claimed but not published yet, the thread that claimed it is still copying its message in
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                FormatRecord(i, record);
+                if (record.m_longMessage)
+                {
+                    Aws::Free(record.m_longMessage);
+                    record.m_longMessage = nullptr;
+                }
+                record.m_sequence.store(buffer.m_readPosition + buffer.m_mask + 1, std::memory_order_release);
+                buffer.m_readPosition++;
+
+                if (m_batch.size() >= BATCH_SIZE)
+                {
+                    log->write(m_batch.data(), m_batch.size());
+                    m_batch.clear();
+                }
+                wroteRecords = true;
+            }
+        }
+
+        size_t droppedLines = m_droppedLines.load(std::memory_order_relaxed);
+        if (droppedLines != m_reportedDroppedLines)
+        {
+            Record record;
+            record.m_level = LogLevel::Warn;
+            record.m_threadId = std::this_thread::get_id();
+            record.m_timestamp = std::chrono::system_clock::now();
+            memcpy(record.m_tag, AllocationTag, strlen(AllocationTag) + 1);
+            int length = snprintf(record.m_message, MESSAGE_LENGTH, "Dropped %llu log lines because the ring buffer was full.",
+                                  static_cast<unsigned long long>(droppedLines - m_reportedDroppedLines));
+            record.m_length = static_cast<size_t>((std::max)(length, 0));
+            FormatRecord(0, record);
+            m_reportedDroppedLines = droppedLines;
+            wroteRecords = true;
+        }
+
+        if (wroteRecords)
+        {
+            log->write(m_batch.data(), m_batch.size());
+            m_batch.clear();
+            log->flush();
+        }
+
+        {
+            std::lock_guard<std::mutex> locker(m_signalMutex);
+            m_flushesCompleted = flushes;
+        }
+        m_flushSignal.notify_all();
+
+        if (stop)
+        {
+            break;
+        }
+    }
+}
+
+void RingBufferLogSystem::FormatRecord(size_t bufferIndex, const Record& record)
+{
+    // the date and time only change once a second, so they are formatted once a second
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(record.m_timestamp.time_since_epoch()).count();
+    auto second = millis / 1000;
+    if (second != m_cachedSecond)
+    {
+        m_cachedTimestamp = DateTime(record.m_timestamp).ToGmtString("%Y-%m-%d %H:%M:%S");
+        m_cachedSecond = second;
+    }
+
+    auto& buffer = m_buffers[bufferIndex];
+    if (buffer.m_lastThreadIdString.empty() || buffer.m_lastThreadId != record.m_threadId)
+    {
+        Aws::StringStream ss;
+        ss << record.m_threadId;
+        buffer.m_lastThreadIdString = ss.str();
+        buffer.m_lastThreadId = record.m_threadId;
+    }
+
+    auto ms = static_cast<int>(millis - second * 1000);
+    char fraction[5] = { '.', char('0' + ms / 100), char('0' + ms / 10 % 10), char('0' + ms % 10), ' ' };
+
+    m_batch.append(GetLevelPrefix(record.m_level));
+    m_batch.append(m_cachedTimestamp);
+    m_batch.append(fraction, sizeof(fraction));
+    m_batch.append(record.m_tag);
+    m_batch.append(" [");
+    m_batch.append(buffer.m_lastThreadIdString);
+    m_batch.append("] ");
+    m_batch.append(record.m_longMessage ? record.m_longMessage : record.m_message, record.m_length);
+    m_batch.push_back('\n');
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/core/utils/memory/MonotonicArena.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/UnreferencedParam.h>
+
+#include <cassert>
+#include <cstdint>
+
+using namespace Aws::Utils::Memory;
+
+static const std::size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+//keeps the first allocation in every block aligned for any type.
+static const std::size_t BLOCK_HEADER_SIZE = (sizeof(void*) + sizeof(std::size_t) + DEFAULT_ALIGNMENT - 1) & ~(DEFAULT_ALIGNMENT - 1);
+
+MonotonicArena::MonotonicArena(std::size_t initialBlockSize, const char* allocationTag) :
+    m_allocationTag(allocationTag),
+    m_currentBlock(nullptr),
+    m_cursor(nullptr),
+    m_end(nullptr),
+    m_nextBlockSize(initialBlockSize ? initialBlockSize : 1),
+    m_reservedBytes(0)
+{
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    FreeBlocks(m_currentBlock);
+}
+
+void* MonotonicArena::AllocateMemory(std::size_t blockSize, std::size_t alignment, const char* allocationTag)
+{
+    AWS_UNREFERENCED_PARAM(allocationTag);
+    assert((alignment & (alignment - 1)) == 0);
+    if (alignment <= 1)
+    {
+        alignment = DEFAULT_ALIGNMENT;
+    }
+
+    std::uintptr_t cursor = reinterpret_cast<std::uintptr_t>(m_cursor);
+    std::uintptr_t aligned = (cursor + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(m_end);
+    if (!m_currentBlock || aligned > end || blockSize > end - aligned)
+    {
+        //blocks start out aligned for any type, so only a larger alignment needs extra room.
+        AddBlock(blockSize + (alignment > DEFAULT_ALIGNMENT ? alignment : 0));
+        cursor = reinterpret_cast<std::uintptr_t>(m_cursor);
+        aligned = (cursor + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    }
+
+    m_cursor = reinterpret_cast<char*>(aligned + blockSize);
+    return reinterpret_cast<void*>(aligned);
+}
+
+void MonotonicArena::FreeMemory(void* memoryPtr)
+{
+    AWS_UNREFERENCED_PARAM(memoryPtr);
+}
+
+void MonotonicArena::Reset()
+{
+    if (!m_currentBlock)
+    {
+        return;
+    }
+
+    //blocks grow, so the current one is the largest.
+    FreeBlocks(m_currentBlock->previous);
+    m_currentBlock->previous = nullptr;
+    m_reservedBytes = m_currentBlock->size;
+    m_cursor = reinterpret_cast<char*>(m_currentBlock) + BLOCK_HEADER_SIZE;
+}
+
+void MonotonicArena::AddBlock(std::size_t minimumSize)
+{
+    std::size_t size = m_nextBlockSize;
+    if (size < minimumSize)
+    {
+        size = minimumSize;
+    }
+
+    char* memory = static_cast<char*>(Aws::Malloc(m_allocationTag, BLOCK_HEADER_SIZE + size));
+    Block* block = reinterpret_cast<Block*>(memory);
+    block->previous = m_currentBlock;
+    block->size = size;
+
+    m_currentBlock = block;
+    m_cursor = memory + BLOCK_HEADER_SIZE;
+    m_end = m_cursor + size;
+    m_reservedBytes += size;
+    m_nextBlockSize = size * 2;
+}
+
+void MonotonicArena::FreeBlocks(Block* last)
+{
+    while (last)
+    {
+        Block* previous = last->previous;
+        Aws::Free(last);
+        last = previous;
+    }
+}
@@ -0,0 +1,170 @@
+
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/stream/FileRangeStreamBuf.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/StringUtils.h>
+#include <algorithm>
+#include <cstring>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Stream
+        {
+            static const char FILE_RANGE_STREAM_BUF_TAG[] = "FileRangeStreamBuf";
+
+            FileRangeStreamBuf::FileRangeStreamBuf(const Aws::String& path, uint64_t offset, uint64_t length) :
+                m_path(path), m_offset(offset), m_length(length), m_position(0), m_seekPending(false), m_openFailed(false)
+            {
+                setg(m_getArea, m_getArea, m_getArea);
+            }
+
+            FileRangeStreamBuf::pos_type FileRangeStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+            {
+                off_type base = 0;
+                if (dir == std::ios_base::cur)
+                {
+                    base = static_cast<off_type>(m_position) - (egptr() - gptr());
+                }
+                else if (dir == std::ios_base::end)
+                {
+                    base = static_cast<off_type>(m_length);
+                }
+
+                return seekpos(base + off, which);
+            }
+
+            FileRangeStreamBuf::pos_type FileRangeStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+            {
+                off_type target = static_cast<off_type>(pos);
+                if (!(which & std::ios_base::in) || target < 0 || static_cast<uint64_t>(target) > m_length)
+                {
+                    return pos_type(off_type(-1));
+                }
+
+                // moving within what is already in the get area doesn't need to touch the file, which keeps tellg cheap.
+                off_type areaBegin = static_cast<off_type>(m_position) - (egptr() - eback());
+                if (target >= areaBegin && target <= static_cast<off_type>(m_position))
+                {
+                    setg(eback(), eback() + (target - areaBegin), egptr());
+                    return pos;
+                }
+
+                setg(m_getArea, m_getArea, m_getArea);
+                m_position = static_cast<uint64_t>(target);
+                m_seekPending = true;
+                return pos;
+            }
+
+            FileRangeStreamBuf::int_type FileRangeStreamBuf::underflow()
+            {
+                if (gptr() < egptr())
+                {
+                    return traits_type::to_int_type(*gptr());
+                }
+
+                std::streamsize read = ReadFile(m_getArea, static_cast<std::streamsize>(GET_AREA_SIZE));
+                if (read <= 0)
+                {
+                    return traits_type::eof();
+                }
+
+                setg(m_getArea, m_getArea, m_getArea + read);
+                return traits_type::to_int_type(*gptr());
+            }
+
+            std::streamsize FileRangeStreamBuf::xsgetn(char* s, std::streamsize n)
+            {
+                std::streamsize copied = (std::min)(static_cast<std::streamsize>(egptr() - gptr()), n);
+                if (copied > 0)
+                {
+                    std::memcpy(s, gptr(), static_cast<size_t>(copied));
+                    gbump(static_cast<int>(copied));
+                }
+
+                if (copied < n)
+                {
+                    // the rest bypasses the get area, which then no longer ends at m_position and mustn't be seeked back into.
+                    setg(m_getArea, m_getArea, m_getArea);
+                }
+
+                while (copied < n)
+                {
+                    std::streamsize read = ReadFile(s + copied, n - copied);
+                    if (read <= 0)
+                    {
+                        break;
+                    }
+                    copied += read;
+                }
+
+                return copied;
+            }
+
+            std::streamsize FileRangeStreamBuf::showmanyc()
+            {
+                return m_openFailed ? -1 : static_cast<std::streamsize>(m_length - m_position);
+            }
+
+            std::streamsize FileRangeStreamBuf::ReadFile(char* s, std::streamsize n)
+            {
+                if (n <= 0 || m_position >= m_length || m_openFailed)
+                {
+                    return 0;
+                }
+
+                if (!m_file.is_open())
+                {
+                    // unbuffered, reads land directly in the get area or the caller's memory.
+                    m_file.pubsetbuf(nullptr, 0);
+#ifdef _MSC_VER
+                    bool opened = m_file.open(StringUtils::ToWString(m_path.c_str()).c_str(), std::ios_base::in | std::ios_base::binary) != nullptr;
+#else
+                    bool opened = m_file.open(m_path.c_str(), std::ios_base::in | std::ios_base::binary) != nullptr;
+#endif
+                    if (!opened)
+                    {
+                        AWS_LOGSTREAM_ERROR(FILE_RANGE_STREAM_BUF_TAG, "Could not open " << m_path << " for reading.");
+                        m_openFailed = true;
+                        return 0;
+                    }
+                    m_seekPending = true;
+                }
+
+                if (m_seekPending)
+                {
+                    auto filePosition = static_cast<off_type>(m_offset + m_position);
+                    if (m_file.pubseekpos(filePosition, std::ios_base::in) != pos_type(filePosition))
+                    {
+                        AWS_LOGSTREAM_ERROR(FILE_RANGE_STREAM_BUF_TAG, "Could not seek to " << filePosition << " in " << m_path);
+                        return 0;
+                    }
+                    m_seekPending = false;
+                }
+
+                auto toRead = static_cast<std::streamsize>((std::min)(static_cast<uint64_t>(n), m_length - m_position));
+                std::streamsize read = m_file.sgetn(s, toRead);
+                if (read > 0)
+                {
+                    m_position += static_cast<uint64_t>(read);
+                }
+                return read;
+            }
+        }
+    }
+}
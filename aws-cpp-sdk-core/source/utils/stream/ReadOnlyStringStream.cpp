@@ -0,0 +1,75 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/core/utils/stream/ReadOnlyStringStream.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+
+static const char READ_ONLY_STRING_STREAM_TAG[] = "ReadOnlyStringStream";
+
+namespace Aws
+{
+namespace Utils
+{
+namespace Stream
+{
+    ReadOnlyStringBuf::ReadOnlyStringBuf(const std::shared_ptr<const Aws::String>& value) :
+        m_value(value)
+    {
+        //the get area never writes through these pointers, there is no put area and pbackfail is not overridden.
+        char* begin = const_cast<char*>(m_value->data());
+        setg(begin, begin, begin + m_value->size());
+    }
+
+    std::streampos ReadOnlyStringBuf::seekoff(std::streamoff off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+    {
+        if (dir == std::ios_base::beg)
+        {
+            return seekpos(off, which);
+        }
+        else if (dir == std::ios_base::end)
+        {
+            return seekpos(static_cast<std::streamoff>(m_value->size()) + off, which);
+        }
+        else if (dir == std::ios_base::cur)
+        {
+            return seekpos((gptr() - eback()) + off, which);
+        }
+
+        return std::streamoff(-1);
+    }
+
+    std::streampos ReadOnlyStringBuf::seekpos(std::streampos pos, std::ios_base::openmode which)
+    {
+        if ((which & std::ios_base::out) || pos < 0 || static_cast<size_t>(pos) > m_value->size())
+        {
+            return std::streamoff(-1);
+        }
+
+        setg(eback(), eback() + static_cast<size_t>(pos), egptr());
+        return pos;
+    }
+
+    ReadOnlyStringStream::ReadOnlyStringStream(const std::shared_ptr<const Aws::String>& value) :
+        Aws::IOStream(&m_buf), m_buf(value)
+    {
+    }
+
+    ReadOnlyStringStream::ReadOnlyStringStream(Aws::String&& value) :
+        ReadOnlyStringStream(Aws::MakeShared<Aws::String>(READ_ONLY_STRING_STREAM_TAG, std::move(value)))
+    {
+    }
+}
+}
+}
@@ -16,9 +16,15 @@
 #include <aws/core/utils/threading/Executor.h>
 #include <aws/core/utils/threading/ThreadTask.h>
 #include <thread>
+#include <algorithm>
+#include <cstddef>
 #include <cassert>
 
 static const char* POOLED_CLASS_TAG = "PooledThreadExecutor";
+static const char* WORK_STEALING_CLASS_TAG = "WorkStealingExecutor";
+static const char* FAIR_QUEUEING_CLASS_TAG = "FairQueueingExecutor";
+// slots in each worker's queue, a power of two.
+static const size_t TASKS_PER_QUEUE = 1024;
 
 using namespace Aws::Utils::Threading;
 
@@ -163,3 +169,423 @@ bool PooledThreadExecutor::HasTasks()
     std::lock_guard<std::mutex> locker(m_queueLock);
     return m_tasks.size() > 0;
 }
+
+/**
+ * Bounded queue any thread may push to and pop from without locking. Each slot's sequence number says whether it is free for the push at
+ * that position or holds the task for the pop at that position, so a push or pop only has to win the compare-exchange on its end's position.
+ */
+class WorkStealingExecutor::TaskQueue
+{
+public:
+    TaskQueue() : m_slots(TASKS_PER_QUEUE), m_pushPosition(0), m_popPosition(0)
+    {
+        for (size_t index = 0; index < TASKS_PER_QUEUE; ++index)
+        {
+            m_slots[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Moves from task only if there was room for it.
+     */
+    bool Push(std::function<void()>& task)
+    {
+        size_t position = m_pushPosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot& slot = m_slots[position & (TASKS_PER_QUEUE - 1)];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0)
+            {
+                if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.task = std::move(task);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool Pop(std::function<void()>& task)
+    {
+        size_t position = m_popPosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot& slot = m_slots[position & (TASKS_PER_QUEUE - 1)];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (difference == 0)
+            {
+                if (m_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    task = std::move(slot.task);
+                    slot.task = nullptr;
+                    slot.sequence.store(position + TASKS_PER_QUEUE, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_popPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        std::function<void()> task;
+    };
+
+    Aws::Vector<Slot> m_slots;
+    // the two ends are written by different threads, keep them off each other's cache line.
+    alignas(64) std::atomic<size_t> m_pushPosition;
+    alignas(64) std::atomic<size_t> m_popPosition;
+};
+
+WorkStealingExecutor::WorkStealingExecutor(size_t poolSize, OverflowPolicy overflowPolicy) :
+    m_nextQueue(0), m_pendingTasks(0), m_sleepingWorkers(0), m_overflowSize(0), m_stopping(false),
+    m_poolSize((std::max)(poolSize, static_cast<size_t>(1))), m_overflowPolicy(overflowPolicy)
+{
+    for (size_t index = 0; index < m_poolSize; ++index)
+    {
+        m_queues.push_back(Aws::New<TaskQueue>(WORK_STEALING_CLASS_TAG));
+    }
+    for (size_t index = 0; index < m_poolSize; ++index)
+    {
+        m_workers.emplace_back([this, index] { Work(index); });
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    {
+        std::lock_guard<std::mutex> locker(m_sleepLock);
+        m_stopping = true;
+    }
+    m_wakeUp.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+
+    for (auto queue : m_queues)
+    {
+        Aws::Delete(queue);
+    }
+}
+
+bool WorkStealingExecutor::SubmitToThread(std::function<void()>&& fn)
+{
+    if (m_overflowPolicy == OverflowPolicy::REJECT_IMMEDIATELY && m_pendingTasks.load() >= m_poolSize)
+    {
+        return false;
+    }
+
+    ++m_pendingTasks;
+    size_t first = m_nextQueue.fetch_add(1, std::memory_order_relaxed);
+    bool queued = false;
+    for (size_t offset = 0; offset < m_poolSize && !queued; ++offset)
+    {
+        queued = m_queues[(first + offset) % m_poolSize]->Push(fn);
+    }
+
+    if (!queued)
+    {
+        std::lock_guard<std::mutex> locker(m_overflowLock);
+        m_overflowTasks.push(std::move(fn));
+        ++m_overflowSize;
+    }
+
+    // a worker going to sleep counts itself before it checks m_pendingTasks, so one of the two always sees the other.
+    if (m_sleepingWorkers.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_sleepLock);
+        }
+        m_wakeUp.notify_one();
+    }
+
+    return true;
+}
+
+bool WorkStealingExecutor::TakeTask(size_t workerIndex, std::function<void()>& task)
+{
+    // own queue first, then the others' in order.
+    for (size_t offset = 0; offset < m_poolSize; ++offset)
+    {
+        if (m_queues[(workerIndex + offset) % m_poolSize]->Pop(task))
+        {
+            return true;
+        }
+    }
+
+    if (m_overflowSize.load() > 0)
+    {
+        std::lock_guard<std::mutex> locker(m_overflowLock);
+        if (!m_overflowTasks.empty())
+        {
+            task = std::move(m_overflowTasks.front());
+            m_overflowTasks.pop();
+            --m_overflowSize;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingExecutor::Work(size_t workerIndex)
+{
+    std::function<void()> task;
+    while (!m_stopping.load())
+    {
+        if (TakeTask(workerIndex, task))
+        {
+            --m_pendingTasks;
+            task();
+            // don't hold on to what the task captured while waiting for the next one.
+            task = nullptr;
+            continue;
+        }
+
+        if (m_pendingTasks.load() > 0)
+        {
+            // a submitter has counted a task it hasn't finished queueing, let it run rather than spinning.
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> locker(m_sleepLock);
+        ++m_sleepingWorkers;
+        m_wakeUp.wait(locker, [this] { return m_stopping.load() || m_pendingTasks.load() > 0; });
+        --m_sleepingWorkers;
+    }
+}
+
+/**
+ * The queues and the lock shared by a FairQueueingExecutor's workers and the Executors returned by CreateQueue, which may outlive it.
+ * Each queue keeps a virtual time that advances by 1/weight per task it runs; among the non-empty queues of the highest priority, the
+ * one furthest behind runs next. A queue that was idle catches up to the virtual time of the last task started from its priority so it
+ * can't save up a burst of turns while it had nothing to run. Virtual times of different priorities are unrelated, as a lower priority
+ * only runs while the higher ones have nothing queued.
+ */
+class FairQueueingExecutor::Scheduler
+{
+public:
+    struct TaskQueue
+    {
+        TaskQueue(TaskPriority queuePriority, size_t queueWeight) :
+            priority(queuePriority), weight(static_cast<double>((std::max)(queueWeight, static_cast<size_t>(1)))), virtualTime(0), closed(false)
+        {}
+
+        TaskPriority priority;
+        double weight;
+        double virtualTime;
+        // set once nothing can submit to the queue any more, it is removed after its last task is taken.
+        bool closed;
+        Aws::Queue<std::function<void()>> tasks;
+    };
+
+    Scheduler() : m_stopping(false)
+    {
+        for (auto& virtualTime : m_virtualTime)
+        {
+            virtualTime = 0;
+        }
+    }
+
+    std::shared_ptr<TaskQueue> AddQueue(TaskPriority priority, size_t weight)
+    {
+        auto queue = Aws::MakeShared<TaskQueue>(FAIR_QUEUEING_CLASS_TAG, priority, weight);
+        std::lock_guard<std::mutex> locker(m_lock);
+        m_queues.push_back(queue);
+        return queue;
+    }
+
+    void CloseQueue(const std::shared_ptr<TaskQueue>& queue)
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        queue->closed = true;
+        if (queue->tasks.empty())
+        {
+            RemoveQueue(queue.get());
+        }
+    }
+
+    bool Push(TaskQueue& queue, std::function<void()>&& fn)
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            if (m_stopping)
+            {
+                return false;
+            }
+
+            if (queue.tasks.empty())
+            {
+                queue.virtualTime = (std::max)(queue.virtualTime, m_virtualTime[static_cast<size_t>(queue.priority)]);
+            }
+            queue.tasks.push(std::move(fn));
+        }
+        m_taskAvailable.notify_one();
+        return true;
+    }
+
+    /**
+     * Waits for the next task to run. Returns false once the scheduler is stopped.
+     */
+    bool Pop(std::function<void()>& task)
+    {
+        std::unique_lock<std::mutex> locker(m_lock);
+        for (;;)
+        {
+            if (m_stopping)
+            {
+                return false;
+            }
+
+            TaskQueue* next = nullptr;
+            for (auto& queue : m_queues)
+            {
+                if (queue->tasks.empty())
+                {
+                    continue;
+                }
+
+                if (!next || queue->priority > next->priority ||
+                    (queue->priority == next->priority && queue->virtualTime < next->virtualTime))
+                {
+                    next = queue.get();
+                }
+            }
+
+            if (next)
+            {
+                task = std::move(next->tasks.front());
+                next->tasks.pop();
+                m_virtualTime[static_cast<size_t>(next->priority)] = next->virtualTime;
+                next->virtualTime += 1.0 / next->weight;
+                if (next->closed && next->tasks.empty())
+                {
+                    RemoveQueue(next);
+                }
+                return true;
+            }
+
+            m_taskAvailable.wait(locker);
+        }
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            m_stopping = true;
+            for (auto& queue : m_queues)
+            {
+                Aws::Queue<std::function<void()>>().swap(queue->tasks);
+            }
+            m_queues.clear();
+        }
+        m_taskAvailable.notify_all();
+    }
+
+private:
+    void RemoveQueue(const TaskQueue* queue)
+    {
+        for (auto iter = m_queues.begin(); iter != m_queues.end(); ++iter)
+        {
+            if (iter->get() == queue)
+            {
+                m_queues.erase(iter);
+                return;
+            }
+        }
+    }
+
+    std::mutex m_lock;
+    std::condition_variable m_taskAvailable;
+    Aws::Vector<std::shared_ptr<TaskQueue>> m_queues;
+    // virtual time of the last task started, per priority
+    double m_virtualTime[static_cast<size_t>(TaskPriority::HIGH) + 1];
+    bool m_stopping;
+};
+
+class FairQueueingExecutor::QueueExecutor : public Executor
+{
+public:
+    QueueExecutor(const std::shared_ptr<Scheduler>& scheduler, TaskPriority priority, size_t weight) :
+        m_scheduler(scheduler), m_queue(scheduler->AddQueue(priority, weight))
+    {}
+
+    ~QueueExecutor()
+    {
+        m_scheduler->CloseQueue(m_queue);
+    }
+
+protected:
+    bool SubmitToThread(std::function<void()>&& fn) override
+    {
+        return m_scheduler->Push(*m_queue, std::move(fn));
+    }
+
+private:
+    std::shared_ptr<Scheduler> m_scheduler;
+    std::shared_ptr<Scheduler::TaskQueue> m_queue;
+
+    friend class FairQueueingExecutor;
+};
+
+FairQueueingExecutor::FairQueueingExecutor(size_t poolSize) :
+    m_scheduler(Aws::MakeShared<Scheduler>(FAIR_QUEUEING_CLASS_TAG))
+{
+    m_defaultQueue = Aws::MakeShared<QueueExecutor>(FAIR_QUEUEING_CLASS_TAG, m_scheduler, TaskPriority::NORMAL, 1);
+    auto scheduler = m_scheduler;
+    for (size_t index = 0; index < (std::max)(poolSize, static_cast<size_t>(1)); ++index)
+    {
+        m_workers.emplace_back([scheduler] {
+            std::function<void()> task;
+            while (scheduler->Pop(task))
+            {
+                task();
+                task = nullptr;
+            }
+        });
+    }
+}
+
+FairQueueingExecutor::~FairQueueingExecutor()
+{
+    m_scheduler->Stop();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+std::shared_ptr<Executor> FairQueueingExecutor::CreateQueue(TaskPriority priority, size_t weight)
+{
+    return Aws::MakeShared<QueueExecutor>(FAIR_QUEUEING_CLASS_TAG, m_scheduler, priority, weight);
+}
+
+bool FairQueueingExecutor::SubmitToThread(std::function<void()>&& fn)
+{
+    return m_defaultQueue->SubmitToThread(std::move(fn));
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/core/utils/threading/TimerQueue.h>
+#include <algorithm>
+
+using namespace Aws::Utils::Threading;
+
+TimerQueue::TimerQueue() : m_nextSequence(0), m_stopped(false)
+{
+}
+
+TimerQueue::~TimerQueue()
+{
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        m_stopped = true;
+        m_signal.notify_all();
+    }
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void TimerQueue::Schedule(std::chrono::milliseconds delay, const std::function<void()>& task)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    if (m_stopped)
+    {
+        return;
+    }
+
+    ScheduledTask scheduledTask;
+    scheduledTask.deadline = std::chrono::steady_clock::now() + delay;
+    scheduledTask.sequence = m_nextSequence++;
+    scheduledTask.task = task;
+    m_tasks.push_back(std::move(scheduledTask));
+    std::push_heap(m_tasks.begin(), m_tasks.end(), LaterDeadline());
+
+    if (!m_thread.joinable())
+    {
+        m_thread = std::thread(&TimerQueue::Run, this);
+    }
+    //only the earliest deadline can shorten the wait the timer thread is currently in.
+    else if (m_tasks.front().sequence == m_nextSequence - 1)
+    {
+        m_signal.notify_one();
+    }
+}
+
+size_t TimerQueue::GetPendingTaskCount() const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    return m_tasks.size();
+}
+
+void TimerQueue::Run()
+{
+    std::unique_lock<std::mutex> locker(m_mutex);
+    while (!m_stopped)
+    {
+        if (m_tasks.empty())
+        {
+            m_signal.wait(locker);
+            continue;
+        }
+
+        auto deadline = m_tasks.front().deadline;
+        if (std::chrono::steady_clock::now() < deadline)
+        {
+            m_signal.wait_until(locker, deadline);
+            continue;
+        }
+
+        std::pop_heap(m_tasks.begin(), m_tasks.end(), LaterDeadline());
+        std::function<void()> task = std::move(m_tasks.back().task);
+        m_tasks.pop_back();
+
+        locker.unlock();
+        task();
+        locker.lock();
+    }
+}
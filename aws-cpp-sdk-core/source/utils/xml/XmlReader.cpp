@@ -0,0 +1,624 @@
+/*
+ * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/core/utils/xml/XmlReader.h>
+
+#include <cstring>
+#include <cstdlib>
+
+using namespace Aws::Utils::Xml;
+
+static const size_t XML_READER_CHUNK_SIZE = 16 * 1024;
+
+static bool IsXmlWhitespace(int c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool IsNameTerminator(int c)
+{
+    return c < 0 || IsXmlWhitespace(c) || c == '/' || c == '>' || c == '=' || c == '<';
+}
+
+static void AppendUtf8(Aws::String& out, unsigned long codePoint)
+{
+    if (codePoint < 0x80)
+    {
+        out += static_cast<char>(codePoint);
+    }
+    else if (codePoint < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+//decodes the reference between '&' and ';', returns false if it isn't one we know, in which case it's kept as is.
+static bool AppendReference(Aws::String& out, const char* begin, const char* end)
+{
+    const size_t length = static_cast<size_t>(end - begin);
+    if (length >= 2 && begin[0] == '#')
+    {
+        const bool hex = begin[1] == 'x' || begin[1] == 'X';
+        const char* digits = begin + (hex ? 2 : 1);
+        if (digits == end)
+        {
+            return false;
+        }
+
+        unsigned long codePoint = 0;
+        for (const char* c = digits; c != end; ++c)
+        {
+            int digit = -1;
+            if (*c >= '0' && *c <= '9') digit = *c - '0';
+            else if (hex && *c >= 'a' && *c <= 'f') digit = *c - 'a' + 10;
+            else if (hex && *c >= 'A' && *c <= 'F') digit = *c - 'A' + 10;
+            if (digit < 0 || codePoint > 0x10FFFF)
+            {
+                return false;
+            }
+            codePoint = codePoint * (hex ? 16 : 10) + static_cast<unsigned long>(digit);
+        }
+
+        if (codePoint == 0 || codePoint > 0x10FFFF)
+        {
+            return false;
+        }
+        AppendUtf8(out, codePoint);
+        return true;
+    }
+
+    static const struct { const char* name; size_t length; char value; } namedReferences[] = {
+        { "lt", 2, '<' }, { "gt", 2, '>' }, { "amp", 3, '&' }, { "quot", 4, '"' }, { "apos", 4, '\'' }
+    };
+    for (const auto& reference : namedReferences)
+    {
+        if (length == reference.length && strncmp(begin, reference.name, length) == 0)
+        {
+            out += reference.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+XmlReader::XmlReader(Aws::IStream& stream) :
+    m_stream(stream),
+    m_position(0),
+    m_endOfStream(false),
+    m_nodeType(NodeType::None),
+    m_depth(0),
+    m_pendingEndElement(false),
+    m_rootClosed(false),
+    m_attributeCount(0)
+{
+}
+
+XmlReader::NodeType XmlReader::Read()
+{
+    if (m_nodeType == NodeType::EndDocument || m_nodeType == NodeType::Error)
+    {
+        return m_nodeType;
+    }
+
+    if (m_nodeType == NodeType::EndElement)
+    {
+        m_rootClosed = m_depth == 1;
+        --m_depth;
+    }
+    m_attributeCount = 0;
+
+    if (m_pendingEndElement)
+    {
+        m_pendingEndElement = false;
+        m_nodeType = NodeType::EndElement;
+        return m_nodeType;
+    }
+
+    if (m_rootClosed)
+    {
+        m_nodeType = NodeType::EndDocument;
+        return m_nodeType;
+    }
+
+    for (;;)
+    {
+        const int c = Peek(0);
+        if (c < 0)
+        {
+            //an empty body is a document without content rather than a broken one.
+            if (m_depth == 0)
+            {
+                m_nodeType = NodeType::EndDocument;
+                return m_nodeType;
+            }
+            return Fail("unexpected end of document");
+        }
+
+        if (c == '<')
+        {
+            const NodeType nodeType = ReadMarkup();
+            if (nodeType != NodeType::None)
+            {
+                m_nodeType = nodeType;
+                return m_nodeType;
+            }
+            continue;
+        }
+
+        if (m_depth == 0)
+        {
+            if (!IsXmlWhitespace(c))
+            {
+                return Fail("text outside of the root element");
+            }
+            ++m_position;
+            continue;
+        }
+
+        m_nodeType = ReadText();
+        return m_nodeType;
+    }
+}
+
+Aws::String XmlReader::GetAttributeValue(const char* name) const
+{
+    for (size_t i = 0; i < m_attributeCount; ++i)
+    {
+        if (m_attributes[i].first == name)
+        {
+            return m_attributes[i].second;
+        }
+    }
+    return {};
+}
+
+bool XmlReader::ReadRootElement()
+{
+    while (m_depth != 1 || m_nodeType != NodeType::StartElement)
+    {
+        const NodeType nodeType = Read();
+        if (nodeType == NodeType::EndDocument || nodeType == NodeType::Error)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool XmlReader::ReadChildElement(size_t parentDepth)
+{
+    for (;;)
+    {
+        switch (Read())
+        {
+            case NodeType::StartElement:
+                if (m_depth == parentDepth + 1)
+                {
+                    return true;
+                }
+                SkipElement();
+                break;
+            case NodeType::EndElement:
+                if (m_depth <= parentDepth)
+                {
+                    return false;
+                }
+                break;
+            case NodeType::EndDocument:
+            case NodeType::Error:
+                return false;
+            default:
+                break;
+        }
+    }
+}
+
+Aws::String XmlReader::ReadElementText()
+{
+    Aws::String text;
+    if (m_nodeType != NodeType::StartElement)
+    {
+        return text;
+    }
+
+    const size_t depth = m_depth;
+    for (;;)
+    {
+        switch (Read())
+        {
+            case NodeType::Text:
+                text += m_text;
+                break;
+            case NodeType::EndElement:
+                if (m_depth == depth)
+                {
+                    return text;
+                }
+                break;
+            case NodeType::EndDocument:
+            case NodeType::Error:
+                return text;
+            default:
+                break;
+        }
+    }
+}
+
+void XmlReader::SkipElement()
+{
+    if (m_nodeType != NodeType::StartElement)
+    {
+        return;
+    }
+
+    const size_t depth = m_depth;
+    for (;;)
+    {
+        const NodeType nodeType = Read();
+        if ((nodeType == NodeType::EndElement && m_depth == depth) || nodeType == NodeType::EndDocument || nodeType == NodeType::Error)
+        {
+            return;
+        }
+    }
+}
+
+bool XmlReader::Fill()
+{
+    if (m_endOfStream)
+    {
+        return false;
+    }
+
+    //drop what has been consumed so the buffer only ever holds the token being read and one chunk.
+    if (m_position > 0)
+    {
+        m_buffer.erase(0, m_position);
+        m_position = 0;
+    }
+
+    const size_t size = m_buffer.size();
+    m_buffer.resize(size + XML_READER_CHUNK_SIZE);
+    const auto read = m_stream.rdbuf() ? m_stream.rdbuf()->sgetn(&m_buffer[size], static_cast<std::streamsize>(XML_READER_CHUNK_SIZE)) : 0;
+    m_buffer.resize(size + static_cast<size_t>(read > 0 ? read : 0));
+    if (read <= 0)
+    {
+        m_endOfStream = true;
+        return false;
+    }
+    return true;
+}
+
+int XmlReader::Peek(size_t offset)
+{
+    while (m_position + offset >= m_buffer.size())
+    {
+        if (!Fill())
+        {
+            return -1;
+        }
+    }
+    return static_cast<unsigned char>(m_buffer[m_position + offset]);
+}
+
+bool XmlReader::StartsWith(const char* token)
+{
+    for (size_t i = 0; token[i] != '\0'; ++i)
+    {
+        if (Peek(i) != static_cast<unsigned char>(token[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t XmlReader::Find(const char* token)
+{
+    const size_t length = strlen(token);
+    size_t offset = 0;
+    for (;;)
+    {
+        const size_t found = m_buffer.find(token[0], m_position + offset);
+        if (found == Aws::String::npos)
+        {
+            offset = m_buffer.size() - m_position;
+            if (!Fill())
+            {
+                return Aws::String::npos;
+            }
+            continue;
+        }
+
+        offset = found - m_position;
+        size_t matched = 1;
+        while (matched < length && Peek(offset + matched) == static_cast<unsigned char>(token[matched]))
+        {
+            ++matched;
+        }
+        if (matched == length)
+        {
+            return offset;
+        }
+        ++offset;
+    }
+}
+
+bool XmlReader::SkipPast(const char* terminator)
+{
+    const size_t offset = Find(terminator);
+    if (offset == Aws::String::npos)
+    {
+        return false;
+    }
+    m_position += offset + strlen(terminator);
+    return true;
+}
+
+void XmlReader::SkipWhitespace()
+{
+    while (IsXmlWhitespace(Peek(0)))
+    {
+        ++m_position;
+    }
+}
+
+XmlReader::NodeType XmlReader::ReadMarkup()
+{
+    switch (Peek(1))
+    {
+        case '?':
+            return SkipPast("?>") ? NodeType::None : Fail("unterminated processing instruction");
+        case '!':
+            if (StartsWith("<!--"))
+            {
+                return SkipPast("-->") ? NodeType::None : Fail("unterminated comment");
+            }
+            if (StartsWith("<![CDATA["))
+            {
+                return ReadCharacterData();
+            }
+            return SkipPast(">") ? NodeType::None : Fail("unterminated declaration");
+        case '/':
+            return ReadEndElement();
+        default:
+            return ReadStartElement();
+    }
+}
+
+XmlReader::NodeType XmlReader::ReadStartElement()
+{
+    ++m_position;
+    if (m_depth == m_openElements.size())
+    {
+        m_openElements.emplace_back();
+    }
+    Aws::String& name = m_openElements[m_depth];
+    if (!ReadName(name))
+    {
+        return Fail("malformed element name");
+    }
+
+    for (;;)
+    {
+        SkipWhitespace();
+        const int c = Peek(0);
+        if (c == '>')
+        {
+            ++m_position;
+            break;
+        }
+        if (c == '/')
+        {
+            if (Peek(1) != '>')
+            {
+                return Fail("malformed empty element");
+            }
+            m_position += 2;
+            m_pendingEndElement = true;
+            break;
+        }
+
+        if (m_attributeCount == m_attributes.size())
+        {
+            m_attributes.emplace_back();
+        }
+        auto& attribute = m_attributes[m_attributeCount];
+        if (!ReadName(attribute.first))
+        {
+            return Fail("malformed attribute name");
+        }
+        SkipWhitespace();
+        if (Peek(0) != '=')
+        {
+            return Fail("attribute without a value");
+        }
+        ++m_position;
+        SkipWhitespace();
+        if (!ReadAttributeValue(attribute.second))
+        {
+            return Fail("malformed attribute value");
+        }
+        ++m_attributeCount;
+    }
+
+    m_name = name;
+    ++m_depth;
+    return NodeType::StartElement;
+}
+
+XmlReader::NodeType XmlReader::ReadEndElement()
+{
+    m_position += 2;
+    if (!ReadName(m_name))
+    {
+        return Fail("malformed end tag");
+    }
+    SkipWhitespace();
+    if (Peek(0) != '>')
+    {
+        return Fail("malformed end tag");
+    }
+    ++m_position;
+
+    if (m_depth == 0 || m_openElements[m_depth - 1] != m_name)
+    {
+        return Fail("end tag does not match the open element");
+    }
+    return NodeType::EndElement;
+}
+
+XmlReader::NodeType XmlReader::ReadCharacterData()
+{
+    if (m_depth == 0)
+    {
+        return Fail("text outside of the root element");
+    }
+
+    m_position += 9;
+    const size_t length = Find("]]>");
+    if (length == Aws::String::npos)
+    {
+        return Fail("unterminated CDATA section");
+    }
+    m_text.assign(m_buffer, m_position, length);
+    m_position += length + 3;
+    return NodeType::Text;
+}
+
+XmlReader::NodeType XmlReader::ReadText()
+{
+    //text runs to the next markup, or to the end of the stream, which Read reports as an error next time round.
+    size_t offset = Find("<");
+    if (offset == Aws::String::npos)
+    {
+        offset = m_buffer.size() - m_position;
+    }
+
+    m_text.clear();
+    const char* begin = m_buffer.data() + m_position;
+    AppendDecoded(m_text, begin, begin + offset);
+    m_position += offset;
+    return NodeType::Text;
+}
+
+bool XmlReader::ReadName(Aws::String& name)
+{
+    size_t length = 0;
+    while (!IsNameTerminator(Peek(length)))
+    {
+        ++length;
+    }
+    if (length == 0)
+    {
+        return false;
+    }
+
+    name.assign(m_buffer, m_position, length);
+    m_position += length;
+    return true;
+}
+
+bool XmlReader::ReadAttributeValue(Aws::String& value)
+{
+    const int quote = Peek(0);
+    if (quote != '"' && quote != '\'')
+    {
+        return false;
+    }
+
+    size_t length = 0;
+    for (;;)
+    {
+        const int c = Peek(1 + length);
+        if (c < 0)
+        {
+            return false;
+        }
+        if (c == quote)
+        {
+            break;
+        }
+        ++length;
+    }
+
+    value.clear();
+    const char* begin = m_buffer.data() + m_position + 1;
+    AppendDecoded(value, begin, begin + length);
+    m_position += length + 2;
+    return true;
+}
+
+void XmlReader::AppendDecoded(Aws::String& out, const char* begin, const char* end)
+{
+    const char* run = begin;
+    for (const char* c = begin; c != end; )
+    {
+        if (*c == '&')
+        {
+            const char* semicolon = static_cast<const char*>(memchr(c, ';', static_cast<size_t>(end - c)));
+            if (semicolon)
+            {
+                out.append(run, c);
+                if (AppendReference(out, c + 1, semicolon))
+                {
+                    c = semicolon + 1;
+                    run = c;
+                    continue;
+                }
+                run = c;
+            }
+            ++c;
+        }
+        else if (*c == '\r')
+        {
+            //line endings are normalized to \n, as required of xml processors.
+            out.append(run, c);
+            out += '\n';
+            ++c;
+            if (c != end && *c == '\n')
+            {
+                ++c;
+            }
+            run = c;
+        }
+        else
+        {
+            ++c;
+        }
+    }
+    out.append(run, end);
+}
+
+XmlReader::NodeType XmlReader::Fail(const char* message)
+{
+    m_errorMessage = "Failed to parse xml: ";
+    m_errorMessage += message;
+    m_nodeType = NodeType::Error;
+    return m_nodeType;
+}
@@ -0,0 +1,140 @@
+/*
+  * Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License").
+  * You may not use this file except in compliance with the License.
+  * A copy of the License is located at
+  *
+  *  http://aws.amazon.com/apache2.0
+  *
+  * or in the "license" file accompanying this file. This file is distributed
+  * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+  * express or implied. See the License for the specific language governing
+  * permissions and limitations under the License.
+  */
+
+#include <aws/external/gtest.h>
+#include <aws/transfer/PartConcurrencyLimiter.h>
+#include <aws/transfer/TransferManager.h>
+
+using namespace Aws::Transfer;
+
+static const uint64_t PART_BYTES = 1024 * 1024;
+
+// every part takes the same time per byte unless told otherwise, so only failures and explicitly slow parts count as congestion.
+static void CompleteParts(PartConcurrencyLimiter& limiter, size_t count, std::chrono::milliseconds elapsed = std::chrono::milliseconds(10))
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint64_t ticket = limiter.Acquire();
+        limiter.Release(ticket, true, PART_BYTES, elapsed);
+    }
+}
+
+static void FailPart(PartConcurrencyLimiter& limiter)
+{
+    uint64_t ticket = limiter.Acquire();
+    limiter.Release(ticket, false, 0, std::chrono::milliseconds(10));
+}
+
+TEST(PartConcurrencyLimiterTest, TestSlowStartThenAdditiveIncrease)
+{
+    PartConcurrencyLimiter limiter(8, true);
+    ASSERT_EQ(1u, limiter.GetLimit());
+
+    // one more part per completed part until the first back-off.
+    CompleteParts(limiter, 1);
+    ASSERT_EQ(2u, limiter.GetLimit());
+    CompleteParts(limiter, 1);
+    ASSERT_EQ(3u, limiter.GetLimit());
+    CompleteParts(limiter, 5);
+    ASSERT_EQ(8u, limiter.GetLimit());
+
+    FailPart(limiter);
+    ASSERT_EQ(4u, limiter.GetLimit());
+
+    // after it, about one more part per round of parts at the current limit.
+    CompleteParts(limiter, 4);
+    ASSERT_EQ(4u, limiter.GetLimit());
+    CompleteParts(limiter, 1);
+    ASSERT_EQ(5u, limiter.GetLimit());
+    CompleteParts(limiter, 5);
+    ASSERT_EQ(6u, limiter.GetLimit());
+}
+
+TEST(PartConcurrencyLimiterTest, TestMultiplicativeDecrease)
+{
+    PartConcurrencyLimiter limiter(16, true);
+    CompleteParts(limiter, 15);
+    ASSERT_EQ(16u, limiter.GetLimit());
+
+    // a failed part, e.g. throttled, halves the limit.
+    FailPart(limiter);
+    ASSERT_EQ(8u, limiter.GetLimit());
+
+    // a part taking well over the best time per byte seen cuts it by a quarter.
+    CompleteParts(limiter, 1, std::chrono::milliseconds(30));
+    ASSERT_EQ(6u, limiter.GetLimit());
+
+    // parts started before a cut were competing with the old limit, they don't cut it again.
+    uint64_t first = limiter.Acquire();
+    uint64_t second = limiter.Acquire();
+    limiter.Release(first, false, 0, std::chrono::milliseconds(10));
+    ASSERT_EQ(3u, limiter.GetLimit());
+    limiter.Release(second, false, 0, std::chrono::milliseconds(10));
+    ASSERT_EQ(3u, limiter.GetLimit());
+}
+
+TEST(PartConcurrencyLimiterTest, TestLimitStaysBetweenOneAndMaximum)
+{
+    PartConcurrencyLimiter limiter(4, true);
+    for (int i = 0; i < 10; ++i)
+    {
+        FailPart(limiter);
+        ASSERT_EQ(1u, limiter.GetLimit());
+    }
+
+    CompleteParts(limiter, 100);
+    ASSERT_EQ(4u, limiter.GetLimit());
+
+    PartConcurrencyLimiter noParts(0, true);
+    ASSERT_EQ(1u, noParts.GetLimit());
+    FailPart(noParts);
+    ASSERT_EQ(1u, noParts.GetLimit());
+}
+
+TEST(PartConcurrencyLimiterTest, TestFixedLimitWithoutAdaptiveTuning)
+{
+    PartConcurrencyLimiter limiter(6, false);
+    ASSERT_EQ(6u, limiter.GetLimit());
+    FailPart(limiter);
+    CompleteParts(limiter, 1, std::chrono::milliseconds(1000));
+    ASSERT_EQ(6u, limiter.GetLimit());
+}
+
+TEST(PartConcurrencyLimiterTest, TestChoosePartSizeStaysWithinPartLimit)
+{
+    const uint64_t GB = 1024 * 1024 * 1024;
+    const uint64_t TB = 1024 * GB;
+
+    // small objects keep the minimum part size.
+    ASSERT_EQ(MB5, TransferManager::ChoosePartSize(0, MB5));
+    ASSERT_EQ(MB5, TransferManager::ChoosePartSize(3 * MB5, MB5));
+    ASSERT_EQ(MB5, TransferManager::ChoosePartSize(1000 * MB5, MB5));
+    ASSERT_EQ(2 * MB5, TransferManager::ChoosePartSize(1000 * MB5 + 1, MB5));
+
+    const uint64_t objectSizes[] = { 10 * GB, 100 * GB, TB, 4 * TB };
+    for (uint64_t objectSize : objectSizes)
+    {
+        uint64_t partSize = TransferManager::ChoosePartSize(objectSize, MB5);
+        ASSERT_LE(partSize, 5 * GB);
+        ASSERT_LE((objectSize + partSize - 1) / partSize, 1000u);
+        // the smallest doubling of the minimum that fits.
+        ASSERT_GT((objectSize + partSize / 2 - 1) / (partSize / 2), 1000u);
+    }
+
+    // the largest object S3 takes goes past 1,000 parts with the part size capped at 5GB, but stays within 10,000.
+    ASSERT_EQ(5 * GB, TransferManager::ChoosePartSize(5 * TB, MB5));
+    ASSERT_LE((5 * TB + 5 * GB - 1) / (5 * GB), 10000u);
+    ASSERT_EQ(6 * GB, TransferManager::ChoosePartSize(TB, 6 * GB));
+}
@@ -24,6 +24,8 @@
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/ListObjectsV2Request.h>
+#include <aws/s3/model/PutObjectRequest.h>
+#include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/utils/ratelimiter/DefaultRateLimiter.h>
 #include <aws/s3/model/HeadBucketRequest.h>
@@ -143,7 +145,7 @@ class MockS3Client : public S3Client
 {
 public:
     MockS3Client(const Aws::Client::ClientConfiguration& clientConfiguration = Aws::Client::ClientConfiguration()):
-        S3Client(clientConfiguration), executor(clientConfiguration.executor), listObjectsV2RequestCount(0) 
+        S3Client(clientConfiguration), executor(clientConfiguration.executor), listObjectsV2RequestCount(0), verifyListObjectsV2Requests(true)
     {}
 
     ~MockS3Client() 
@@ -154,8 +156,11 @@ public:
     // Override this function to do verification.
     void ListObjectsV2Async(const Model::ListObjectsV2Request& request, const ListObjectsV2ResponseReceivedHandler& handler, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context = nullptr) const override
     {
-        EXPECT_STREQ("", request.GetDelimiter().c_str());
-        EXPECT_STREQ("nestedTest", request.GetPrefix().c_str());
+        if (verifyListObjectsV2Requests)
+        {
+            EXPECT_STREQ("", request.GetDelimiter().c_str());
+            EXPECT_STREQ("nestedTest", request.GetPrefix().c_str());
+        }
         executor->Submit( [this, request, handler, context](){ this->ListObjectsV2AsyncHelper( request, handler, context ); } );
     }
 
@@ -171,6 +176,142 @@ public:
 
     // Declared as mutable in order to get updated in constness function.
     mutable std::atomic<unsigned int> listObjectsV2RequestCount;
+
+    // Only DownloadToDirectory of the "nestedTest" prefix is expected to list objects, unless this is turned off.
+    std::atomic<bool> verifyListObjectsV2Requests;
+};
+
+// Answers PutObjectAsync locally, keeping the body of every object "uploaded" so tests can run without S3.
+class PutObjectRecordingS3Client : public S3Client
+{
+public:
+    PutObjectRecordingS3Client() : S3Client(Aws::Auth::AWSCredentials("accessKey", "secretKey"), Aws::Client::ClientConfiguration()) {}
+
+    void PutObjectAsync(const Model::PutObjectRequest& request, const PutObjectResponseReceivedHandler& handler, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context = nullptr) const override
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            Aws::StringStream body;
+            body << request.GetBody()->rdbuf();
+            m_uploadedObjects[request.GetKey()] = body.str();
+        }
+        PutObjectResult result;
+        result.SetETag("\"etag\"");
+        handler(this, request, PutObjectOutcome(result), context);
+    }
+
+    size_t GetUploadedObjectCount() const
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        return m_uploadedObjects.size();
+    }
+
+    Aws::String GetUploadedObject(const Aws::String& key) const
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+        auto uploaded = m_uploadedObjects.find(key);
+        return uploaded == m_uploadedObjects.end() ? Aws::String() : uploaded->second;
+    }
+
+private:
+    mutable std::mutex m_lock;
+    mutable Aws::Map<Aws::String, Aws::String> m_uploadedObjects;
+};
+
+// Serves ListObjectsV2 from objects, pageSize keys at a time, and notes how much of the listing had been requested when the first object went up.
+class PagedListingS3Client : public PutObjectRecordingS3Client
+{
+public:
+    PagedListingS3Client(const Aws::Map<Aws::String, Object>& objects, size_t pageSize) :
+        m_objects(objects), m_pageSize(pageSize), listRequestCount(0), listRequestsAtFirstPut(0),
+        m_executor(Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, 1))
+    {}
+
+    void ListObjectsV2Async(const Model::ListObjectsV2Request& request, const ListObjectsV2ResponseReceivedHandler& handler, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context = nullptr) const override
+    {
+        ++listRequestCount;
+        m_executor->Submit([this, request, handler, context]()
+            {
+                // the continuation token is the last key of the previous page.
+                auto object = request.GetContinuationToken().empty() ? m_objects.lower_bound(request.GetPrefix()) : m_objects.upper_bound(request.GetContinuationToken());
+                ListObjectsV2Result result;
+                for (size_t count = 0; count < m_pageSize && object != m_objects.end() && object->first.find(request.GetPrefix()) == 0; ++count, ++object)
+                {
+                    result.AddContents(object->second);
+                }
+                if (object != m_objects.end() && object->first.find(request.GetPrefix()) == 0)
+                {
+                    result.SetIsTruncated(true);
+                    result.SetNextContinuationToken(result.GetContents().back().GetKey());
+                }
+                handler(this, request, ListObjectsV2Outcome(result), context);
+            });
+    }
+
+    void PutObjectAsync(const Model::PutObjectRequest& request, const PutObjectResponseReceivedHandler& handler, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context = nullptr) const override
+    {
+        unsigned int noneYet = 0;
+        listRequestsAtFirstPut.compare_exchange_strong(noneYet, listRequestCount.load());
+        PutObjectRecordingS3Client::PutObjectAsync(request, handler, context);
+    }
+
+private:
+    Aws::Map<Aws::String, Object> m_objects;
+    size_t m_pageSize;
+
+public:
+    mutable std::atomic<unsigned int> listRequestCount;
+    mutable std::atomic<unsigned int> listRequestsAtFirstPut;
+
+private:
+    std::shared_ptr<Aws::Utils::Threading::Executor> m_executor;
+};
+
+// Reports reportedLength when seeked to the end, but only ever reads the bytes it holds, like a file truncated after the upload was queued.
+class TruncatedStreamBuf : public std::streambuf
+{
+public:
+    TruncatedStreamBuf(const Aws::String& data, size_t reportedLength) : m_data(data), m_reportedLength(reportedLength), m_atReportedEnd(false)
+    {
+        setg(&m_data[0], &m_data[0], &m_data[0] + m_data.size());
+    }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        if (dir == std::ios_base::end || (dir == std::ios_base::cur && m_atReportedEnd))
+        {
+            if (off != 0)
+            {
+                return pos_type(off_type(-1));
+            }
+            // nothing is left to read there.
+            setg(&m_data[0], &m_data[0] + m_data.size(), &m_data[0] + m_data.size());
+            m_atReportedEnd = true;
+            return pos_type(static_cast<off_type>(m_reportedLength));
+        }
+        if (dir == std::ios_base::cur)
+        {
+            return seekpos(pos_type(static_cast<off_type>(gptr() - eback()) + off), which);
+        }
+        return seekpos(pos_type(off), which);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode) override
+    {
+        if (pos < 0 || static_cast<size_t>(pos) > m_data.size())
+        {
+            return pos_type(off_type(-1));
+        }
+        setg(&m_data[0], &m_data[0] + static_cast<size_t>(pos), &m_data[0] + m_data.size());
+        m_atReportedEnd = false;
+        return pos;
+    }
+
+private:
+    Aws::String m_data;
+    size_t m_reportedLength;
+    bool m_atReportedEnd;
 };
 
 class TransferTests : public ::testing::Test
@@ -759,6 +900,118 @@ TEST_F(TransferTests, TransferManager_DirectoryUploadAndDownloadTest)
     ASSERT_EQ(1u, m_s3Client->listObjectsV2RequestCount);
 }
 
+TEST_F(TransferTests, TransferManager_DirectorySyncTest)
+{
+    // directory uploads list the bucket per directory when skipping unchanged files.
+    m_s3Client->verifyListObjectsV2Requests = false;
+
+    const Aws::String RandomFileName = Aws::Utils::UUID::RandomUUID();
+    const Aws::String syncPrefix = RandomFileName + "syncTest";
+    auto uploadDir = Aws::FileSystem::Join(GetTestFilesDirectory(), RandomFileName + "syncUpload");
+    ASSERT_TRUE(Aws::FileSystem::CreateDirectoryIfNotExists(uploadDir.c_str()));
+    auto nestedDirectory = Aws::FileSystem::Join(uploadDir, "nested");
+    ASSERT_TRUE(Aws::FileSystem::CreateDirectoryIfNotExists(nestedDirectory.c_str()));
+    auto changingFileName = Aws::FileSystem::Join(uploadDir, "changing");
+    auto nestedFileName = Aws::FileSystem::Join(nestedDirectory, "unchanged");
+    Aws::UniquePtr<ScopedTestFile> changingFile = Aws::MakeUnique<ScopedTestFile>(ALLOCATION_TAG, changingFileName, CONTENT_TEST_FILE_TEXT);
+    ScopedTestFile nestedFile(nestedFileName, CONTENT_TEST_FILE_TEXT);
+
+    std::mutex semaphoreLock;
+    std::condition_variable handleSignal;
+    Aws::Vector<std::shared_ptr<TransferHandle>> handles;
+
+    TransferManagerConfiguration transferManagerConfig(m_executor.get());
+    transferManagerConfig.s3Client = m_s3Client;
+    transferManagerConfig.skipUnchangedDirectoryObjects = true;
+    transferManagerConfig.transferInitiatedCallback = [&](const TransferManager*, const std::shared_ptr<const TransferHandle>& handle)
+        {
+            std::lock_guard<std::mutex> locker(semaphoreLock);
+            handles.push_back(std::const_pointer_cast<TransferHandle>(handle));
+            handleSignal.notify_one();
+        };
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+
+    // waits for a directory operation's handles to finish, and returns their final status by object key.
+    auto waitForHandles = [&](size_t expectedCount)
+        {
+            Aws::Vector<std::shared_ptr<TransferHandle>> started;
+            {
+                std::unique_lock<std::mutex> locker(semaphoreLock);
+                handleSignal.wait_for(locker, std::chrono::seconds(60), [&]() { return handles.size() >= expectedCount; });
+                started.swap(handles);
+            }
+            Aws::Map<Aws::String, TransferStatus> statusByKey;
+            for (const auto& handle : started)
+            {
+                handle->WaitUntilFinished();
+                statusByKey[handle->GetKey()] = handle->GetStatus();
+            }
+            return statusByKey;
+        };
+
+    const Aws::String changingKey = syncPrefix + "/changing";
+    const Aws::String nestedKey = syncPrefix + "/nested/unchanged";
+    const Aws::String extraKey = syncPrefix + "/extra";
+
+    transferManager->UploadDirectory(uploadDir, GetTestBucketName(), syncPrefix, Aws::Map<Aws::String, Aws::String>());
+    auto uploads = waitForHandles(2);
+    ASSERT_EQ(2u, uploads.size());
+    ASSERT_EQ(TransferStatus::COMPLETED, uploads[changingKey]);
+    ASSERT_EQ(TransferStatus::COMPLETED, uploads[nestedKey]);
+
+    // an object that only exists in the bucket
+    PutObjectRequest putObjectRequest;
+    putObjectRequest.WithBucket(GetTestBucketName()).WithKey(extraKey);
+    auto extraBody = Aws::MakeShared<Aws::StringStream>(ALLOCATION_TAG);
+    *extraBody << CONTENT_TEST_FILE_TEXT;
+    putObjectRequest.SetBody(extraBody);
+    ASSERT_TRUE(m_s3Client->PutObject(putObjectRequest).IsSuccess());
+
+    // nothing changed: every file is skipped, and the object missing locally stays.
+    transferManager->UploadDirectory(uploadDir, GetTestBucketName(), syncPrefix, Aws::Map<Aws::String, Aws::String>());
+    uploads = waitForHandles(2);
+    ASSERT_EQ(2u, uploads.size());
+    ASSERT_EQ(TransferStatus::EXACT_OBJECT_ALREADY_EXISTS, uploads[changingKey]);
+    ASSERT_EQ(TransferStatus::EXACT_OBJECT_ALREADY_EXISTS, uploads[nestedKey]);
+
+    HeadObjectRequest headObjectRequest;
+    headObjectRequest.WithBucket(GetTestBucketName()).WithKey(extraKey);
+    ASSERT_TRUE(m_s3Client->HeadObject(headObjectRequest).IsSuccess());
+
+    // a file whose size changed is uploaded again, the other one is still skipped.
+    changingFile = nullptr;
+    changingFile = Aws::MakeUnique<ScopedTestFile>(ALLOCATION_TAG, changingFileName, Aws::String(CONTENT_TEST_FILE_TEXT) + CONTENT_TEST_FILE_TEXT);
+    transferManager->UploadDirectory(uploadDir, GetTestBucketName(), syncPrefix, Aws::Map<Aws::String, Aws::String>());
+    uploads = waitForHandles(2);
+    ASSERT_EQ(2u, uploads.size());
+    ASSERT_EQ(TransferStatus::COMPLETED, uploads[changingKey]);
+    ASSERT_EQ(TransferStatus::EXACT_OBJECT_ALREADY_EXISTS, uploads[nestedKey]);
+
+    // a local file that isn't in the bucket stays through downloads.
+    auto downloadDir = Aws::FileSystem::Join(GetTestFilesDirectory(), RandomFileName + "syncDownload");
+    ASSERT_TRUE(Aws::FileSystem::CreateDirectoryIfNotExists(downloadDir.c_str()));
+    auto extraLocalFileName = Aws::FileSystem::Join(downloadDir, "extraLocal");
+    ScopedTestFile extraLocalFile(extraLocalFileName, CONTENT_TEST_FILE_TEXT);
+
+    transferManager->DownloadToDirectory(downloadDir, GetTestBucketName(), syncPrefix);
+    auto downloads = waitForHandles(3);
+    ASSERT_EQ(3u, downloads.size());
+    ASSERT_EQ(TransferStatus::COMPLETED, downloads[changingKey]);
+    ASSERT_EQ(TransferStatus::COMPLETED, downloads[nestedKey]);
+    ASSERT_EQ(TransferStatus::COMPLETED, downloads[extraKey]);
+
+    transferManager->DownloadToDirectory(downloadDir, GetTestBucketName(), syncPrefix);
+    downloads = waitForHandles(3);
+    ASSERT_EQ(3u, downloads.size());
+    ASSERT_EQ(TransferStatus::EXACT_OBJECT_ALREADY_EXISTS, downloads[changingKey]);
+    ASSERT_EQ(TransferStatus::EXACT_OBJECT_ALREADY_EXISTS, downloads[nestedKey]);
+    ASSERT_EQ(TransferStatus::EXACT_OBJECT_ALREADY_EXISTS, downloads[extraKey]);
+    ASSERT_TRUE(AreFilesSame(changingFileName, Aws::FileSystem::Join(downloadDir, "changing")));
+    ASSERT_TRUE(Aws::FileSystem::GetFileInfo(extraLocalFileName.c_str()));
+
+    m_s3Client->verifyListObjectsV2Requests = true;
+}
+
 // Test of a basic multi part upload - 7.5 megs
 TEST_F(TransferTests, TransferManager_MediumTest)
 {
@@ -1374,4 +1627,132 @@ TEST_F(TransferTests, TransferManager_CancelAndRetryDownloadTest)
         ASSERT_TRUE(AreFilesSame(downloadFileName, cancelTestFileName));
     }
 }
+
+TEST(TransferManagerSmallObjectTest, TransferManager_SmallObjectUploadSendsWholeObject)
+{
+    auto s3Client = Aws::MakeShared<PutObjectRecordingS3Client>(ALLOCATION_TAG);
+    auto executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, 2);
+    TransferManagerConfiguration transferManagerConfig(executor.get());
+    transferManagerConfig.s3Client = s3Client;
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+
+    // up to 128KB is read into a buffer of the object's own size.
+    const size_t objectSizes[] = { 1, 1000, 128 * 1024 };
+    for (size_t objectSize : objectSizes)
+    {
+        Aws::String content;
+        for (size_t i = 0; i < objectSize; ++i)
+        {
+            content += testString[i % testStrLen];
+        }
+        Aws::String key = "SmallObject" + Aws::Utils::StringUtils::to_string(objectSize);
+
+        auto stream = Aws::MakeShared<Aws::StringStream>(ALLOCATION_TAG, content);
+        auto requestPtr = transferManager->UploadFile(stream, "bucket", key, "text/plain", Aws::Map<Aws::String, Aws::String>());
+        requestPtr->WaitUntilFinished();
+
+        ASSERT_EQ(TransferStatus::COMPLETED, requestPtr->GetStatus());
+        ASSERT_FALSE(requestPtr->IsMultipart());
+        ASSERT_EQ(1u, requestPtr->GetCompletedParts().size());
+        ASSERT_EQ(0u, requestPtr->GetFailedParts().size());
+        ASSERT_EQ(0u, requestPtr->GetPendingParts().size());
+        ASSERT_EQ(objectSize, requestPtr->GetBytesTotalSize());
+        ASSERT_EQ(content, s3Client->GetUploadedObject(key));
+    }
+    ASSERT_EQ(3u, s3Client->GetUploadedObjectCount());
+}
+
+TEST(TransferManagerSmallObjectTest, TransferManager_SmallObjectUploadFailsOnShortRead)
+{
+    auto s3Client = Aws::MakeShared<PutObjectRecordingS3Client>(ALLOCATION_TAG);
+    auto executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, 2);
+    TransferManagerConfiguration transferManagerConfig(executor.get());
+    transferManagerConfig.s3Client = s3Client;
+    Aws::Utils::Threading::Semaphore errorReported(0, 1);
+    transferManagerConfig.errorCallback = [&errorReported](const TransferManager*, const std::shared_ptr<const TransferHandle>&,
+        const Aws::Client::AWSError<Aws::S3::S3Errors>&) { errorReported.Release(); };
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+
+    TruncatedStreamBuf truncated(Aws::String(1000, 'x'), 64 * 1024);
+    auto stream = Aws::MakeShared<Aws::IOStream>(ALLOCATION_TAG, &truncated);
+    auto requestPtr = transferManager->UploadFile(stream, "bucket", "TruncatedObject", "text/plain", Aws::Map<Aws::String, Aws::String>());
+    requestPtr->WaitUntilFinished();
+
+    ASSERT_EQ(TransferStatus::FAILED, requestPtr->GetStatus());
+    ASSERT_EQ(64u * 1024u, requestPtr->GetBytesTotalSize());
+    ASSERT_EQ(0u, requestPtr->GetCompletedParts().size());
+    ASSERT_EQ(1u, requestPtr->GetFailedParts().size());
+    ASSERT_EQ(0u, requestPtr->GetPendingParts().size());
+    ASSERT_STREQ("ReadFailed", requestPtr->GetLastError().GetExceptionName().c_str());
+    errorReported.WaitOne();
+    // nothing short of the whole object is sent.
+    ASSERT_EQ(0u, s3Client->GetUploadedObjectCount());
+}
+
+TEST(TransferManagerSmallObjectTest, TransferManager_DirectorySyncComparesListingPageByPage)
+{
+    const Aws::String RandomFileName = Aws::Utils::UUID::RandomUUID();
+    ASSERT_TRUE(Aws::FileSystem::CreateDirectoryIfNotExists("TransferTests"));
+    auto uploadDir = Aws::FileSystem::Join("TransferTests", RandomFileName + "pagedSync");
+    ASSERT_TRUE(Aws::FileSystem::CreateDirectoryIfNotExists(uploadDir.c_str()));
+    const char* fileNames[] = { "a", "b", "c", "d", "e" };
+    for (const char* fileName : fileNames)
+    {
+        Aws::OFStream testFile(Aws::FileSystem::Join(uploadDir, fileName).c_str());
+        testFile << CONTENT_TEST_FILE_TEXT;
+    }
+
+    // a and b changed, c and d are already up to date, e is new and f only exists in the bucket.
+    Aws::Map<Aws::String, Object> objects;
+    const Aws::Utils::DateTime later(Aws::Utils::DateTime::Now().Millis() + 3600 * 1000);
+    const char* objectNames[] = { "a", "b", "c", "d", "f" };
+    for (const char* objectName : objectNames)
+    {
+        Aws::String key = Aws::String("sync/") + objectName;
+        bool unchanged = key == "sync/c" || key == "sync/d";
+        objects[key] = Object().WithKey(key).WithSize(unchanged ? static_cast<long long>(strlen(CONTENT_TEST_FILE_TEXT)) : 1).WithLastModified(later);
+    }
+    auto s3Client = Aws::MakeShared<PagedListingS3Client>(ALLOCATION_TAG, objects, 2);
+
+    std::mutex semaphoreLock;
+    std::condition_variable handleSignal;
+    Aws::Vector<std::shared_ptr<TransferHandle>> handles;
+    auto executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, 2);
+    TransferManagerConfiguration transferManagerConfig(executor.get());
+    transferManagerConfig.s3Client = s3Client;
+    transferManagerConfig.skipUnchangedDirectoryObjects = true;
+    transferManagerConfig.transferInitiatedCallback = [&](const TransferManager*, const std::shared_ptr<const TransferHandle>& handle)
+        {
+            std::lock_guard<std::mutex> locker(semaphoreLock);
+            handles.push_back(std::const_pointer_cast<TransferHandle>(handle));
+            handleSignal.notify_one();
+        };
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+
+    transferManager->UploadDirectory(uploadDir, "bucket", "sync", Aws::Map<Aws::String, Aws::String>());
+    Aws::Vector<std::shared_ptr<TransferHandle>> started;
+    {
+        std::unique_lock<std::mutex> locker(semaphoreLock);
+        handleSignal.wait_for(locker, std::chrono::seconds(60), [&]() { return handles.size() >= 5; });
+        started.swap(handles);
+    }
+    Aws::Map<Aws::String, TransferStatus> statusByKey;
+    for (const auto& handle : started)
+    {
+        handle->WaitUntilFinished();
+        statusByKey[handle->GetKey()] = handle->GetStatus();
+    }
+    Aws::FileSystem::DeepDeleteDirectory(uploadDir.c_str());
+
+    ASSERT_EQ(5u, statusByKey.size());
+    ASSERT_EQ(TransferStatus::COMPLETED, statusByKey["sync/a"]);
+    ASSERT_EQ(TransferStatus::COMPLETED, statusByKey["sync/b"]);
+    ASSERT_EQ(TransferStatus::EXACT_OBJECT_ALREADY_EXISTS, statusByKey["sync/c"]);
+    ASSERT_EQ(TransferStatus::EXACT_OBJECT_ALREADY_EXISTS, statusByKey["sync/d"]);
+    ASSERT_EQ(TransferStatus::COMPLETED, statusByKey["sync/e"]);
+    ASSERT_EQ(3u, s3Client->GetUploadedObjectCount());
+    // the first page and at most the one after it had been asked for when the first changed file went up.
+    ASSERT_EQ(3u, s3Client->listRequestCount.load());
+    ASSERT_LE(s3Client->listRequestsAtFirstPut.load(), 2u);
+}
 }
@@ -0,0 +1,76 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#pragma once
+
+#include <aws/transfer/Transfer_EXPORTS.h>
+#include <cstdint>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+namespace Aws
+{
+    namespace Transfer
+    {
+        /**
+         * Bounds how many parts of multi-part transfers are in flight at once. With adaptive tuning off the bound is fixed at maxPartsInFlight.
+         * With it on, the bound starts at one part and is tuned AIMD-style as parts complete: it grows by one part per completed part until the
+         * first back-off (slow start) and by roughly one part per round of parts after that, and it is cut when a part fails or when a part's
+         * time per byte climbs well above the best seen so far, which means the extra parts are only queueing behind each other.
+         */
+        class AWS_TRANSFER_API PartConcurrencyLimiter
+        {
+        public:
+            PartConcurrencyLimiter(size_t maxPartsInFlight, bool adaptive);
+
+            /**
+             * Blocks until another part may be started. Returns a ticket to hand back to Release once the part is done.
+             */
+            uint64_t Acquire();
+
+            /**
+             * Gives back the slot of a part that was never sent, without feeding the tuning.
+             */
+            void Release();
+
+            /**
+             * Gives back the slot of a finished part. bytes and elapsed are the size of the part and the time it took from Acquire; pass 0 bytes
+             * for parts whose timing shouldn't count, e.g. a short last part.
+             */
+            void Release(uint64_t ticket, bool succeeded, uint64_t bytes, std::chrono::steady_clock::duration elapsed);
+
+            /**
+             * The number of parts currently allowed in flight.
+             */
+            size_t GetLimit() const;
+
+        private:
+            size_t CurrentLimit() const;
+            void Adapt(uint64_t ticket, bool succeeded, uint64_t bytes, std::chrono::steady_clock::duration elapsed);
+
+            const size_t m_maxPartsInFlight;
+            const bool m_adaptive;
+            size_t m_inFlight;
+            double m_limit;
+            double m_slowStartThreshold;
+            double m_bestSecondsPerByte;
+            uint64_t m_partsStarted;
+            uint64_t m_decreasedAt;
+            mutable std::mutex m_lock;
+            std::condition_variable m_slotAvailable;
+        };
+    }
+}
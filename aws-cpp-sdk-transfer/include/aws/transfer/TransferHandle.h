@@ -22,6 +22,7 @@
 #include <aws/core/utils/UUID.h>
 #include <aws/core/client/AWSError.h>
 #include <aws/core/client/AsyncCallerContext.h>
+#include <aws/core/platform/FileSystem.h>
 #include <aws/s3/S3Errors.h>
 #include <iostream>
 #include <atomic>
@@ -349,6 +350,21 @@ namespace Aws
 
             void WritePartToDownloadStream(Aws::IOStream* partStream, std::size_t writeOffset);
 
+            /**
+             * (Download only) When set, multipart downloads write each part into the target file at its own offset instead of going through
+             * the stream from the create download stream function, so parts don't wait on each other to be written.
+             */
+            inline void SetWritePartsToFile(bool value) { m_writePartsToFile = value; }
+            inline bool WritesPartsToFile() const { return m_writePartsToFile; }
+
+            /**
+             * Opens the target file for positional writes and sizes it to fileSize, unless it is already open from an earlier attempt.
+             * Returns false if the file can't be used.
+             */
+            bool OpenDownloadFile(uint64_t fileSize);
+
+            bool WritePartToDownloadFile(const unsigned char* partBuffer, std::size_t partSize, std::size_t writeOffset);
+
             void ApplyDownloadConfiguration(const DownloadConfiguration& downloadConfig);
 
             bool LockForCompletion() 
@@ -390,6 +406,8 @@ namespace Aws
 
             CreateDownloadStreamCallback m_createDownloadStreamFn;
             Aws::IOStream* m_downloadStream;
+            bool m_writePartsToFile;
+            Aws::UniquePtr<Aws::FileSystem::PositionalFileWriter> m_downloadFile;
 
             mutable std::mutex m_downloadStreamLock;
             mutable std::mutex m_partsLock;
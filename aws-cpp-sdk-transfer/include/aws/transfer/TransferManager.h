@@ -16,6 +16,7 @@
 #pragma once
 
 #include <aws/transfer/TransferHandle.h>
+#include <aws/transfer/PartConcurrencyLimiter.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/PutObjectRequest.h>
 #include <aws/s3/model/CreateMultipartUploadRequest.h>
@@ -24,14 +25,19 @@
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
 #include <aws/core/utils/ResourceManager.h>
 #include <aws/core/client/AsyncCallerContext.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
 
 #include <memory>
+#include <mutex>
 
 namespace Aws
 {    
     namespace Transfer
     {
         class TransferManager;
+        struct DirectoryTransferState;
+        struct DirectoryUploadState;
+        struct DirectoryDownloadState;
 
         typedef std::function<void(const TransferManager*, const std::shared_ptr<const TransferHandle>&)> UploadProgressCallback;
         typedef std::function<void(const TransferManager*, const std::shared_ptr<const TransferHandle>&)> DownloadProgressCallback;
@@ -46,7 +52,8 @@ namespace Aws
          */
         struct TransferManagerConfiguration
         {
-            TransferManagerConfiguration(Aws::Utils::Threading::Executor* executor) : s3Client(nullptr), transferExecutor(executor), transferBufferMaxHeapSize(10 * MB5), bufferSize(MB5)
+            TransferManagerConfiguration(Aws::Utils::Threading::Executor* executor) : s3Client(nullptr), transferExecutor(executor), transferBufferMaxHeapSize(10 * MB5), bufferSize(MB5),
+                enableAdaptiveTransfer(false), maxDirectoryTransfersInFlight(128), skipUnchangedDirectoryObjects(false)
             {
             }
 
@@ -79,6 +86,8 @@ namespace Aws
              * Maximum size of the working buffers to use. This is not the same thing as max heap size for your process. This is the maximum amount of memory we will
              * allocate for all transfer buffers. default is 50MB.
              * If you are using Aws::Utils::Threading::PooledThreadExecutor for transferExecutor, this size should be greater than bufferSize * poolSize.
+             * Multi-part uploads from a file read each part from the file as it is sent and don't use these buffers, but they still keep at most
+             * transferBufferMaxHeapSize / bufferSize parts in flight.
              */
             uint64_t transferBufferMaxHeapSize;
             /**
@@ -86,6 +95,28 @@ namespace Aws
              * to increase your max heap size if this is something you plan on increasing.
              */
             uint64_t bufferSize;
+            /**
+             * Defaults to false. When true, multi-part uploads from a file choose their part size from the size of the object: bufferSize is doubled
+             * until the object takes no more than about a thousand parts, keeping well inside S3's limit of 10,000. Downloads and uploads from a stream
+             * keep using bufferSize, since each of their parts has to fit in one of the working buffers.
+             * The number of parts in flight also starts at one and is tuned from the throughput and latency of the parts as they complete, never going
+             * above transferBufferMaxHeapSize / bufferSize. Use TransferManager::GetPartsInFlightLimit from the callbacks to follow the tuning.
+             */
+            bool enableAdaptiveTransfer;
+            /**
+             * Maximum number of transfers UploadDirectory and DownloadToDirectory keep started and unfinished at once, per call. The directory or
+             * bucket listing only moves on as those transfers finish, so a directory operation never holds more than this many handles, plus
+             * one page of the bucket listing for downloads. Defaults to 128.
+             */
+            size_t maxDirectoryTransfersInFlight;
+            /**
+             * Defaults to false. When true, UploadDirectory and DownloadToDirectory don't transfer a file whose copy on the other side has the same
+             * size and was last modified at the same time or later. Skipped files are still passed to transferInitiatedCallback, with a handle in
+             * the EXACT_OBJECT_ALREADY_EXISTS status. Uploads read each local directory ahead and start its files in key order, comparing them
+             * with the bucket listing of the directory's prefix page by page, with at most two pages held at a time. Files and objects that only
+             * exist on the destination are left in place.
+             */
+            bool skipUnchangedDirectoryObjects;
 
             /**
              * Callback to receive progress updates for uploads.
@@ -196,7 +227,7 @@ namespace Aws
             /**
              * Uploads entire contents of directory to Amazon S3 bucket and stores them in a directory starting at prefix. This is an asynchronous method. You will receive notifications
              * that an upload has started via the transferInitiatedCallback callback function in your configuration. If you do not set this callback, then you will not be able to handle
-             * the file transfers.
+             * the file transfers. At most maxDirectoryTransfersInFlight uploads are started ahead of the ones that have finished.
              *
              * directory: the absolute directory on disk to upload
              * bucketName: the name of the S3 bucket to upload to
@@ -208,6 +239,7 @@ namespace Aws
             * Downloads entire contents of an Amazon S3 bucket starting at prefix stores them in a directory (not including the prefix). This is an asynchronous method. You will receive notifications
             * that a download has started via the transferInitiatedCallback callback function in your configuration. If you do not set this callback, then you will not be able to handle
             * the file transfers. If an error occurs prior to the transfer being initiated (e.g. list objects fails, then an error will be passed through the errorCallback).
+            * At most maxDirectoryTransfersInFlight downloads are started ahead of the ones that have finished.
             *
             * directory: the absolute directory on disk to download to
             * bucketName: the name of the S3 bucket to upload to
@@ -215,6 +247,18 @@ namespace Aws
             */
             void DownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix = Aws::String());
 
+            /**
+             * The number of parts of multi-part transfers this manager currently lets be in flight at once. This only moves when
+             * enableAdaptiveTransfer is set.
+             */
+            size_t GetPartsInFlightLimit() const;
+
+            /**
+             * The part size enableAdaptiveTransfer uploads objectSize bytes from a file with: minPartSize doubled until the object splits into at
+             * most 1,000 parts, and no larger than S3's 5GB part limit unless minPartSize already is.
+             */
+            static uint64_t ChoosePartSize(uint64_t objectSize, uint64_t minPartSize);
+
         private:
             /**
              * To ensure TransferManager is always created as a shared_ptr, since it inherits enable_shared_from_this.
@@ -234,6 +278,25 @@ namespace Aws
                                                                    const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context,
                                                                    const Aws::String& fileName = "");
 
+            /**
+             * Creates TransferHandle for uploading the file at fileName. The handle is FAILED if the file can't be opened.
+             */
+            std::shared_ptr<TransferHandle> CreateUploadFileHandle(const Aws::String& fileName,
+                                                                   const Aws::String& bucketName,
+                                                                   const Aws::String& keyName,
+                                                                   const Aws::String& contentType,
+                                                                   const Aws::Map<Aws::String, Aws::String>& metadata,
+                                                                   const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context);
+
+            /**
+             * Creates TransferHandle for downloading bucketName/keyName to the file at writeToFile.
+             */
+            std::shared_ptr<TransferHandle> CreateDownloadFileHandle(const Aws::String& bucketName,
+                                                                     const Aws::String& keyName,
+                                                                     const Aws::String& writeToFile,
+                                                                     const DownloadConfiguration& downloadConfig,
+                                                                     const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context);
+
             /**
              * Submits the actual task to task schecduler
              */
@@ -271,6 +334,14 @@ namespace Aws
             void DoMultiPartUpload(const std::shared_ptr<TransferHandle>& handle);
             void DoSinglePartUpload(const std::shared_ptr<TransferHandle>& handle);
 
+            /**
+             * Uploads a small object with PutObjectAsync, reading it into a buffer of its own size rather than a pooled
+             * bufferSize one. streamToPut may be null to read the handle's file.
+             */
+            void DoSmallObjectUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle);
+            Aws::S3::Model::PutObjectRequest CreatePutObjectRequest(const std::shared_ptr<TransferHandle>& handle, const PartPointer& partState);
+            void FinishSinglePartUpload(const std::shared_ptr<TransferHandle>& handle, const PartPointer& partState, const Aws::S3::Model::PutObjectOutcome& outcome);
+
             void DoDownload(const std::shared_ptr<TransferHandle>& handle);
             void DoSinglePartDownload(const std::shared_ptr<TransferHandle>& handle);
 
@@ -285,16 +356,43 @@ namespace Aws
             void HandlePutObjectResponse(const Aws::S3::S3Client*, const Aws::S3::Model::PutObjectRequest&, const Aws::S3::Model::PutObjectOutcome&, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&);
             void HandleListObjectsResponse(const Aws::S3::S3Client*, const Aws::S3::Model::ListObjectsV2Request&, const Aws::S3::Model::ListObjectsV2Outcome&, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&);
 
+            /**
+             * Start transfers of a directory operation until it has maxDirectoryTransfersInFlight of them unfinished or runs out of files. Only one
+             * of these runs per directory operation at a time; it is resumed whenever one of its transfers finishes or, for downloads, a page of
+             * the listing arrives.
+             */
+            void ContinueDirectoryUpload(const std::shared_ptr<DirectoryUploadState>& state);
+            void ContinueDirectoryDownload(const std::shared_ptr<DirectoryDownloadState>& state);
+            /**
+             * Sets entry to the next file of a directory upload, or to an empty entry once there are none, reporting the unchanged files it passes
+             * over. Returns false instead when the page of the listing the next file is compared with hasn't arrived yet; the page resumes the upload.
+             */
+            bool NextFileToUpload(const std::shared_ptr<DirectoryUploadState>& state, Aws::FileSystem::DirectoryEntry& entry);
+            void ListExistingDirectoryObjects(const std::shared_ptr<DirectoryUploadState>& state);
+            void ListDirectoryObjects(const std::shared_ptr<DirectoryDownloadState>& state);
+            void TrackDirectoryTransfer(const std::shared_ptr<DirectoryTransferState>& state, const std::shared_ptr<TransferHandle>& handle);
+            void ReportUnchangedDirectoryObject(const std::shared_ptr<TransferHandle>& handle);
+            void OnTransferFinished(const std::shared_ptr<const TransferHandle>& handle);
+
             TransferStatus DetermineIfFailedOrCanceled(const TransferHandle&) const;
             void TriggerUploadProgressCallback(const std::shared_ptr<const TransferHandle>&) const;
             void TriggerDownloadProgressCallback(const std::shared_ptr<const TransferHandle>&) const;
             void TriggerTransferStatusUpdatedCallback(const std::shared_ptr<const TransferHandle>&) const;
+            /**
+             * Updates handle's status and, once that is a final one, frees the handle's slot in the directory operation that started it.
+             */
+            void UpdateHandleStatus(const std::shared_ptr<TransferHandle>& handle, TransferStatus status);
             void TriggerErrorCallback(const std::shared_ptr<const TransferHandle>&, const Aws::Client::AWSError<Aws::S3::S3Errors>& error)const;
 
             static Aws::String DetermineFilePath(const Aws::String& directory, const Aws::String& prefix, const Aws::String& keyName);
 
             Aws::Utils::ExclusiveOwnershipResourceManager<unsigned char*> m_bufferManager;
             TransferManagerConfiguration m_transferConfig;
+            // bounds the parts in flight, including those of file uploads which don't take a buffer from m_bufferManager.
+            PartConcurrencyLimiter m_partLimiter;
+            // the directory operation each unfinished transfer started by UploadDirectory or DownloadToDirectory belongs to, by handle id.
+            Aws::Map<Aws::String, std::shared_ptr<DirectoryTransferState>> m_directoryTransfers;
+            std::mutex m_directoryTransfersLock;
         };
 
         
@@ -0,0 +1,124 @@
+/*
+* Copyright 2010-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+*  http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <aws/transfer/PartConcurrencyLimiter.h>
+#include <aws/core/utils/logging/LogMacros.h>
+
+#include <algorithm>
+
+namespace Aws
+{
+    namespace Transfer
+    {
+        static const char LIMITER_TAG[] = "PartConcurrencyLimiter";
+
+        // a part taking more than this many times the best time per byte seen is queueing, not transferring.
+        static const double LATENCY_TOLERANCE = 2.0;
+        static const double LATENCY_BACKOFF = 0.75;
+        static const double FAILURE_BACKOFF = 0.5;
+
+        PartConcurrencyLimiter::PartConcurrencyLimiter(size_t maxPartsInFlight, bool adaptive) :
+            m_maxPartsInFlight((std::max)(maxPartsInFlight, static_cast<size_t>(1))),
+            m_adaptive(adaptive),
+            m_inFlight(0),
+            m_limit(adaptive ? 1.0 : static_cast<double>(m_maxPartsInFlight)),
+            m_slowStartThreshold(static_cast<double>(m_maxPartsInFlight)),
+            m_bestSecondsPerByte(0.0),
+            m_partsStarted(0),
+            m_decreasedAt(0)
+        {
+        }
+
+        uint64_t PartConcurrencyLimiter::Acquire()
+        {
+            std::unique_lock<std::mutex> locker(m_lock);
+            m_slotAvailable.wait(locker, [this] { return m_inFlight < CurrentLimit(); });
+            ++m_inFlight;
+            return m_partsStarted++;
+        }
+
+        void PartConcurrencyLimiter::Release()
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_lock);
+                --m_inFlight;
+            }
+            m_slotAvailable.notify_one();
+        }
+
+        void PartConcurrencyLimiter::Release(uint64_t ticket, bool succeeded, uint64_t bytes, std::chrono::steady_clock::duration elapsed)
+        {
+            {
+                std::lock_guard<std::mutex> locker(m_lock);
+                --m_inFlight;
+                if (m_adaptive)
+                {
+                    Adapt(ticket, succeeded, bytes, elapsed);
+                }
+            }
+            // the limit may have grown by more than the slot just given back.
+            m_slotAvailable.notify_all();
+        }
+
+        size_t PartConcurrencyLimiter::GetLimit() const
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            return CurrentLimit();
+        }
+
+        size_t PartConcurrencyLimiter::CurrentLimit() const
+        {
+            return (std::min)((std::max)(static_cast<size_t>(m_limit), static_cast<size_t>(1)), m_maxPartsInFlight);
+        }
+
+        void PartConcurrencyLimiter::Adapt(uint64_t ticket, bool succeeded, uint64_t bytes, std::chrono::steady_clock::duration elapsed)
+        {
+            bool congested = !succeeded;
+            if (succeeded && bytes > 0)
+            {
+                double secondsPerByte = std::chrono::duration<double>(elapsed).count() / static_cast<double>(bytes);
+                if (m_bestSecondsPerByte == 0.0 || secondsPerByte < m_bestSecondsPerByte)
+                {
+                    m_bestSecondsPerByte = secondsPerByte;
+                }
+                congested = secondsPerByte > LATENCY_TOLERANCE * m_bestSecondsPerByte;
+            }
+
+            size_t previousLimit = CurrentLimit();
+            if (congested)
+            {
+                // parts started before the last cut were competing with the old limit, they must not cut it again.
+                if (ticket < m_decreasedAt)
+                {
+                    return;
+                }
+                m_limit = (std::max)(m_limit * (succeeded ? LATENCY_BACKOFF : FAILURE_BACKOFF), 1.0);
+                m_slowStartThreshold = m_limit;
+                m_decreasedAt = m_partsStarted;
+            }
+            else if (succeeded)
+            {
+                m_limit += m_limit < m_slowStartThreshold ? 1.0 : 1.0 / m_limit;
+                m_limit = (std::min)(m_limit, static_cast<double>(m_maxPartsInFlight));
+            }
+
+            if (CurrentLimit() != previousLimit)
+            {
+                AWS_LOGSTREAM_DEBUG(LIMITER_TAG, "Parts in flight limit changed from " << previousLimit << " to " << CurrentLimit()
+                        << (congested ? (succeeded ? " after a slow part." : " after a failed part.") : "."));
+            }
+        }
+    }
+}
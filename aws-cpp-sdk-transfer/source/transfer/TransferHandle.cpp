@@ -85,7 +85,8 @@ namespace Aws
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(), 
-            m_downloadStream(nullptr)
+            m_downloadStream(nullptr),
+            m_writePartsToFile(false)
         {}
 
         TransferHandle::TransferHandle(const Aws::String& bucketName, const Aws::String& keyName, const Aws::String& targetFilePath) :
@@ -102,7 +103,8 @@ namespace Aws
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(), 
-            m_downloadStream(nullptr)
+            m_downloadStream(nullptr),
+            m_writePartsToFile(false)
         {}
 
         TransferHandle::TransferHandle(const Aws::String& bucketName, const Aws::String& keyName, CreateDownloadStreamCallback createDownloadStreamFn, const Aws::String& targetFilePath) :
@@ -119,7 +121,8 @@ namespace Aws
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(createDownloadStreamFn), 
-            m_downloadStream(nullptr)
+            m_downloadStream(nullptr),
+            m_writePartsToFile(false)
         {}
 
         TransferHandle::~TransferHandle()
@@ -361,6 +364,30 @@ namespace Aws
             m_downloadStream->flush();
         }
 
+        bool TransferHandle::OpenDownloadFile(uint64_t fileSize)
+        {
+            std::lock_guard<std::mutex> lock(m_downloadStreamLock);
+
+            if(!m_downloadFile)
+            {
+                auto downloadFile = Aws::FileSystem::OpenFileForPositionalWrite(m_fileName.c_str(), fileSize);
+                if(!downloadFile || !*downloadFile)
+                {
+                    return false;
+                }
+                m_downloadFile = std::move(downloadFile);
+            }
+
+            return true;
+        }
+
+        bool TransferHandle::WritePartToDownloadFile(const unsigned char* partBuffer, std::size_t partSize, std::size_t writeOffset)
+        {
+            // parts cover disjoint ranges of the file, and the file stays open until every part has finished, so no lock is needed here.
+            assert(m_downloadFile);
+            return m_downloadFile->WriteAt(writeOffset, partBuffer, partSize);
+        }
+
         void TransferHandle::ApplyDownloadConfiguration(const DownloadConfiguration& downloadConfig)
         {
             SetVersionId(downloadConfig.versionId);
@@ -375,6 +402,7 @@ namespace Aws
                 Aws::Delete(m_downloadStream);
                 m_downloadStream = nullptr;
             }
+            m_downloadFile = nullptr;
         }
 
         TransferStatus TransferHandle::GetStatus() const
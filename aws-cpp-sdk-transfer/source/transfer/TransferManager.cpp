@@ -17,7 +17,10 @@
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
 #include <aws/core/utils/memory/AWSMemory.h>
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/stream/FileRangeStreamBuf.h>
+#include <aws/core/utils/stream/ResponseStream.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/memory/stl/AWSDeque.h>
 #include <aws/core/utils/HashingUtils.h>
 #include <aws/core/utils/FileSystemUtils.h>
 #include <aws/core/platform/FileSystem.h>
@@ -29,6 +32,7 @@
 #include <aws/s3/model/AbortMultipartUploadRequest.h>
 #include <fstream>
 #include <algorithm>
+#include <chrono>
 
 #include <aws/core/utils/logging/LogMacros.h>
 
@@ -43,16 +47,125 @@ namespace Aws
 
         struct TransferHandleAsyncContext : public Aws::Client::AsyncCallerContext
         {
+            TransferHandleAsyncContext() : partBuffer(nullptr), partTicket(0) {}
+
             std::shared_ptr<TransferHandle> handle;
             PartPointer partState;
+            // pooled buffer holding an upload part's body, null when the part is read from the file as it is sent.
+            unsigned char* partBuffer;
+            // what the part limiter needs back once a part of a multi-part transfer is done.
+            uint64_t partTicket;
+            std::chrono::steady_clock::time_point partStarted;
+        };
+
+        // bookkeeping shared by the transfers one UploadDirectory or DownloadToDirectory call starts.
+        struct DirectoryTransferState
+        {
+            DirectoryTransferState(TransferDirection transferDirection) :
+                direction(transferDirection), inFlight(0), dispatching(true), exhausted(false) {}
+
+            const TransferDirection direction;
+            std::mutex lock;
+            size_t inFlight;
+            // a task is starting transfers, only one may walk the files at a time.
+            bool dispatching;
+            // every file has been started or skipped.
+            bool exhausted;
+        };
+
+        // all a directory upload compares a local file against, the rest of a listed object isn't kept.
+        struct ExistingObject
+        {
+            long long size;
+            Aws::Utils::DateTime lastModified;
+        };
+
+        // one page of the listing of the objects already under a directory's prefix.
+        struct ExistingObjectsPage
+        {
+            ExistingObjectsPage() : isLast(true) {}
+
+            Aws::Map<Aws::String, ExistingObject> objects;
+            // pages come in key order, so a file with a key up to this one can only have its object in this page.
+            Aws::String lastKey;
+            bool isLast;
+        };
+
+        struct DirectoryUploadState : public DirectoryTransferState
+        {
+            DirectoryUploadState() : DirectoryTransferState(TransferDirection::UPLOAD), listingGeneration(0), listing(false), waitingForListing(false) {}
+
+            Aws::String bucketName;
+            Aws::String prefix;
+            Aws::Map<Aws::String, Aws::String> metadata;
+            // directories are walked breadth first, one open at a time.
+            Aws::Deque<Aws::FileSystem::DirectoryEntry> pendingDirectories;
+            Aws::UniquePtr<Aws::FileSystem::Directory> currentDirectory;
+            // when skipping unchanged files, the current directory's files not started yet by object key, so that they go in the listing's order.
+            Aws::Map<Aws::String, Aws::FileSystem::DirectoryEntry> directoryFiles;
+            // the listing of the current directory's prefix, guarded by lock since its pages arrive while the files are worked through.
+            // At most the page being compared against and the next one are held.
+            Aws::String directoryPath;
+            Aws::String listPrefix;
+            Aws::String continuationToken;
+            Aws::Deque<ExistingObjectsPage> existingObjectPages;
+            // bumped per directory, so a page still on its way for the previous one is dropped.
+            size_t listingGeneration;
+            bool listing;
+            // the walk is suspended until the page it needs arrives.
+            bool waitingForListing;
+        };
+
+        struct DirectoryDownloadState : public DirectoryTransferState
+        {
+            DirectoryDownloadState() : DirectoryTransferState(TransferDirection::DOWNLOAD), listing(false), listingDone(false) {}
+
+            Aws::String bucketName;
+            Aws::String rootDirectory;
+            Aws::String prefix;
+            // listed objects not started yet, the next page is only requested once these run low.
+            Aws::Deque<Aws::S3::Model::Object> pendingObjects;
+            Aws::String continuationToken;
+            bool listing;
+            bool listingDone;
         };
 
         struct DownloadDirectoryContext : public Aws::Client::AsyncCallerContext
         {
             Aws::String rootDirectory;
             Aws::String prefix;
+            std::shared_ptr<DirectoryDownloadState> state;
         };
 
+        static const size_t LIST_OBJECTS_PAGE_SIZE = 1000;
+        // objects up to this size get a buffer of their own size rather than a pooled bufferSize one.
+        static const uint64_t SMALL_OBJECT_MAX_SIZE = 128 * 1024;
+
+        static Aws::String DetermineObjectKey(const Aws::String& prefix, const Aws::String& relativePath)
+        {
+            Aws::String keyRelativePath = relativePath;
+            char delimiter[] = { Aws::FileSystem::PATH_DELIM, 0 };
+            Aws::Utils::StringUtils::Replace(keyRelativePath, delimiter, "/");
+
+            Aws::StringStream ssKey;
+            ssKey << prefix << "/" << keyRelativePath;
+            return ssKey.str();
+        }
+
+        static const uint64_t TARGET_PART_COUNT = 1000;
+        static const uint64_t MAX_PART_SIZE = 5ull * 1024 * 1024 * 1024;
+
+        static size_t GetPartsInFlight(const TransferManagerConfiguration& config)
+        {
+            return (std::max)(static_cast<size_t>(config.transferBufferMaxHeapSize / config.bufferSize), static_cast<size_t>(1));
+        }
+
+        // parts shorter than a full part would skew the time per byte the limiter tunes on.
+        static uint64_t GetPartSampleBytes(const PartPointer& partState)
+        {
+            return partState->IsLastPart() ? 0 : partState->GetSizeInBytes();
+        }
+
         std::shared_ptr<TransferManager> TransferManager::Create(const TransferManagerConfiguration& config)
         {
             // Because TransferManager's ctor is private (to ensure it's always constructed as a shared_ptr)
@@ -65,7 +178,9 @@ namespace Aws
             return Aws::MakeShared<MakeSharedEnabler>(CLASS_TAG, config);
         }
 
-        TransferManager::TransferManager(const TransferManagerConfiguration& configuration) : m_transferConfig(configuration)
+        TransferManager::TransferManager(const TransferManagerConfiguration& configuration) :
+            m_transferConfig(configuration),
+            m_partLimiter(GetPartsInFlight(configuration), configuration.enableAdaptiveTransfer)
         {
             assert(m_transferConfig.s3Client);
             assert(m_transferConfig.transferExecutor);
@@ -124,6 +239,19 @@ namespace Aws
                                                                       const DownloadConfiguration& downloadConfig,
                                                                       const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
         {
+            auto handle = CreateDownloadFileHandle(bucketName, keyName, writeToFile, downloadConfig, context);
+
+            auto self = shared_from_this();
+            m_transferConfig.transferExecutor->Submit([self, handle] { self->DoDownload(handle); });
+            return handle;
+        }
+
+        std::shared_ptr<TransferHandle> TransferManager::CreateDownloadFileHandle(const Aws::String& bucketName,
+                                                                                  const Aws::String& keyName,
+                                                                                  const Aws::String& writeToFile,
+                                                                                  const DownloadConfiguration& downloadConfig,
+                                                                                  const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
+        {
 #ifdef _MSC_VER
             auto createFileFn = [=]() { return Aws::New<Aws::FStream>(CLASS_TAG, Aws::Utils::StringUtils::ToWString(writeToFile.c_str()).c_str(),
                                                                      std::ios_base::out | std::ios_base::in | std::ios_base::binary | std::ios_base::trunc);};
@@ -132,7 +260,11 @@ namespace Aws
                                                                      std::ios_base::out | std::ios_base::in | std::ios_base::binary | std::ios_base::trunc);};
 #endif
 
-            return DownloadFile(bucketName, keyName, createFileFn, downloadConfig, writeToFile, context);
+            auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, bucketName, keyName, createFileFn, writeToFile);
+            handle->SetWritePartsToFile(true);
+            handle->ApplyDownloadConfiguration(downloadConfig);
+            handle->SetContext(context);
+            return handle;
         }
 
         std::shared_ptr<TransferHandle> TransferManager::RetryUpload(const Aws::String& fileName, const std::shared_ptr<TransferHandle>& retryHandle)
@@ -180,7 +312,7 @@ namespace Aws
                 }
             }
 
-            retryHandle->UpdateStatus(TransferStatus::NOT_STARTED);
+            UpdateHandleStatus(retryHandle, TransferStatus::NOT_STARTED);
             retryHandle->Restart();
             TriggerTransferStatusUpdatedCallback(retryHandle);
 
@@ -204,35 +336,36 @@ namespace Aws
         {
             assert(m_transferConfig.transferInitiatedCallback);
 
-            auto self = shared_from_this();
-            auto visitor = [self, bucketName, prefix, metadata](const Aws::FileSystem::DirectoryTree*, const Aws::FileSystem::DirectoryEntry& entry)
-            {
-                if (entry && entry.fileType == Aws::FileSystem::FileType::File)
-                {
-                    Aws::StringStream ssKey;
-                    Aws::String relativePath = entry.relativePath;
-                    char delimiter[] = { Aws::FileSystem::PATH_DELIM, 0 };
-                    Aws::Utils::StringUtils::Replace(relativePath, delimiter, "/");
-
-                    ssKey << prefix << "/" << relativePath;
-                    Aws::String keyName = ssKey.str();
-                    AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Uploading file: " << entry.path
-                            << " as part of directory upload to S3 Bucket: [" << bucketName << "] and Key: ["
-                            << keyName << "].");
-                    self->m_transferConfig.transferInitiatedCallback(self.get(), self->UploadFile(entry.path, bucketName, keyName, DEFAULT_CONTENT_TYPE, metadata));
-                }
+            auto state = Aws::MakeShared<DirectoryUploadState>(CLASS_TAG);
+            state->bucketName = bucketName;
+            state->prefix = prefix;
+            state->metadata = metadata;
+            Aws::FileSystem::DirectoryEntry root;
+            root.path = directory;
+            state->pendingDirectories.push_back(root);
 
-                return true;
-            };
-
-            m_transferConfig.transferExecutor->Submit([directory, visitor]() { Aws::FileSystem::DirectoryTree dir(directory); dir.TraverseDepthFirst(visitor); });
+            auto self = shared_from_this();
+            m_transferConfig.transferExecutor->Submit([self, state]() { self->ContinueDirectoryUpload(state); });
         }
 
         void TransferManager::DownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix)
         {
             assert(m_transferConfig.transferInitiatedCallback);
             Aws::FileSystem::CreateDirectoryIfNotExists(directory.c_str());
-         
+
+            auto state = Aws::MakeShared<DirectoryDownloadState>(CLASS_TAG);
+            state->bucketName = bucketName;
+            state->rootDirectory = directory;
+            state->prefix = prefix;
+            // nothing to start until the first page of the listing arrives.
+            state->dispatching = false;
+            state->listing = true;
+
+            ListDirectoryObjects(state);
+        }
+
+        void TransferManager::ListDirectoryObjects(const std::shared_ptr<DirectoryDownloadState>& state)
+        {
             auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
             auto handler = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::ListObjectsV2Request& request,
                 const Aws::S3::Model::ListObjectsV2Outcome& outcome,
@@ -240,26 +373,403 @@ namespace Aws
 
             Aws::S3::Model::ListObjectsV2Request request;
             request.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
-            request.WithBucket(bucketName)
-                .WithPrefix(prefix);
+            request.WithBucket(state->bucketName)
+                .WithPrefix(state->prefix);
+            if (!state->continuationToken.empty())
+            {
+                request.SetContinuationToken(state->continuationToken);
+            }
 
             auto context = Aws::MakeShared<DownloadDirectoryContext>(CLASS_TAG);
-            context->rootDirectory = directory;
-            context->prefix = prefix;
+            context->rootDirectory = state->rootDirectory;
+            context->prefix = state->prefix;
+            context->state = state;
 
             m_transferConfig.s3Client->ListObjectsV2Async(request, handler, context);
         }
 
+        bool TransferManager::NextFileToUpload(const std::shared_ptr<DirectoryUploadState>& state, Aws::FileSystem::DirectoryEntry& entry)
+        {
+            for (;;)
+            {
+                if (!state->directoryFiles.empty())
+                {
+                    auto file = state->directoryFiles.begin();
+                    ExistingObject existingObject;
+                    bool exists = false;
+                    bool listNextPage = false;
+                    bool waitForPage = false;
+                    {
+                        std::lock_guard<std::mutex> locker(state->lock);
+                        auto& pages = state->existingObjectPages;
+                        // pages before the one that can hold this key have nothing left to compare.
+                        while (!pages.empty() && !pages.front().isLast && file->first > pages.front().lastKey)
+                        {
+                            pages.pop_front();
+                        }
+                        if (pages.empty() || (!pages.back().isLast && pages.size() < 2))
+                        {
+                            listNextPage = !state->listing;
+                            state->listing = true;
+                        }
+                        if (pages.empty())
+                        {
+                            state->waitingForListing = true;
+                            waitForPage = true;
+                        }
+                        else
+                        {
+                            auto existing = pages.front().objects.find(file->first);
+                            exists = existing != pages.front().objects.end();
+                            if (exists)
+                            {
+                                existingObject = existing->second;
+                            }
+                        }
+                    }
+
+                    if (listNextPage)
+                    {
+                        ListExistingDirectoryObjects(state);
+                    }
+                    if (waitForPage)
+                    {
+                        return false;
+                    }
+
+                    entry = file->second;
+                    Aws::String keyName = file->first;
+                    state->directoryFiles.erase(file);
+                    if (state->directoryFiles.empty())
+                    {
+                        std::lock_guard<std::mutex> locker(state->lock);
+                        ++state->listingGeneration;
+                        state->listing = false;
+                        state->existingObjectPages.clear();
+                    }
+
+                    if (exists && existingObject.size == entry.fileSize && existingObject.lastModified >= entry.lastModified)
+                    {
+                        AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Skipping file: " << entry.path << " as part of directory upload, S3 Bucket: ["
+                                << state->bucketName << "] already has Key: [" << keyName << "] with the same size.");
+                        ReportUnchangedDirectoryObject(Aws::MakeShared<TransferHandle>(CLASS_TAG, state->bucketName, keyName,
+                                static_cast<uint64_t>(entry.fileSize), entry.path));
+                        continue;
+                    }
+                    return true;
+                }
+
+                if (!state->currentDirectory)
+                {
+                    if (state->pendingDirectories.empty())
+                    {
+                        entry = Aws::FileSystem::DirectoryEntry();
+                        return true;
+                    }
+
+                    auto directoryEntry = state->pendingDirectories.front();
+                    state->pendingDirectories.pop_front();
+                    state->currentDirectory = Aws::FileSystem::OpenDirectory(directoryEntry.path, directoryEntry.relativePath);
+                    if (!*state->currentDirectory)
+                    {
+                        AWS_LOGSTREAM_ERROR(CLASS_TAG, "Could not open directory " << directoryEntry.path << " for directory upload.");
+                        state->currentDirectory = nullptr;
+                        continue;
+                    }
+
+                    if (m_transferConfig.skipUnchangedDirectoryObjects)
+                    {
+                        // the listing comes back in key order, so the directory's files are read ahead and started in that order,
+                        // each compared with the page that can hold its key while the next page is fetched.
+                        for (auto file = state->currentDirectory->Next(); file; file = state->currentDirectory->Next())
+                        {
+                            if (file.fileType == Aws::FileSystem::FileType::Directory)
+                            {
+                                state->pendingDirectories.push_back(file);
+                            }
+                            else if (file.fileType == Aws::FileSystem::FileType::File)
+                            {
+                                state->directoryFiles[DetermineObjectKey(state->prefix, file.relativePath)] = file;
+                            }
+                        }
+                        state->currentDirectory = nullptr;
+
+                        std::lock_guard<std::mutex> locker(state->lock);
+                        state->directoryPath = directoryEntry.path;
+                        // only this directory's own objects, anything deeper comes back as a common prefix.
+                        state->listPrefix = directoryEntry.relativePath.empty() ? state->prefix + "/" : DetermineObjectKey(state->prefix, directoryEntry.relativePath) + "/";
+                        state->continuationToken.clear();
+                    }
+                    continue;
+                }
+
+                entry = state->currentDirectory->Next();
+                if (!entry)
+                {
+                    state->currentDirectory = nullptr;
+                }
+                else if (entry.fileType == Aws::FileSystem::FileType::Directory)
+                {
+                    state->pendingDirectories.push_back(entry);
+                }
+                else if (entry.fileType == Aws::FileSystem::FileType::File)
+                {
+                    return true;
+                }
+            }
+        }
+
+        void TransferManager::ListExistingDirectoryObjects(const std::shared_ptr<DirectoryUploadState>& state)
+        {
+            Aws::S3::Model::ListObjectsV2Request request;
+            request.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
+            size_t generation;
+            Aws::String directoryPath;
+            {
+                std::lock_guard<std::mutex> locker(state->lock);
+                request.WithBucket(state->bucketName)
+                    .WithPrefix(state->listPrefix)
+                    .WithDelimiter("/");
+                if (!state->continuationToken.empty())
+                {
+                    request.SetContinuationToken(state->continuationToken);
+                }
+                generation = state->listingGeneration;
+                directoryPath = state->directoryPath;
+            }
+
+            // a walk waiting for this page doesn't hold an executor thread, the handler resumes it.
+            auto self = shared_from_this();
+            auto handler = [self, state, generation, directoryPath](const Aws::S3::S3Client*, const Aws::S3::Model::ListObjectsV2Request& listRequest,
+                const Aws::S3::Model::ListObjectsV2Outcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&)
+            {
+                ExistingObjectsPage page;
+                if (!outcome.IsSuccess())
+                {
+                    // an empty last page, the files not compared yet are all uploaded.
+                    AWS_LOGSTREAM_WARN(CLASS_TAG, "Could not list objects under [" << listRequest.GetPrefix() << "] in Bucket: ["
+                            << listRequest.GetBucket() << "], uploading the remaining files of " << directoryPath << ". " << outcome.GetError());
+                }
+                else
+                {
+                    const auto& result = outcome.GetResult();
+                    for (const auto& object : result.GetContents())
+                    {
+                        ExistingObject existing;
+                        existing.size = object.GetSize();
+                        existing.lastModified = object.GetLastModified();
+                        page.objects[object.GetKey()] = existing;
+                        page.lastKey = (std::max)(page.lastKey, object.GetKey());
+                    }
+                    for (const auto& commonPrefix : result.GetCommonPrefixes())
+                    {
+                        page.lastKey = (std::max)(page.lastKey, commonPrefix.GetPrefix());
+                    }
+                    page.isLast = !result.GetIsTruncated();
+                }
+
+                bool resume = false;
+                {
+                    std::lock_guard<std::mutex> locker(state->lock);
+                    if (generation != state->listingGeneration)
+                    {
+                        return;
+                    }
+                    state->listing = false;
+                    if (outcome.IsSuccess())
+                    {
+                        state->continuationToken = outcome.GetResult().GetNextContinuationToken();
+                    }
+                    state->existingObjectPages.push_back(std::move(page));
+                    resume = state->waitingForListing;
+                    state->waitingForListing = false;
+                }
+
+                if (resume)
+                {
+                    self->m_transferConfig.transferExecutor->Submit([self, state]() { self->ContinueDirectoryUpload(state); });
+                }
+            };
+
+            m_transferConfig.s3Client->ListObjectsV2Async(request, handler);
+        }
+
+        void TransferManager::ContinueDirectoryUpload(const std::shared_ptr<DirectoryUploadState>& state)
+        {
+            // several files go out per task, and the walk stops whenever enough of them are in flight.
+            for (;;)
+            {
+                {
+                    std::lock_guard<std::mutex> locker(state->lock);
+                    if (state->inFlight >= m_transferConfig.maxDirectoryTransfersInFlight)
+                    {
+                        state->dispatching = false;
+                        return;
+                    }
+                }
+
+                Aws::FileSystem::DirectoryEntry entry;
+                if (!NextFileToUpload(state, entry))
+                {
+                    // still dispatching, the listing handler picks the walk back up.
+                    return;
+                }
+                if (!entry)
+                {
+                    std::lock_guard<std::mutex> locker(state->lock);
+                    state->exhausted = true;
+                    state->dispatching = false;
+                    return;
+                }
+
+                Aws::String keyName = DetermineObjectKey(state->prefix, entry.relativePath);
+                AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Uploading file: " << entry.path
+                        << " as part of directory upload to S3 Bucket: [" << state->bucketName << "] and Key: ["
+                        << keyName << "].");
+                auto handle = CreateUploadFileHandle(entry.path, state->bucketName, keyName, DEFAULT_CONTENT_TYPE, state->metadata, nullptr);
+                TrackDirectoryTransfer(state, handle);
+                m_transferConfig.transferInitiatedCallback(this, handle);
+                SubmitUpload(handle);
+            }
+        }
+
+        void TransferManager::ContinueDirectoryDownload(const std::shared_ptr<DirectoryDownloadState>& state)
+        {
+            for (;;)
+            {
+                Aws::S3::Model::Object object;
+                bool listNextPage = false;
+                bool haveObject = false;
+                {
+                    std::lock_guard<std::mutex> locker(state->lock);
+                    if (state->inFlight < m_transferConfig.maxDirectoryTransfersInFlight && !state->pendingObjects.empty())
+                    {
+                        object = state->pendingObjects.front();
+                        state->pendingObjects.pop_front();
+                        haveObject = true;
+                    }
+                    // keep the next page coming while this one is worked through.
+                    if (!state->listing && !state->listingDone && state->pendingObjects.size() < LIST_OBJECTS_PAGE_SIZE)
+                    {
+                        state->listing = true;
+                        listNextPage = true;
+                    }
+                    if (!haveObject)
+                    {
+                        state->exhausted = state->listingDone && !state->listing && state->pendingObjects.empty();
+                        state->dispatching = false;
+                    }
+                }
+
+                if (listNextPage)
+                {
+                    ListDirectoryObjects(state);
+                }
+                if (!haveObject)
+                {
+                    return;
+                }
+
+                if (IsS3KeyPrefix(object.GetKey()))
+                {
+                    continue;
+                }
+
+                Aws::String fileName = DetermineFilePath(state->rootDirectory, state->prefix, object.GetKey());
+                if (m_transferConfig.skipUnchangedDirectoryObjects)
+                {
+                    auto local = Aws::FileSystem::GetFileInfo(fileName.c_str());
+                    if (local && local.fileType == Aws::FileSystem::FileType::File && local.fileSize == object.GetSize() &&
+                        local.lastModified >= object.GetLastModified())
+                    {
+                        AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Skipping download of key: [" << object.GetKey() << "] in bucket: ["
+                                << state->bucketName << "], destination file: [" << fileName << "] already has the same size.");
+                        ReportUnchangedDirectoryObject(Aws::MakeShared<TransferHandle>(CLASS_TAG, state->bucketName, object.GetKey(), fileName));
+                        continue;
+                    }
+                }
+
+                auto lastDelimter = fileName.find_last_of(Aws::FileSystem::PATH_DELIM);
+                if (lastDelimter != std::string::npos)
+                {
+                    Aws::FileSystem::CreateDirectoryIfNotExists(fileName.substr(0, lastDelimter).c_str(), true/*create parent dirs*/);
+                }
+                AWS_LOGSTREAM_INFO(CLASS_TAG, "Initiating download of key: [" << object.GetKey() <<
+                        "] in bucket: [" << state->bucketName << "] to destination file: [" << fileName << "]");
+
+                auto handle = CreateDownloadFileHandle(state->bucketName, object.GetKey(), fileName, DownloadConfiguration(), nullptr);
+                TrackDirectoryTransfer(state, handle);
+                m_transferConfig.transferInitiatedCallback(this, handle);
+
+                auto self = shared_from_this();
+                m_transferConfig.transferExecutor->Submit([self, handle] { self->DoDownload(handle); });
+            }
+        }
+
+        void TransferManager::TrackDirectoryTransfer(const std::shared_ptr<DirectoryTransferState>& state, const std::shared_ptr<TransferHandle>& handle)
+        {
+            // a handle that failed on creation never runs, so it never reports back to free its slot.
+            if (handle->GetStatus() != TransferStatus::NOT_STARTED)
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> locker(state->lock);
+                ++state->inFlight;
+            }
+            std::lock_guard<std::mutex> locker(m_directoryTransfersLock);
+            m_directoryTransfers[handle->GetId()] = state;
+        }
+
+        void TransferManager::ReportUnchangedDirectoryObject(const std::shared_ptr<TransferHandle>& handle)
+        {
+            UpdateHandleStatus(handle, TransferStatus::EXACT_OBJECT_ALREADY_EXISTS);
+            m_transferConfig.transferInitiatedCallback(this, handle);
+            TriggerTransferStatusUpdatedCallback(handle);
+        }
+
+        void TransferManager::OnTransferFinished(const std::shared_ptr<const TransferHandle>& handle)
+        {
+            std::shared_ptr<DirectoryTransferState> state;
+            {
+                std::lock_guard<std::mutex> locker(m_directoryTransfersLock);
+                auto tracked = m_directoryTransfers.find(handle->GetId());
+                if (tracked == m_directoryTransfers.end())
+                {
+                    return;
+                }
+                state = tracked->second;
+                m_directoryTransfers.erase(tracked);
+            }
+
+            {
+                std::lock_guard<std::mutex> locker(state->lock);
+                --state->inFlight;
+                if (state->dispatching || state->exhausted)
+                {
+                    return;
+                }
+                state->dispatching = true;
+            }
+
+            auto self = shared_from_this();
+            if (state->direction == TransferDirection::UPLOAD)
+            {
+                auto uploadState = std::static_pointer_cast<DirectoryUploadState>(state);
+                m_transferConfig.transferExecutor->Submit([self, uploadState]() { self->ContinueDirectoryUpload(uploadState); });
+            }
+            else
+            {
+                auto downloadState = std::static_pointer_cast<DirectoryDownloadState>(state);
+                m_transferConfig.transferExecutor->Submit([self, downloadState]() { self->ContinueDirectoryDownload(downloadState); });
+            }
+        }
+
         void TransferManager::DoMultiPartUpload(const std::shared_ptr<TransferHandle>& handle)
         {
-#ifdef _MSC_VER
-            auto wide = Aws::Utils::StringUtils::ToWString(handle->GetTargetFilePath().c_str());
-            auto streamToPut = Aws::MakeShared<Aws::FStream>(CLASS_TAG, wide.c_str(), std::ios_base::in | std::ios_base::binary);
-            DoMultiPartUpload(streamToPut, handle);
-#else
-            auto streamToPut = Aws::MakeShared<Aws::FStream>(CLASS_TAG, handle->GetTargetFilePath().c_str(), std::ios_base::in | std::ios_base::binary);
-            DoMultiPartUpload(streamToPut, handle);
-#endif
+            // each part reads its own range of the file while it is being sent.
+            DoMultiPartUpload(nullptr, handle);
         }
 
         void TransferManager::DoMultiPartUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle)
@@ -283,17 +793,23 @@ namespace Aws
                 {
                     handle->SetMultipartId(createMultipartResponse.GetResult().GetUploadId());
                     uint64_t totalSize = handle->GetBytesTotalSize();
-                    uint64_t partCount = ( totalSize + m_transferConfig.bufferSize - 1 ) / m_transferConfig.bufferSize;
+                    // stream parts are copied into the pooled buffers, so only file parts can grow past bufferSize.
+                    uint64_t fullPartSize = !streamToPut && m_transferConfig.enableAdaptiveTransfer ?
+                        ChoosePartSize(totalSize, m_transferConfig.bufferSize) : m_transferConfig.bufferSize;
+                    uint64_t partCount = ( totalSize + fullPartSize - 1 ) / fullPartSize;
                     AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Transfer handle [" << handle->GetId()
                             << "] Successfully created a multi-part upload request. Upload ID: ["
                             << createMultipartResponse.GetResult().GetUploadId()
-                            << "]. Splitting the multi-part upload to " << partCount << " part(s).");
+                            << "]. Splitting the multi-part upload to " << partCount << " part(s) of "
+                            << fullPartSize << " bytes.");
 
                     for (uint64_t i = 0; i < partCount; ++i)
                     {
-                        uint64_t partSize = (std::min)(totalSize - i * m_transferConfig.bufferSize, m_transferConfig.bufferSize);
+                        uint64_t partSize = (std::min)(totalSize - i * fullPartSize, fullPartSize);
                         bool lastPart = (i == partCount - 1) ? true : false;
-                        handle->AddQueuedPart(Aws::MakeShared<PartState>(CLASS_TAG, static_cast<int>(i + 1), 0, static_cast<size_t>(partSize), lastPart));
+                        auto partState = Aws::MakeShared<PartState>(CLASS_TAG, static_cast<int>(i + 1), 0, static_cast<size_t>(partSize), lastPart);
+                        partState->SetRangeBegin(static_cast<size_t>(i * fullPartSize));
+                        handle->AddQueuedPart(partState);
                     }
                 }
                 else
@@ -302,7 +818,7 @@ namespace Aws
                             "multi-part upload request. Bucket: [" << handle->GetBucketName()
                             << "] with Key: [" << handle->GetKey() << "]. " << createMultipartResponse.GetError());
                     handle->SetError(createMultipartResponse.GetError());
-                    handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+                    UpdateHandleStatus(handle, DetermineIfFailedOrCanceled(*handle));
 
                     TriggerErrorCallback(handle, createMultipartResponse.GetError());
                     TriggerTransferStatusUpdatedCallback(handle);
@@ -332,21 +848,34 @@ namespace Aws
             PartStateMap queuedParts = handle->GetQueuedParts();
             auto partsIter = queuedParts.begin();
 
-            handle->UpdateStatus(TransferStatus::IN_PROGRESS);
+            UpdateHandleStatus(handle, TransferStatus::IN_PROGRESS);
             TriggerTransferStatusUpdatedCallback(handle);
 
 
             while (sentBytes < handle->GetBytesTotalSize() && handle->ShouldContinue() && partsIter != queuedParts.end())
             {
-                auto buffer = m_bufferManager.Acquire();
+                // a file part only needs a slot, its body reads the file lazily on the thread sending it.
+                uint64_t partTicket = m_partLimiter.Acquire();
+                unsigned char* buffer = streamToPut ? m_bufferManager.Acquire() : nullptr;
+
                 if(handle->ShouldContinue())
                 {
                     auto lengthToWrite = partsIter->second->GetSizeInBytes();
-                    streamToPut->seekg((partsIter->first - 1) * m_transferConfig.bufferSize);
-                    streamToPut->read(reinterpret_cast<char*>(buffer), lengthToWrite);
+                    uint64_t partOffset = partsIter->second->GetRangeBegin();
 
-                    auto streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, static_cast<size_t>(lengthToWrite));
-                    auto preallocatedStreamReader = Aws::MakeShared<Aws::IOStream>(CLASS_TAG, streamBuf);
+                    std::shared_ptr<Aws::IOStream> partBody;
+                    if (buffer)
+                    {
+                        streamToPut->seekg(partOffset);
+                        streamToPut->read(reinterpret_cast<char*>(buffer), lengthToWrite);
+                        partBody = Aws::MakeShared<Aws::Utils::Stream::DefaultUnderlyingStream>(CLASS_TAG,
+                                Aws::MakeUnique<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, static_cast<size_t>(lengthToWrite)));
+                    }
+                    else
+                    {
+                        partBody = Aws::MakeShared<Aws::Utils::Stream::DefaultUnderlyingStream>(CLASS_TAG,
+                                Aws::MakeUnique<Aws::Utils::Stream::FileRangeStreamBuf>(CLASS_TAG, handle->GetTargetFilePath(), partOffset, lengthToWrite));
+                    }
 
                     auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
                     PartPointer partPtr = partsIter->second;
@@ -363,11 +892,14 @@ namespace Aws
 
                     handle->AddPendingPart(partsIter->second);
 
-                    uploadPartRequest.SetBody(preallocatedStreamReader);
+                    uploadPartRequest.SetBody(partBody);
                     uploadPartRequest.SetContentType(handle->GetContentType());
                     auto asyncContext = Aws::MakeShared<TransferHandleAsyncContext>(CLASS_TAG);
                     asyncContext->handle = handle;
                     asyncContext->partState = partsIter->second;
+                    asyncContext->partBuffer = buffer;
+                    asyncContext->partTicket = partTicket;
+                    asyncContext->partStarted = std::chrono::steady_clock::now();
 
                     auto callback = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::UploadPartRequest& request,
                         const Aws::S3::Model::UploadPartOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
@@ -382,7 +914,11 @@ namespace Aws
                 }
                 else
                 {
-                    m_bufferManager.Release(buffer);
+                    if (buffer)
+                    {
+                        m_bufferManager.Release(buffer);
+                    }
+                    m_partLimiter.Release();
                 }
             }
             //parts get moved from queued to pending on this thread.
@@ -394,7 +930,7 @@ namespace Aws
 
             if (handle->HasFailedParts())
             {
-                handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+                UpdateHandleStatus(handle, DetermineIfFailedOrCanceled(*handle));
                 TriggerTransferStatusUpdatedCallback(handle);
             }
         }
@@ -415,20 +951,12 @@ namespace Aws
         {
             auto partState = Aws::MakeShared<PartState>(CLASS_TAG, 1, 0, static_cast<size_t>(handle->GetBytesTotalSize()), true);
 
-            handle->UpdateStatus(TransferStatus::IN_PROGRESS);
+            UpdateHandleStatus(handle, TransferStatus::IN_PROGRESS);
             handle->SetIsMultipart(false);
             handle->AddPendingPart(partState);
             TriggerTransferStatusUpdatedCallback(handle);
 
-            auto putObjectRequest = m_transferConfig.putObjectTemplate;
-            putObjectRequest.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
-            putObjectRequest.SetContinueRequestHandler([handle](const Aws::Http::HttpRequest*) { return handle->ShouldContinue(); });
-            putObjectRequest.WithBucket(handle->GetBucketName())
-                .WithKey(handle->GetKey())
-                .WithContentLength(static_cast<long long>(handle->GetBytesTotalSize()))
-                .WithMetadata(handle->GetMetadata());
-
-            putObjectRequest.SetContentType(handle->GetContentType());
+            auto putObjectRequest = CreatePutObjectRequest(handle, partState);
 
             auto buffer = m_bufferManager.Acquire();
 
@@ -439,6 +967,87 @@ namespace Aws
 
             putObjectRequest.SetBody(preallocatedStreamReader);
 
+            auto asyncContext = Aws::MakeShared<TransferHandleAsyncContext>(CLASS_TAG);
+            asyncContext->handle = handle;
+            asyncContext->partState = partState;
+
+            auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
+            auto callback = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::PutObjectRequest& request,
+                const Aws::S3::Model::PutObjectOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
+            {
+                self->HandlePutObjectResponse(client, request, outcome, context);
+            };
+
+            m_transferConfig.s3Client->PutObjectAsync(putObjectRequest, callback, asyncContext);
+        }
+
+        void TransferManager::DoSmallObjectUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle)
+        {
+            auto partState = Aws::MakeShared<PartState>(CLASS_TAG, 1, 0, static_cast<size_t>(handle->GetBytesTotalSize()), true);
+
+            UpdateHandleStatus(handle, TransferStatus::IN_PROGRESS);
+            handle->SetIsMultipart(false);
+            handle->AddPendingPart(partState);
+            TriggerTransferStatusUpdatedCallback(handle);
+
+            auto putObjectRequest = CreatePutObjectRequest(handle, partState);
+
+            std::shared_ptr<Aws::IOStream> source = streamToPut;
+            if (!source)
+            {
+#ifdef _MSC_VER
+                auto wide = Aws::Utils::StringUtils::ToWString(handle->GetTargetFilePath().c_str());
+                source = Aws::MakeShared<Aws::FStream>(CLASS_TAG, wide.c_str(), std::ios_base::in | std::ios_base::binary);
+#else
+                source = Aws::MakeShared<Aws::FStream>(CLASS_TAG, handle->GetTargetFilePath().c_str(), std::ios_base::in | std::ios_base::binary);
+#endif
+            }
+
+            // sized to the object, a tiny file shouldn't tie up one of the bufferSize pooled buffers.
+            auto lengthToWrite = static_cast<size_t>(handle->GetBytesTotalSize());
+            auto buffer = Aws::MakeShared<Aws::Vector<unsigned char>>(CLASS_TAG, lengthToWrite);
+            source->read(reinterpret_cast<char*>(buffer->data()), lengthToWrite);
+            if (static_cast<size_t>(source->gcount()) != lengthToWrite)
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Transfer handle [" << handle->GetId() << "] Could only read " << source->gcount()
+                        << " of " << lengthToWrite << " bytes to upload to Bucket: [" << handle->GetBucketName() << "] with Key: ["
+                        << handle->GetKey() << "].");
+                Aws::Client::AWSError<Aws::S3::S3Errors> readError(Aws::S3::S3Errors::INTERNAL_FAILURE, "ReadFailed",
+                        "The object to upload could not be read in full.", false);
+                handle->ChangePartToFailed(partState);
+                handle->SetError(readError);
+                UpdateHandleStatus(handle, DetermineIfFailedOrCanceled(*handle));
+                TriggerErrorCallback(handle, readError);
+                TriggerTransferStatusUpdatedCallback(handle);
+                return;
+            }
+
+            putObjectRequest.SetBody(Aws::MakeShared<Aws::Utils::Stream::DefaultUnderlyingStream>(CLASS_TAG,
+                    Aws::MakeUnique<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer->data(), lengthToWrite)));
+
+            auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
+            // the body reads straight from buffer, so the callback holds on to it until the request is done.
+            auto callback = [self, handle, partState, buffer](const Aws::S3::S3Client*, const Aws::S3::Model::PutObjectRequest&,
+                const Aws::S3::Model::PutObjectOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&)
+            {
+                self->FinishSinglePartUpload(handle, partState, outcome);
+            };
+
+            m_transferConfig.s3Client->PutObjectAsync(putObjectRequest, callback);
+        }
+
+        Aws::S3::Model::PutObjectRequest TransferManager::CreatePutObjectRequest(const std::shared_ptr<TransferHandle>& handle, const PartPointer& partState)
+        {
+            auto putObjectRequest = m_transferConfig.putObjectTemplate;
+            putObjectRequest.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
+            putObjectRequest.SetContinueRequestHandler([handle](const Aws::Http::HttpRequest*) { return handle->ShouldContinue(); });
+            putObjectRequest.WithBucket(handle->GetBucketName())
+                .WithKey(handle->GetKey())
+                .WithContentLength(static_cast<long long>(handle->GetBytesTotalSize()))
+                .WithMetadata(handle->GetMetadata());
+
+            putObjectRequest.SetContentType(handle->GetContentType());
+
             auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
             auto uploadProgressCallback = [self, partState, handle](const Aws::Http::HttpRequest*, long long progress)
             {
@@ -454,18 +1063,7 @@ namespace Aws
 
             putObjectRequest.SetDataSentEventHandler(uploadProgressCallback);
             putObjectRequest.SetRequestRetryHandler(retryHandlerCallback);
-
-            auto asyncContext = Aws::MakeShared<TransferHandleAsyncContext>(CLASS_TAG);
-            asyncContext->handle = handle;
-            asyncContext->partState = partState;
-
-            auto callback = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::PutObjectRequest& request,
-                const Aws::S3::Model::PutObjectOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
-            {
-                self->HandlePutObjectResponse(client, request, outcome, context);
-            };
-
-            m_transferConfig.s3Client->PutObjectAsync(putObjectRequest, callback, asyncContext);
+            return putObjectRequest;
         }
 
         void TransferManager::HandleUploadPartResponse(const Aws::S3::S3Client*, const Aws::S3::Model::UploadPartRequest& request,
@@ -474,13 +1072,18 @@ namespace Aws
             std::shared_ptr<TransferHandleAsyncContext> transferContext =
                 std::const_pointer_cast<TransferHandleAsyncContext>(std::static_pointer_cast<const TransferHandleAsyncContext>(context));
 
-            auto originalStreamBuffer = (Aws::Utils::Stream::PreallocatedStreamBuf*)request.GetBody()->rdbuf();
+            AWS_UNREFERENCED_PARAM(request);
 
-            m_bufferManager.Release(originalStreamBuffer->GetBuffer());
-            Aws::Delete(originalStreamBuffer);
             const auto& handle = transferContext->handle;
             const auto& partState = transferContext->partState;
 
+            if (transferContext->partBuffer)
+            {
+                m_bufferManager.Release(transferContext->partBuffer);
+            }
+            m_partLimiter.Release(transferContext->partTicket, outcome.IsSuccess(), GetPartSampleBytes(partState),
+                    std::chrono::steady_clock::now() - transferContext->partStarted);
+
             if (outcome.IsSuccess())
             {
                 if (handle->ShouldContinue())
@@ -551,7 +1154,7 @@ namespace Aws
                                 << "] Multi-part upload completed successfully to Bucket: ["
                                 << handle->GetBucketName() << "] with Key: [" << handle->GetKey()
                                 << "] with Upload ID: [" << handle->GetMultiPartId() << "].");
-                        handle->UpdateStatus(TransferStatus::COMPLETED);
+                        UpdateHandleStatus(handle, TransferStatus::COMPLETED);
                     }
                     else
                     {
@@ -561,7 +1164,7 @@ namespace Aws
                                 << "] with Upload ID: [" << handle->GetMultiPartId()
                                 << "]. " << completeUploadOutcome.GetError());
 
-                        handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+                        UpdateHandleStatus(handle, DetermineIfFailedOrCanceled(*handle));
                     }
                 }
                 else
@@ -569,7 +1172,7 @@ namespace Aws
                     AWS_LOGSTREAM_TRACE(CLASS_TAG, "Transfer handle [" << handle->GetId() << "] " << failedParts.size()
                             << " Failed parts. " << handle->GetBytesTransferred() << " bytes transferred out of "
                             << handle->GetBytesTotalSize() << " total bytes.");
-                    handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+                    UpdateHandleStatus(handle, DetermineIfFailedOrCanceled(*handle));
                 }
                 TriggerTransferStatusUpdatedCallback(handle);
             }
@@ -586,9 +1189,12 @@ namespace Aws
             m_bufferManager.Release(originalStreamBuffer->GetBuffer());
             Aws::Delete(originalStreamBuffer);
 
-            const auto& handle = transferContext->handle;
-            const auto& partState = transferContext->partState;
+            FinishSinglePartUpload(transferContext->handle, transferContext->partState, outcome);
+        }
 
+        void TransferManager::FinishSinglePartUpload(const std::shared_ptr<TransferHandle>& handle, const PartPointer& partState,
+            const Aws::S3::Model::PutObjectOutcome& outcome)
+        {
             if (outcome.IsSuccess())
             {
                 AWS_LOGSTREAM_INFO(CLASS_TAG, "Transfer handle [" << handle->GetId()
@@ -596,7 +1202,7 @@ namespace Aws
                         << handle->GetBucketName() << "] with Key: [" << handle->GetKey()
                         << "].");
                 handle->ChangePartToCompleted(partState, outcome.GetResult().GetETag());
-                handle->UpdateStatus(TransferStatus::COMPLETED);
+                UpdateHandleStatus(handle, TransferStatus::COMPLETED);
             }
             else
             {
@@ -605,7 +1211,7 @@ namespace Aws
                         << "] " << outcome.GetError());
                 handle->ChangePartToFailed(partState);
                 handle->SetError(outcome.GetError());
-                handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+                UpdateHandleStatus(handle, DetermineIfFailedOrCanceled(*handle));
                 TriggerErrorCallback(handle, outcome.GetError());
             }
 
@@ -622,10 +1228,14 @@ namespace Aws
             {
                 DownloadConfiguration retryDownloadConfig;
                 retryDownloadConfig.versionId = retryHandle->GetVersionId();
+                if (retryHandle->WritesPartsToFile())
+                {
+                    return DownloadFile(retryHandle->GetBucketName(), retryHandle->GetKey(), retryHandle->GetTargetFilePath(), retryDownloadConfig);
+                }
                 return DownloadFile(retryHandle->GetBucketName(), retryHandle->GetKey(), retryHandle->GetCreateDownloadStreamFunction(), retryDownloadConfig, retryHandle->GetTargetFilePath());
             }
 
-            retryHandle->UpdateStatus(TransferStatus::NOT_STARTED);
+            UpdateHandleStatus(retryHandle, TransferStatus::NOT_STARTED);
             retryHandle->Restart();
             TriggerTransferStatusUpdatedCallback(retryHandle);
             
@@ -673,7 +1283,7 @@ namespace Aws
                 handle->SetMetadata(getObjectOutcome.GetResult().GetMetadata());
                 handle->SetContentType(getObjectOutcome.GetResult().GetContentType());
                 handle->ChangePartToCompleted(partState, getObjectOutcome.GetResult().GetETag());
-                handle->UpdateStatus(TransferStatus::COMPLETED);
+                UpdateHandleStatus(handle, TransferStatus::COMPLETED);
             }
             else
             {
@@ -681,7 +1291,7 @@ namespace Aws
                         << "] Failed to download object to Bucket: [" << handle->GetBucketName() << "] with Key: ["
                         << handle->GetKey() << "] " << getObjectOutcome.GetError());
                 handle->ChangePartToFailed(partState);
-                handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+                UpdateHandleStatus(handle, DetermineIfFailedOrCanceled(*handle));
                 handle->SetError(getObjectOutcome.GetError());
 
                 TriggerErrorCallback(handle, getObjectOutcome.GetError());
@@ -721,7 +1331,7 @@ namespace Aws
                             << "] Failed to get download parts information for object in Bucket: ["
                             << handle->GetBucketName() << "] with Key: [" << handle->GetKey()
                             << "] " << headObjectOutcome.GetError());
-                    handle->UpdateStatus(TransferStatus::FAILED);
+                    UpdateHandleStatus(handle, TransferStatus::FAILED);
                     handle->SetError(headObjectOutcome.GetError());
                     TriggerErrorCallback(handle, headObjectOutcome.GetError());
                     TriggerTransferStatusUpdatedCallback(handle);
@@ -767,11 +1377,10 @@ namespace Aws
             {
                 return;
             }
-            handle->UpdateStatus(TransferStatus::IN_PROGRESS);
+            UpdateHandleStatus(handle, TransferStatus::IN_PROGRESS);
             TriggerTransferStatusUpdatedCallback(handle);
 
             bool isMultipart = handle->IsMultipart();
-            size_t bufferSize = static_cast<size_t>(m_transferConfig.bufferSize);
 
             if(!isMultipart)
             {
@@ -780,13 +1389,22 @@ namespace Aws
                 return;
             }
 
+            if (handle->WritesPartsToFile() && !handle->OpenDownloadFile(handle->GetBytesTotalSize()))
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Transfer handle [" << handle->GetId()
+                        << "] Could not open " << handle->GetTargetFilePath()
+                        << " for positional writes, falling back to writing parts through the download stream.");
+                handle->SetWritePartsToFile(false);
+            }
+
             auto queuedParts = handle->GetQueuedParts();
             auto queuedPartIter = queuedParts.begin();
             while(queuedPartIter != queuedParts.end() && handle->ShouldContinue())
             {
                 const auto& partState = queuedPartIter->second;
-                std::size_t rangeStart = ( partState->GetPartId() - 1 ) * bufferSize;
+                std::size_t rangeStart = partState->GetRangeBegin();
                 std::size_t rangeEnd = rangeStart + partState->GetSizeInBytes() - 1;
+                uint64_t partTicket = m_partLimiter.Acquire();
                 auto buffer = m_bufferManager.Acquire();
                 partState->SetDownloadBuffer(buffer);
 
@@ -831,6 +1449,8 @@ namespace Aws
                     auto asyncContext = Aws::MakeShared<TransferHandleAsyncContext>(CLASS_TAG);
                     asyncContext->handle = handle;
                     asyncContext->partState = partState;
+                    asyncContext->partTicket = partTicket;
+                    asyncContext->partStarted = std::chrono::steady_clock::now();
 
                     auto callback = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::GetObjectRequest& request,
                         const Aws::S3::Model::GetObjectOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
@@ -843,9 +1463,10 @@ namespace Aws
                     m_transferConfig.s3Client->GetObjectAsync(getObjectRangeRequest, callback, asyncContext);
                     ++queuedPartIter;
                 }
-                else if(buffer)
+                else
                 {
                     m_bufferManager.Release(buffer);
+                    m_partLimiter.Release();
                     break;
                 }
             }
@@ -859,7 +1480,7 @@ namespace Aws
             }
             if (handle->HasFailedParts())
             {
-                handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+                UpdateHandleStatus(handle, DetermineIfFailedOrCanceled(*handle));
                 TriggerTransferStatusUpdatedCallback(handle);      
             }
         }
@@ -877,6 +1498,9 @@ namespace Aws
             const auto& handle = transferContext->handle;
             const auto& partState = transferContext->partState;
 
+            m_partLimiter.Release(transferContext->partTicket, outcome.IsSuccess(), GetPartSampleBytes(partState),
+                    std::chrono::steady_clock::now() - transferContext->partStarted);
+
             if (!outcome.IsSuccess())
             {
                 AWS_LOGSTREAM_ERROR(CLASS_TAG, "Transfer handle [" << handle->GetId()
@@ -891,10 +1515,33 @@ namespace Aws
             {
                 if(handle->ShouldContinue())
                 {
-                    Aws::IOStream* bufferStream = partState->GetDownloadPartStream();
-                    assert(bufferStream);
-                    handle->WritePartToDownloadStream(bufferStream, partState->GetRangeBegin());
-                    handle->ChangePartToCompleted(partState, outcome.GetResult().GetETag());
+                    bool partWritten = true;
+                    if (handle->WritesPartsToFile())
+                    {
+                        // the part is already in the pooled buffer, write it straight to its place in the file.
+                        partWritten = handle->WritePartToDownloadFile(partState->GetDownloadBuffer(), partState->GetSizeInBytes(), partState->GetRangeBegin());
+                    }
+                    else
+                    {
+                        Aws::IOStream* bufferStream = partState->GetDownloadPartStream();
+                        assert(bufferStream);
+                        handle->WritePartToDownloadStream(bufferStream, partState->GetRangeBegin());
+                    }
+
+                    if (partWritten)
+                    {
+                        handle->ChangePartToCompleted(partState, outcome.GetResult().GetETag());
+                    }
+                    else
+                    {
+                        AWS_LOGSTREAM_ERROR(CLASS_TAG, "Transfer handle [" << handle->GetId()
+                                << "] Failed to write part " << partState->GetPartId() << " to " << handle->GetTargetFilePath());
+                        Aws::Client::AWSError<Aws::S3::S3Errors> writeError(Aws::S3::S3Errors::INTERNAL_FAILURE, "WriteFailed",
+                                "The downloaded part could not be written to the file.", false);
+                        handle->ChangePartToFailed(partState);
+                        handle->SetError(writeError);
+                        TriggerErrorCallback(handle, writeError);
+                    }
                 }
                 else
                 {
@@ -918,11 +1565,11 @@ namespace Aws
             {
                 if (failedParts.size() == 0 && handle->GetBytesTransferred() == handle->GetBytesTotalSize())
                 {
-                    handle->UpdateStatus(TransferStatus::COMPLETED);
+                    UpdateHandleStatus(handle, TransferStatus::COMPLETED);
                 }
                 else
                 {
-                    handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+                    UpdateHandleStatus(handle, DetermineIfFailedOrCanceled(*handle));
                 }
                 TriggerTransferStatusUpdatedCallback(handle);
             }
@@ -956,7 +1603,7 @@ namespace Aws
                             "] Successfully aborted multi-part upload. In Bucket: ["
                             << canceledHandle->GetBucketName() << "] with Key: [" << canceledHandle->GetKey()
                             << "] with Upload ID: [" << canceledHandle->GetMultiPartId() << "].");
-                    canceledHandle->UpdateStatus(TransferStatus::ABORTED);
+                    UpdateHandleStatus(canceledHandle, TransferStatus::ABORTED);
                     TriggerTransferStatusUpdatedCallback(canceledHandle);
                 }
                 else
@@ -984,49 +1631,27 @@ namespace Aws
         void TransferManager::HandleListObjectsResponse(const Aws::S3::S3Client*, const Aws::S3::Model::ListObjectsV2Request& request, const Aws::S3::Model::ListObjectsV2Outcome& outcome,
             const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
         {
-            auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
-            auto handler = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::ListObjectsV2Request& request, const Aws::S3::Model::ListObjectsV2Outcome& outcome,
-                const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context) { self->HandleListObjectsResponse(client, request, outcome, context); };
-
             auto downloadContext = std::static_pointer_cast<const DownloadDirectoryContext>(context);
             const auto& directory = downloadContext->rootDirectory;
             const auto& prefix = downloadContext->prefix;
+            const auto& state = downloadContext->state;
 
             if (outcome.IsSuccess())
             {
-                Aws::S3::Model::ListObjectsV2Request requestCpy = request;
-
                 auto& result = outcome.GetResult();
 
                 AWS_LOGSTREAM_TRACE(CLASS_TAG, "Listing objects succeeded for bucket: " << directory <<
                         " with prefix: " << prefix << ". Number of keys received: " << result.GetContents().size());
 
-                //if it was truncated, we don't care on this pass anyways. Just go ahead and kick off another list objects and will handle it when it finishes.
-                if (result.GetIsTruncated())
-                {
-                    AWS_LOGSTREAM_TRACE(CLASS_TAG, "Listing objects response has a continuation token for bucket: "
-                            << directory << " with prefix: " << prefix << ". Getting the next set of results.");
-                    requestCpy.SetContinuationToken(result.GetNextContinuationToken());
-                    m_transferConfig.s3Client->ListObjectsV2Async(requestCpy, handler, context);
-                }
-
-                //this can contain matching directories or actual objects to download. If it's a directory, go ahead and create a local directory then
-                // take the new prefix and call list again. if it's an object key, go ahead and initiate download.
+                //keys ending in a delimiter are directories, they are skipped once the objects are picked up for download.
+                std::lock_guard<std::mutex> locker(state->lock);
                 for (auto& content : result.GetContents())
                 {
-                    if (!IsS3KeyPrefix(content.GetKey()))
-                    {
-                        Aws::String fileName = DetermineFilePath(downloadContext->rootDirectory, downloadContext->prefix, content.GetKey());
-                        auto lastDelimter = fileName.find_last_of(Aws::FileSystem::PATH_DELIM);
-                        if (lastDelimter != std::string::npos)
-                        {
-                            Aws::FileSystem::CreateDirectoryIfNotExists(fileName.substr(0, lastDelimter).c_str(), true/*create parent dirs*/);
-                        }
-                        AWS_LOGSTREAM_INFO(CLASS_TAG, "Initiating download of key: [" << content.GetKey() <<
-                                "] in bucket: [" << directory << "] to destination file: [" << fileName << "]");
-                        m_transferConfig.transferInitiatedCallback(this, DownloadFile(request.GetBucket(), content.GetKey(), fileName));
-                    }
+                    state->pendingObjects.push_back(content);
                 }
+                //if it was truncated, the next page is requested once the objects from this one start running out.
+                state->continuationToken = result.GetIsTruncated() ? result.GetNextContinuationToken() : Aws::String();
+                state->listingDone = !result.GetIsTruncated();
             }
             else
             {
@@ -1038,7 +1663,22 @@ namespace Aws
                     auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, request.GetBucket(), "");
                     m_transferConfig.errorCallback(this, handle, outcome.GetError());
                 }
+                std::lock_guard<std::mutex> locker(state->lock);
+                state->listingDone = true;
+            }
+
+            {
+                std::lock_guard<std::mutex> locker(state->lock);
+                state->listing = false;
+                if (state->dispatching)
+                {
+                    return;
+                }
+                state->dispatching = true;
             }
+
+            auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
+            m_transferConfig.transferExecutor->Submit([self, state]() { self->ContinueDirectoryDownload(state); });
         }
 
         Aws::String TransferManager::DetermineFilePath(const Aws::String& directory, const Aws::String& prefix, const Aws::String& keyName)
@@ -1088,6 +1728,19 @@ namespace Aws
             }
         }
 
+        void TransferManager::UpdateHandleStatus(const std::shared_ptr<TransferHandle>& handle, TransferStatus status)
+        {
+            handle->UpdateStatus(status);
+            switch (handle->GetStatus())
+            {
+                case TransferStatus::NOT_STARTED:
+                case TransferStatus::IN_PROGRESS:
+                    break;
+                default:
+                    OnTransferFinished(handle);
+            }
+        }
+
         void TransferManager::TriggerErrorCallback(const std::shared_ptr<const TransferHandle>& handle, const Aws::Client::AWSError<Aws::S3::S3Errors>& error) const
         {
             if (m_transferConfig.errorCallback)
@@ -1096,6 +1749,23 @@ namespace Aws
             }
         }
 
+        uint64_t TransferManager::ChoosePartSize(uint64_t objectSize, uint64_t minPartSize)
+        {
+            // even a 5TB object then stays far below the 10,000 parts S3 allows, and small objects keep small parts so they still get spread
+            // over several connections.
+            uint64_t partSize = minPartSize;
+            while (partSize < MAX_PART_SIZE && (objectSize + partSize - 1) / partSize > TARGET_PART_COUNT)
+            {
+                partSize *= 2;
+            }
+            return (std::min)(partSize, (std::max)(MAX_PART_SIZE, minPartSize));
+        }
+
+        size_t TransferManager::GetPartsInFlightLimit() const
+        {
+            return m_partLimiter.GetLimit();
+        }
+
         bool TransferManager::MultipartUploadSupported(uint64_t length) const
         {
             return length > m_transferConfig.bufferSize && 
@@ -1121,7 +1791,7 @@ namespace Aws
                 AWS_LOGSTREAM_ERROR(CLASS_TAG, "Failed to read from input stream to upload file to bucket: " <<
                         bucketName << " with key: " << keyName);
                 handle->SetError(Aws::Client::AWSError<Aws::Client::CoreErrors>(static_cast<Aws::Client::CoreErrors>(Aws::S3::S3Errors::NO_SUCH_UPLOAD), "NoSuchUpload", "The requested file could not be opened.", false));
-                handle->UpdateStatus(Aws::Transfer::TransferStatus::FAILED);
+                UpdateHandleStatus(handle, Aws::Transfer::TransferStatus::FAILED);
                 TriggerTransferStatusUpdatedCallback(handle);
                 return handle;
             }
@@ -1161,6 +1831,11 @@ namespace Aws
             else
             {
                 AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Transfer handle [" << handle->GetId() << "] Scheduling a single-part upload.");
+                if (handle->GetBytesTotalSize() <= SMALL_OBJECT_MAX_SIZE)
+                {
+                    m_transferConfig.transferExecutor->Submit([self, handle, fileStream] { self->DoSmallObjectUpload(fileStream, handle); });
+                    return handle;
+                }
                 m_transferConfig.transferExecutor->Submit([self, handle, fileStream]
                     {
                         if (fileStream != nullptr)
@@ -1193,6 +1868,17 @@ namespace Aws
                                                                       const Aws::String& contentType,
                                                                       const Aws::Map<Aws::String, Aws::String>& metadata,
                                                                       const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
+        {
+            auto handle = CreateUploadFileHandle(fileName, bucketName, keyName, contentType, metadata, context);
+            return SubmitUpload(handle);
+        }
+
+        std::shared_ptr<TransferHandle> TransferManager::CreateUploadFileHandle(const Aws::String& fileName,
+                                                                                const Aws::String& bucketName,
+                                                                                const Aws::String& keyName,
+                                                                                const Aws::String& contentType,
+                                                                                const Aws::Map<Aws::String, Aws::String>& metadata,
+                                                                                const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
         {
             // destructor of FStream will close stream automatically (when out of scope), no need to call close explicitly
 #ifdef _MSC_VER
@@ -1201,8 +1887,7 @@ namespace Aws
 #else
             auto fileStream = Aws::MakeShared<Aws::FStream>(CLASS_TAG, fileName.c_str(), std::ios_base::in | std::ios_base::binary);
 #endif
-            auto handle = CreateUploadFileHandle(fileStream.get(), bucketName, keyName, contentType, metadata, context, fileName);
-            return SubmitUpload(handle);
+            return CreateUploadFileHandle(fileStream.get(), bucketName, keyName, contentType, metadata, context, fileName);
         }
     }
 }
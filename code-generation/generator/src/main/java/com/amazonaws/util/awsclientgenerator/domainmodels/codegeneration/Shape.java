@@ -45,6 +45,7 @@ public class Shape {
     private boolean isReferenced;
     private boolean flattened;
     private boolean computeContentMd5;
+    private boolean xmlPullParsed;
     private boolean supportsPresigning;
     private boolean signBody;
     private String signerName;
@@ -429,4 +429,29 @@ public abstract class CppClientGenerator implements ClientGenerator {
     protected Set<String> getOperationsToRemove(){
         return new HashSet<String>();
     }
+
+    /**
+     * Has the results of the given operations deserialized straight from the response stream with an XmlReader instead of
+     * a parsed XmlDocument. Results streamed back to the caller, or with an explicit payload, keep the document path.
+     */
+    protected void markXmlPullParsedResults(ServiceModel serviceModel, Set<String> operationNames) {
+        serviceModel.getOperations().values().stream()
+                .filter(operation -> operationNames.contains(operation.getName()) && operation.getResult() != null)
+                .map(operation -> operation.getResult().getShape())
+                .filter(shape -> shape.getPayload() == null && !shape.hasStreamMembers() && !shape.hasEventStreamMembers())
+                .forEach(shape -> markXmlPullParsed(shape));
+    }
+
+    private void markXmlPullParsed(Shape shape) {
+        if (shape.isList()) {
+            markXmlPullParsed(shape.getListMember().getShape());
+        } else if (shape.isMap()) {
+            markXmlPullParsed(shape.getMapValue().getShape());
+        } else if (shape.isStructure() && !shape.isXmlPullParsed()) {
+            shape.setXmlPullParsed(true);
+            if (shape.getMembers() != null) {
+                shape.getMembers().values().forEach(member -> markXmlPullParsed(member.getShape()));
+            }
+        }
+    }
 }
@@ -20,7 +20,9 @@ import com.amazonaws.util.awsclientgenerator.domainmodels.codegeneration.*;
 import com.amazonaws.util.awsclientgenerator.domainmodels.codegeneration.Error;
 import com.amazonaws.util.awsclientgenerator.generators.cpp.QueryCppClientGenerator;
 
+import java.util.Arrays;
 import java.util.Collection;
+import java.util.HashSet;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.Map;
@@ -49,6 +51,10 @@ public class Ec2CppClientGenerator extends QueryCppClientGenerator{
             shapes.put(key.replaceAll("Result$", "Response"), shape);
         }
 
+        //the large Describe* responses are read off the wire instead of building a document first.
+        markXmlPullParsedResults(serviceModel, new HashSet<>(Arrays.asList(
+                "DescribeInstances", "DescribeImages", "DescribeSnapshots", "DescribeVolumes")));
+
         //add "disabled" state to SpotInstanceState
         List<String> spotInstanceStateEnumValues = shapes.get("SpotInstanceState").getEnumValues();
 
@@ -36,6 +36,7 @@ public class S3RestXmlCppClientGenerator  extends RestXmlCppClientGenerator {
     private static Set<String> opsThatNeedMd5 = new HashSet<>();
     private static Set<String> opsThatDoNotSupportVirtualAddressing = new HashSet<>();
     private static Set<String> bucketLocationConstraints = new HashSet<>();
+    private static Set<String> opsWithPullParsedResults = new HashSet<>();
 
     static {
         opsThatNeedMd5.add("DeleteObjects");
@@ -48,6 +49,12 @@ public class S3RestXmlCppClientGenerator  extends RestXmlCppClientGenerator {
         opsThatNeedMd5.add("PutObjectLockConfiguration");
         opsThatNeedMd5.add("PutObjectRetention");
 
+        opsWithPullParsedResults.add("ListObjects");
+        opsWithPullParsedResults.add("ListObjectsV2");
+        opsWithPullParsedResults.add("ListObjectVersions");
+        opsWithPullParsedResults.add("ListMultipartUploads");
+        opsWithPullParsedResults.add("ListParts");
+
         opsThatDoNotSupportVirtualAddressing.add("CreateBucket");
         opsThatDoNotSupportVirtualAddressing.add("ListBuckets");
 
@@ -88,6 +95,9 @@ public class S3RestXmlCppClientGenerator  extends RestXmlCppClientGenerator {
                         opsThatNeedMd5.contains(operationEntry.getName()))
                 .forEach(operationEntry -> operationEntry.getRequest().getShape().setComputeContentMd5(true));
 
+        //listings can run to thousands of entries, read them off the wire instead of building a document first.
+        markXmlPullParsedResults(serviceModel, opsWithPullParsedResults);
+
         //size and content length should ALWAYS be 64 bit integers, if they aren't set them as that now.
         serviceModel.getShapes().entrySet().stream().filter(shapeEntry -> shapeEntry.getKey().toLowerCase().equals("contentlength") || shapeEntry.getKey().toLowerCase().equals("size"))
                 .forEach(shapeEntry -> shapeEntry.getValue().setType("long"));
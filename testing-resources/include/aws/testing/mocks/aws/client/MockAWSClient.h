@@ -95,6 +95,14 @@ public:
         return httpOutcome;
     }
 
+    void MakeRequestAsync(const std::shared_ptr<const AmazonWebServiceRequest>& request, const HttpResponseOutcomeHandler& handler,
+        const std::shared_ptr<Aws::Utils::Threading::Executor>& executor = nullptr)
+    {
+        m_countedRetryStrategy->ResetAttemptedRetriesCount();
+        const URI uri("domain.com/something");
+        AWSClient::AttemptExhaustivelyAsync(uri, request, HttpMethod::HTTP_GET, Aws::Auth::SIGV4_SIGNER, handler, executor);
+    }
+
     inline static const char* GetMockAccessKey() { return "AKIDEXAMPLE"; }
     inline static const char* GetMockSecretAccessKey() { return "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY"; }
 